@@ -4,6 +4,7 @@
 #include <string>
 #include <filesystem>
 #include <map>
+#include <vector>
 
 namespace config {
 
@@ -35,6 +36,10 @@ public:
     void setPrinterMarginH(int value);
     int getPrinterMarginV() const { return printerMarginV_; }
     void setPrinterMarginV(int value);
+    /// 추가 프린터 이름 목록 (쉼표 구분). printer.name과 함께 풀로 등록되어 부하 분산됨.
+    std::string getPrinterPool() const { return printerPool_; }
+    void setPrinterPool(const std::string& names);
+    std::vector<std::string> getPrinterPoolNames() const;
 
     // Payment terminal
     std::string getPaymentComPort() const { return paymentComPort_; }
@@ -48,6 +53,14 @@ public:
     bool getCashEnabled() const { return cashEnabled_; }
     void setCashEnabled(bool value);
 
+    // Background heartbeat interval (ms). 0 = disabled.
+    int getHeartbeatIntervalMs() const { return heartbeatIntervalMs_; }
+    void setHeartbeatIntervalMs(int value);
+
+    // DEVICE_STATE_CHANGED 등 상태 이벤트 병합 창 (ms, 이벤트 타입 이름 → 창). 0 = 병합 안 함.
+    // config key: events.coalesce_ms.<event_type> (e.g. events.coalesce_ms.device_state_changed=250)
+    std::map<std::string, int> getEventCoalesceWindowsMs() const { return eventCoalesceMs_; }
+
     // Bulk get/set for IPC (key = e.g. "printer.name", "payment.com_port")
     std::map<std::string, std::string> getAll() const;
     void setFromMap(const std::map<std::string, std::string>& kv);
@@ -75,10 +88,15 @@ private:
     std::string printerPaperSize_{"A4"};
     int printerMarginH_{0};
     int printerMarginV_{0};
+    std::string printerPool_;
     std::string paymentComPort_;
     bool paymentEnabled_{true};
     std::string cashComPort_;
     bool cashEnabled_{false};
+    int heartbeatIntervalMs_{15000};
+    std::map<std::string, int> eventCoalesceMs_{{"device_state_changed", 250}, {"camera_state_changed", 250}};
+
+    bool setEventCoalesceFromKey(const std::string& key, const std::string& value);
 };
 
 } // namespace config
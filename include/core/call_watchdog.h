@@ -0,0 +1,91 @@
+// include/core/call_watchdog.h
+#pragma once
+
+#include "devices/device_types.h"
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+
+namespace core {
+
+/// Hung-call watchdog: tracks every in-flight device call (serial I/O, EDSDK, GDI spooler) with a deadline.
+/// A call that overruns marks its device HUNG until that call returns: onHang fires once on the
+/// watchdog thread, further guarded calls to the device fail fast, and onRecovered fires when
+/// the stuck call finally comes back.
+class CallWatchdog {
+public:
+    struct HangInfo {
+        std::string deviceId;
+        devices::DeviceType deviceType = devices::DeviceType::PAYMENT_TERMINAL;
+        std::string operation;
+        std::string tag;            // caller-defined (e.g. captureId)
+        long long elapsedMs = 0;
+    };
+    using HangCallback = std::function<void(const HangInfo&)>;
+
+    CallWatchdog();
+    ~CallWatchdog();
+
+    CallWatchdog(const CallWatchdog&) = delete;
+    CallWatchdog& operator=(const CallWatchdog&) = delete;
+
+    /// Callbacks run without internal locks held (onHang on the watchdog thread,
+    /// onRecovered on the thread that finished the stuck call).
+    void start(HangCallback onHang, HangCallback onRecovered);
+    void stop();
+
+    /// Register an in-flight call; returns a token for end().
+    uint64_t begin(const std::string& deviceId, devices::DeviceType deviceType, const std::string& operation,
+                   std::chrono::milliseconds timeout, const std::string& tag = "");
+
+    /// Call finished. Returns false if it had already been declared hung.
+    bool end(uint64_t token);
+
+    /// end() for asynchronous operations completed by an event (capture_complete → captureId).
+    /// Returns false if the call had been declared hung; true if it completed in time or was not tracked.
+    bool endByTag(const std::string& deviceId, const std::string& tag);
+
+    /// Run fn on a separate thread and wait up to timeout. Returns false without running fn if the
+    /// device is already HUNG, or when fn overruns (fn keeps running detached — capture by value).
+    bool call(const std::string& deviceId, devices::DeviceType deviceType, const std::string& operation,
+              std::chrono::milliseconds timeout, std::function<void()> fn);
+
+    bool isHung(const std::string& deviceId) const;
+
+    /// Oldest outstanding hung call for the device (false if not hung).
+    bool getHang(const std::string& deviceId, HangInfo& out) const;
+
+    /// Total hangs detected for the device since start.
+    uint64_t getHangCount(const std::string& deviceId) const;
+
+    /// RAII begin()/end() for calls made on the caller's own thread (printer worker).
+    class Scope {
+    public:
+        Scope(CallWatchdog* watchdog, const std::string& deviceId, devices::DeviceType deviceType,
+              const std::string& operation, std::chrono::milliseconds timeout)
+            : watchdog_(watchdog), token_(watchdog ? watchdog->begin(deviceId, deviceType, operation, timeout) : 0) {}
+        ~Scope() { if (watchdog_) watchdog_->end(token_); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        CallWatchdog* watchdog_;
+        uint64_t token_;
+    };
+
+private:
+    /// Shared with detached call() workers so a call that returns after stop()/destruction is harmless.
+    struct Shared;
+    static bool finish(const std::shared_ptr<Shared>& shared, uint64_t token);
+    void monitorThread();
+
+    std::shared_ptr<Shared> shared_;
+    std::thread thread_;
+};
+
+} // namespace core
@@ -10,6 +10,7 @@
 #include <map>
 #include <vector>
 #include <mutex>
+#include <functional>
 
 namespace core {
 
@@ -40,9 +41,17 @@ public:
     std::shared_ptr<devices::IPaymentTerminal> getDefaultPaymentTerminal();
     std::shared_ptr<devices::IPrinter> getDefaultPrinter();
     std::shared_ptr<devices::ICamera> getDefaultCamera();
+
+    /// deviceId of the default device of the type (empty if none)
+    std::string getDefaultDeviceId(devices::DeviceType type) const;
     
     // Get all device information
     std::vector<devices::DeviceInfo> getAllDeviceInfo() const;
+
+    /// Same, but override(info) is consulted first with deviceId/deviceType filled in;
+    /// when it returns true the device itself is not queried (e.g. HUNG device holding its lock).
+    std::vector<devices::DeviceInfo> getAllDeviceInfo(
+        const std::function<bool(devices::DeviceInfo&)>& override) const;
     
     // Get device list by type
     std::vector<std::string> getDeviceIds(devices::DeviceType type) const;
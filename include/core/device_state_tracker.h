@@ -0,0 +1,53 @@
+// include/core/device_state_tracker.h
+#pragma once
+
+#include "devices/device_types.h"
+#include <string>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+
+namespace core {
+
+/// Per-device change versioning for get_state_snapshot delta queries.
+/// Each observed change (state / lastError / deviceName) bumps a global version and
+/// stamps the device with it, so clients can ask for "everything since version N".
+/// Versions restart at 0 with every service run; epoch() tells runs apart.
+class DeviceStateTracker {
+public:
+    struct Entry {
+        devices::DeviceInfo info;
+        uint64_t version = 0;
+    };
+
+    DeviceStateTracker();
+
+    /// Compare with last observed info and bump versions for changed devices.
+    /// Devices missing from the list keep their last entry. Returns current version.
+    uint64_t update(const std::vector<devices::DeviceInfo>& devices);
+
+    /// Adapter reported a state transition: bump the device's version even if a later poll
+    /// sees the same state again (READY→ERROR→READY between two polls). Unknown devices are
+    /// left to the next update(). Returns current version.
+    uint64_t recordState(const std::string& deviceId, devices::DeviceState state);
+
+    /// Entries changed after sinceVersion (all entries when sinceVersion == 0).
+    std::vector<Entry> changedSince(uint64_t sinceVersion) const;
+
+    uint64_t currentVersion() const;
+
+    /// Service run id (start time, epoch ms): a client version from another run is meaningless.
+    int64_t epoch() const { return epochMs_; }
+
+    /// Last observed info for the device (false if never seen).
+    bool getLastInfo(const std::string& deviceId, devices::DeviceInfo& out) const;
+
+private:
+    std::map<std::string, Entry> entries_;
+    uint64_t version_ = 0;
+    const int64_t epochMs_;
+    mutable std::mutex mutex_;
+};
+
+} // namespace core
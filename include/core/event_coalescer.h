@@ -0,0 +1,91 @@
+// include/core/event_coalescer.h
+#pragma once
+
+#include "ipc/message_types.h"
+#include <string>
+#include <map>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace core {
+
+/// Coalescing stage in front of IpcServer::broadcastEvent for state-change storms
+/// (reconnect / port scan: CONNECTING → ERROR → CONNECTING → READY).
+/// Per (eventType, deviceType, deviceId) the first event goes out immediately; further events
+/// within the type's window replace each other and only the latest is emitted when it closes.
+/// Payment, cash and completion events are never coalesced. Any of them flushes pending
+/// coalesced events first, so the client still sees everything in publish order.
+class EventCoalescer {
+public:
+    using Sink = std::function<void(const ipc::Event&)>;
+
+    struct Stats {
+        uint64_t published = 0;     // publish() calls
+        uint64_t emitted = 0;       // events handed to the sink
+        uint64_t coalesced = 0;     // events replaced by a newer one (or identical to the last emitted)
+    };
+
+    explicit EventCoalescer(Sink sink);
+    ~EventCoalescer();
+
+    EventCoalescer(const EventCoalescer&) = delete;
+    EventCoalescer& operator=(const EventCoalescer&) = delete;
+
+    /// 0 disables coalescing for the type. Ignored for types that must never be merged.
+    void setWindow(ipc::EventType type, std::chrono::milliseconds window);
+
+    /// Before start() / after stop() every event is passed straight through.
+    void start();
+    void stop();    // emits anything still pending
+
+    void publish(const ipc::Event& event);
+
+    Stats getStats() const;
+    /// Coalesced count per event type name (only types that coalesced anything).
+    std::map<std::string, uint64_t> getCoalescedByType() const;
+
+    /// Payment / cash / completion / probe results: every occurrence matters.
+    static bool isCoalescable(ipc::EventType type);
+
+private:
+    struct Slot {
+        std::chrono::steady_clock::time_point windowEnd{};
+        bool hasPending = false;
+        ipc::Event pending;
+        std::map<std::string, std::string> lastEmittedData;
+    };
+
+    static std::string keyOf(const ipc::Event& event);
+    /// Queue for the sink (caller holds mutex_); drainOutbox() delivers it after unlocking.
+    void emitLocked(const ipc::Event& event, Slot* slot);
+    void countCoalesced(ipc::EventType type);
+    void flushLocked();
+    void flushThread();
+    /// Call the sink for queued events without holding mutex_. One thread drains at a time
+    /// (others only queue), so the sink still sees publish order.
+    void drainOutbox();
+
+    Sink sink_;
+    mutable std::mutex mutex_;
+    std::deque<ipc::Event> outbox_;
+    bool draining_ = false;
+    std::condition_variable cv_;
+    std::map<ipc::EventType, std::chrono::milliseconds> windows_;
+    std::map<std::string, Slot> slots_;
+    bool running_ = false;
+    std::thread thread_;
+
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> emitted_{0};
+    std::atomic<uint64_t> coalesced_{0};
+    mutable std::mutex statsMutex_;
+    std::map<std::string, uint64_t> coalescedByType_;
+};
+
+} // namespace core
@@ -0,0 +1,62 @@
+// include/core/health_probe.h
+#pragma once
+
+#include "devices/device_types.h"
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+
+namespace core {
+
+/// One device probe for HealthProbeEngine.
+/// probe: touches hardware (checkDevice, EDSDK re-init, ...) and returns the resulting info.
+/// snapshot: current cached info without hardware access, used when the probe misses the deadline.
+struct HealthProbe {
+    std::string deviceId;
+    std::string deviceType;     // "payment" | "cash" | "camera" | "printer"
+    std::function<devices::DeviceInfo()> probe;
+    std::function<devices::DeviceInfo()> snapshot;
+};
+
+struct HealthProbeResult {
+    std::string deviceId;
+    std::string deviceType;
+    devices::DeviceInfo info;
+    bool timedOut = false;      // deadline passed; info is the cached snapshot
+    uint32_t elapsedMs = 0;
+};
+
+/// Runs all probes in parallel under one global deadline.
+/// Results are delivered (onResult) on the caller's thread in completion order, so
+/// total time is bounded by the slowest device (or the deadline), not the sum.
+/// Probes still running at the deadline keep running in the background; their
+/// outcome is reflected in the device's own state later. The engine counts them so the
+/// owner can wait for every probe thread before tearing down what the probes touch.
+class HealthProbeEngine {
+public:
+    using ResultCallback = std::function<void(const HealthProbeResult&)>;
+
+    HealthProbeEngine() = default;
+    ~HealthProbeEngine();
+
+    HealthProbeEngine(const HealthProbeEngine&) = delete;
+    HealthProbeEngine& operator=(const HealthProbeEngine&) = delete;
+
+    std::vector<HealthProbeResult> run(std::vector<HealthProbe> probes,
+                                       std::chrono::milliseconds deadline,
+                                       const ResultCallback& onResult = nullptr);
+
+    /// Wait for all probe threads, including those past their deadline (service shutdown).
+    void waitIdle();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    size_t running_ = 0;
+};
+
+} // namespace core
@@ -0,0 +1,67 @@
+// include/core/heartbeat_monitor.h
+#pragma once
+
+#include "core/device_manager.h"
+#include "core/call_watchdog.h"
+#include <string>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+
+namespace core {
+
+/// Background device heartbeat: runs each device's cheap heartbeat() on a schedule while idle,
+/// so DeviceState/lastError stay fresh and health queries never have to touch hardware.
+/// A tick is skipped entirely while any payment terminal or camera is PROCESSING
+/// (active transaction / capture) or while paused by the service.
+class HeartbeatMonitor {
+public:
+    explicit HeartbeatMonitor(DeviceManager& deviceManager);
+    ~HeartbeatMonitor();
+
+    HeartbeatMonitor(const HeartbeatMonitor&) = delete;
+    HeartbeatMonitor& operator=(const HeartbeatMonitor&) = delete;
+
+    /// intervalMs == 0 → disabled.
+    void start(uint32_t intervalMs);
+    void stop();
+
+    /// Explicit pause (nested). Returns once no heartbeat is running (waits at most
+    /// kPauseWaitMs for one already in progress). Heartbeats also pause automatically
+    /// during transactions.
+    void pause();
+    void resume();
+
+    /// Devices the watchdog reports HUNG are skipped (their adapters may hold the state lock).
+    void setWatchdog(const CallWatchdog* watchdog) { watchdog_ = watchdog; }
+
+    /// Milliseconds since the device's last heartbeat; -1 if never checked.
+    long long getHeartbeatAgeMs(const std::string& deviceId) const;
+
+private:
+    void monitorThread();
+    bool transactionActive() const;
+    void beat(const std::string& deviceId, const std::function<bool()>& heartbeat);
+
+    DeviceManager& deviceManager_;
+    const CallWatchdog* watchdog_ = nullptr;
+    static constexpr uint32_t kPauseWaitMs = 10000;
+
+    uint32_t intervalMs_ = 0;
+    std::atomic<bool> running_{false};
+    std::atomic<int> pauseCount_{0};
+    bool beating_ = false;          // a device heartbeat is running (guarded by mutex_)
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+
+    mutable std::mutex beatMutex_;
+    std::map<std::string, std::chrono::steady_clock::time_point> lastBeat_;
+};
+
+} // namespace core
@@ -0,0 +1,67 @@
+// include/core/hotplug_watcher.h
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+namespace core {
+
+/// Hotplug watcher: keeps a live serial port inventory and reports what changed.
+/// Windows: hidden message-only window + RegisterDeviceNotification (WM_DEVICECHANGE).
+/// Linux: inotify on /dev (ttyUSB*/ttyACM*, serial/by-id).
+/// Notifications are debounced; the port list is re-enumerated only after a device event.
+class HotplugWatcher {
+public:
+    struct Change {
+        std::vector<std::string> addedPorts;
+        std::vector<std::string> removedPorts;
+        bool usbChanged = false;    // non-serial USB device arrived/left (e.g. camera)
+    };
+    using ChangeCallback = std::function<void(const Change&)>;
+    using PortEnumerator = std::function<std::vector<std::string>()>;
+
+    HotplugWatcher() = default;
+    ~HotplugWatcher();
+
+    HotplugWatcher(const HotplugWatcher&) = delete;
+    HotplugWatcher& operator=(const HotplugWatcher&) = delete;
+
+    /// Start watching. enumerator lists current ports; callback runs on the watcher thread.
+    bool start(PortEnumerator enumerator, ChangeCallback callback);
+    void stop();
+    bool isRunning() const { return running_; }
+
+    /// Live port inventory (as of the last device event).
+    std::vector<std::string> getPorts() const;
+
+    /// Incremented on every inventory change.
+    uint64_t getGeneration() const { return generation_; }
+
+private:
+    static constexpr int kDebounceMs = 500;
+
+    /// Re-enumerate, diff against the inventory and invoke the callback.
+    void refresh(bool usbChanged);
+    void watchThread();
+
+    PortEnumerator enumerator_;
+    ChangeCallback callback_;
+    std::vector<std::string> ports_;
+    mutable std::mutex mutex_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> generation_{0};
+    std::thread thread_;
+    std::atomic<bool> ready_{false};
+#ifdef _WIN32
+    void* hwnd_ = nullptr;          // HWND of the notification window
+#else
+    int stopPipe_[2] = {-1, -1};    // self-pipe to wake poll() on stop
+#endif
+};
+
+} // namespace core
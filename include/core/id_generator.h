@@ -0,0 +1,24 @@
+// include/core/id_generator.h
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace core {
+
+/// Time-ordered 128-bit IDs in UUIDv7 layout (RFC 9562), formatted as the usual 36-char
+/// lowercase 8-4-4-4-12 string so existing eventId/jobId consumers keep working:
+///   48-bit Unix ms | ver 7 | 12-bit per-thread counter | variant | 62 random bits
+/// IDs sort lexicographically by creation time (strictly increasing within a thread).
+/// State is thread_local: no locks, no iostreams, no shared RNG.
+class IdGenerator {
+public:
+    static constexpr size_t kLength = 36;
+
+    /// Write kLength chars plus a terminating NUL into out.
+    static void next(char (&out)[kLength + 1]);
+
+    static std::string next();
+};
+
+} // namespace core
@@ -0,0 +1,96 @@
+// include/core/printer_pool.h
+#pragma once
+
+#include "core/device_manager.h"
+#include "core/call_watchdog.h"
+#include "devices/iprinter.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <set>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+namespace core {
+
+/// Print job routed through PrinterPool (filePath or raw data).
+struct PrintJob {
+    std::string jobId;
+    std::string filePath;
+    std::string orientation = "portrait";
+    std::vector<uint8_t> data;
+    bool pinned = false;                // deviceId explicitly requested → no failover
+    std::set<std::string> triedDevices; // printers that already failed this job
+};
+
+/// Printer pool: one job queue + worker per registered printer.
+/// printer_print goes to the least-loaded READY printer (or an explicit deviceId);
+/// jobs fail over to another printer when theirs is in ERROR or the print fails.
+class PrinterPool {
+public:
+    explicit PrinterPool(DeviceManager& deviceManager);
+    ~PrinterPool();
+
+    /// Queue a job. preferredDeviceId empty → least-loaded READY printer.
+    /// Returns chosen deviceId, or empty with error set.
+    std::string submit(PrintJob job, const std::string& preferredDeviceId, std::string& error);
+
+    /// Called from the printer's job-complete callback (worker thread).
+    /// Returns true if the failed job was re-queued on another printer (suppress the event).
+    bool handleJobComplete(const std::string& deviceId, const devices::PrintJobCompleteEvent& event);
+
+    /// Completion for jobs that never reached a printer's own job-complete callback (printer
+    /// unregistered with no other printer to take the job, or print() threw).
+    void setJobFailedCallback(std::function<void(const devices::PrintJobCompleteEvent&)> callback);
+
+    /// Track each print call with the watchdog (a wedged StartDoc/spooler call marks the printer HUNG).
+    void setWatchdog(CallWatchdog* watchdog, std::chrono::milliseconds printTimeout);
+
+    /// Printer reported ERROR, DISCONNECTED or HUNG: move its queued (not pinned) jobs to other
+    /// printers. Printer states are queried once for the whole batch.
+    void handleStateChanged(const std::string& deviceId, devices::DeviceState state);
+
+    /// Queued + in-flight jobs for the printer.
+    size_t getQueueDepth(const std::string& deviceId) const;
+
+    void stop();
+
+private:
+    struct Worker {
+        std::string deviceId;
+        std::deque<PrintJob> queue;
+        std::shared_ptr<PrintJob> active;
+        std::thread thread;
+    };
+
+    using StateMap = std::map<std::string, devices::DeviceState>;
+
+    /// State of every registered printer not in `exclude` (HUNG if the watchdog says so).
+    /// Queries the devices (CreateDC etc.), so call without holding mutex_.
+    StateMap queryStates(CallWatchdog* watchdog, const std::set<std::string>& exclude) const;
+    /// Least-loaded printer in `states` excluding `exclude`; READY first, then any usable one.
+    /// Caller holds mutex_.
+    std::string pickFromLocked(const StateMap& states, const std::set<std::string>& exclude) const;
+    /// Single job: lock (on mutex_) is released while printer states are queried.
+    std::string pickPrinter(std::unique_lock<std::mutex>& lock, const std::set<std::string>& exclude);
+    void enqueueLocked(const std::string& deviceId, PrintJob job);
+    void workerLoop(const std::string& deviceId);
+    void reportJobFailed(const std::string& jobId, const std::string& error, devices::DeviceState state);
+
+    DeviceManager& deviceManager_;
+    CallWatchdog* watchdog_ = nullptr;
+    std::chrono::milliseconds printTimeout_{0};
+    std::function<void(const devices::PrintJobCompleteEvent&)> jobFailedCallback_;
+    std::map<std::string, std::unique_ptr<Worker>> workers_;
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    std::atomic<bool> running_{true};
+};
+
+} // namespace core
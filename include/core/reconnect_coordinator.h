@@ -0,0 +1,77 @@
+// include/core/reconnect_coordinator.h
+#pragma once
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <random>
+#include <cstdint>
+
+namespace core {
+
+/// Per-device single-flight reconnect with exponential backoff + jitter.
+/// At most one reconnect runs per device; concurrent requesters wait for and share its result.
+/// After a failure, automatic (non-forced) attempts are refused until the backoff expires:
+/// base * 2^(failures-1), capped at max, randomized to [50%, 100%] to avoid lockstep retries.
+class ReconnectCoordinator {
+public:
+    enum class Outcome { SUCCEEDED, FAILED, BACKOFF };
+
+    struct Stats {
+        uint64_t attempts = 0;
+        uint64_t successes = 0;
+        uint64_t failures = 0;
+        uint64_t joined = 0;            // requests that joined an in-flight attempt
+        uint64_t skippedBackoff = 0;    // requests refused during backoff
+        uint32_t consecutiveFailures = 0;
+        long long backoffRemainingMs = 0;
+        bool inFlight = false;
+    };
+
+    ReconnectCoordinator() = default;
+    ~ReconnectCoordinator();
+
+    ReconnectCoordinator(const ReconnectCoordinator&) = delete;
+    ReconnectCoordinator& operator=(const ReconnectCoordinator&) = delete;
+
+    void setBackoff(std::chrono::milliseconds base, std::chrono::milliseconds max);
+
+    /// Run (or join) a reconnect for deviceId. Blocks until it completes.
+    /// force: explicit user request (camera_reconnect, detect_hardware) — ignores backoff, still single-flight.
+    Outcome run(const std::string& deviceId, const std::function<bool()>& attempt, bool force = false);
+
+    /// Background reconnect (get_state_snapshot). No thread is started if one is in flight or backing off.
+    /// Returns true if an attempt was started.
+    bool runAsync(const std::string& deviceId, std::function<bool()> attempt);
+
+    Stats getStats(const std::string& deviceId) const;
+
+    /// Wait for background attempts to finish (service shutdown).
+    void waitIdle();
+
+private:
+    struct Slot {
+        bool inFlight = false;
+        bool lastResult = false;
+        uint64_t generation = 0;
+        std::chrono::steady_clock::time_point nextAllowed{};
+        Stats stats;
+    };
+
+    /// Caller holds mutex_. Returns true if the caller should run the attempt itself.
+    bool acquire(Slot& slot, bool force, std::unique_lock<std::mutex>& lock, Outcome& joinedOutcome);
+    void release(Slot& slot, bool ok);
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::map<std::string, Slot> slots_;
+    int asyncRunning_ = 0;
+    std::chrono::milliseconds base_{2000};
+    std::chrono::milliseconds max_{60000};
+    std::mt19937 rng_{std::random_device{}()};
+};
+
+} // namespace core
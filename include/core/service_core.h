@@ -3,8 +3,18 @@
 
 #include "core/device_manager.h"
 #include "core/device_constants.h"
+#include "core/device_state_tracker.h"
+#include "core/printer_pool.h"
+#include "core/hotplug_watcher.h"
+#include "core/health_probe.h"
+#include "core/heartbeat_monitor.h"
+#include "core/reconnect_coordinator.h"
+#include "core/call_watchdog.h"
+#include "core/event_coalescer.h"
+#include "core/id_generator.h"
 #include "devices/iprinter.h"
 #include "ipc/ipc_server.h"
+#include <map>
 #include <memory>
 #include <queue>
 #include <thread>
@@ -58,6 +68,44 @@ private:
     DeviceManager deviceManager_;
     ipc::IpcServer ipcServer_;
     bool running_;
+
+    // Per-device change versions for get_state_snapshot (sinceVersion delta queries)
+    DeviceStateTracker stateTracker_;
+
+    // Parallel health probes (detect_hardware / system status check)
+    static constexpr long long kHealthProbeDeadlineMs = 10000;
+    static constexpr long long kMaxHealthProbeDeadlineMs = 30000;
+
+    // Printer pool: printer_print routing (least-loaded READY / explicit deviceId) + failover
+    PrinterPool printerPool_;
+
+    // Hotplug: live COM port inventory; probes only ports that appeared/disappeared
+    HotplugWatcher hotplugWatcher_;
+    std::mutex hotplugMutex_;
+
+    // Background heartbeat while idle (health.heartbeat_ms); paused during transactions/probes
+    HeartbeatMonitor heartbeatMonitor_;
+
+    // Single-flight reconnect per device (snapshot / detect_hardware / camera_reconnect / hotplug)
+    ReconnectCoordinator reconnectCoordinator_;
+
+    // Hung-call watchdog: deadline per device call; overrun → HUNG, fail fast, background recovery
+    CallWatchdog callWatchdog_;
+    static constexpr long long kDeviceCallTimeoutMs = 20000;
+    static constexpr long long kLongDeviceCallTimeoutMs = 45000;   // vendor-side 30 s requests (last approval, cancel)
+    static constexpr long long kCaptureTimeoutMs = 60000;          // capture → capture_complete (incl. download)
+    static constexpr long long kPrintTimeoutMs = 120000;
+
+    // Watchdog HUNG/recovered transitions per device (the adapter is stuck, so its own history
+    // cannot record them); merged with the adapter's history in get_device_history
+    std::map<std::string, devices::StateHistory> hangHistory_;
+    std::mutex hangHistoryMutex_;
+
+    // All IPC events go through here: state-change storms are merged per device (events.coalesce_ms.*)
+    EventCoalescer eventCoalescer_;
+
+    // Probe threads (may outlive their deadline); stop() waits for them before teardown
+    HealthProbeEngine healthProbes_;
     
     // Async task queue
     std::queue<DeviceTask> taskQueue_;
@@ -75,6 +123,39 @@ private:
     
     // Setup event callbacks (for IPC event broadcasting)
     void setupEventCallbacks();
+    void wirePaymentTerminalCallbacks(const std::string& deviceId,
+                                      const std::shared_ptr<devices::IPaymentTerminal>& terminal);
+
+    /// Hotplug watcher callback: targeted re-probe of payment/cash/camera for changed ports.
+    void handleHotplugChange(const HotplugWatcher::Change& change);
+
+    /// Current COM port list: live hotplug inventory if the watcher runs, else registry enumeration.
+    std::vector<std::string> getKnownPorts();
+
+    /// Reconnect attempts (run through reconnectCoordinator_, never directly).
+    bool reconnectCamera(const std::shared_ptr<devices::ICamera>& camera);
+    bool detectCardTerminal(const std::vector<std::string>& ports, const std::string& excludePort);
+
+    /// Run a device call under callWatchdog_. Returns false (resp set to DEVICE_HUNG) if the device
+    /// is already HUNG or the call overran timeoutMs. fn may outlive the handler — capture by value.
+    bool guardedDeviceCall(const std::string& deviceId, devices::DeviceType deviceType, const std::string& operation,
+                           long long timeoutMs, std::function<void()> fn, ipc::Response& resp);
+    void setDeviceHungError(ipc::Response& resp, const std::string& deviceId, const std::string& operation);
+
+    /// Watchdog callbacks: publish HUNG + start recovery / publish the state after the stuck call returned.
+    void handleDeviceHang(const CallWatchdog::HangInfo& hang);
+    void handleDeviceRecovered(const CallWatchdog::HangInfo& hang);
+    void recordHangTransition(const std::string& deviceId, devices::DeviceState from,
+                              devices::DeviceState to, devices::StateErrorCode error);
+
+    /// Fill info (deviceId/deviceType set) for a HUNG device without touching its adapter. false if not hung.
+    bool hungDeviceInfo(devices::DeviceInfo& info);
+
+    /// All devices; HUNG ones come from the watchdog instead of their (possibly locked) adapters.
+    std::vector<devices::DeviceInfo> collectDeviceInfo();
+
+    /// Track a health probe with the watchdog; its deadline snapshot never waits on a busy adapter.
+    void guardHealthProbe(HealthProbe& probe, devices::DeviceType deviceType, long long timeoutMs);
     
     // Task queue management
     void startTaskWorker();
@@ -85,6 +166,7 @@ private:
     // Command handler implementations (synchronous - immediate response)
     ipc::Response handleGetStateSnapshot(const ipc::Command& cmd);
     ipc::Response handleGetDeviceList(const ipc::Command& cmd);
+    ipc::Response handleGetDeviceHistory(const ipc::Command& cmd);
     ipc::Response handleGetConfig(const ipc::Command& cmd);
     ipc::Response handleSetConfig(const ipc::Command& cmd);
     ipc::Response handlePrinterPrint(const ipc::Command& cmd);
@@ -114,8 +196,10 @@ private:
 
     /// 자동감지(detect_hardware) 전에 READY가 아닌 장치에 대해 재연결 시도. 호출 후 handleDetectHardware로 상태 수집.
     /// payloadOverrides: command payload로 enable 플래그 오버라이드 가능 (비어있으면 config에서 읽음).
-    void tryReconnectDevicesBeforeDetect(
-        const std::map<std::string, std::string>& payloadOverrides = {});
+    /// 장치별 프로브는 병렬로 실행되며 deadlineMs(기본 10초) 안에 끝나지 않은 장치는 현재 상태로 보고.
+    std::vector<HealthProbeResult> tryReconnectDevicesBeforeDetect(
+        const std::map<std::string, std::string>& payloadOverrides = {},
+        const std::string& commandId = "");
 
     // Async task implementations (executed in worker thread)
     void executePaymentStart(const DeviceTask& task);
@@ -127,7 +211,8 @@ private:
     void publishPaymentCompleteEvent(const devices::PaymentCompleteEvent& event);
     void publishPaymentFailedEvent(const devices::PaymentFailedEvent& event);
     void publishPaymentCancelledEvent(const devices::PaymentCancelledEvent& event);
-    void publishDeviceStateChangedEvent(const std::string& deviceType, devices::DeviceState state);
+    void publishDeviceStateChangedEvent(const std::string& deviceType, const std::string& deviceId, devices::DeviceState state);
+    void publishHealthProbeEvent(const HealthProbeResult& result, const std::string& commandId);
     void publishSystemStatusCheckEvent(const std::map<std::string, devices::DeviceInfo>& deviceStatuses, bool allHealthy);
     void publishCameraCaptureCompleteEvent(const devices::CaptureCompleteEvent& event);
     void publishPrinterJobCompleteEvent(const devices::PrintJobCompleteEvent& event);
@@ -140,9 +225,6 @@ private:
     
     /// Called when pipe client disconnects: cancel payment, stop liveview, etc.
     void resetOnClientDisconnect();
-    
-    // UUID generation
-    std::string generateUUID();
 };
 
 } // namespace core
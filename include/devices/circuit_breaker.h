@@ -0,0 +1,63 @@
+// include/devices/circuit_breaker.h
+#pragma once
+
+#include <string>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+namespace devices {
+
+/// Per-device circuit breaker around adapter I/O.
+/// CLOSED: calls pass; failureThreshold consecutive transport failures trip it OPEN.
+/// OPEN: calls fail fast until the cooldown expires, then a single trial call passes (HALF_OPEN).
+/// HALF_OPEN: trial success → CLOSED; failure → OPEN again with the cooldown doubled (capped).
+/// Only "no answer" failures should be recorded — a device that answers with an error is present.
+class CircuitBreaker {
+public:
+    enum class State { CLOSED, OPEN, HALF_OPEN };
+
+    struct Stats {
+        State state = State::CLOSED;
+        uint32_t consecutiveFailures = 0;
+        uint64_t trips = 0;         // transitions to OPEN
+        uint64_t rejected = 0;      // calls failed fast while OPEN
+        long long retryInMs = 0;    // time until the next trial call (OPEN only)
+    };
+
+    explicit CircuitBreaker(std::string name, uint32_t failureThreshold = 3,
+                            std::chrono::milliseconds cooldown = std::chrono::milliseconds(5000),
+                            std::chrono::milliseconds maxCooldown = std::chrono::milliseconds(60000));
+
+    /// true → perform the call (and report it with recordSuccess/recordFailure).
+    /// false → circuit open, fail fast without touching the device.
+    bool allow();
+
+    void recordSuccess();
+    void recordFailure();
+
+    /// Close immediately (port changed / device re-plugged).
+    void reset();
+
+    State getState() const;
+    Stats getStats() const;
+
+    static std::string stateToString(State state);
+
+private:
+    void tripLocked();
+
+    mutable std::mutex mutex_;
+    const std::string name_;        // for logging (device id)
+    const uint32_t failureThreshold_;
+    const std::chrono::milliseconds baseCooldown_;
+    const std::chrono::milliseconds maxCooldown_;
+    std::chrono::milliseconds cooldown_;
+    State state_ = State::CLOSED;
+    uint32_t consecutiveFailures_ = 0;
+    uint64_t trips_ = 0;
+    uint64_t rejected_ = 0;
+    std::chrono::steady_clock::time_point retryAt_{};      // OPEN: next trial; HALF_OPEN: trial expiry
+};
+
+} // namespace devices
@@ -12,6 +12,7 @@
 #endif
 
 #include "devices/device_types.h"
+#include "devices/state_history.h"
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -57,6 +58,12 @@ public:
     // Check state
     virtual DeviceState getState() const = 0;
 
+    // Cheap liveness check for the background heartbeat (idle only; default: cached state)
+    virtual bool heartbeat() { return getState() == DeviceState::STATE_READY; }
+
+    // Recent state transitions (nullptr if the adapter keeps none)
+    virtual const StateHistory* getStateHistory() const { return nullptr; }
+
     // Start preview
     virtual bool startPreview() = 0;
 
@@ -2,6 +2,8 @@
 #pragma once
 
 #include "devices/device_types.h"
+#include "devices/circuit_breaker.h"
+#include "devices/state_history.h"
 #include <string>
 #include <cstdint>
 #include <functional>
@@ -123,6 +125,19 @@ public:
     /// Close current port and reconnect on a different COM port.
     virtual bool reconnect(const std::string& newPort) = 0;
 
+    /// Cheap liveness check for the background heartbeat: current port only, no port scan,
+    /// no-op while a transaction is in progress. Updates state/lastError on change.
+    /// Default: no hardware access, reports the cached state.
+    virtual bool heartbeat() { return getState() == DeviceState::STATE_READY; }
+
+    /// Circuit breaker guarding the adapter's serial I/O (nullptr if the adapter has none).
+    /// Never takes the adapter's state lock, so it is safe to read while a call is in flight.
+    virtual CircuitBreaker* getCircuitBreaker() { return nullptr; }
+
+    /// Recent state transitions recorded by updateState (nullptr if the adapter keeps none).
+    /// Like the breaker, readable without the adapter's state lock.
+    virtual const StateHistory* getStateHistory() const { return nullptr; }
+
     // --- Event callbacks (pure virtual) ---
 
     virtual void setPaymentCompleteCallback(std::function<void(const PaymentCompleteEvent&)> callback) = 0;
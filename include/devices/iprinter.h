@@ -2,6 +2,7 @@
 #pragma once
 
 #include "devices/device_types.h"
+#include "devices/state_history.h"
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -45,6 +46,9 @@ public:
     // Check state
     virtual DeviceState getState() const = 0;
 
+    // Recent state transitions (nullptr if the adapter keeps none)
+    virtual const StateHistory* getStateHistory() const { return nullptr; }
+
     // Reset printer
     virtual bool reset() = 0;
 
@@ -1,7 +1,7 @@
 // include/devices/payment_terminal_factory.h
 // Factory for auto-detecting and creating payment terminal adapters.
-// Register vendor probes at startup; during detect_hardware, iterate COM ports
-// and pick the first vendor whose protocol responds.
+// Register vendor probes at startup; during detect_hardware, probe COM ports
+// concurrently (bounded) and pick the first port (in list order) whose vendor responds.
 #pragma once
 
 #include "devices/ipayment_terminal.h"
@@ -10,6 +10,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <cstdint>
 
 namespace devices {
 
@@ -20,6 +21,8 @@ public:
         std::string vendorName;
         /// Device category: "card" for card payment terminals, "cash" for cash devices.
         std::string category;
+        /// Baud rate used by tryPort (recorded in the probe cache).
+        uint32_t baudRate = 0;
         /// Returns true if a terminal of this vendor responds on `port`.
         std::function<bool(const std::string& port)> tryPort;
         /// Create an adapter instance for the given deviceId / port.
@@ -27,13 +30,23 @@ public:
             const std::string& deviceId, const std::string& port)> create;
     };
 
+    /// Per-port vendor ordering: vendor names to try first on `port`.
+    /// Vendors not listed are tried afterwards in registration order.
+    using VendorOrderPolicy = std::function<std::vector<std::string>(const std::string& port)>;
+
     /// Register a vendor probe (call once at startup per vendor).
     static void registerVendor(VendorProbe probe);
 
+    /// Set the vendor ordering policy (empty = registration order on every port).
+    static void setVendorOrderPolicy(VendorOrderPolicy policy);
+
+    /// Max ports probed at once by detectOnPorts (default 4, minimum 1).
+    static void setMaxConcurrentProbes(size_t count);
+
     /// Ordered list of registered vendor names.
     static std::vector<std::string> getRegisteredVendors();
 
-    /// Try all registered vendors on `port`; return the first that responds.
+    /// Try registered vendors on `port` (policy order); return the first that responds.
     /// If `category` is non-empty, only try vendors matching that category.
     /// Returns (vendorName, adapter) on success, ("", nullptr) on failure.
     static std::pair<std::string, std::shared_ptr<IPaymentTerminal>>
@@ -42,7 +55,13 @@ public:
 
     /// Scan `ports` (excluding `excludePort`) with all registered vendors.
     /// If `category` is non-empty, only try vendors matching that category.
-    /// Returns (vendorName, adapter) for the first port+vendor that responds.
+    /// Ports are probed concurrently (up to setMaxConcurrentProbes); vendors on one port
+    /// run sequentially. When a port responds, ports later in the list are cancelled
+    /// (not started / no further vendors), earlier ones still finish, so the result is
+    /// always the earliest responding port in `ports` order — same as a sequential scan.
+    /// When `category` has a ProbeCache entry, the cached vendor is validated first with a
+    /// single probe on its (re-resolved) port; the full scan only runs on a mismatch.
+    /// Returns (vendorName, adapter) for that port+vendor.
     static std::pair<std::string, std::shared_ptr<IPaymentTerminal>>
         detectOnPorts(const std::string& deviceId,
                       const std::vector<std::string>& ports,
@@ -55,6 +74,17 @@ public:
 private:
     static std::mutex& mutex();
     static std::vector<VendorProbe>& vendors();
+    static VendorOrderPolicy& orderPolicy();
+    static size_t& maxConcurrentProbes();
+
+    /// Single probe of the cached vendor for `category`. Returns ("", nullptr) on mismatch.
+    static std::pair<std::string, std::shared_ptr<IPaymentTerminal>>
+        tryCachedAssignment(const std::string& deviceId,
+                            const std::vector<std::string>& targets,
+                            const std::string& category);
+
+    /// Snapshot of vendors for `category`, ordered by the policy for `port`.
+    static std::vector<VendorProbe> orderedVendorsFor(const std::string& port, const std::string& category);
 };
 
 } // namespace devices
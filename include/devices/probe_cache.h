@@ -0,0 +1,72 @@
+// include/devices/probe_cache.h
+// Persistent detection cache: which vendor answered on which port, keyed by category
+// ("card" / "cash"). Lets detect_hardware validate the last assignment with one probe
+// instead of scanning every COM port. Replaces the old smartro_port.cfg text file.
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <functional>
+#include <cstdint>
+
+namespace devices {
+
+struct ProbeCacheEntry {
+    std::string category;        // "card" / "cash"
+    std::string port;            // e.g. "COM3"
+    std::string hardwareId;      // device instance id (USB VID/PID + serial) when available
+    std::string vendor;          // VendorProbe::vendorName
+    uint32_t baudRate = 0;
+    int64_t lastSuccessMs = 0;   // epoch ms
+    uint32_t probeLatencyMs = 0;
+};
+
+class ProbeCache {
+public:
+    /// port -> hardware id for ports currently present (platform-specific, injected at startup).
+    using PortIdentityResolver = std::function<std::map<std::string, std::string>()>;
+
+    static ProbeCache& getInstance();
+
+    /// Load cache from `filePath` (missing file = empty cache).
+    void initialize(const std::string& filePath);
+
+    void setPortIdentityResolver(PortIdentityResolver resolver);
+
+    bool get(const std::string& category, ProbeCacheEntry& out) const;
+
+    /// Store a successful probe. Saves right away only when port / vendor / hardware id / baud
+    /// changed; lastSuccessMs and probeLatencyMs stay in memory until the next flush
+    /// (at most every kFlushIntervalMs, or flush() on shutdown).
+    void recordSuccess(ProbeCacheEntry entry);
+
+    /// Write pending lastSuccessMs / probeLatencyMs updates (no-op if nothing changed).
+    void flush();
+
+    /// Vendors last seen on `port` (for PaymentTerminalFactory vendor ordering).
+    std::vector<std::string> vendorsForPort(const std::string& port) const;
+
+    /// Where the cached device lives now: the port whose hardware id matches (COM renumbering),
+    /// otherwise the cached port name.
+    std::string resolvePort(const ProbeCacheEntry& entry) const;
+
+private:
+    ProbeCache() = default;
+    ProbeCache(const ProbeCache&) = delete;
+    ProbeCache& operator=(const ProbeCache&) = delete;
+
+    void saveLocked();
+
+    static constexpr int64_t kFlushIntervalMs = 5 * 60 * 1000;
+
+    std::map<std::string, ProbeCacheEntry> entries_;
+    bool dirty_ = false;          // in-memory timestamps/latency newer than the file
+    int64_t lastSaveMs_ = 0;      // epoch ms
+    std::string filePath_;
+    PortIdentityResolver resolver_;
+    mutable std::mutex mutex_;
+};
+
+} // namespace devices
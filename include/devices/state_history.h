@@ -0,0 +1,57 @@
+// include/devices/state_history.h
+#pragma once
+
+#include "devices/device_types.h"
+#include <array>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+namespace devices {
+
+/// Why a transition happened (index into a fixed name table, so recording never allocates).
+enum class StateErrorCode : uint8_t {
+    NONE = 0,
+    PORT_OPEN_FAILED,   // serial port could not be opened
+    NO_RESPONSE,        // device did not answer (timeout / heartbeat miss)
+    DEVICE_FAULT,       // device answered with an error status
+    SEND_FAILED,        // request could not be written / was not acknowledged
+    CIRCUIT_OPEN,       // call rejected by the circuit breaker
+    NOT_FOUND,          // device not found on any port / by the SDK
+    SDK_ERROR,          // vendor SDK call failed
+    TIMEOUT_RECOVERY,   // adapter recovered from a stuck PROCESSING state
+    COUNT
+};
+
+const char* stateErrorCodeToString(StateErrorCode code);
+
+/// Fixed-size ring of state transitions for one device (oldest entries are overwritten).
+/// record() is O(1), allocation-free and takes only its own lock, so adapters can call it
+/// from updateState() while holding their state mutex.
+class StateHistory {
+public:
+    static constexpr size_t kCapacity = 64;
+
+    struct Entry {
+        int64_t timestampMs = 0;    // system_clock epoch ms
+        DeviceState from = DeviceState::DISCONNECTED;
+        DeviceState to = DeviceState::DISCONNECTED;
+        StateErrorCode error = StateErrorCode::NONE;
+    };
+
+    void record(DeviceState from, DeviceState to, StateErrorCode error = StateErrorCode::NONE);
+
+    /// Copy up to maxEntries most recent transitions, oldest first.
+    std::vector<Entry> getEntries(size_t maxEntries = kCapacity) const;
+
+    /// Transitions recorded since start (including those already overwritten).
+    uint64_t getTotal() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::array<Entry, kCapacity> entries_{};
+    uint64_t total_ = 0;
+};
+
+} // namespace devices
@@ -0,0 +1,41 @@
+// include/ipc/event_log.h
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace ipc {
+
+/// Bounded ring of recently broadcast events (serialized JSON) keyed by sequence number,
+/// for replay after a client reconnects (resume). Not thread-safe: IpcServer serializes access.
+class EventLog {
+public:
+    explicit EventLog(size_t capacity = 512);
+
+    /// Next sequence number to stamp (1, 2, ...).
+    uint64_t nextSeq() const { return lastSeq_ + 1; }
+
+    /// Store an event stamped with nextSeq(); the oldest entry is dropped when full.
+    void append(uint64_t seq, std::string json);
+
+    /// Events with seq > sinceSeq, oldest first. Returns false when the ring no longer holds
+    /// all of them (or sinceSeq is from a previous service run) — the client must resync fully.
+    bool since(uint64_t sinceSeq, std::vector<std::string>& out) const;
+
+    uint64_t lastSeq() const { return lastSeq_; }
+    /// Oldest sequence number still held (0 if empty).
+    uint64_t oldestSeq() const;
+    size_t capacity() const { return entries_.size(); }
+
+private:
+    struct Entry {
+        uint64_t seq = 0;
+        std::string json;
+    };
+    std::vector<Entry> entries_;    // fixed size, indexed by seq % capacity
+    uint64_t lastSeq_ = 0;
+};
+
+} // namespace ipc
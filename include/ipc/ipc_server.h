@@ -4,11 +4,15 @@
 #include "ipc/named_pipe_server.h"
 #include "ipc/message_types.h"
 #include "ipc/message_parser.h"
+#include "ipc/event_log.h"
 #include "core/device_manager.h"
 #include <string>
 #include <memory>
 #include <functional>
 #include <map>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 
 namespace ipc {
 
@@ -29,8 +33,11 @@ public:
     // Register command handler
     void registerHandler(CommandType type, CommandHandler handler);
     
-    // Broadcast event to all connected clients
+    // Broadcast event to all connected clients (stamps seq and keeps it for resume)
     void broadcastEvent(const Event& event);
+
+    /// Sequence number of the last broadcast event (0 before the first).
+    uint64_t getLastEventSeq() const;
     
     bool isRunning() const { return pipeServer_ && pipeServer_->isRunning(); }
     
@@ -39,10 +46,32 @@ public:
 private:
     void handlePipeMessage(PipeClient& client, const std::string& message);
     Response processCommand(const Command& command);
+    /// resume: response, then the missed events to this client only. Queued in one step with the
+    /// log snapshot, so no broadcast can interleave with the replay; returns once they are written.
+    void handleResume(PipeClient& client, const Command& command);
+
+    struct Outgoing {
+        std::string json;
+        PipeClient* client = nullptr;   // nullptr: broadcast
+    };
+    /// Write queued messages in queue order without holding eventMutex_. One thread drains at a
+    /// time; the others only queue and return.
+    void drainOutbox();
     
     std::unique_ptr<NamedPipeServer> pipeServer_;
     core::DeviceManager& deviceManager_;
     std::map<CommandType, CommandHandler> commandHandlers_;
+
+    // Sequenced event log for replay-on-reconnect. eventMutex_ covers seq, the log and the outbox;
+    // pipe writes happen outside it, ordered by the outbox
+    mutable std::mutex eventMutex_;
+    EventLog eventLog_;
+    std::deque<Outgoing> outbox_;
+    bool draining_ = false;
+    uint64_t queuedCount_ = 0;      // messages ever queued
+    uint64_t writtenCount_ = 0;     // messages taken off the outbox and written
+    std::condition_variable writtenCv_;
+    const int64_t epochMs_;     // service run id: seq restarts at 1 when this changes
     
     static constexpr const char* PIPE_NAME = "\\\\.\\pipe\\DeviceControllerService";
 };
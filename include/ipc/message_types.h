@@ -39,6 +39,8 @@ enum class CommandType {
     PAYMENT_SCREEN_SOUND_SETTING,
     GET_DEVICE_LIST,
     GET_STATE_SNAPSHOT,
+    GET_DEVICE_HISTORY,
+    RESUME,
     GET_CONFIG,
     SET_CONFIG,
     PRINTER_PRINT,
@@ -67,7 +69,8 @@ enum class EventType {
     PRINTER_JOB_COMPLETE,
     CASH_TEST_AMOUNT,
     CASH_PAYMENT_TARGET_REACHED,
-    CASH_BILL_STACKED
+    CASH_BILL_STACKED,
+    DEVICE_HEALTH_PROBE
 };
 
 // Error structure
@@ -120,6 +123,8 @@ struct Event {
     int64_t timestampMs;
     std::string deviceType;
     std::map<std::string, std::string> data;
+    uint64_t seq = 0;   // stamped by IpcServer::broadcastEvent (monotonic per service run)
+    int64_t epoch = 0;  // service run id the seq belongs to (stamped with seq)
 };
 
 // Helper functions for string conversion
@@ -137,6 +142,8 @@ inline std::string commandTypeToString(CommandType type) {
         case CommandType::PAYMENT_SCREEN_SOUND_SETTING: return "payment_screen_sound_setting";
         case CommandType::GET_DEVICE_LIST: return "get_device_list";
         case CommandType::GET_STATE_SNAPSHOT: return "get_state_snapshot";
+        case CommandType::GET_DEVICE_HISTORY: return "get_device_history";
+        case CommandType::RESUME: return "resume";
         case CommandType::GET_CONFIG: return "get_config";
         case CommandType::SET_CONFIG: return "set_config";
         case CommandType::PRINTER_PRINT: return "printer_print";
@@ -168,6 +175,8 @@ inline CommandType stringToCommandType(const std::string& str) {
     if (str == "payment_screen_sound_setting") return CommandType::PAYMENT_SCREEN_SOUND_SETTING;
     if (str == "get_device_list") return CommandType::GET_DEVICE_LIST;
     if (str == "get_state_snapshot") return CommandType::GET_STATE_SNAPSHOT;
+    if (str == "get_device_history") return CommandType::GET_DEVICE_HISTORY;
+    if (str == "resume") return CommandType::RESUME;
     if (str == "get_config") return CommandType::GET_CONFIG;
     if (str == "set_config") return CommandType::SET_CONFIG;
     if (str == "printer_print") return CommandType::PRINTER_PRINT;
@@ -214,6 +223,7 @@ inline std::string eventTypeToString(EventType type) {
         case EventType::CASH_TEST_AMOUNT: return "cash_test_amount";
         case EventType::CASH_PAYMENT_TARGET_REACHED: return "cash_payment_target_reached";
         case EventType::CASH_BILL_STACKED: return "cash_bill_stacked";
+        case EventType::DEVICE_HEALTH_PROBE: return "device_health_probe";
         default: return "unknown";
     }
 }
@@ -230,6 +240,7 @@ inline EventType stringToEventType(const std::string& str) {
     if (str == "cash_test_amount") return EventType::CASH_TEST_AMOUNT;
     if (str == "cash_payment_target_reached") return EventType::CASH_PAYMENT_TARGET_REACHED;
     if (str == "cash_bill_stacked") return EventType::CASH_BILL_STACKED;
+    if (str == "device_health_probe") return EventType::DEVICE_HEALTH_PROBE;
     return EventType::PAYMENT_COMPLETE; // Default
 }
 
@@ -53,6 +53,8 @@ public:
     devices::DeviceInfo getDeviceInfo() const override;
     bool capture(const std::string& captureId) override;
     devices::DeviceState getState() const override;
+    bool heartbeat() override;
+    const devices::StateHistory* getStateHistory() const override { return &history_; }
     bool startPreview() override;
     bool stopPreview() override;
     bool setSettings(const devices::CameraSettings& settings) override;
@@ -102,7 +104,7 @@ private:
     void onObjectEvent(EdsUInt32 event, EdsBaseRef ref);
     
     // Helper methods
-    void updateState(devices::DeviceState newState);
+    void updateState(devices::DeviceState newState, devices::StateErrorCode error = devices::StateErrorCode::NONE);
     std::vector<uint8_t> readImageFile(const std::string& filePath) const;
     
     std::string deviceId_;
@@ -110,6 +112,7 @@ private:
     devices::DeviceState state_;
     std::string lastError_;
     std::chrono::system_clock::time_point lastUpdateTime_;
+    devices::StateHistory history_;
     
     // EDSDK objects (forward declared types)
     EdsCameraRef cameraRef_;
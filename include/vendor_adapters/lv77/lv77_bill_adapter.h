@@ -7,6 +7,10 @@
 #include <string>
 #include <memory>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <functional>
 #include <atomic>
 #include <chrono>
 
@@ -27,6 +31,9 @@ public:
     std::string getVendorName() const override { return "lv77"; }
     std::string getComPort() const override { return comPort_; }
     bool reconnect(const std::string& newPort) override;
+    bool heartbeat() override;
+    devices::CircuitBreaker* getCircuitBreaker() override { return &circuit_; }
+    const devices::StateHistory* getStateHistory() const override { return &history_; }
 
     /// Single-port probe for auto-detect: returns true if LV77 responds on the given port (opens/closes internally).
     static bool tryPort(const std::string& port);
@@ -43,8 +50,13 @@ public:
     void setCashBillStackedCallback(std::function<void(uint32_t amount, uint32_t currentTotal)> callback);
 
 private:
-    void updateState(devices::DeviceState newState);
+    void updateState(devices::DeviceState newState, devices::StateErrorCode error = devices::StateErrorCode::NONE);
     void onBillStacked(uint32_t amount);
+    bool circuitAllows(const std::string& operation);
+    // Comm callbacks run on the shared SerialReactor thread: they only decide from atomics and
+    // hand events (IPC publish, state changes, stop/disable) to the notification thread.
+    void postNotification(std::function<void()> task);
+    void notificationThread();
 
     std::string deviceId_;
     std::string comPort_;
@@ -52,8 +64,11 @@ private:
     std::unique_ptr<Lv77Comm> comm_;
 
     mutable std::mutex stateMutex_;
+    std::mutex ioMutex_;  // serial I/O outside the poll loop (heartbeat vs start/check/reset)
     devices::DeviceState state_;
     std::string lastError_;
+    devices::CircuitBreaker circuit_;  // shared with comm_ poll loop
+    devices::StateHistory history_;
     std::atomic<bool> paymentInProgress_;
     std::atomic<bool> paymentCancelled_;
     /// 결제 목표 금액 (startPayment(amount) 시 설정). 0이면 테스트 모드(전 수락).
@@ -68,6 +83,12 @@ private:
     std::function<void(uint32_t amount, uint32_t currentTotal)> cashBillStackedCallback_;
     std::function<void(devices::DeviceState)> stateChangedCallback_;
     std::chrono::system_clock::time_point lastUpdateTime_;
+
+    std::mutex notifyMutex_;
+    std::condition_variable notifyCondition_;
+    std::deque<std::function<void()>> notifyQueue_;
+    bool notifyStopping_ = false;
+    std::thread notifyThread_;
 };
 
 } // namespace lv77
@@ -12,11 +12,14 @@
 
 #include "vendor_adapters/lv77/lv77_protocol.h"
 #include "vendor_adapters/smartro/serial_port.h"
+#include "vendor_adapters/smartro/serial_reactor.h"
+#include "vendor_adapters/smartro/rtt_estimator.h"
+#include "devices/circuit_breaker.h"
 #include <string>
 #include <functional>
 #include <mutex>
-#include <thread>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 
 namespace lv77 {
@@ -25,6 +28,8 @@ namespace lv77 {
 constexpr uint32_t LV77_BAUD = 9600;
 constexpr uint8_t  LV77_PARITY_EVEN = 2;  // EVENPARITY for Windows DCB
 
+// Callbacks run on the shared SerialReactor thread (every serial device's I/O waits on them):
+// decide from atomics and return; hand anything that can block (IPC events, locks) to another thread.
 // Callback: bill in escrow (amount from bill type); return true to accept, false to reject
 using EscrowCallback = std::function<bool(uint32_t amount)>;
 // Callback: bill stacked (accepted)
@@ -58,13 +63,16 @@ public:
     bool acceptBill();
     bool rejectBill();
 
-    // Start background poll loop (sends 0x0C every pollIntervalMs); processes escrow and status
+    // Start the poll loop on the shared SerialReactor (0x0C every pollIntervalMs; escrow and status
+    // bytes handled as they arrive). The synchronous calls above must not be used while it runs.
     void startPollLoop(uint32_t pollIntervalMs = 500);
     void stopPollLoop();
 
     void setEscrowCallback(EscrowCallback cb) { escrowCallback_ = std::move(cb); }
     void setBillStackedCallback(BillStackedCallback cb) { billStackedCallback_ = std::move(cb); }
     void setStatusCallback(StatusCallback cb) { statusCallback_ = std::move(cb); }
+    /// Poll loop reports to / is gated by the adapter's breaker (open → no 0x0C until the trial).
+    void setCircuitBreaker(devices::CircuitBreaker* breaker) { breaker_ = breaker; }
 
     std::string getLastError() const { return lastError_; }
 
@@ -74,18 +82,34 @@ private:
     mutable std::mutex mutex_;
 
     std::atomic<bool> pollLoopRunning_{false};
-    std::thread pollLoopThread_;
     uint32_t pollIntervalMs_{500};
+    // Poll loop state (reactor thread only)
+    bool pollOutstanding_{false};  // 0x0C sent, no response byte yet
+    bool pollLate_{false};         // its deadline passed; a byte before the next 0x0C is still its answer
+    int noResponseCount_{0};
+    std::chrono::steady_clock::time_point pollSentAt_;
+    smartro::SerialReactor::TimerId pollDeadlineTimer_{0};
+    smartro::SerialReactor::TimerId escrowTimer_{0};
+    // 0x0C -> response byte; "no response" is declared after SRTT + 4*RTTVAR instead of a whole interval
+    smartro::RttEstimator pollRtt_;
+    static constexpr uint32_t POLL_RESPONSE_FLOOR_MS = 50;
 
     EscrowCallback escrowCallback_;
     BillStackedCallback billStackedCallback_;
     StatusCallback statusCallback_;
+    devices::CircuitBreaker* breaker_{nullptr};
 
     enum class EscrowState { Idle, WaitingBillType, WaitingAcceptReject };
     EscrowState escrowState_{EscrowState::Idle};
     uint32_t escrowAmount_{0};
 
-    void pollLoopThread();
+    // Reactor callbacks
+    void onPollTimer();
+    void onPollDeadline();
+    void onBytes(const uint8_t* data, size_t length);
+    void handleByte(uint8_t byte);
+    void onEscrowTimeout();
+    void schedulePoll(std::chrono::milliseconds delay);
     bool readByte(uint8_t& byte, uint32_t timeoutMs);
     void setError(const std::string& msg);
 };
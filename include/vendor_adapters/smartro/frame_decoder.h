@@ -0,0 +1,76 @@
+// include/vendor_adapters/smartro/frame_decoder.h
+#pragma once
+
+#include "vendor_adapters/smartro/smartro_protocol.h"
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+namespace smartro {
+
+/// Non-owning view of one complete STX..ETX+BCC frame. Inside a decoder callback it points into
+/// the chunk that was fed (or the decoder's assembly buffer if the frame arrived split), so it is
+/// only valid until the callback returns.
+struct FrameView {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+    FrameView() = default;
+    FrameView(const uint8_t* frameData, size_t frameSize) : data(frameData), size(frameSize) {}
+
+    bool hasHeader() const { return size >= HEADER_SIZE; }
+    char jobCode() const { return hasHeader() ? static_cast<char>(data[31]) : 0; }
+    const uint8_t* payload() const { return data + HEADER_SIZE; }
+    size_t payloadSize() const { return size >= MIN_PACKET_SIZE ? size - HEADER_SIZE - TAIL_SIZE : 0; }
+};
+
+/// Resumable Smartro link-layer decoder. Feed byte chunks of any size; ACK/NACK bytes and
+/// frames come out through the sink in arrival order. ETX and BCC are checked here, so a
+/// FRAME token is ready to parse. A frame that fails the check is reported once as BAD_FRAME
+/// (caller NACKs) and hunting resumes right after its STX. Bytes outside frames are dropped.
+/// Frames wholly inside one chunk are never copied; only a frame split across chunks is
+/// assembled internally.
+class FrameDecoder {
+public:
+    enum class TokenType { ACK, NACK, FRAME, BAD_FRAME };
+    struct Token {
+        TokenType type;
+        FrameView frame;  // FRAME / BAD_FRAME
+    };
+    using Sink = std::function<void(const Token&)>;
+
+    struct Stats {
+        uint64_t frames = 0;
+        uint64_t zeroCopyFrames = 0;
+        uint64_t badFrames = 0;
+        uint64_t discardedBytes = 0;
+    };
+
+    /// Length fields above this are line noise that happened to follow a 0x02, not a frame.
+    static constexpr size_t MAX_DATA_LENGTH = 4096;
+
+    void feed(const uint8_t* data, size_t length, const Sink& sink);
+
+    /// The rest of a partial frame never arrived: re-scan its bytes (the STX may have been noise
+    /// in front of real frames), then drop whatever is still incomplete.
+    void abandonPartial(const Sink& sink);
+    /// Drop all state (port reopened).
+    void reset();
+    bool inFrame() const { return state_ != State::HUNT; }
+
+    const Stats& getStats() const { return stats_; }
+
+private:
+    enum class State { HUNT, HEADER, BODY };
+    State state_ = State::HUNT;
+    std::vector<uint8_t> assembly_;
+    size_t expected_ = 0;
+    Stats stats_;
+
+    // quietUntil: bytes [0, quietUntil) belong to a frame already reported bad — don't report again
+    void feedInternal(const uint8_t* data, size_t length, const Sink& sink, size_t quietUntil);
+    static bool frameValid(const uint8_t* frame, size_t size);
+};
+
+} // namespace smartro
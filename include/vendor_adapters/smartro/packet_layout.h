@@ -0,0 +1,273 @@
+// include/vendor_adapters/smartro/packet_layout.h
+#pragma once
+
+#include <array>
+#include <limits>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+namespace smartro {
+namespace layout {
+
+// One fixed-width field: byte offset (within the header, or within the data section) and width
+template <size_t Offset, size_t Width>
+struct Field {
+    static_assert(Width > 0, "Smartro fields are at least one byte wide");
+    static constexpr size_t offset = Offset;
+    static constexpr size_t width = Width;
+    static constexpr size_t end = Offset + Width;
+};
+
+// Fields listed in wire order follow each other with no gap or overlap and end exactly at `size`
+template <typename... Fields>
+constexpr bool isPacked(size_t size) {
+    size_t next = 0;
+    bool packed = true;
+    ((packed = packed && Fields::offset == next, next = Fields::end), ...);
+    return packed && next == size;
+}
+
+// Wire-order field table entry (logging, fuzzing)
+enum class FieldKind {
+    Code,    // single CHAR code ('1', 'X', 'O', ...)
+    Digits,  // right-aligned decimal, '0'-padded
+    Text     // left-aligned, space or 0x00 padded (CP949 for issuer/acquirer)
+};
+
+struct FieldInfo {
+    const char* name;
+    size_t offset;
+    size_t width;
+    FieldKind kind;
+};
+
+template <typename F>
+constexpr FieldInfo fieldInfo(const char* name, FieldKind kind) {
+    return FieldInfo{name, F::offset, F::width, kind};
+}
+
+template <size_t N>
+constexpr bool isPacked(const FieldInfo (&fields)[N], size_t size) {
+    size_t next = 0;
+    for (size_t i = 0; i < N; ++i) {
+        if (fields[i].offset != next || fields[i].width == 0) {
+            return false;
+        }
+        next = fields[i].offset + fields[i].width;
+    }
+    return next == size;
+}
+
+// Field value without padding: trailing spaces / 0x00 and leading spaces
+inline std::string_view trimField(std::string_view value) {
+    size_t end = value.size();
+    while (end > 0 && (value[end - 1] == ' ' || value[end - 1] == '\0')) {
+        --end;
+    }
+    size_t begin = 0;
+    while (begin < end && value[begin] == ' ') {
+        ++begin;
+    }
+    return value.substr(begin, end - begin);
+}
+
+// Decimal digits needed for the largest value of T (numeric field overflow is impossible when
+// this fits the field width, so the writer skips the runtime check)
+template <typename T>
+constexpr size_t maxDecimalDigits() {
+    size_t digits = 1;
+    for (auto v = (std::numeric_limits<T>::max)(); v >= 10; v /= 10) {
+        ++digits;
+    }
+    return digits;
+}
+
+// ---------------------------------------------------------------------
+// Header (35 bytes, packet offsets) / Tail
+// ---------------------------------------------------------------------
+struct Header {
+    using Stx = Field<0, 1>;
+    using TerminalId = Field<1, 16>;    // left-aligned, rest 0x00
+    using DateTime = Field<17, 14>;     // YYYYMMDDhhmmss
+    using JobCode = Field<31, 1>;
+    using ResponseCode = Field<32, 1>;  // unused in requests (0x00)
+    using DataLength = Field<33, 2>;    // USHORT, little endian
+    static constexpr size_t SIZE = 35;
+};
+static_assert(isPacked<Header::Stx, Header::TerminalId, Header::DateTime, Header::JobCode,
+                       Header::ResponseCode, Header::DataLength>(Header::SIZE),
+              "Smartro header layout must cover exactly 35 bytes");
+
+struct Tail {
+    using Etx = Field<0, 1>;
+    using Bcc = Field<1, 1>;            // XOR of STX..ETX
+    static constexpr size_t SIZE = 2;
+};
+static_assert(isPacked<Tail::Etx, Tail::Bcc>(Tail::SIZE), "tail is ETX + BCC");
+
+// ---------------------------------------------------------------------
+// Request data sections (offsets within the data)
+// ---------------------------------------------------------------------
+
+// 'B' payment approval (30 bytes)
+struct PaymentApproval {
+    using TransactionType = Field<0, 1>;    // BYTE
+    using Amount = Field<1, 10>;            // digits, '0'-padded
+    using Tax = Field<11, 8>;
+    using Service = Field<19, 8>;
+    using Installments = Field<27, 2>;
+    using SignatureRequired = Field<29, 1>; // BYTE
+    static constexpr size_t SIZE = 30;
+};
+static_assert(isPacked<PaymentApproval::TransactionType, PaymentApproval::Amount, PaymentApproval::Tax,
+                       PaymentApproval::Service, PaymentApproval::Installments,
+                       PaymentApproval::SignatureRequired>(PaymentApproval::SIZE),
+              "payment approval layout must cover its 30 data bytes");
+
+// 'C' transaction cancel (56 bytes, then optional 2-digit length + additional info).
+// The header's Data Length is one more than the bytes sent (57 / 59 + N), exactly as the
+// original builder wrote it; keep the wire bytes unchanged.
+struct TransactionCancel {
+    using CancelType = Field<0, 1>;         // '1' request / '2' last transaction
+    using TransactionType = Field<1, 1>;    // BYTE
+    using Amount = Field<2, 10>;
+    using Tax = Field<12, 8>;
+    using Service = Field<20, 8>;
+    using Installments = Field<28, 2>;
+    using ApprovalNumber = Field<30, 12>;   // space-padded
+    using OriginalDate = Field<42, 8>;      // YYYYMMDD
+    using OriginalTime = Field<50, 6>;      // hhmmss
+    static constexpr size_t SIZE = 56;
+    static constexpr size_t DECLARED_EXTRA = 1;     // Data Length = bytes sent + 1
+    using AdditionalInfoLength = Field<SIZE, 2>;
+    static constexpr size_t MAX_ADDITIONAL_INFO = 99;  // what a 2-digit length can describe
+    static constexpr size_t MAX_SIZE = AdditionalInfoLength::end + MAX_ADDITIONAL_INFO;
+};
+static_assert(isPacked<TransactionCancel::CancelType, TransactionCancel::TransactionType,
+                       TransactionCancel::Amount, TransactionCancel::Tax, TransactionCancel::Service,
+                       TransactionCancel::Installments, TransactionCancel::ApprovalNumber,
+                       TransactionCancel::OriginalDate, TransactionCancel::OriginalTime>(TransactionCancel::SIZE),
+              "transaction cancel layout must cover its 56 fixed data bytes");
+static_assert(TransactionCancel::AdditionalInfoLength::width == 2 && TransactionCancel::MAX_ADDITIONAL_INFO == 99,
+              "additional info length is written as 2 digits");
+
+// 'S' screen/sound setting (3 bytes, one '0'..'9' each)
+struct ScreenSoundSetting {
+    using ScreenBrightness = Field<0, 1>;
+    using SoundVolume = Field<1, 1>;
+    using TouchSoundVolume = Field<2, 1>;
+    static constexpr size_t SIZE = 3;
+};
+static_assert(isPacked<ScreenSoundSetting::ScreenBrightness, ScreenSoundSetting::SoundVolume,
+                       ScreenSoundSetting::TouchSoundVolume>(ScreenSoundSetting::SIZE),
+              "screen/sound setting layout must cover its 3 data bytes");
+
+// Largest request data section (A/E/F/R/L/M carry none)
+constexpr size_t MAX_REQUEST_DATA = TransactionCancel::MAX_SIZE;
+static_assert(MAX_REQUEST_DATA >= PaymentApproval::SIZE && MAX_REQUEST_DATA >= ScreenSoundSetting::SIZE,
+              "MAX_REQUEST_DATA must cover every request");
+static_assert(MAX_REQUEST_DATA <= 0xFFFF, "data length is a USHORT");
+
+// ---------------------------------------------------------------------
+// Response data sections (offsets within the data)
+// ---------------------------------------------------------------------
+
+// 'a' device check (4 bytes: N not installed / O ok / X error / F server connection failed)
+struct DeviceCheckResult {
+    using CardModule = Field<0, 1>;
+    using RfModule = Field<1, 1>;
+    using VanServer = Field<2, 1>;
+    using IntegrationServer = Field<3, 1>;
+    static constexpr size_t SIZE = 4;
+};
+static_assert(isPacked<DeviceCheckResult::CardModule, DeviceCheckResult::RfModule, DeviceCheckResult::VanServer,
+                       DeviceCheckResult::IntegrationServer>(DeviceCheckResult::SIZE),
+              "device check result layout must cover its 4 data bytes");
+
+// 'b' approval / 'c' cancel result (157 bytes).
+// Widths and offsets are the ones the original hand-written parser used: SMARTRO_PROTOCOL.md §7.3
+// gives only the 157-byte total. Bytes 137-156 are the VAN response field (rejection code and
+// message), read for every result, not only for 'X'. Acquirer follows at 157, outside the
+// 157 bytes the terminal is required to send: it is read only when the payload carries it.
+struct ApprovalResult {
+    using TransactionType = Field<0, 1>;
+    using TransactionMedium = Field<1, 1>;  // 1 IC / 2 MS / 3 RF / 4 QR / 5 KEYIN
+    using CardNumber = Field<2, 20>;        // masked
+    using ApprovalAmount = Field<22, 10>;
+    using Tax = Field<32, 8>;
+    using ServiceCharge = Field<40, 8>;
+    using Installments = Field<48, 2>;
+    using ApprovalNumber = Field<50, 12>;
+    using SalesDate = Field<62, 8>;         // YYYYMMDD
+    using SalesTime = Field<70, 6>;         // hhmmss
+    using TransactionId = Field<76, 12>;
+    using MerchantNumber = Field<88, 15>;
+    using TerminalNumber = Field<103, 14>;
+    using Issuer = Field<117, 20>;          // CP949
+    using RejectionInfo = Field<137, 20>;   // VAN response (rejection code / message)
+    static constexpr size_t SIZE = 157;
+    using Acquirer = Field<SIZE, 20>;       // CP949; past SIZE, optional
+    static constexpr size_t MAX_SIZE = Acquirer::end;
+};
+
+constexpr FieldInfo APPROVAL_RESULT_FIELDS[] = {
+    fieldInfo<ApprovalResult::TransactionType>("Transaction Type", FieldKind::Code),
+    fieldInfo<ApprovalResult::TransactionMedium>("Transaction Medium", FieldKind::Code),
+    fieldInfo<ApprovalResult::CardNumber>("Card Number", FieldKind::Text),
+    fieldInfo<ApprovalResult::ApprovalAmount>("Approval Amount", FieldKind::Digits),
+    fieldInfo<ApprovalResult::Tax>("Tax", FieldKind::Digits),
+    fieldInfo<ApprovalResult::ServiceCharge>("Service Charge", FieldKind::Digits),
+    fieldInfo<ApprovalResult::Installments>("Installments", FieldKind::Digits),
+    fieldInfo<ApprovalResult::ApprovalNumber>("Approval Number", FieldKind::Text),
+    fieldInfo<ApprovalResult::SalesDate>("Sales Date", FieldKind::Digits),
+    fieldInfo<ApprovalResult::SalesTime>("Sales Time", FieldKind::Digits),
+    fieldInfo<ApprovalResult::TransactionId>("Transaction ID", FieldKind::Text),
+    fieldInfo<ApprovalResult::MerchantNumber>("Merchant Number", FieldKind::Text),
+    fieldInfo<ApprovalResult::TerminalNumber>("Terminal Number", FieldKind::Text),
+    fieldInfo<ApprovalResult::Issuer>("Issuer", FieldKind::Text),
+    fieldInfo<ApprovalResult::RejectionInfo>("Rejection Info", FieldKind::Text),
+};
+static_assert(isPacked(APPROVAL_RESULT_FIELDS, ApprovalResult::SIZE),
+              "approval result table must cover its 157 data bytes in wire order");
+
+// 's' screen/sound setting result (same 3 CHAR levels as the request)
+using ScreenSoundSettingResult = ScreenSoundSetting;
+
+// 'm' IC card check ('O' inserted / 'X' none)
+struct IcCardCheckResult {
+    using CardStatus = Field<0, 1>;
+    static constexpr size_t SIZE = 1;
+};
+
+// '@' event: 1-byte event code, then event data (format unspecified)
+struct EventResult {
+    using EventCode = Field<0, 1>;
+    static constexpr size_t MIN_SIZE = EventCode::end;
+};
+
+} // namespace layout
+
+/// Fixed-capacity request buffer: every Smartro request fits, so building one never allocates.
+/// Filled by the SmartroProtocol::create*Request builders; sent as data()/size().
+class RequestPacket {
+public:
+    static constexpr size_t CAPACITY = layout::Header::SIZE + layout::MAX_REQUEST_DATA + layout::Tail::SIZE;
+
+    const uint8_t* data() const { return bytes_.data(); }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /// Builder side: size the packet for dataLength data bytes (<= layout::MAX_REQUEST_DATA)
+    /// and return its storage.
+    uint8_t* reset(size_t dataLength) {
+        size_ = layout::Header::SIZE + dataLength + layout::Tail::SIZE;
+        return bytes_.data();
+    }
+
+private:
+    std::array<uint8_t, CAPACITY> bytes_;
+    size_t size_ = 0;
+};
+
+} // namespace smartro
@@ -0,0 +1,47 @@
+// include/vendor_adapters/smartro/rtt_estimator.h
+#pragma once
+
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+namespace smartro {
+
+// Per-port response-time estimator in the style of TCP's RTO (RFC 6298): smoothed RTT plus
+// 4x its mean deviation, clamped to the command class's floor/ceiling. Before the first sample
+// the class's initial timeout applies. A timeout doubles the result until the next good sample
+// (only answered, non-retried exchanges should be sampled). Thread-safe.
+class RttEstimator {
+public:
+    struct Bounds {
+        uint32_t initialMs;  // no samples yet
+        uint32_t floorMs;
+        uint32_t ceilingMs;
+    };
+
+    struct Stats {
+        double srttMs = 0;
+        double rttvarMs = 0;
+        uint64_t samples = 0;
+        uint32_t backoffShift = 0;
+    };
+
+    void addSample(std::chrono::steady_clock::duration rtt);
+    void onTimeout();
+    uint32_t timeoutMs(const Bounds& bounds) const;
+    // Forget everything (different port / device)
+    void reset();
+    Stats getStats() const;
+
+private:
+    static constexpr double GRANULARITY_MS = 16.0;  // Windows timer tick; lower bound for the variance term
+    static constexpr uint32_t MAX_BACKOFF_SHIFT = 6;
+
+    mutable std::mutex mutex_;
+    double srttMs_ = 0;
+    double rttvarMs_ = 0;
+    uint64_t samples_ = 0;
+    uint32_t backoffShift_ = 0;
+};
+
+} // namespace smartro
@@ -16,10 +16,22 @@
 
 #include <string>
 #include <vector>
+#include <map>
 #include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <functional>
 
 namespace smartro {
 
+// Thread safety: one reader thread and one writer thread may use the port at the same time
+// (overlapped handle on Windows, non-blocking fd + poll on POSIX — a pending read never delays a write).
+// open/close wait for in-flight I/O; close() wakes a blocked read first.
+// Receive is readiness-driven (WaitCommEvent EV_RXCHAR / poll): an idle reader blocks in the kernel
+// with no periodic wakeups, and bytes are handed over as soon as the driver has them.
+// Port names: "COM3" on Windows, "/dev/ttyUSB0" (or "ttyUSB0") on POSIX.
 class SerialPort {
 public:
     SerialPort();
@@ -34,12 +46,62 @@ public:
     // Open/close port
     bool open(const std::string& portName, uint32_t baudRate = 115200);
     void close();
-    bool isOpen() const { return handle_ != INVALID_HANDLE_VALUE; }
+#ifdef _WIN32
+    bool isOpen() const { return handle_.load() != INVALID_HANDLE_VALUE; }
+#else
+    bool isOpen() const { return fd_.load() >= 0; }
+#endif
+    // Incremented by every successful open — lets a reader notice the port was reopened under it
+    uint64_t getOpenGeneration() const { return openGeneration_; }
+    
+    static constexpr uint32_t WAIT_FOREVER = 0xFFFFFFFF;  // timeoutMs: until data, wakeReader() or close()
+    // Make a blocked (or the next) read / waitUntilOpen return early, e.g. so a reader thread can stop
+    void wakeReader();
+    // Block until the port is open (true) or wakeReader()/timeout (false)
+    bool waitUntilOpen(uint32_t timeoutMs = WAIT_FOREVER);
+    
+    // SerialReactor support — only the reactor calls these, and while a port is registered with it
+    // the reactor is the port's single reader.
+    // Called (outside the port's locks) after every successful open() and close().
+    void setOpenListener(std::function<void()> listener);
+#ifdef _WIN32
+    // Start an overlapped EV_RXCHAR wait unless one is already pending. Returns the event to wait on
+    // (nullptr: port closed or the wait failed); ready = bytes are already queued in the driver.
+    void* armReadiness(bool& ready);
+    // Reap the wait after its event was signalled (a new one is started by the next armReadiness)
+    void completeReadiness();
+    // Cancel a pending wait (port leaves the reactor but stays open for synchronous reads)
+    void cancelReadiness();
+#else
+    // fd to watch for POLLIN (-1 when closed)
+    int readinessFd() const { return fd_.load(); }
+#endif
     
     // Read/write data
     bool write(const uint8_t* data, size_t length);
+    // Returns whatever is buffered (up to bufferSize); waits up to timeoutMs only if nothing is.
     bool read(uint8_t* buffer, size_t bufferSize, size_t& bytesRead, uint32_t timeoutMs = 1000);
     
+    // Buffered receive: input goes through a ring; each fill takes everything the driver has
+    // as soon as it arrives, so a frame costs a few syscalls instead of one per byte.
+    size_t available();
+    // Copy up to maxLength buffered bytes without consuming; waits up to timeoutMs if the ring is empty.
+    size_t peek(uint8_t* buffer, size_t maxLength, uint32_t timeoutMs = 0);
+    // Zero-copy peek for the port's single reader thread: points at the contiguous buffered bytes
+    // inside the ring (waits up to timeoutMs if empty). Valid until that thread calls consume().
+    size_t peekView(const uint8_t*& data, uint32_t timeoutMs = 0);
+    void consume(size_t length);
+    // Exactly length bytes within timeoutMs (total), or false with nothing consumed.
+    bool readExact(uint8_t* buffer, size_t length, uint32_t timeoutMs);
+    
+    struct IoStats {
+        uint64_t readCalls = 0;   // ReadFile / read(2)
+        uint64_t bytesRead = 0;
+        uint64_t waits = 0;       // blocking readiness waits (WaitCommEvent / poll) = reader wakeups
+        uint64_t writeCalls = 0;
+    };
+    IoStats getIoStats() const;
+    
     // Configuration
     bool setBaudRate(uint32_t baudRate);
     bool setDataBits(uint8_t dataBits);
@@ -54,23 +116,66 @@ public:
     
     // Get list of available COM ports.
     // registryOnly: if true, only read registry (fast). If false, fallback to CreateFile on COM1..COM20 (can block ~10s).
+    // POSIX: /dev/ttyUSB*, /dev/ttyACM* and /dev/serial/by-id targets; registryOnly=false adds
+    // /dev/ttyS* ports that report real UART hardware.
     static std::vector<std::string> getAvailablePorts(bool registryOnly = false);
     
-    // Save working COM port
-    static bool saveWorkingPort(const std::string& portName);
-    
-    // Load saved COM port
-    static std::string loadWorkingPort();
+    // COM port -> device instance id (USB VID/PID + serial where available) for present ports.
+    // Used by the probe cache to follow a device when its COM number changes.
+    // POSIX: /dev/ttyUSB0 -> its /dev/serial/by-id name (vendor, product, serial, interface).
+    static std::map<std::string, std::string> getPortHardwareIds();
     
 private:
-    void* handle_;  // HANDLE (declared as void* to minimize windows.h dependency)
+#ifdef _WIN32
+    std::atomic<void*> handle_;  // HANDLE (declared as void* to minimize windows.h dependency)
+    void* readEvent_;            // overlapped completion events (HANDLE), one per direction
+    void* writeEvent_;
+    void* wakeEvent_;            // auto-reset, set by wakeReader()/close()
+    void* readinessEvent_;       // reactor's EV_RXCHAR wait (HANDLE)
+    void* readinessOverlapped_;  // OVERLAPPED (heap, outlives each wait)
+    unsigned long readinessMask_ = 0;  // DWORD
+    bool readinessPending_ = false;  // readMutex_ (or exclusive handleMutex_)
+#else
+    std::atomic<int> fd_{-1};    // O_NONBLOCK tty fd
+    int wakePipe_[2] = {-1, -1}; // self-pipe: close() wakes a read blocked in poll()
+    void setLowLatency();
+#endif
+    std::shared_mutex handleMutex_;  // shared: read/write, exclusive: open/close
+    std::mutex readMutex_;   // also guards the receive ring
+    std::mutex writeMutex_;
+    std::atomic<bool> closing_{false};  // close() in progress: reads return at once so it gets the lock
+    std::mutex stateMutex_;             // waitUntilOpen()
+    std::condition_variable stateCondition_;
+    bool wakePending_ = false;
+    std::function<void()> openListener_;  // stateMutex_
+    void notifyOpenChanged();
+    
+    static constexpr size_t RX_RING_SIZE = 4096;  // power of two
+    std::vector<uint8_t> rxRing_;
+    size_t rxHead_ = 0;  // monotonic read position
+    size_t rxTail_ = 0;  // monotonic write position
+    
+    std::atomic<uint64_t> openGeneration_{0};
+    std::atomic<uint64_t> readCalls_{0};
+    std::atomic<uint64_t> bytesRead_{0};
+    std::atomic<uint64_t> waits_{0};
+    std::atomic<uint64_t> writeCalls_{0};
     std::string portName_;
     uint32_t baudRate_;
     uint8_t dataBits_;
     uint8_t stopBits_;
-    uint8_t parity_;  // 0=NOPARITY, 1=ODDPARITY, 2=EVENPARITY (Windows)
+    uint8_t parity_;  // 0=NOPARITY, 1=ODDPARITY, 2=EVENPARITY
 
     bool configurePort();
+    void closeLocked();
+    // Ring helpers (readMutex_ held)
+    size_t bufferedLocked() const { return rxTail_ - rxHead_; }
+    void copyOutLocked(uint8_t* buffer, size_t length) const;
+    // Take what the driver has into the ring's free space; if nothing, wait up to timeoutMs for it.
+    bool fillLocked(uint32_t timeoutMs);
+    // One non-blocking OS read into target (false: port error / hang-up)
+    bool readNowLocked(uint8_t* target, size_t space, size_t& bytesRead);
+    void commitLocked(const uint8_t* target, size_t bytesRead);
     void logError(const std::string& operation);
 };
 
@@ -0,0 +1,109 @@
+// include/vendor_adapters/smartro/serial_reactor.h
+#pragma once
+
+#include "vendor_adapters/smartro/serial_port.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+
+namespace smartro {
+
+// One I/O thread for every serial device: waits on all registered ports at once (poll() on POSIX,
+// WaitForMultipleObjects over the ports' EV_RXCHAR waits on Windows) and runs timers from the same
+// loop. Data handlers and timer callbacks run on the reactor thread one at a time, so per-port
+// protocol state needs no locks — but they must not block (no waiting for a device response);
+// requests are still written from the caller's thread.
+class SerialReactor {
+public:
+    // Bytes straight from the port's receive ring; consumed once the handler returns
+    using DataHandler = std::function<void(const uint8_t* data, size_t length)>;
+    using TimerId = uint64_t;  // 0 = none
+
+    static SerialReactor& getInstance();
+
+    // Watch a port (open or not — it is waited on whenever it is open). While registered the
+    // reactor is the port's only reader.
+    void addPort(SerialPort& port, DataHandler handler);
+    // Stop watching and cancel the port's timers. On return neither its handler nor its timers
+    // are running or will run again; safe to call from a handler.
+    void removePort(SerialPort& port);
+
+    // Run callback once on the reactor thread after delay. Timers with an owner port are
+    // cancelled by removePort(owner).
+    TimerId addTimer(std::chrono::milliseconds delay, std::function<void()> callback, SerialPort* owner = nullptr);
+    // On return the callback is not running and will not run (also from the reactor thread)
+    void cancelTimer(TimerId id);
+
+    bool inReactorThread() const { return std::this_thread::get_id() == threadId_.load(); }
+
+    struct Stats {
+        uint64_t wakeups = 0;      // returns from the OS wait
+        uint64_t dispatches = 0;   // data handler calls
+        uint64_t timersFired = 0;
+        size_t ports = 0;
+    };
+    Stats getStats() const;
+
+private:
+    SerialReactor();
+    ~SerialReactor();
+    SerialReactor(const SerialReactor&) = delete;
+    SerialReactor& operator=(const SerialReactor&) = delete;
+
+    struct Entry {
+        uint64_t id = 0;
+        SerialPort* port = nullptr;
+        DataHandler handler;
+        // Reactor thread only (and removePort while the reactor is parked in its wait)
+        uint64_t generation = 0;  // port open generation the registration below belongs to
+        bool parked = false;      // wait failed / hung up: ignore until the port is reopened
+        bool hangup = false;      // POSIX: POLLHUP/POLLERR reported by the last wait
+        int emptyReads = 0;       // consecutive ready-but-nothing-read dispatches
+    };
+    struct Timer {
+        std::chrono::steady_clock::time_point deadline;
+        std::function<void()> callback;
+        SerialPort* owner = nullptr;
+    };
+
+    static constexpr int MAX_EMPTY_READS = 16;
+
+    void run();
+    // Arm every open port and block until one is readable, wake() or the next timer is due
+    void waitForEvents(std::vector<std::shared_ptr<Entry>>& ready);
+    void dispatch(const std::shared_ptr<Entry>& entry);
+    void runDueTimers();
+    int msUntilNextTimerLocked() const;  // -1: no timers
+    void ensureThreadLocked();
+    void wake();
+
+    mutable std::mutex mutex_;      // entries_, timers_, waiting_/waitSeq_
+    std::mutex dispatchMutex_;      // held by the reactor whenever it touches ports or runs callbacks
+    std::condition_variable waitCondition_;
+    std::map<uint64_t, std::shared_ptr<Entry>> entries_;
+    std::map<TimerId, Timer> timers_;
+    uint64_t nextId_ = 1;
+    bool waiting_ = false;          // reactor is blocked in the OS wait
+    uint64_t waitSeq_ = 0;          // incremented after every OS wait
+
+    std::thread thread_;
+    std::atomic<std::thread::id> threadId_{};
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> wakeups_{0};
+    std::atomic<uint64_t> dispatches_{0};
+    std::atomic<uint64_t> timersFired_{0};
+#ifdef _WIN32
+    void* wakeEvent_;  // HANDLE, auto-reset
+#else
+    int wakePipe_[2] = {-1, -1};
+#endif
+};
+
+} // namespace smartro
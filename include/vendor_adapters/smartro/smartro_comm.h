@@ -12,14 +12,20 @@
 #endif
 
 #include "vendor_adapters/smartro/smartro_protocol.h"
+#include "vendor_adapters/smartro/packet_layout.h"
 #include "vendor_adapters/smartro/serial_port.h"
+#include "vendor_adapters/smartro/frame_decoder.h"
+#include "vendor_adapters/smartro/serial_reactor.h"
+#include "vendor_adapters/smartro/rtt_estimator.h"
+#include "vendor_adapters/smartro/spsc_queue.h"
 #include <string>
 #include <vector>
+#include <variant>
 #include <cstdint>
 #include <mutex>
-#include <thread>
 #include <atomic>
-#include <queue>
+#include <deque>
+#include <map>
 #include <condition_variable>
 #include <chrono>
 
@@ -48,60 +54,87 @@ enum class ResponseType {
     EVENT                  // '@'
 };
 
-// Unified response structure
-// Note: Types DeviceCheckResponse, PaymentWaitResponse, etc. are defined in smartro_protocol.h
+// One queued response: exactly one payload, matching the type (std::monostate for 'r', which
+// carries no data). Built in place in the response queue by the reactor thread. Every payload
+// type is fixed-size (variable-length data in InlineBytes), so queuing a response never allocates.
+using ResponsePayload = std::variant<std::monostate,
+                                     DeviceCheckResponse,
+                                     PaymentWaitResponse,
+                                     CardUidReadResponse,
+                                     PaymentApprovalResponse,   // 'b' and 'c'
+                                     LastApprovalResponse,
+                                     ScreenSoundSettingResponse,
+                                     IcCardCheckResponse,
+                                     EventResponse>;
+
 struct ResponseData {
-    ResponseType type;
-    char jobCode;
-    std::vector<uint8_t> rawData;  // Original data
-    
-    // Type-specific data (use only the one matching the type)
-    // Types are in the same namespace, so no namespace prefix needed
-    DeviceCheckResponse deviceCheck;
-    PaymentWaitResponse paymentWait;
-    CardUidReadResponse cardUid;
-    PaymentApprovalResponse paymentApproval;
-    LastApprovalResponse lastApproval;
-    ScreenSoundSettingResponse screenSound;
-    IcCardCheckResponse icCard;
-    EventResponse event;
+    ResponseType type = ResponseType::RESET;
+    char jobCode = 0;
+    ResponsePayload payload;
 };
 
+// Full-duplex transport: the shared SerialReactor thread owns all serial input and dispatches
+// ACK/NACK bytes and complete frames; senders never read the port themselves.
+// A synchronous request registers a pending slot keyed by its response Job Code, writes its
+// packet (only the write itself is serialized) and waits on the slot, so a cancel can go out
+// while another request is still waiting for its response. Frames nobody waits for
+// (events, async approval results) go to the response queue (pollResponse).
 class SmartroComm {
 public:
     SmartroComm(SerialPort& serialPort);
     ~SmartroComm();
     
-    // Start/stop response receiver thread
+    // Register/unregister the port with SerialReactor (receive callbacks)
     void startResponseReceiver();
     void stopResponseReceiver();
     
-    // Poll response (get asynchronous response)
+    // Poll response (get asynchronous response). Single consumer: one polling thread per SmartroComm.
     bool pollResponse(ResponseData& response, uint32_t timeoutMs = 0);
     
     // Legacy synchronous functions (for backward compatibility)
-    // Send device check request and receive response
+    // Send device check request and receive response. Persistent session: when a port is already
+    // open the check is one request/ACK on that handle (retried once with ceiling timeouts); ports
+    // are scanned (preferredPort first, never excludePort) only when none is open or both fail.
+    // timeoutMs caps every ACK/response wait (the adaptive ones and the retry's ceilings).
     bool sendDeviceCheckRequest(const std::string& terminalId,
                                 DeviceCheckResponse& response,
                                 uint32_t timeoutMs = 3000,
-                                const std::string& preferredPort = "");
+                                const std::string& preferredPort = "",
+                                const std::string& excludePort = "");
+
+    // Explicit rescan: close the current port and device-check every available port except
+    // excludePort (preferredPort first); the first one that answers stays open as the new session.
+    // timeoutMs (0 = none) caps each port's ACK/response wait.
+    bool scanForDevice(const std::string& terminalId,
+                       DeviceCheckResponse& response,
+                       const std::string& preferredPort = "",
+                       const std::string& excludePort = "",
+                       uint32_t timeoutMs = 0);
+
+    // Device check on exactly one port (no scan). Opens `port` if not already open on it.
+    bool sendDeviceCheckOnPort(const std::string& terminalId,
+                               DeviceCheckResponse& response,
+                               const std::string& port);
     
-    // Send payment wait request and receive response
+    // Send payment wait request and receive response (timeoutMs caps the adaptive ACK/response waits,
+    // likewise for screen/sound setting and IC card check)
     bool sendPaymentWaitRequest(const std::string& terminalId, 
                                 PaymentWaitResponse& response,
                                 uint32_t timeoutMs = 3000);
     
-    // Send card UID read request and receive response
+    // Send card UID read request and receive response. The response comes only after a card is
+    // presented, so timeoutMs is its fixed limit (and caps the adaptive ACK wait).
     bool sendCardUidReadRequest(const std::string& terminalId, 
                                 CardUidReadResponse& response,
-                                uint32_t timeoutMs = 3000);
+                                uint32_t timeoutMs = 10000);
     
     // Wait for event (blocking, timeout available)
     // Events are automatically sent from device, so no ACK/NACK is sent
+    // While waiting, events are delivered here instead of the response queue.
     bool waitForEvent(EventResponse& event, uint32_t timeoutMs = 0);  // timeoutMs=0 means infinite wait
     
-    // Send terminal reset request and receive response
-    bool sendResetRequest(const std::string& terminalId, uint32_t timeoutMs = 3000);
+    // Send terminal reset request and receive response (timeoutMs: fixed response limit, caps the ACK wait)
+    bool sendResetRequest(const std::string& terminalId, uint32_t timeoutMs = 10000);
     
     // Send payment approval request (asynchronous - send request and return immediately)
     bool sendPaymentApprovalRequestAsync(const std::string& terminalId, 
@@ -140,43 +173,127 @@ public:
     std::string getLastError() const;
     
 private:
+    // One in-flight request, owned by the sending thread's stack; guarded by pendingMutex_
+    struct PendingRequest {
+        char responseJobCode = 0;  // 0: waits for ACK only (async send)
+        bool acked = false;
+        bool nacked = false;
+        bool completed = false;    // response frame delivered into packet
+        std::vector<uint8_t> packet;
+    };
+
     SerialPort& serialPort_;
-    CommState state_;
+    std::atomic<CommState> state_;
     std::string lastError_;
-    mutable std::mutex commMutex_;  // Lock for thread safety
+    mutable std::mutex errorMutex_;  // lastError_ only
+    
+    // Writer side: serializes packet writes (and ACK-order registration); never held while waiting
+    std::mutex writeMutex_;
     
-    // Asynchronous response reception
+    // Request/response correlation
+    std::mutex pendingMutex_;
+    std::condition_variable pendingCondition_;
+    std::map<char, PendingRequest*> pendingByJobCode_;  // response Job Code -> waiting request
+    // ACK order entry. A request that gave up before its ACK stays as a tombstone (request == nullptr)
+    // until STALE_ACK_WINDOW_MS after its write, so a late ACK/NACK is consumed by it instead of
+    // completing the next write.
+    struct AckWaiter {
+        PendingRequest* request;
+        std::chrono::steady_clock::time_point writtenAt;
+    };
+    std::deque<AckWaiter> ackWaiters_;                   // in write order; ACK/NACK completes the front
+    
+    // Reader side: callbacks on the SerialReactor thread (the only reader of the port)
     std::atomic<bool> receiverRunning_;
-    std::thread receiverThread_;
-    std::queue<ResponseData> responseQueue_;
+    FrameDecoder decoder_;  // fed straight from the receive ring (reactor thread only)
+    FrameDecoder::Sink tokenSink_;
+    uint64_t decoderGeneration_ = 0;  // port open generation the decoder state belongs to
+    std::chrono::steady_clock::time_point lastByteTime_;
+    SerialReactor::TimerId frameTimer_ = 0;  // pending FRAME_TIMEOUT_MS check (reactor thread only)
+    // Reactor thread -> polling thread, lock-free. The mutex/condition are only for a consumer
+    // that found the queue empty and goes to sleep (consumerWaiting_ tells the producer to wake it).
+    static constexpr size_t RESPONSE_QUEUE_CAPACITY = 32;
+    SpscQueue<ResponseData, RESPONSE_QUEUE_CAPACITY> responseQueue_;
+    std::atomic<bool> consumerWaiting_{false};
     std::mutex queueMutex_;
     std::condition_variable queueCondition_;
     
-    static constexpr uint32_t ACK_TIMEOUT_MS = 5000;  // ACK wait timeout
-    static constexpr uint32_t RESPONSE_TIMEOUT_MS = 10000;  // Response receive timeout
+    static constexpr uint32_t ACK_TIMEOUT_MS = 5000;  // ACK wait ceiling
+    static constexpr uint32_t RESPONSE_TIMEOUT_MS = 10000;  // Response receive ceiling (quick commands) / fixed default
+    static constexpr uint32_t FRAME_TIMEOUT_MS = 1000;  // max gap between bytes of one frame (reader)
+    static constexpr uint32_t STALE_ACK_WINDOW_MS = ACK_TIMEOUT_MS;  // tombstone lifetime after the write
     
-    // Background response receiver thread
-    void responseReceiverThread();
+    // Timeout argument: derive from this port's measured latency (RttEstimator) instead of a fixed value.
+    // Used for every ACK wait and for responses the terminal produces without customer interaction
+    // (A/E/S/M); card UID read, reset and approval/cancel/last-approval responses keep fixed timeouts.
+    static constexpr uint32_t ADAPTIVE_TIMEOUT = 0xFFFFFFFE;
+    // initial (no samples yet: also the fast-fail limits when probing an unknown port) / floor / ceiling
+    static constexpr RttEstimator::Bounds ACK_BOUNDS{1500, 200, ACK_TIMEOUT_MS};
+    static constexpr RttEstimator::Bounds QUICK_RESPONSE_BOUNDS{2000, 500, RESPONSE_TIMEOUT_MS};
     
-    // Parse response and add to queue
-    void processResponse(const std::vector<uint8_t>& packet);
+    // Write -> ACK, and ACK -> response per response Job Code, of the port named latencyPort_
+    // (reset when the port changes; entries are never erased, so references stay valid)
+    RttEstimator ackRtt_;
+    std::map<char, RttEstimator> responseRtt_;
+    std::mutex latencyMutex_;
+    std::string latencyPort_;
+    void syncLatencyPort();
+    RttEstimator& responseRttFor(char jobCode);
     
-    // ACK/NACK handling
-    bool waitForAck(uint32_t timeoutMs, std::vector<uint8_t>& responsePacket);
-    bool sendAck();
-    bool sendNack();
+    // Reactor callbacks
+    void onReceive(const uint8_t* data, size_t length);
+    void onFrameTimeout();
+    void handleToken(const FrameDecoder::Token& token);
+    void ensureReceiver();
+    
+    // Reader -> waiting senders / response queue
+    void dispatchAck(bool ack);
+    void dispatchFrame(const FrameView& frame);
+    
+    // Parse a validated frame (view into the receive ring) into the next queue slot
+    void processResponse(const FrameView& frame);
+    
+    // Pending slot lifecycle
+    bool beginRequest(PendingRequest& request, char responseJobCode, uint32_t timeoutMs);
+    void endRequest(PendingRequest& request);
+    void eraseAckWaiterLocked(PendingRequest* request);  // caller holds pendingMutex_
+    bool writeRequest(PendingRequest& request, const RequestPacket& packet);
+    bool waitForAck(PendingRequest& request, uint32_t timeoutMs);
+    bool waitForResponse(PendingRequest& request, uint32_t timeoutMs);  // 0 = until receiver stops
     
-    // Receive response
-    bool receiveResponse(std::vector<uint8_t>& responsePacket, uint32_t timeoutMs);
+    // Send packet, wait ACK then the response frame (responseJobCode == 0: ACK only).
+    // Either timeout may be ADAPTIVE_TIMEOUT; only adaptive waits are sampled.
+    // ceilingMs (0 = none): the caller's timeoutMs, caps the adaptive waits.
+    // ackBeforeResponse: reply ACK as soon as the device ACKs (requests whose response arrives later).
+    bool transact(const RequestPacket& packet, char responseJobCode,
+                  uint32_t ackTimeoutMs, uint32_t responseTimeoutMs,
+                  std::vector<uint8_t>& responsePacket, bool ackBeforeResponse = false,
+                  uint32_t ceilingMs = 0);
     
-    // Read single byte (for ACK/NACK)
-    bool readByte(uint8_t& byte, uint32_t timeoutMs);
+    // Common request: port check, transact; responsePacket is the whole validated frame
+    bool exchange(const RequestPacket& packet, char responseJobCode, const std::string& what,
+                  std::vector<uint8_t>& responsePacket,
+                  uint32_t ackTimeoutMs = ADAPTIVE_TIMEOUT, uint32_t responseTimeoutMs = ADAPTIVE_TIMEOUT,
+                  uint32_t ceilingMs = 0);
+    // ACK a parsed response (NACK if parsing failed)
+    bool completeResponse(bool parsed, const std::string& what);
     
-    // Flush serial buffer
-    void flushSerialBuffer();
+    // Device check request/ACK/response on the already-open port
+    bool deviceCheckOnOpenPort(const std::string& terminalId,
+                               DeviceCheckResponse& response,
+                               const std::string& currentPort,
+                               uint32_t ackTimeoutMs = ADAPTIVE_TIMEOUT,
+                               uint32_t responseTimeoutMs = ADAPTIVE_TIMEOUT,
+                               uint32_t ceilingMs = 0);
+
+    // ACK/NACK sending (writer side)
+    bool sendAck();
+    bool sendNack();
+    bool writeFrame(const uint8_t* data, size_t length);
     
     // Set error
     void setError(const std::string& error);
+    void clearError();
 };
 
 } // namespace smartro
@@ -33,6 +33,9 @@ public:
     std::string getVendorName() const override { return "smartro"; }
     std::string getComPort() const override { return comPort_; }
     bool reconnect(const std::string& newPort) override;
+    bool heartbeat() override;
+    devices::CircuitBreaker* getCircuitBreaker() override { return &circuit_; }
+    const devices::StateHistory* getStateHistory() const override { return &history_; }
 
     // IPaymentTerminal extended operations (vendor-agnostic interface)
     devices::CardUidResult readCardUid() override;
@@ -57,10 +60,12 @@ public:
     void setStateChangedCallback(std::function<void(devices::DeviceState)> callback) override;
     
 private:
-    void updateState(devices::DeviceState newState);
+    void updateState(devices::DeviceState newState, devices::StateErrorCode error = devices::StateErrorCode::NONE);
     void processPaymentResponse(const PaymentApprovalResponse& response);
     void processEvent(const EventResponse& event);
     void eventMonitorThread();
+    // 회로 열림이면 lastError_ 설정 후 false (stateMutex_ 보유 상태에서 호출)
+    bool circuitAllows(const std::string& operation);
     
     std::string deviceId_;
     std::string comPort_;
@@ -73,6 +78,10 @@ private:
     devices::DeviceState state_;
     std::string lastError_;
     
+    // 응답 없는 단말에 매 호출마다 포트 스캔/타임아웃을 반복하지 않도록
+    devices::CircuitBreaker circuit_;
+    devices::StateHistory history_;
+    
     // Payment progress state
     std::atomic<bool> paymentInProgress_;
     std::atomic<bool> paymentCancelled_;  // Flag to indicate payment was cancelled
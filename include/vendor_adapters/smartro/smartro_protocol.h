@@ -11,8 +11,12 @@
     #endif
 #endif
 
+#include "vendor_adapters/smartro/packet_layout.h"
 #include <string>
+#include <string_view>
 #include <vector>
+#include <array>
+#include <algorithm>
 #include <cstdint>
 #include <cstddef>
 
@@ -25,8 +29,8 @@ constexpr uint8_t ACK = 0x06;
 constexpr uint8_t NACK = 0x15;
 
 // Header structure size
-constexpr size_t HEADER_SIZE = 35;
-constexpr size_t TAIL_SIZE = 2;
+constexpr size_t HEADER_SIZE = layout::Header::SIZE;
+constexpr size_t TAIL_SIZE = layout::Tail::SIZE;
 constexpr size_t MIN_PACKET_SIZE = HEADER_SIZE + TAIL_SIZE;  // When no data
 
 // Job Codes
@@ -58,14 +62,41 @@ struct DeviceCheckResponse {
     char integrationServerStatus; // N/O/X/F
 };
 
-// Payment wait response structure (format not specified in docs)
+// Variable-length response data kept inline (bounded array + length), so the responses queued in
+// ResponseData never allocate. assign() stores at most N bytes and returns false when it had to cut.
+template <size_t N>
+class InlineBytes {
+public:
+    static constexpr size_t capacity() { return N; }
+
+    bool assign(const uint8_t* src, size_t length) {
+        size_ = static_cast<uint16_t>(std::min(length, N));
+        std::copy(src, src + size_, bytes_.begin());
+        return length <= N;
+    }
+    void clear() { size_ = 0; }
+
+    const uint8_t* data() const { return bytes_.data(); }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const uint8_t* begin() const { return bytes_.data(); }
+    const uint8_t* end() const { return bytes_.data() + size_; }
+    uint8_t operator[](size_t i) const { return bytes_[i]; }
+
+private:
+    static_assert(N <= 0xFFFF, "length is a uint16_t");
+    std::array<uint8_t, N> bytes_{};
+    uint16_t size_ = 0;
+};
+
+// Payment wait response structure (format not specified in docs; longer data is cut with a warning)
 struct PaymentWaitResponse {
-    std::vector<uint8_t> data;  // Response data (format unspecified)
+    InlineBytes<64> data;  // Response data (format unspecified)
 };
 
 // Card UID read response structure (format not specified in docs)
 struct CardUidReadResponse {
-    std::vector<uint8_t> uid;  // Card UID (typically 4-8 bytes)
+    InlineBytes<16> uid;  // Card UID (typically 4-8 bytes, ISO 14443 at most 10); longer = parse error
 };
 
 // Event type
@@ -81,7 +112,7 @@ enum class EventType {
 // Event response structure
 struct EventResponse {
     EventType type;              // Event type
-    std::vector<uint8_t> data;  // Event data (format not specified in docs)
+    InlineBytes<64> data;        // Event data (format not specified in docs; longer data is cut)
 };
 
 // Payment approval request structure
@@ -94,36 +125,55 @@ struct PaymentApprovalRequest {
     uint8_t signatureRequired;  // 1: No signature, 2: Signature required
 };
 
-// Payment approval response structure (157 bytes)
+// Payment approval response (157 bytes): the payload as received, decoded on access through
+// layout::ApprovalResult. Text accessors are views into `data` with the padding trimmed; copy
+// them only where an owned string is needed (PaymentCompleteEvent and the other device results).
 struct PaymentApprovalResponse {
-    char transactionType;        // Transaction type: 1=Credit, 2=Cash Receipt, 3=Prepaid, 4=Zero Pay, 5=Kakao Mini, 6=Kakao Credit, X=Rejected
-    char transactionMedium;      // Transaction medium: 1=IC, 2=MS, 3=RF, 4=QR, 5=KEYIN
-    std::string cardNumber;      // Card number (20 bytes, masked)
-    std::string approvalAmount;  // Approval/Cancellation amount (10 bytes)
-    std::string tax;             // Tax (8 bytes)
-    std::string serviceCharge;   // Service charge (8 bytes)
-    std::string installments;    // Installment months (2 bytes)
-    std::string approvalNumber;  // Approval number/Prepaid card info (12 bytes)
-    std::string salesDate;       // Sales date (8 bytes, YYYYMMDD)
-    std::string salesTime;       // Sales time (6 bytes, hhmmss)
-    std::string transactionId;   // Transaction unique number (12 bytes)
-    std::string merchantNumber; // Merchant number (15 bytes)
-    std::string terminalNumber;  // Terminal number (14 bytes)
-    std::string issuer;          // Issuer (20 bytes)
-    std::string rejectionInfo;   // Rejection info (20 bytes, if rejected)
-    std::string acquirer;        // Acquirer (20 bytes)
+    using Layout = layout::ApprovalResult;
+    std::array<uint8_t, Layout::MAX_SIZE> data{};
+    size_t size = 0;    // payload bytes received (SIZE..MAX_SIZE)
     
-    // Original data (backup)
-    std::vector<uint8_t> data;
+    char transactionType() const { return code<Layout::TransactionType>(); }      // 1=Credit, 2=Cash Receipt, 3=Prepaid, 4=Zero Pay, 5=Kakao Mini, 6=Kakao Credit, X=Rejected
+    char transactionMedium() const { return code<Layout::TransactionMedium>(); }  // 1=IC, 2=MS, 3=RF, 4=QR, 5=KEYIN
+    std::string_view cardNumber() const { return text<Layout::CardNumber>(); }
+    std::string_view approvalAmount() const { return text<Layout::ApprovalAmount>(); }
+    std::string_view tax() const { return text<Layout::Tax>(); }
+    std::string_view serviceCharge() const { return text<Layout::ServiceCharge>(); }
+    std::string_view installments() const { return text<Layout::Installments>(); }
+    std::string_view approvalNumber() const { return text<Layout::ApprovalNumber>(); }  // or prepaid card info
+    std::string_view salesDate() const { return text<Layout::SalesDate>(); }
+    std::string_view salesTime() const { return text<Layout::SalesTime>(); }
+    std::string_view transactionId() const { return text<Layout::TransactionId>(); }
+    std::string_view merchantNumber() const { return text<Layout::MerchantNumber>(); }
+    std::string_view terminalNumber() const { return text<Layout::TerminalNumber>(); }
+    std::string_view issuer() const { return text<Layout::Issuer>(); }
+    std::string_view rejectionInfo() const { return text<Layout::RejectionInfo>(); }  // VAN response, any result
+    std::string_view acquirer() const {
+        // 157 byte만 온 응답에는 없음 (받은 만큼만 읽음)
+        if (size <= Layout::Acquirer::offset) return std::string_view();
+        size_t width = (std::min)(Layout::Acquirer::width, size - Layout::Acquirer::offset);
+        return layout::trimField(field(Layout::Acquirer::offset, width));
+    }
+    
+    // Any field by layout entry, untrimmed
+    std::string_view field(size_t offset, size_t width) const {
+        return std::string_view(reinterpret_cast<const char*>(data.data()) + offset, width);
+    }
     
     // Convenience functions
-    bool isRejected() const { return transactionType == 'X' || transactionType == 'x'; }
+    bool isRejected() const { return transactionType() == 'X' || transactionType() == 'x'; }
     bool isSuccess() const { return !isRejected(); }
+
+private:
+    template <typename F>
+    char code() const { return static_cast<char>(data[F::offset]); }
+    template <typename F>
+    std::string_view text() const { return layout::trimField(field(F::offset, F::width)); }
 };
 
 // Last approval response structure (same as PaymentApprovalResponse)
 struct LastApprovalResponse {
-    std::vector<uint8_t> data;  // Response data (157 bytes, same as PaymentApprovalResponse)
+    InlineBytes<layout::ApprovalResult::SIZE> data;  // Response data (157 bytes, same as PaymentApprovalResponse)
 };
 
 // Screen/sound setting request structure
@@ -159,65 +209,26 @@ struct TransactionCancelRequest {
     std::string additionalInfo;    // Additional info (for PG cancellation, 30 digits)
 };
 
-// Transaction cancellation response structure (same as PaymentApprovalResponse)
-struct TransactionCancelResponse {
-    // Same structure as PaymentApprovalResponse
-    char transactionType;        // Transaction type
-    char transactionMedium;      // Transaction medium
-    std::string cardNumber;      // Card number (20 bytes, masked)
-    std::string approvalAmount;  // Approval/Cancellation amount (10 bytes)
-    std::string tax;             // Tax (8 bytes)
-    std::string serviceCharge;   // Service charge (8 bytes)
-    std::string installments;    // Installment months (2 bytes)
-    std::string approvalNumber;  // Approval number/Prepaid card info (12 bytes)
-    std::string salesDate;       // Sales date (8 bytes, YYYYMMDD)
-    std::string salesTime;       // Sales time (6 bytes, hhmmss)
-    std::string transactionId;   // Transaction unique number (12 bytes)
-    std::string merchantNumber; // Merchant number (15 bytes)
-    std::string terminalNumber;  // Terminal number (14 bytes)
-    std::string issuer;          // Issuer (20 bytes)
-    std::string rejectionInfo;   // Rejection info (20 bytes, if rejected)
-    std::string acquirer;        // Acquirer (20 bytes)
-    
-    // Original data (backup)
-    std::vector<uint8_t> data;
-    
-    // Convenience functions
-    bool isRejected() const { return transactionType == 'X' || transactionType == 'x'; }
-    bool isSuccess() const { return !isRejected(); }
-};
+// Transaction cancellation response: same 157-byte layout as the approval result
+using TransactionCancelResponse = PaymentApprovalResponse;
 
 class SmartroProtocol {
 public:
-    // Create device check request packet
-    static std::vector<uint8_t> createDeviceCheckRequest(const std::string& terminalId);
-    
-    // Create payment wait request packet
-    static std::vector<uint8_t> createPaymentWaitRequest(const std::string& terminalId);
-    
-    // Create card UID read request packet
-    static std::vector<uint8_t> createCardUidReadRequest(const std::string& terminalId);
-    
-    // Create reset request packet
-    static std::vector<uint8_t> createResetRequest(const std::string& terminalId);
-    
-    // Create payment approval request packet
-    static std::vector<uint8_t> createPaymentApprovalRequest(const std::string& terminalId,
-                                                              const PaymentApprovalRequest& request);
-    
-    // Create transaction cancellation request packet
-    static std::vector<uint8_t> createTransactionCancelRequest(const std::string& terminalId,
-                                                                const TransactionCancelRequest& request);
-    
-    // Create last approval response request packet
-    static std::vector<uint8_t> createLastApprovalResponseRequest(const std::string& terminalId);
-    
-    // Create screen/sound setting request packet
-    static std::vector<uint8_t> createScreenSoundSettingRequest(const std::string& terminalId,
-                                                                const ScreenSoundSettingRequest& request);
-    
-    // Create IC card check request packet
-    static std::vector<uint8_t> createIcCardCheckRequest(const std::string& terminalId);
+    // Request builders: serialize straight into the caller's fixed-size buffer (packet_layout.h)
+    // in one pass — header, job code, data length, data, ETX and BCC. Requests with data return
+    // false (and log the field) when a value does not fit its fixed-width field.
+    static void createDeviceCheckRequest(const std::string& terminalId, RequestPacket& packet);
+    static void createPaymentWaitRequest(const std::string& terminalId, RequestPacket& packet);
+    static void createCardUidReadRequest(const std::string& terminalId, RequestPacket& packet);
+    static void createResetRequest(const std::string& terminalId, RequestPacket& packet);
+    static bool createPaymentApprovalRequest(const std::string& terminalId,
+                                             const PaymentApprovalRequest& request, RequestPacket& packet);
+    static bool createTransactionCancelRequest(const std::string& terminalId,
+                                               const TransactionCancelRequest& request, RequestPacket& packet);
+    static void createLastApprovalResponseRequest(const std::string& terminalId, RequestPacket& packet);
+    static void createScreenSoundSettingRequest(const std::string& terminalId,
+                                                const ScreenSoundSettingRequest& request, RequestPacket& packet);
+    static void createIcCardCheckRequest(const std::string& terminalId, RequestPacket& packet);
     
     // Parse packet
     static bool parsePacket(const uint8_t* data, size_t length, 
@@ -250,7 +261,7 @@ public:
     static bool parsePaymentApprovalResponse(const uint8_t* data, size_t length, 
                                             PaymentApprovalResponse& response);
     
-    // Parse transaction cancellation response (same as payment approval response)
+    // Parse transaction cancellation response (same layout as payment approval response)
     static bool parseTransactionCancelResponse(const uint8_t* data, size_t length, 
                                               TransactionCancelResponse& response);
     
@@ -266,12 +277,6 @@ public:
     static bool parseIcCardCheckResponse(const uint8_t* data, size_t length, 
                                         IcCardCheckResponse& response);
     
-    // Generate DateTime (YYYYMMDDhhmmss)
-    static std::string getCurrentDateTime();
-    
-    // Format Terminal ID (16 bytes, left-aligned, rest 0x00)
-    static std::vector<uint8_t> formatTerminalId(const std::string& terminalId);
-    
     // Convert USHORT to Little Endian
     static void writeUshortLE(uint16_t value, uint8_t* buffer);
     
@@ -0,0 +1,92 @@
+// include/vendor_adapters/smartro/spsc_queue.h
+#pragma once
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+
+namespace smartro {
+
+/// Bounded single-producer / single-consumer ring, lock-free on both sides. The producer
+/// constructs the next item directly in its slot (prepare), fills it, then publishes it or
+/// throws it away; the consumer moves items out in order. Capacity is a power of two.
+/// tail_ is published with seq_cst so a consumer that announces it is about to sleep and then
+/// re-checks empty() cannot miss an item (see SmartroComm::pollResponse).
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::atomic<size_t>::is_always_lock_free, "SpscQueue needs lock-free size_t atomics");
+
+public:
+    SpscQueue() = default;
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    ~SpscQueue() {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        for (; head != tail; ++head) {
+            slot(head)->~T();
+        }
+    }
+
+    // ---- producer ----
+
+    /// Construct the next item in place; nullptr when full. Follow with publish() or discard().
+    template <typename... Args>
+    T* prepare(Args&&... args) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == Capacity) {
+            return nullptr;
+        }
+        return new (&slots_[tail & (Capacity - 1)]) T(std::forward<Args>(args)...);
+    }
+
+    void publish() {
+        tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+    }
+
+    void discard() {
+        slot(tail_.load(std::memory_order_relaxed))->~T();
+    }
+
+    // ---- consumer ----
+
+    bool tryPop(T& out) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        T* item = slot(head);
+        out = std::move(*item);
+        item->~T();
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // ---- either side (a snapshot) ----
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_seq_cst);
+    }
+
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    T* slot(size_t index) {
+        return std::launder(reinterpret_cast<T*>(&slots_[index & (Capacity - 1)]));
+    }
+
+    // Producer and consumer indices on separate cache lines (free-running, wrap via the mask)
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+    alignas(64) std::aligned_storage_t<sizeof(T), alignof(T)> slots_[Capacity];
+};
+
+} // namespace smartro
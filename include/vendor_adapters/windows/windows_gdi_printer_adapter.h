@@ -31,6 +31,7 @@ public:
     bool print(const std::string& jobId, const std::vector<uint8_t>& printData) override;
     bool printFromFile(const std::string& jobId, const std::string& filePath, const std::string& orientation = "portrait") override;
     devices::DeviceState getState() const override;
+    const devices::StateHistory* getStateHistory() const override { return &history_; }
     bool reset() override;
     devices::PrinterCapabilities getCapabilities() const override;
     void setPrintJobCompleteCallback(std::function<void(const devices::PrintJobCompleteEvent&)> callback) override;
@@ -44,7 +45,18 @@ private:
     std::string printerName_;
     std::function<void(const devices::PrintJobCompleteEvent&)> printJobCompleteCallback_;
     std::function<void(devices::DeviceState)> stateChangedCallback_;
-    mutable std::mutex mutex_;
+    mutable std::mutex mutex_;              // serializes print jobs (held for the whole job)
+
+    // Outcome of the last print attempt. Sticky: getState() reports it until a print succeeds
+    // (or reset()); a successful CreateDC never promotes it back to READY.
+    devices::DeviceState reportedState_ = devices::DeviceState::STATE_READY;
+    std::string lastError_;
+    mutable std::mutex stateMutex_;         // reportedState_ / lastError_ (never held across callbacks)
+    devices::StateHistory history_;         // reportedState_ transitions
+
+    /// Print outcome → state (READY / ERROR for StartDoc/StartPage / DISCONNECTED when the printer
+    /// or its DC is gone); calls stateChangedCallback_ on a change. Caller holds mutex_.
+    void reportStateLocked(const devices::PrintJobCompleteEvent& outcome);
 
     bool doPrint(const std::string& jobId, const std::vector<uint8_t>& printData,
                  devices::PrintJobCompleteEvent& outEvent);
@@ -67,10 +67,13 @@ void ConfigManager::loadDefaults() {
     printerPaperSize_ = "A4";
     printerMarginH_ = 0;
     printerMarginV_ = 0;
+    printerPool_ = "";
     paymentComPort_ = "";
     paymentEnabled_ = false;
     cashComPort_ = "";
     cashEnabled_ = false;
+    heartbeatIntervalMs_ = 15000;
+    eventCoalesceMs_ = {{"device_state_changed", 250}, {"camera_state_changed", 250}};
     ensureSaveDirectoryExists();
 }
 
@@ -122,11 +125,11 @@ namespace {
         size_t start = s.find_first_not_of(" \t\r\n");
         if (start != std::string::npos) s.erase(0, start);
     }
-    // Normalize COM port to "COMn" (uppercase, no spaces)
+    // Normalize COM port to "COMn" (uppercase, no spaces). POSIX device paths are case-sensitive, keep as is
     std::string normalizeComPort(const std::string& s) {
         std::string v = s;
         normalizeIniValue(v);
-        if (v.empty()) return v;
+        if (v.empty() || v[0] == '/') return v;
         for (size_t i = 0; i < v.size(); ++i) {
             if (v[i] >= 'a' && v[i] <= 'z') v[i] = static_cast<char>(v[i] - 32);
         }
@@ -171,6 +174,8 @@ void ConfigManager::loadFromFile(const std::string& configPath) {
                 try { printerMarginH_ = std::stoi(value); } catch (...) {}
             } else if (key == "printer.margin_v") {
                 try { printerMarginV_ = std::stoi(value); } catch (...) {}
+            } else if (key == "printer.pool") {
+                printerPool_ = value;
             } else if (key == "payment.com_port") {
                 paymentComPort_ = normalizeComPort(value);
             } else if (key == "payment.enabled") {
@@ -179,6 +184,10 @@ void ConfigManager::loadFromFile(const std::string& configPath) {
                 cashComPort_ = normalizeComPort(value);
             } else if (key == "cash.enabled") {
                 cashEnabled_ = (value == "1" || value == "true" || value == "yes");
+            } else if (key == "health.heartbeat_ms") {
+                try { heartbeatIntervalMs_ = std::stoi(value); } catch (...) {}
+            } else {
+                setEventCoalesceFromKey(key, value);
             }
         }
     }
@@ -232,12 +241,20 @@ void ConfigManager::saveToFile(const std::string& configPath) {
     file << "printer.paper_size=" << printerPaperSize_ << "\n";
     file << "printer.margin_h=" << printerMarginH_ << "\n";
     file << "printer.margin_v=" << printerMarginV_ << "\n";
+    file << "# printer.pool: additional printer names (comma-separated), load-balanced with printer.name\n";
+    file << "printer.pool=" << printerPool_ << "\n";
     file << "# payment.com_port: COM port from Admin auto-detect (card reader)\n";
     file << "payment.com_port=" << paymentComPort_ << "\n";
     file << "payment.enabled=" << (paymentEnabled_ ? "1" : "0") << "\n";
     file << "# cash.com_port: COM port from Admin auto-detect (cash acceptor)\n";
     file << "cash.com_port=" << cashComPort_ << "\n";
     file << "cash.enabled=" << (cashEnabled_ ? "1" : "0") << "\n";
+    file << "# health.heartbeat_ms: background device liveness check interval while idle (0 = off)\n";
+    file << "health.heartbeat_ms=" << heartbeatIntervalMs_ << "\n";
+    file << "# events.coalesce_ms.<event_type>: merge state-change storms within this window (ms, 0 = off)\n";
+    for (const auto& entry : eventCoalesceMs_) {
+        file << "events.coalesce_ms." << entry.first << "=" << entry.second << "\n";
+    }
 
     file.close();
 }
@@ -277,10 +294,31 @@ void ConfigManager::setPrinterName(const std::string& name) { printerName_ = nam
 void ConfigManager::setPrinterPaperSize(const std::string& size) { printerPaperSize_ = size; }
 void ConfigManager::setPrinterMarginH(int value) { printerMarginH_ = value; }
 void ConfigManager::setPrinterMarginV(int value) { printerMarginV_ = value; }
+void ConfigManager::setPrinterPool(const std::string& names) { printerPool_ = names; }
+
+std::vector<std::string> ConfigManager::getPrinterPoolNames() const {
+    std::vector<std::string> names;
+    std::stringstream ss(printerPool_);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        normalizeIniValue(item);
+        if (!item.empty() && item != printerName_)
+            names.push_back(item);
+    }
+    return names;
+}
 void ConfigManager::setPaymentComPort(const std::string& port) { paymentComPort_ = port; }
 void ConfigManager::setPaymentEnabled(bool value) { paymentEnabled_ = value; }
 void ConfigManager::setCashComPort(const std::string& port) { cashComPort_ = port; }
 void ConfigManager::setCashEnabled(bool value) { cashEnabled_ = value; }
+void ConfigManager::setHeartbeatIntervalMs(int value) { heartbeatIntervalMs_ = value; }
+
+bool ConfigManager::setEventCoalesceFromKey(const std::string& key, const std::string& value) {
+    static const std::string prefix = "events.coalesce_ms.";
+    if (key.compare(0, prefix.size(), prefix) != 0 || key.size() == prefix.size()) return false;
+    try { eventCoalesceMs_[key.substr(prefix.size())] = std::stoi(value); } catch (...) {}
+    return true;
+}
 
 std::map<std::string, std::string> ConfigManager::getAll() const {
     std::map<std::string, std::string> m;
@@ -289,10 +327,15 @@ std::map<std::string, std::string> ConfigManager::getAll() const {
     m["printer.paper_size"] = printerPaperSize_;
     m["printer.margin_h"] = std::to_string(printerMarginH_);
     m["printer.margin_v"] = std::to_string(printerMarginV_);
+    m["printer.pool"] = printerPool_;
     m["payment.com_port"] = paymentComPort_;
     m["payment.enabled"] = paymentEnabled_ ? "1" : "0";
     m["cash.com_port"] = cashComPort_;
     m["cash.enabled"] = cashEnabled_ ? "1" : "0";
+    m["health.heartbeat_ms"] = std::to_string(heartbeatIntervalMs_);
+    for (const auto& entry : eventCoalesceMs_) {
+        m["events.coalesce_ms." + entry.first] = std::to_string(entry.second);
+    }
     return m;
 }
 
@@ -306,10 +349,13 @@ void ConfigManager::setFromMap(const std::map<std::string, std::string>& kv) {
         else if (k == "printer.paper_size") printerPaperSize_ = v;
         else if (k == "printer.margin_h") try { printerMarginH_ = std::stoi(v); } catch (...) {}
         else if (k == "printer.margin_v") try { printerMarginV_ = std::stoi(v); } catch (...) {}
+        else if (k == "printer.pool") printerPool_ = v;
         else if (k == "payment.com_port") paymentComPort_ = normalizeComPort(v);
         else if (k == "payment.enabled") paymentEnabled_ = (v == "1" || v == "true" || v == "yes");
         else if (k == "cash.com_port") cashComPort_ = normalizeComPort(v);
         else if (k == "cash.enabled") cashEnabled_ = (v == "1" || v == "true" || v == "yes");
+        else if (k == "health.heartbeat_ms") try { heartbeatIntervalMs_ = std::stoi(v); } catch (...) {}
+        else setEventCoalesceFromKey(k, v);
     }
 }
 
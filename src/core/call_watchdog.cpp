@@ -0,0 +1,234 @@
+// src/core/call_watchdog.cpp
+#include "core/call_watchdog.h"
+#include "logging/logger.h"
+
+#include <vector>
+
+namespace core {
+
+struct CallWatchdog::Shared {
+    struct Call {
+        HangInfo info;
+        std::chrono::steady_clock::time_point started;
+        std::chrono::steady_clock::time_point deadline;
+        bool hung = false;
+    };
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::map<uint64_t, Call> calls;
+    std::map<std::string, uint32_t> hungCalls;      // deviceId → outstanding hung calls
+    std::map<std::string, uint64_t> hangCounts;
+    uint64_t nextToken = 1;
+    bool running = false;
+    HangCallback onHang;
+    HangCallback onRecovered;
+};
+
+namespace {
+    long long elapsedSince(std::chrono::steady_clock::time_point t) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t).count();
+    }
+} // namespace
+
+CallWatchdog::CallWatchdog()
+    : shared_(std::make_shared<Shared>()) {
+}
+
+CallWatchdog::~CallWatchdog() {
+    stop();
+}
+
+void CallWatchdog::start(HangCallback onHang, HangCallback onRecovered) {
+    {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        if (shared_->running) return;
+        shared_->running = true;
+        shared_->onHang = std::move(onHang);
+        shared_->onRecovered = std::move(onRecovered);
+    }
+    thread_ = std::thread(&CallWatchdog::monitorThread, this);
+}
+
+void CallWatchdog::stop() {
+    {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        if (!shared_->running) return;
+        shared_->running = false;
+        // 종료 후 늦게 돌아오는 호출이 ServiceCore 콜백을 부르지 않도록
+        shared_->onHang = nullptr;
+        shared_->onRecovered = nullptr;
+    }
+    shared_->cv.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+uint64_t CallWatchdog::begin(const std::string& deviceId, devices::DeviceType deviceType, const std::string& operation,
+                             std::chrono::milliseconds timeout, const std::string& tag) {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    uint64_t token = shared_->nextToken++;
+    Shared::Call& call = shared_->calls[token];
+    call.info.deviceId = deviceId;
+    call.info.deviceType = deviceType;
+    call.info.operation = operation;
+    call.info.tag = tag;
+    call.started = std::chrono::steady_clock::now();
+    call.deadline = call.started + timeout;
+    shared_->cv.notify_all();
+    return token;
+}
+
+bool CallWatchdog::finish(const std::shared_ptr<Shared>& shared, uint64_t token) {
+    HangInfo info;
+    HangCallback onRecovered;
+    {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        auto it = shared->calls.find(token);
+        if (it == shared->calls.end()) return true;
+        bool hung = it->second.hung;
+        info = it->second.info;
+        info.elapsedMs = elapsedSince(it->second.started);
+        shared->calls.erase(it);
+        if (!hung) return true;
+
+        auto h = shared->hungCalls.find(info.deviceId);
+        if (h != shared->hungCalls.end() && --h->second == 0) {
+            shared->hungCalls.erase(h);
+            onRecovered = shared->onRecovered;
+        }
+    }
+    logging::Logger::getInstance().warn("CallWatchdog: " + info.deviceId + " " + info.operation
+        + " returned after " + std::to_string(info.elapsedMs) + " ms (was hung)");
+    if (onRecovered) {
+        try {
+            onRecovered(info);
+        } catch (const std::exception& e) {
+            logging::Logger::getInstance().error("CallWatchdog recovered callback failed: " + std::string(e.what()));
+        }
+    }
+    return false;
+}
+
+bool CallWatchdog::end(uint64_t token) {
+    return finish(shared_, token);
+}
+
+bool CallWatchdog::endByTag(const std::string& deviceId, const std::string& tag) {
+    uint64_t token = 0;
+    {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        for (const auto& pair : shared_->calls) {
+            if (pair.second.info.deviceId == deviceId && pair.second.info.tag == tag) {
+                token = pair.first;
+                break;
+            }
+        }
+    }
+    return token == 0 || finish(shared_, token);
+}
+
+bool CallWatchdog::call(const std::string& deviceId, devices::DeviceType deviceType, const std::string& operation,
+                        std::chrono::milliseconds timeout, std::function<void()> fn) {
+    if (isHung(deviceId)) {
+        logging::Logger::getInstance().warn("CallWatchdog: " + deviceId + " is HUNG, " + operation + " rejected");
+        return false;
+    }
+
+    struct Completion {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool done = false;
+    };
+    auto completion = std::make_shared<Completion>();
+    uint64_t token = begin(deviceId, deviceType, operation, timeout);
+
+    std::thread([shared = shared_, token, completion, fn = std::move(fn), deviceId, operation]() {
+        try {
+            fn();
+        } catch (const std::exception& e) {
+            logging::Logger::getInstance().error("CallWatchdog: " + deviceId + " " + operation + " threw: " + e.what());
+        }
+        finish(shared, token);
+        {
+            std::lock_guard<std::mutex> lock(completion->mutex);
+            completion->done = true;
+        }
+        completion->cv.notify_all();
+    }).detach();
+
+    std::unique_lock<std::mutex> lock(completion->mutex);
+    return completion->cv.wait_for(lock, timeout, [&completion] { return completion->done; });
+}
+
+bool CallWatchdog::isHung(const std::string& deviceId) const {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    return shared_->hungCalls.count(deviceId) > 0;
+}
+
+bool CallWatchdog::getHang(const std::string& deviceId, HangInfo& out) const {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    if (!shared_->hungCalls.count(deviceId)) return false;
+    for (const auto& pair : shared_->calls) {
+        const auto& call = pair.second;
+        if (call.hung && call.info.deviceId == deviceId) {
+            out = call.info;
+            out.elapsedMs = elapsedSince(call.started);
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t CallWatchdog::getHangCount(const std::string& deviceId) const {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    auto it = shared_->hangCounts.find(deviceId);
+    return it == shared_->hangCounts.end() ? 0 : it->second;
+}
+
+void CallWatchdog::monitorThread() {
+    std::unique_lock<std::mutex> lock(shared_->mutex);
+    while (shared_->running) {
+        auto now = std::chrono::steady_clock::now();
+        auto next = std::chrono::steady_clock::time_point::max();
+        std::vector<HangInfo> expired;
+        for (auto& pair : shared_->calls) {
+            auto& call = pair.second;
+            if (call.hung) continue;
+            if (call.deadline <= now) {
+                call.hung = true;
+                ++shared_->hungCalls[call.info.deviceId];
+                ++shared_->hangCounts[call.info.deviceId];
+                HangInfo info = call.info;
+                info.elapsedMs = elapsedSince(call.started);
+                expired.push_back(info);
+            } else if (call.deadline < next) {
+                next = call.deadline;
+            }
+        }
+
+        if (!expired.empty()) {
+            HangCallback onHang = shared_->onHang;
+            lock.unlock();
+            for (const auto& info : expired) {
+                logging::Logger::getInstance().error("CallWatchdog: " + info.deviceId + " " + info.operation
+                    + " exceeded deadline (" + std::to_string(info.elapsedMs) + " ms), device HUNG");
+                if (!onHang) continue;
+                try {
+                    onHang(info);
+                } catch (const std::exception& e) {
+                    logging::Logger::getInstance().error("CallWatchdog hang callback failed: " + std::string(e.what()));
+                }
+            }
+            lock.lock();
+            continue;
+        }
+
+        if (next == std::chrono::steady_clock::time_point::max()) {
+            shared_->cv.wait(lock);
+        } else {
+            shared_->cv.wait_until(lock, next);
+        }
+    }
+}
+
+} // namespace core
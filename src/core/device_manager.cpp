@@ -75,6 +75,20 @@ std::shared_ptr<devices::ICamera> DeviceManager::getDefaultCamera() {
     return nullptr;
 }
 
+std::string DeviceManager::getDefaultDeviceId(devices::DeviceType type) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    switch (type) {
+        case devices::DeviceType::PAYMENT_TERMINAL:
+            return paymentTerminals_.empty() ? "" : paymentTerminals_.begin()->first;
+        case devices::DeviceType::PRINTER:
+            return printers_.empty() ? "" : printers_.begin()->first;
+        case devices::DeviceType::CAMERA:
+            return cameras_.empty() ? "" : cameras_.begin()->first;
+        default:
+            return "";
+    }
+}
+
 std::vector<devices::DeviceInfo> DeviceManager::getAllDeviceInfo() const {
     std::lock_guard<std::mutex> lock(mutex_);
     std::vector<devices::DeviceInfo> result;
@@ -94,6 +108,30 @@ std::vector<devices::DeviceInfo> DeviceManager::getAllDeviceInfo() const {
     return result;
 }
 
+std::vector<devices::DeviceInfo> DeviceManager::getAllDeviceInfo(
+    const std::function<bool(devices::DeviceInfo&)>& override) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<devices::DeviceInfo> result;
+
+    auto collect = [&](const std::string& deviceId, devices::DeviceType type, auto&& query) {
+        devices::DeviceInfo info;
+        info.deviceId = deviceId;
+        info.deviceType = type;
+        result.push_back(override && override(info) ? info : query());
+    };
+    for (const auto& pair : paymentTerminals_) {
+        collect(pair.first, devices::DeviceType::PAYMENT_TERMINAL, [&] { return pair.second->getDeviceInfo(); });
+    }
+    for (const auto& pair : printers_) {
+        collect(pair.first, devices::DeviceType::PRINTER, [&] { return pair.second->getDeviceInfo(); });
+    }
+    for (const auto& pair : cameras_) {
+        collect(pair.first, devices::DeviceType::CAMERA, [&] { return pair.second->getDeviceInfo(); });
+    }
+
+    return result;
+}
+
 std::vector<std::string> DeviceManager::getDeviceIds(devices::DeviceType type) const {
     std::lock_guard<std::mutex> lock(mutex_);
     std::vector<std::string> result;
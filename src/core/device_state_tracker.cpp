@@ -0,0 +1,66 @@
+// src/core/device_state_tracker.cpp
+#include "core/device_state_tracker.h"
+#include <chrono>
+
+namespace core {
+
+DeviceStateTracker::DeviceStateTracker()
+    : epochMs_(std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count()) {
+}
+
+uint64_t DeviceStateTracker::update(const std::vector<devices::DeviceInfo>& devices) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& info : devices) {
+        auto it = entries_.find(info.deviceId);
+        if (it != entries_.end()) {
+            const auto& prev = it->second.info;
+            if (prev.state == info.state &&
+                prev.lastError == info.lastError &&
+                prev.deviceName == info.deviceName &&
+                prev.deviceType == info.deviceType) {
+                continue;
+            }
+        }
+        Entry& e = entries_[info.deviceId];
+        e.info = info;
+        e.version = ++version_;
+    }
+    return version_;
+}
+
+uint64_t DeviceStateTracker::recordState(const std::string& deviceId, devices::DeviceState state) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(deviceId);
+    if (it != entries_.end()) {
+        it->second.info.state = state;
+        it->second.version = ++version_;
+    }
+    return version_;
+}
+
+std::vector<DeviceStateTracker::Entry> DeviceStateTracker::changedSince(uint64_t sinceVersion) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Entry> result;
+    for (const auto& pair : entries_) {
+        if (pair.second.version > sinceVersion) {
+            result.push_back(pair.second);
+        }
+    }
+    return result;
+}
+
+bool DeviceStateTracker::getLastInfo(const std::string& deviceId, devices::DeviceInfo& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(deviceId);
+    if (it == entries_.end()) return false;
+    out = it->second.info;
+    return true;
+}
+
+uint64_t DeviceStateTracker::currentVersion() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return version_;
+}
+
+} // namespace core
@@ -0,0 +1,182 @@
+// src/core/event_coalescer.cpp
+#include "logging/logger.h"
+#include "core/event_coalescer.h"
+
+namespace core {
+
+EventCoalescer::EventCoalescer(Sink sink)
+    : sink_(std::move(sink)) {
+}
+
+EventCoalescer::~EventCoalescer() {
+    stop();
+}
+
+bool EventCoalescer::isCoalescable(ipc::EventType type) {
+    switch (type) {
+        case ipc::EventType::DEVICE_STATE_CHANGED:
+        case ipc::EventType::CAMERA_STATE_CHANGED:
+            return true;
+        default:
+            // 결제/현금/완료/프로브 결과는 하나하나가 의미 있음 — 절대 병합하지 않음
+            return false;
+    }
+}
+
+void EventCoalescer::setWindow(ipc::EventType type, std::chrono::milliseconds window) {
+    if (!isCoalescable(type)) {
+        logging::Logger::getInstance().warn("EventCoalescer: " + ipc::eventTypeToString(type) + " is never coalesced, window ignored");
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (window.count() > 0) windows_[type] = window;
+    else windows_.erase(type);
+}
+
+void EventCoalescer::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) return;
+    running_ = true;
+    thread_ = std::thread(&EventCoalescer::flushThread, this);
+}
+
+void EventCoalescer::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return;
+        running_ = false;
+        flushLocked();
+    }
+    drainOutbox();
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+std::string EventCoalescer::keyOf(const ipc::Event& event) {
+    auto it = event.data.find("deviceId");
+    return ipc::eventTypeToString(event.eventType) + "|" + event.deviceType + "|"
+        + (it != event.data.end() ? it->second : std::string());
+}
+
+void EventCoalescer::countCoalesced(ipc::EventType type) {
+    ++coalesced_;
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    ++coalescedByType_[ipc::eventTypeToString(type)];
+}
+
+void EventCoalescer::emitLocked(const ipc::Event& event, Slot* slot) {
+    if (slot) slot->lastEmittedData = event.data;
+    ++emitted_;
+    outbox_.push_back(event);
+}
+
+void EventCoalescer::drainOutbox() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (draining_) return;  // 전달 중인 스레드가 방금 넣은 것까지 순서대로 보냄
+    draining_ = true;
+    while (!outbox_.empty()) {
+        ipc::Event event = std::move(outbox_.front());
+        outbox_.pop_front();
+        lock.unlock();
+        try {
+            sink_(event);
+        } catch (const std::exception& e) {
+            logging::Logger::getInstance().error("EventCoalescer sink failed: " + std::string(e.what()));
+        }
+        lock.lock();
+    }
+    draining_ = false;
+}
+
+void EventCoalescer::flushLocked() {
+    for (auto& pair : slots_) {
+        Slot& slot = pair.second;
+        if (!slot.hasPending) continue;
+        slot.hasPending = false;
+        if (slot.pending.data == slot.lastEmittedData) {
+            countCoalesced(slot.pending.eventType);  // 창 안에서 원래 상태로 되돌아옴 → 보낼 필요 없음
+            continue;
+        }
+        emitLocked(slot.pending, &slot);
+    }
+}
+
+void EventCoalescer::publish(const ipc::Event& event) {
+    ++published_;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto window = windows_.find(event.eventType);
+        if (!running_ || window == windows_.end() || !isCoalescable(event.eventType)) {
+            // 병합 대상이 아닌 이벤트: 대기 중인 상태 이벤트를 먼저 내보내 발행 순서 유지
+            flushLocked();
+            emitLocked(event, nullptr);
+        } else {
+            auto now = std::chrono::steady_clock::now();
+            Slot& slot = slots_[keyOf(event)];
+            if (!slot.hasPending && now >= slot.windowEnd) {
+                // 창 밖 첫 이벤트는 즉시 (지연 없음), 이후 창 동안은 최신 것만 보관
+                emitLocked(event, &slot);
+                slot.windowEnd = now + window->second;
+            } else {
+                if (slot.hasPending) countCoalesced(slot.pending.eventType);
+                slot.pending = event;
+                slot.hasPending = true;
+                cv_.notify_all();
+                return;
+            }
+        }
+    }
+    drainOutbox();
+}
+
+void EventCoalescer::flushThread() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        auto now = std::chrono::steady_clock::now();
+        auto next = std::chrono::steady_clock::time_point::max();
+        for (auto& pair : slots_) {
+            Slot& slot = pair.second;
+            if (!slot.hasPending) continue;
+            if (slot.windowEnd <= now) {
+                slot.hasPending = false;
+                if (slot.pending.data == slot.lastEmittedData) {
+                    countCoalesced(slot.pending.eventType);
+                    continue;
+                }
+                emitLocked(slot.pending, &slot);
+                // 폭주가 계속되면 창 단위로 최신 상태만 계속 내보냄
+                auto window = windows_.find(slot.pending.eventType);
+                if (window != windows_.end()) slot.windowEnd = now + window->second;
+            } else if (slot.windowEnd < next) {
+                next = slot.windowEnd;
+            }
+        }
+        if (!outbox_.empty()) {
+            lock.unlock();
+            drainOutbox();
+            lock.lock();
+            continue;   // 전달하는 동안 새 이벤트가 들어왔을 수 있음
+        }
+        if (next == std::chrono::steady_clock::time_point::max()) {
+            cv_.wait(lock);
+        } else {
+            cv_.wait_until(lock, next);
+        }
+    }
+}
+
+EventCoalescer::Stats EventCoalescer::getStats() const {
+    Stats s;
+    s.published = published_;
+    s.emitted = emitted_;
+    s.coalesced = coalesced_;
+    return s;
+}
+
+std::map<std::string, uint64_t> EventCoalescer::getCoalescedByType() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return coalescedByType_;
+}
+
+} // namespace core
@@ -0,0 +1,109 @@
+// src/core/health_probe.cpp
+#include "core/health_probe.h"
+#include "logging/logger.h"
+
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+
+namespace core {
+
+namespace {
+    // 프로브 스레드와 호출자가 공유 — 데드라인 후에도 늦게 끝난 프로브가 안전하게 기록할 수 있도록 shared_ptr로 유지
+    struct ProbeState {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<HealthProbeResult> completed;
+    };
+
+    uint32_t elapsedSince(std::chrono::steady_clock::time_point t0) {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - t0).count());
+    }
+}
+
+HealthProbeEngine::~HealthProbeEngine() {
+    waitIdle();
+}
+
+void HealthProbeEngine::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return running_ == 0; });
+}
+
+std::vector<HealthProbeResult> HealthProbeEngine::run(std::vector<HealthProbe> probes,
+                                                      std::chrono::milliseconds deadline,
+                                                      const ResultCallback& onResult) {
+    std::vector<HealthProbeResult> results;
+    if (probes.empty()) return results;
+
+    auto state = std::make_shared<ProbeState>();
+    auto t0 = std::chrono::steady_clock::now();
+    auto until = t0 + deadline;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ += probes.size();
+    }
+    for (const auto& p : probes) {
+        std::thread([this, state, p, t0]() {
+            HealthProbeResult r;
+            r.deviceId = p.deviceId;
+            r.deviceType = p.deviceType;
+            try {
+                r.info = p.probe();
+            } catch (const std::exception& e) {
+                logging::Logger::getInstance().warn("Health probe " + p.deviceId + " threw: " + e.what());
+                if (p.snapshot) r.info = p.snapshot();
+            }
+            r.elapsedMs = elapsedSince(t0);
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->completed.push_back(std::move(r));
+                state->cv.notify_all();
+            }
+            // 데드라인 이후에도 계속 도는 프로브를 종료 시 기다릴 수 있도록 끝날 때 감소
+            std::lock_guard<std::mutex> lock(mutex_);
+            --running_;
+            cv_.notify_all();
+        }).detach();
+    }
+
+    std::vector<bool> done(probes.size(), false);
+    while (results.size() < probes.size()) {
+        HealthProbeResult r;
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            if (!state->cv.wait_until(lock, until, [&] { return !state->completed.empty(); })) break;
+            r = std::move(state->completed.front());
+            state->completed.pop_front();
+        }
+        for (size_t i = 0; i < probes.size(); ++i) {
+            if (!done[i] && probes[i].deviceId == r.deviceId) { done[i] = true; break; }
+        }
+        logging::Logger::getInstance().info("Health probe " + r.deviceId + ": " + devices::deviceStateToString(r.info.state)
+            + " (" + std::to_string(r.elapsedMs) + " ms)");
+        if (onResult) onResult(r);
+        results.push_back(std::move(r));
+    }
+
+    // 데드라인 초과: 하드웨어 접근 없이 현재 상태로 보고 (프로브는 백그라운드에서 계속)
+    for (size_t i = 0; i < probes.size(); ++i) {
+        if (done[i]) continue;
+        HealthProbeResult r;
+        r.deviceId = probes[i].deviceId;
+        r.deviceType = probes[i].deviceType;
+        r.timedOut = true;
+        r.elapsedMs = elapsedSince(t0);
+        if (probes[i].snapshot) r.info = probes[i].snapshot();
+        logging::Logger::getInstance().warn("Health probe " + r.deviceId + " exceeded deadline ("
+            + std::to_string(deadline.count()) + " ms), reporting current state");
+        if (onResult) onResult(r);
+        results.push_back(std::move(r));
+    }
+    return results;
+}
+
+} // namespace core
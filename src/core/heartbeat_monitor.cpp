@@ -0,0 +1,123 @@
+// src/core/heartbeat_monitor.cpp
+#include "core/heartbeat_monitor.h"
+#include "logging/logger.h"
+
+namespace core {
+
+HeartbeatMonitor::HeartbeatMonitor(DeviceManager& deviceManager)
+    : deviceManager_(deviceManager) {
+}
+
+HeartbeatMonitor::~HeartbeatMonitor() {
+    stop();
+}
+
+void HeartbeatMonitor::start(uint32_t intervalMs) {
+    if (running_ || intervalMs == 0) {
+        if (intervalMs == 0) logging::Logger::getInstance().info("Heartbeat monitor disabled (health.heartbeat_ms=0)");
+        return;
+    }
+    intervalMs_ = intervalMs;
+    running_ = true;
+    thread_ = std::thread(&HeartbeatMonitor::monitorThread, this);
+    logging::Logger::getInstance().info("Heartbeat monitor started (interval " + std::to_string(intervalMs) + " ms)");
+}
+
+void HeartbeatMonitor::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return;
+        running_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+void HeartbeatMonitor::pause() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++pauseCount_;
+    // 이미 진행 중인 heartbeat가 끝나야 호출자가 같은 포트/카메라를 안전하게 사용
+    if (!cv_.wait_for(lock, std::chrono::milliseconds(kPauseWaitMs), [this] { return !beating_; })) {
+        logging::Logger::getInstance().warn("Heartbeat pause: running heartbeat did not finish in "
+            + std::to_string(kPauseWaitMs) + " ms");
+    }
+}
+
+void HeartbeatMonitor::resume() {
+    if (pauseCount_ > 0) --pauseCount_;
+}
+
+long long HeartbeatMonitor::getHeartbeatAgeMs(const std::string& deviceId) const {
+    std::lock_guard<std::mutex> lock(beatMutex_);
+    auto it = lastBeat_.find(deviceId);
+    if (it == lastBeat_.end()) return -1;
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - it->second).count();
+}
+
+bool HeartbeatMonitor::transactionActive() const {
+    for (const auto& id : deviceManager_.getDeviceIds(devices::DeviceType::PAYMENT_TERMINAL)) {
+        if (watchdog_ && watchdog_->isHung(id)) continue;
+        auto t = deviceManager_.getPaymentTerminal(id);
+        if (t && t->getState() == devices::DeviceState::STATE_PROCESSING) return true;
+    }
+    for (const auto& id : deviceManager_.getDeviceIds(devices::DeviceType::CAMERA)) {
+        if (watchdog_ && watchdog_->isHung(id)) continue;
+        auto c = deviceManager_.getCamera(id);
+        if (c && c->getState() == devices::DeviceState::STATE_PROCESSING) return true;
+    }
+    return false;
+}
+
+void HeartbeatMonitor::beat(const std::string& deviceId, const std::function<bool()>& heartbeat) {
+    // 거래가 시작됐으면 남은 장치도 건너뜀 (같은 tick 안에서도 확인)
+    if (transactionActive()) return;
+    if (watchdog_ && watchdog_->isHung(deviceId)) return;  // 복구는 watchdog/재연결 쪽에서
+    {
+        // pause()와 같은 잠금에서 확인·표시 — pause가 반환된 뒤에는 새 heartbeat가 시작되지 않음
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_ || pauseCount_ > 0) return;
+        beating_ = true;
+    }
+    try {
+        heartbeat();
+    } catch (const std::exception& e) {
+        logging::Logger::getInstance().warn("Heartbeat " + deviceId + " threw: " + e.what());
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        beating_ = false;
+    }
+    cv_.notify_all();
+    std::lock_guard<std::mutex> lock(beatMutex_);
+    lastBeat_[deviceId] = std::chrono::steady_clock::now();
+}
+
+void HeartbeatMonitor::monitorThread() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait_for(lock, std::chrono::milliseconds(intervalMs_), [this] { return !running_; });
+            if (!running_) return;
+        }
+        if (pauseCount_ > 0 || transactionActive()) {
+            logging::Logger::getInstance().debug("Heartbeat skipped (transaction active or paused)");
+            continue;
+        }
+
+        for (const auto& id : deviceManager_.getDeviceIds(devices::DeviceType::PAYMENT_TERMINAL)) {
+            auto t = deviceManager_.getPaymentTerminal(id);
+            if (t) beat(id, [&t]() { return t->heartbeat(); });
+        }
+        for (const auto& id : deviceManager_.getDeviceIds(devices::DeviceType::CAMERA)) {
+            auto c = deviceManager_.getCamera(id);
+            if (c) beat(id, [&c]() { return c->heartbeat(); });
+        }
+        // 프린터: getDeviceInfo가 스풀러 상태를 조회 (장치 I/O 없음)
+        for (const auto& id : deviceManager_.getDeviceIds(devices::DeviceType::PRINTER)) {
+            auto p = deviceManager_.getPrinter(id);
+            if (p) beat(id, [&p]() { return p->getDeviceInfo().state == devices::DeviceState::STATE_READY; });
+        }
+    }
+}
+
+} // namespace core
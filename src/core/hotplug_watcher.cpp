@@ -0,0 +1,264 @@
+// src/core/hotplug_watcher.cpp
+#include "logging/logger.h"
+#include "core/hotplug_watcher.h"
+
+#include <algorithm>
+#include <chrono>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <dbt.h>
+#else
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace core {
+
+HotplugWatcher::~HotplugWatcher() {
+    stop();
+}
+
+bool HotplugWatcher::start(PortEnumerator enumerator, ChangeCallback callback) {
+    if (running_) return true;
+    enumerator_ = std::move(enumerator);
+    callback_ = std::move(callback);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ports_ = enumerator_ ? enumerator_() : std::vector<std::string>{};
+        std::sort(ports_.begin(), ports_.end());
+    }
+    ++generation_;
+    running_ = true;
+    ready_ = false;
+#ifndef _WIN32
+    if (pipe(stopPipe_) != 0) {
+        running_ = false;
+        logging::Logger::getInstance().warn("HotplugWatcher: pipe() failed, hotplug disabled");
+        return false;
+    }
+#endif
+    thread_ = std::thread(&HotplugWatcher::watchThread, this);
+    // 알림 창/inotify 준비까지 잠시 대기 (실패 시 running_=false)
+    for (int i = 0; i < 50 && running_ && !ready_; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (!running_) {
+        if (thread_.joinable()) thread_.join();
+        return false;
+    }
+    logging::Logger::getInstance().info("HotplugWatcher started (" + std::to_string(ports_.size()) + " ports)");
+    return true;
+}
+
+void HotplugWatcher::stop() {
+    if (!running_ && !thread_.joinable()) return;
+    running_ = false;
+#ifdef _WIN32
+    if (hwnd_) PostMessageA(static_cast<HWND>(hwnd_), WM_CLOSE, 0, 0);
+#else
+    if (stopPipe_[1] >= 0) {
+        char c = 1;
+        (void)write(stopPipe_[1], &c, 1);
+    }
+#endif
+    if (thread_.joinable()) thread_.join();
+#ifndef _WIN32
+    for (int& fd : stopPipe_) {
+        if (fd >= 0) close(fd);
+        fd = -1;
+    }
+#endif
+}
+
+std::vector<std::string> HotplugWatcher::getPorts() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ports_;
+}
+
+void HotplugWatcher::refresh(bool usbChanged) {
+    std::vector<std::string> current = enumerator_ ? enumerator_() : std::vector<std::string>{};
+    std::sort(current.begin(), current.end());
+
+    Change change;
+    change.usbChanged = usbChanged;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::set_difference(current.begin(), current.end(), ports_.begin(), ports_.end(),
+                            std::back_inserter(change.addedPorts));
+        std::set_difference(ports_.begin(), ports_.end(), current.begin(), current.end(),
+                            std::back_inserter(change.removedPorts));
+        ports_ = current;
+    }
+    if (change.addedPorts.empty() && change.removedPorts.empty() && !change.usbChanged) return;
+    ++generation_;
+
+    std::string msg = "HotplugWatcher: ports +" + std::to_string(change.addedPorts.size())
+        + " -" + std::to_string(change.removedPorts.size()) + (change.usbChanged ? ", usb changed" : "");
+    for (const auto& p : change.addedPorts) msg += " +" + p;
+    for (const auto& p : change.removedPorts) msg += " -" + p;
+    logging::Logger::getInstance().info(msg);
+
+    if (callback_) {
+        try {
+            callback_(change);
+        } catch (const std::exception& e) {
+            logging::Logger::getInstance().error("HotplugWatcher callback failed: " + std::string(e.what()));
+        }
+    }
+}
+
+#ifdef _WIN32
+namespace {
+    constexpr UINT_PTR kDebounceTimerId = 1;
+    const char* kWindowClass = "DeviceControllerHotplugWatcher";
+
+    struct WindowState {
+        UINT debounceMs = 500;
+        bool pendingUsb = false;
+        std::function<void(bool)> refresh;
+    };
+
+    LRESULT CALLBACK hotplugWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
+        auto* st = reinterpret_cast<WindowState*>(GetWindowLongPtrA(hwnd, GWLP_USERDATA));
+        switch (msg) {
+            case WM_DEVICECHANGE:
+                if (st && (wParam == DBT_DEVICEARRIVAL || wParam == DBT_DEVICEREMOVECOMPLETE)) {
+                    auto* hdr = reinterpret_cast<DEV_BROADCAST_HDR*>(lParam);
+                    if (hdr && hdr->dbch_devicetype == DBT_DEVTYP_DEVICEINTERFACE) {
+                        auto* di = reinterpret_cast<DEV_BROADCAST_DEVICEINTERFACE_A*>(lParam);
+                        // GUID_DEVINTERFACE_COMPORT {86E0D1E0-8089-11D0-9CE4-08003E301F73}
+                        static const GUID kComPort = {0x86E0D1E0, 0x8089, 0x11D0, {0x9C, 0xE4, 0x08, 0x00, 0x3E, 0x30, 0x1F, 0x73}};
+                        if (!IsEqualGUID(di->dbcc_classguid, kComPort)) st->pendingUsb = true;
+                    }
+                    // 연속 이벤트(USB 허브 등)를 모아서 한 번만 재열거
+                    SetTimer(hwnd, kDebounceTimerId, st->debounceMs, nullptr);
+                }
+                return TRUE;
+            case WM_TIMER:
+                if (wParam == kDebounceTimerId && st) {
+                    KillTimer(hwnd, kDebounceTimerId);
+                    bool usb = st->pendingUsb;
+                    st->pendingUsb = false;
+                    st->refresh(usb);
+                }
+                return 0;
+            case WM_CLOSE:
+                DestroyWindow(hwnd);
+                return 0;
+            case WM_DESTROY:
+                PostQuitMessage(0);
+                return 0;
+            default:
+                return DefWindowProcA(hwnd, msg, wParam, lParam);
+        }
+    }
+} // namespace
+
+void HotplugWatcher::watchThread() {
+    HINSTANCE inst = GetModuleHandleA(nullptr);
+    WNDCLASSA wc = {};
+    wc.lpfnWndProc = hotplugWndProc;
+    wc.hInstance = inst;
+    wc.lpszClassName = kWindowClass;
+    RegisterClassA(&wc);  // 이미 등록된 경우 실패해도 무방
+
+    HWND hwnd = CreateWindowExA(0, kWindowClass, "", 0, 0, 0, 0, 0, HWND_MESSAGE, nullptr, inst, nullptr);
+    if (!hwnd) {
+        logging::Logger::getInstance().warn("HotplugWatcher: CreateWindowEx failed, hotplug disabled");
+        running_ = false;
+        return;
+    }
+    WindowState state;
+    state.debounceMs = kDebounceMs;
+    state.refresh = [this](bool usb) { refresh(usb); };
+    SetWindowLongPtrA(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(&state));
+
+    // 모든 인터페이스 클래스 알림 (COM 포트 + 카메라 등 USB 장치)
+    DEV_BROADCAST_DEVICEINTERFACE_A filter = {};
+    filter.dbcc_size = sizeof(filter);
+    filter.dbcc_devicetype = DBT_DEVTYP_DEVICEINTERFACE;
+    HDEVNOTIFY notify = RegisterDeviceNotificationA(hwnd, &filter,
+        DEVICE_NOTIFY_WINDOW_HANDLE | DEVICE_NOTIFY_ALL_INTERFACE_CLASSES);
+    if (!notify) {
+        logging::Logger::getInstance().warn("HotplugWatcher: RegisterDeviceNotification failed, hotplug disabled");
+        DestroyWindow(hwnd);
+        running_ = false;
+        return;
+    }
+    hwnd_ = hwnd;
+    ready_ = true;
+
+    MSG msg;
+    while (GetMessageA(&msg, nullptr, 0, 0) > 0) {
+        TranslateMessage(&msg);
+        DispatchMessageA(&msg);
+    }
+
+    UnregisterDeviceNotification(notify);
+    hwnd_ = nullptr;
+}
+#else
+void HotplugWatcher::watchThread() {
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        logging::Logger::getInstance().warn("HotplugWatcher: inotify_init1 failed, hotplug disabled");
+        running_ = false;
+        return;
+    }
+    const uint32_t mask = IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM;
+    inotify_add_watch(fd, "/dev", mask);
+    int byIdWatch = inotify_add_watch(fd, "/dev/serial/by-id", mask);  // USB-serial 없으면 디렉터리 없음
+    ready_ = true;
+
+    bool pending = false;
+    bool pendingUsb = false;
+    auto deadline = std::chrono::steady_clock::now();
+    alignas(struct inotify_event) char buf[4096];
+
+    while (running_) {
+        int timeout = -1;
+        if (pending) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+            timeout = left > 0 ? static_cast<int>(left) : 0;
+        }
+        pollfd fds[2] = {{fd, POLLIN, 0}, {stopPipe_[0], POLLIN, 0}};
+        int rc = poll(fds, 2, timeout);
+        if (!running_ || (rc > 0 && (fds[1].revents & POLLIN))) break;
+        if (rc > 0 && (fds[0].revents & POLLIN)) {
+            ssize_t n;
+            while ((n = read(fd, buf, sizeof(buf))) > 0) {
+                for (char* p = buf; p < buf + n;) {
+                    auto* ev = reinterpret_cast<struct inotify_event*>(p);
+                    if (ev->len > 0) {
+                        const char* name = ev->name;
+                        bool isSerial = std::strncmp(name, "ttyUSB", 6) == 0 || std::strncmp(name, "ttyACM", 6) == 0
+                            || ev->wd == byIdWatch;
+                        bool isUsb = std::strncmp(name, "video", 5) == 0 || std::strncmp(name, "hidraw", 6) == 0;
+                        if (std::strcmp(name, "serial") == 0 && (ev->mask & IN_CREATE) && byIdWatch < 0) {
+                            byIdWatch = inotify_add_watch(fd, "/dev/serial/by-id", mask);
+                        }
+                        // pts 등 무관한 /dev 변화는 무시
+                        if (isSerial || isUsb) pending = true;
+                        if (isUsb) pendingUsb = true;
+                    }
+                    p += sizeof(struct inotify_event) + ev->len;
+                }
+            }
+            deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kDebounceMs);
+            continue;
+        }
+        if (pending && std::chrono::steady_clock::now() >= deadline) {
+            bool usb = pendingUsb;
+            pending = false;
+            pendingUsb = false;
+            refresh(usb);
+        }
+    }
+    close(fd);
+}
+#endif
+
+} // namespace core
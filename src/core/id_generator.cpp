@@ -0,0 +1,85 @@
+// src/core/id_generator.cpp
+#include "core/id_generator.h"
+
+#include <chrono>
+#include <random>
+#include <thread>
+#include <functional>
+#include <cstdint>
+
+namespace core {
+
+namespace {
+    uint64_t splitmix64(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    struct ThreadState {
+        uint64_t rng;
+        uint64_t lastMs = 0;
+        uint32_t counter = 0;   // 12 bits used
+
+        ThreadState() {
+            // random_device는 스레드당 한 번만 (Windows에서 비쌈)
+            std::random_device rd;
+            rng = (static_cast<uint64_t>(rd()) << 32) ^ rd()
+                ^ std::hash<std::thread::id>{}(std::this_thread::get_id());
+        }
+    };
+
+    thread_local ThreadState tls;
+
+    const char kHex[] = "0123456789abcdef";
+
+    void putHex(char*& p, uint64_t value, int digits) {
+        for (int shift = (digits - 1) * 4; shift >= 0; shift -= 4) {
+            *p++ = kHex[(value >> shift) & 0xF];
+        }
+    }
+} // namespace
+
+void IdGenerator::next(char (&out)[kLength + 1]) {
+    ThreadState& st = tls;
+    uint64_t ms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+
+    // 같은 ms(또는 시계가 뒤로 감) → 카운터 증가로 스레드 내 순서 보장, 넘치면 ms를 앞당김
+    if (ms <= st.lastMs) {
+        ms = st.lastMs;
+        if (++st.counter > 0xFFF) {
+            ++ms;
+            st.counter = static_cast<uint32_t>(splitmix64(st.rng) & 0x3FF);
+        }
+    } else {
+        // 새 ms: 카운터를 하위 절반 범위의 난수로 시작 (추측 어렵게 + 증가 여유)
+        st.counter = static_cast<uint32_t>(splitmix64(st.rng) & 0x3FF);
+    }
+    st.lastMs = ms;
+
+    uint64_t rand = splitmix64(st.rng);
+    uint64_t hi = (ms << 16) | (0x7ull << 12) | (st.counter & 0xFFF);
+    uint64_t lo = (0x2ull << 62) | (rand >> 2);
+
+    char* p = out;
+    putHex(p, hi >> 32, 8);
+    *p++ = '-';
+    putHex(p, (hi >> 16) & 0xFFFF, 4);
+    *p++ = '-';
+    putHex(p, hi & 0xFFFF, 4);
+    *p++ = '-';
+    putHex(p, lo >> 48, 4);
+    *p++ = '-';
+    putHex(p, lo & 0xFFFFFFFFFFFFull, 12);
+    *p = '\0';
+}
+
+std::string IdGenerator::next() {
+    char buf[kLength + 1];
+    next(buf);
+    return std::string(buf, kLength);
+}
+
+} // namespace core
@@ -0,0 +1,277 @@
+// src/core/printer_pool.cpp
+#include "logging/logger.h"
+#include "core/printer_pool.h"
+
+namespace core {
+
+namespace {
+    bool isUnusable(devices::DeviceState s) {
+        return s == devices::DeviceState::STATE_ERROR
+            || s == devices::DeviceState::DISCONNECTED
+            || s == devices::DeviceState::HUNG;
+    }
+} // namespace
+
+PrinterPool::PrinterPool(DeviceManager& deviceManager)
+    : deviceManager_(deviceManager) {
+}
+
+PrinterPool::~PrinterPool() {
+    stop();
+}
+
+void PrinterPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return;
+        running_ = false;
+    }
+    condition_.notify_all();
+    for (auto& pair : workers_) {
+        if (pair.second->thread.joinable()) {
+            pair.second->thread.join();
+        }
+    }
+}
+
+PrinterPool::StateMap PrinterPool::queryStates(CallWatchdog* watchdog, const std::set<std::string>& exclude) const {
+    StateMap states;
+    for (const auto& id : deviceManager_.getDeviceIds(devices::DeviceType::PRINTER)) {
+        if (exclude.count(id)) continue;
+        if (watchdog && watchdog->isHung(id)) {
+            states[id] = devices::DeviceState::HUNG;
+            continue;
+        }
+        auto printer = deviceManager_.getPrinter(id);
+        if (printer) states[id] = printer->getState();
+    }
+    return states;
+}
+
+std::string PrinterPool::pickFromLocked(const StateMap& states, const std::set<std::string>& exclude) const {
+    // READY 중 최소 큐 → 없으면 사용 불가가 아닌 장치 중 최소 큐 (동률이면 deviceId 순 — StateMap/DeviceManager 모두 id로 정렬)
+    std::string best;
+    size_t bestDepth = 0;
+    for (int pass = 0; pass < 2 && best.empty(); ++pass) {
+        for (const auto& pair : states) {
+            if (exclude.count(pair.first)) continue;
+            bool eligible = (pass == 0) ? (pair.second == devices::DeviceState::STATE_READY)
+                                        : !isUnusable(pair.second);
+            if (!eligible) continue;
+            size_t depth = 0;
+            auto it = workers_.find(pair.first);
+            if (it != workers_.end()) {
+                depth = it->second->queue.size() + (it->second->active ? 1 : 0);
+            }
+            if (best.empty() || depth < bestDepth) {
+                best = pair.first;
+                bestDepth = depth;
+            }
+        }
+    }
+    return best;
+}
+
+std::string PrinterPool::pickPrinter(std::unique_lock<std::mutex>& lock, const std::set<std::string>& exclude) {
+    // getState()는 장치 접근(CreateDC 등)이 있으므로 잠금 밖에서 조회
+    CallWatchdog* watchdog = watchdog_;
+    lock.unlock();
+    StateMap states = queryStates(watchdog, exclude);
+    lock.lock();
+    return pickFromLocked(states, exclude);
+}
+
+void PrinterPool::enqueueLocked(const std::string& deviceId, PrintJob job) {
+    auto& worker = workers_[deviceId];
+    if (!worker) {
+        worker = std::make_unique<Worker>();
+        worker->deviceId = deviceId;
+        worker->thread = std::thread(&PrinterPool::workerLoop, this, deviceId);
+    }
+    worker->queue.push_back(std::move(job));
+    condition_.notify_all();
+}
+
+std::string PrinterPool::submit(PrintJob job, const std::string& preferredDeviceId, std::string& error) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!running_) {
+        error = "Printer pool stopped";
+        return "";
+    }
+
+    std::string target;
+    if (!preferredDeviceId.empty()) {
+        if (!deviceManager_.getPrinter(preferredDeviceId)) {
+            error = "Printer not found: " + preferredDeviceId;
+            return "";
+        }
+        job.pinned = true;
+        target = preferredDeviceId;
+    } else {
+        target = pickPrinter(lock, job.triedDevices);
+        if (target.empty()) {
+            // 모두 ERROR/DISCONNECTED여도 작업은 deviceId 순 첫 프린터로 시도 (결과는 printer_job_complete로 전달)
+            auto ids = deviceManager_.getDeviceIds(devices::DeviceType::PRINTER);
+            if (ids.empty()) {
+                error = "No printer registered";
+                return "";
+            }
+            target = ids.front();
+        }
+    }
+
+    logging::Logger::getInstance().info("PrinterPool: job " + job.jobId + " -> " + target
+        + (job.pinned ? " (requested)" : ""));
+    enqueueLocked(target, std::move(job));
+    return target;
+}
+
+bool PrinterPool::handleJobComplete(const std::string& deviceId, const devices::PrintJobCompleteEvent& event) {
+    if (event.success) return false;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!running_) return false;
+    auto it = workers_.find(deviceId);
+    if (it == workers_.end() || !it->second->active) return false;
+    auto active = it->second->active;
+    if (active->jobId != event.jobId || active->pinned) return false;
+
+    PrintJob job = *active;
+    job.triedDevices.insert(deviceId);
+    std::string target = pickPrinter(lock, job.triedDevices);
+    if (target.empty()) return false;
+
+    logging::Logger::getInstance().warn("PrinterPool: job " + job.jobId + " failed on " + deviceId
+        + " (" + event.errorMessage + "), failing over to " + target);
+    enqueueLocked(target, std::move(job));
+    return true;
+}
+
+void PrinterPool::setJobFailedCallback(std::function<void(const devices::PrintJobCompleteEvent&)> callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobFailedCallback_ = std::move(callback);
+}
+
+void PrinterPool::reportJobFailed(const std::string& jobId, const std::string& error, devices::DeviceState state) {
+    std::function<void(const devices::PrintJobCompleteEvent&)> callback;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callback = jobFailedCallback_;
+    }
+    if (!callback) return;
+    devices::PrintJobCompleteEvent event;
+    event.jobId = jobId;
+    event.success = false;
+    event.errorMessage = error;
+    event.state = state;
+    callback(event);
+}
+
+void PrinterPool::setWatchdog(CallWatchdog* watchdog, std::chrono::milliseconds printTimeout) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    watchdog_ = watchdog;
+    printTimeout_ = printTimeout;
+}
+
+void PrinterPool::handleStateChanged(const std::string& deviceId, devices::DeviceState state) {
+    if (!isUnusable(state)) return;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto hasMovable = [&]() {
+        auto it = workers_.find(deviceId);
+        if (it == workers_.end()) return false;
+        for (const auto& job : it->second->queue) {
+            if (!job.pinned) return true;
+        }
+        return false;
+    };
+    if (!running_ || !hasMovable()) return;
+
+    // 옮길 작업 전체에 대해 프린터 상태는 한 번만 조회 (잠금 밖)
+    CallWatchdog* watchdog = watchdog_;
+    lock.unlock();
+    StateMap states = queryStates(watchdog, {deviceId});
+    lock.lock();
+    if (!running_) return;
+
+    auto& queue = workers_[deviceId]->queue;
+    std::deque<PrintJob> keep;
+    std::deque<PrintJob> moved;
+    for (auto& job : queue) {
+        if (job.pinned) keep.push_back(std::move(job));
+        else moved.push_back(std::move(job));
+    }
+    queue.swap(keep);
+
+    for (auto& job : moved) {
+        job.triedDevices.insert(deviceId);
+        std::string target = pickFromLocked(states, job.triedDevices);
+        if (target.empty()) target = deviceId;  // 대체 프린터 없음 → 원래 큐 유지
+        logging::Logger::getInstance().warn("PrinterPool: " + deviceId + " in " + devices::deviceStateToString(state)
+            + ", job " + job.jobId + " -> " + target);
+        enqueueLocked(target, std::move(job));
+    }
+}
+
+size_t PrinterPool::getQueueDepth(const std::string& deviceId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = workers_.find(deviceId);
+    if (it == workers_.end()) return 0;
+    return it->second->queue.size() + (it->second->active ? 1 : 0);
+}
+
+void PrinterPool::workerLoop(const std::string& deviceId) {
+    while (true) {
+        std::shared_ptr<PrintJob> job;
+        CallWatchdog* watchdog = nullptr;
+        std::chrono::milliseconds printTimeout{0};
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            Worker* worker = workers_[deviceId].get();
+            condition_.wait(lock, [&]() { return !running_ || !worker->queue.empty(); });
+            if (!running_) return;
+            job = std::make_shared<PrintJob>(std::move(worker->queue.front()));
+            worker->queue.pop_front();
+            worker->active = job;
+            watchdog = watchdog_;
+            printTimeout = printTimeout_;
+        }
+
+        auto printer = deviceManager_.getPrinter(deviceId);
+        bool rerouted = false;
+        bool hung = watchdog && watchdog->isHung(deviceId);
+        if (!job->pinned && (!printer || hung || isUnusable(printer->getState()))) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            job->triedDevices.insert(deviceId);
+            std::string target = pickPrinter(lock, job->triedDevices);
+            if (!target.empty() && running_) {
+                logging::Logger::getInstance().warn("PrinterPool: " + deviceId + (printer ? " not usable" : " no longer registered")
+                    + ", job " + job->jobId + " -> " + target);
+                enqueueLocked(target, *job);
+                rerouted = true;
+            }
+        }
+
+        if (!printer && !rerouted) {
+            logging::Logger::getInstance().error("PrinterPool: printer " + deviceId + " no longer registered, job " + job->jobId + " failed");
+            reportJobFailed(job->jobId, "Printer not registered: " + deviceId, devices::DeviceState::DISCONNECTED);
+        } else if (!rerouted) {
+            CallWatchdog::Scope guard(watchdog, deviceId, devices::DeviceType::PRINTER, "print", printTimeout);
+            try {
+                if (!job->filePath.empty()) {
+                    printer->printFromFile(job->jobId, job->filePath, job->orientation);
+                } else {
+                    printer->print(job->jobId, job->data);
+                }
+            } catch (const std::exception& e) {
+                logging::Logger::getInstance().error("PrinterPool: print on " + deviceId + " threw: " + std::string(e.what()));
+                reportJobFailed(job->jobId, "Print failed: " + std::string(e.what()), devices::DeviceState::STATE_ERROR);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        workers_[deviceId]->active.reset();
+    }
+}
+
+} // namespace core
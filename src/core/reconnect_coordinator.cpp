@@ -0,0 +1,125 @@
+// src/core/reconnect_coordinator.cpp
+#include "core/reconnect_coordinator.h"
+#include "logging/logger.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace core {
+
+ReconnectCoordinator::~ReconnectCoordinator() {
+    waitIdle();
+}
+
+void ReconnectCoordinator::setBackoff(std::chrono::milliseconds base, std::chrono::milliseconds max) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    base_ = base;
+    max_ = (std::max)(base, max);
+}
+
+bool ReconnectCoordinator::acquire(Slot& slot, bool force, std::unique_lock<std::mutex>& lock, Outcome& joinedOutcome) {
+    if (slot.inFlight) {
+        // 진행 중인 재연결에 합류 — 결과를 공유
+        ++slot.stats.joined;
+        uint64_t gen = slot.generation;
+        cv_.wait(lock, [&] { return slot.generation != gen; });
+        joinedOutcome = slot.lastResult ? Outcome::SUCCEEDED : Outcome::FAILED;
+        return false;
+    }
+    if (!force && std::chrono::steady_clock::now() < slot.nextAllowed) {
+        ++slot.stats.skippedBackoff;
+        joinedOutcome = Outcome::BACKOFF;
+        return false;
+    }
+    slot.inFlight = true;
+    ++slot.stats.attempts;
+    return true;
+}
+
+void ReconnectCoordinator::release(Slot& slot, bool ok) {
+    slot.inFlight = false;
+    slot.lastResult = ok;
+    ++slot.generation;
+    if (ok) {
+        ++slot.stats.successes;
+        slot.stats.consecutiveFailures = 0;
+        slot.nextAllowed = {};
+    } else {
+        ++slot.stats.failures;
+        ++slot.stats.consecutiveFailures;
+        uint32_t shift = (std::min)(slot.stats.consecutiveFailures - 1, 16u);
+        long long delay = (std::min)(static_cast<long long>(base_.count()) << shift, static_cast<long long>(max_.count()));
+        std::uniform_int_distribution<long long> jitter(delay / 2, delay);
+        slot.nextAllowed = std::chrono::steady_clock::now() + std::chrono::milliseconds(jitter(rng_));
+    }
+    cv_.notify_all();
+}
+
+ReconnectCoordinator::Outcome ReconnectCoordinator::run(const std::string& deviceId,
+                                                        const std::function<bool()>& attempt, bool force) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Slot& slot = slots_[deviceId];
+    Outcome outcome = Outcome::FAILED;
+    if (!acquire(slot, force, lock, outcome)) {
+        if (outcome == Outcome::BACKOFF) {
+            logging::Logger::getInstance().debug("Reconnect " + deviceId + " skipped (backoff)");
+        }
+        return outcome;
+    }
+    lock.unlock();
+
+    bool ok = false;
+    try {
+        ok = attempt();
+    } catch (const std::exception& e) {
+        logging::Logger::getInstance().error("Reconnect " + deviceId + " failed: " + std::string(e.what()));
+    }
+
+    lock.lock();
+    release(slot, ok);
+    if (!ok) {
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(slot.nextAllowed - std::chrono::steady_clock::now()).count();
+        logging::Logger::getInstance().info("Reconnect " + deviceId + " failed (" + std::to_string(slot.stats.consecutiveFailures)
+            + " in a row), next automatic attempt in " + std::to_string(wait) + " ms");
+    }
+    return ok ? Outcome::SUCCEEDED : Outcome::FAILED;
+}
+
+bool ReconnectCoordinator::runAsync(const std::string& deviceId, std::function<bool()> attempt) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Slot& slot = slots_[deviceId];
+        if (slot.inFlight) return false;
+        if (std::chrono::steady_clock::now() < slot.nextAllowed) {
+            ++slot.stats.skippedBackoff;
+            return false;
+        }
+        ++asyncRunning_;
+    }
+    std::thread([this, deviceId, attempt = std::move(attempt)]() {
+        run(deviceId, attempt);
+        std::lock_guard<std::mutex> lock(mutex_);
+        --asyncRunning_;
+        cv_.notify_all();
+    }).detach();
+    return true;
+}
+
+ReconnectCoordinator::Stats ReconnectCoordinator::getStats(const std::string& deviceId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = slots_.find(deviceId);
+    if (it == slots_.end()) return {};
+    Stats s = it->second.stats;
+    s.inFlight = it->second.inFlight;
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        it->second.nextAllowed - std::chrono::steady_clock::now()).count();
+    s.backoffRemainingMs = remaining > 0 ? remaining : 0;
+    return s;
+}
+
+void ReconnectCoordinator::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return asyncRunning_ == 0; });
+}
+
+} // namespace core
@@ -33,14 +33,15 @@
 #include "vendor_adapters/windows/windows_gdi_printer_adapter.h"
 #include "vendor_adapters/lv77/lv77_bill_adapter.h"
 
+#include <algorithm>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
-#include <random>
 #include <thread>
 #include <iomanip>
-#include <thread>
+#include <iterator>
 #include <map>
+#include <set>
 #include <vector>
 
 // Undef Windows macros again after includes (edsdk, serial_port, etc. may pull winerror.h)
@@ -64,6 +65,9 @@ namespace core {
 ServiceCore::ServiceCore()
     : ipcServer_(deviceManager_)
     , running_(false)
+    , printerPool_(deviceManager_)
+    , heartbeatMonitor_(deviceManager_)
+    , eventCoalescer_([this](const ipc::Event& event) { ipcServer_.broadcastEvent(event); })
     , taskQueueRunning_(false)
     , cashTestMode_(false)
     , cashTestTotal_(0) {
@@ -79,6 +83,17 @@ bool ServiceCore::start() {
     
     // Start task worker thread (for reset/device check only)
     startTaskWorker();
+
+    // 상태 이벤트 병합 창 (재연결/포트 스캔 중 CONNECTING/ERROR/READY 폭주 → 장치별 최신 상태만)
+    for (const auto& entry : config::ConfigManager::getInstance().getEventCoalesceWindowsMs()) {
+        ipc::EventType type = ipc::stringToEventType(entry.first);
+        if (ipc::eventTypeToString(type) != entry.first) {
+            logging::Logger::getInstance().warn("Unknown event type in events.coalesce_ms." + entry.first);
+            continue;
+        }
+        eventCoalescer_.setWindow(type, std::chrono::milliseconds((std::max)(entry.second, 0)));
+    }
+    eventCoalescer_.start();
     
     // No automatic system status check on connect; client requests get_state_snapshot or detect_hardware when needed (avoids duplicate probe + 0-client broadcasts).
 
@@ -95,13 +110,39 @@ bool ServiceCore::start() {
         return false;
     }
 
+    // Hotplug watcher: COM 포트 추가/제거 시 해당 포트만 재탐지 (전체 스캔 없음)
+    if (!hotplugWatcher_.start([]() { return smartro::SerialPort::getAvailablePorts(true); },
+                               [this](const HotplugWatcher::Change& change) { handleHotplugChange(change); })) {
+        logging::Logger::getInstance().warn("Hotplug watcher not available, falling back to on-demand port enumeration");
+    }
+
+    // Heartbeat: 유휴 시 주기적으로 가벼운 생존 확인 → 상태 조회는 하드웨어 접근 없이 캐시만 사용
+    int heartbeatMs = config::ConfigManager::getInstance().getHeartbeatIntervalMs();
+    heartbeatMonitor_.start(heartbeatMs > 0 ? static_cast<uint32_t>(heartbeatMs) : 0);
+
+    // Hung-call watchdog: 기한을 넘긴 장치 호출 → HUNG 발행 + 별도 스레드에서 복구
+    callWatchdog_.start([this](const CallWatchdog::HangInfo& hang) { handleDeviceHang(hang); },
+                        [this](const CallWatchdog::HangInfo& hang) { handleDeviceRecovered(hang); });
+    printerPool_.setWatchdog(&callWatchdog_, std::chrono::milliseconds(kPrintTimeoutMs));
+    printerPool_.setJobFailedCallback([this](const devices::PrintJobCompleteEvent& event) {
+        publishPrinterJobCompleteEvent(event);
+    });
+    heartbeatMonitor_.setWatchdog(&callWatchdog_);
+
     running_ = true;
     logging::Logger::getInstance().info("Service Core started successfully");
     return true;
 }
 
 void ServiceCore::stop() {
+    heartbeatMonitor_.stop();
+    healthProbes_.waitIdle();  // 데드라인을 넘겨 아직 도는 프로브 (카메라 재초기화, 포트 스캔 등)
+    reconnectCoordinator_.waitIdle();
+    hotplugWatcher_.stop();
     stopTaskWorker();
+    printerPool_.stop();
+    callWatchdog_.stop();
+    eventCoalescer_.stop();
     ipcServer_.stop();
     running_ = false;
     logging::Logger::getInstance().info("Service Core stopped");
@@ -118,6 +159,11 @@ void ServiceCore::registerCommandHandlers() {
         return handleGetDeviceList(cmd);
     });
 
+    // Device state-transition history (diagnostics)
+    ipcServer_.registerHandler(ipc::CommandType::GET_DEVICE_HISTORY, [this](const ipc::Command& cmd) {
+        return handleGetDeviceHistory(cmd);
+    });
+
     // Config (admin)
     ipcServer_.registerHandler(ipc::CommandType::GET_CONFIG, [this](const ipc::Command& cmd) {
         return handleGetConfig(cmd);
@@ -201,10 +247,22 @@ void ServiceCore::registerCommandHandlers() {
     ipcServer_.registerHandler(ipc::CommandType::DETECT_HARDWARE, [this](const ipc::Command& cmd) {
         auto it = cmd.payload.find("probe");
         bool doProbe = (it == cmd.payload.end() || it->second != "false");
+        std::vector<HealthProbeResult> probeResults;
+        // 명시적 프로브 중에는 heartbeat가 같은 포트/카메라에 접근하지 않도록 일시정지 (예외가 나도 재개)
+        heartbeatMonitor_.pause();
+        struct ResumeOnExit {
+            HeartbeatMonitor& monitor;
+            ~ResumeOnExit() { monitor.resume(); }
+        } resumeOnExit{heartbeatMonitor_};
         if (doProbe) {
-            tryReconnectDevicesBeforeDetect(cmd.payload);
+            probeResults = tryReconnectDevicesBeforeDetect(cmd.payload, cmd.commandId);
         }
-        return handleDetectHardware(cmd);
+        auto resp = handleDetectHardware(cmd);
+        for (const auto& r : probeResults) {
+            resp.responseMap["probe." + r.deviceId + ".elapsedMs"] = std::to_string(r.elapsedMs);
+            resp.responseMap["probe." + r.deviceId + ".timedOut"] = r.timedOut ? "true" : "false";
+        }
+        return resp;
     });
     ipcServer_.registerHandler(ipc::CommandType::GET_AVAILABLE_PRINTERS, [this](const ipc::Command& cmd) {
         return handleGetAvailablePrinters(cmd);
@@ -226,31 +284,129 @@ ipc::Response ServiceCore::handleGetStateSnapshot(const ipc::Command& cmd) {
     resp.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
 
+    // sinceVersion: 해당 버전 이후 변경된 장치만 반환 (생략/0이면 전체)
+    // 항상 즉시 응답 — 파이프는 명령을 하나씩 처리하므로 여기서 대기하면 취소 등 다른 명령이 막힘.
+    // 변경 알림은 DEVICE_STATE_CHANGED 이벤트로 받고 sinceVersion으로 다시 조회
+    uint64_t sinceVersion = 0;
+    try {
+        auto it = cmd.payload.find("sinceVersion");
+        if (it != cmd.payload.end() && !it->second.empty())
+            sinceVersion = std::stoull(it->second);
+    } catch (const std::exception&) {
+        resp.status = ipc::ResponseStatus::REJECTED;
+        auto error = std::make_shared<ipc::Error>();
+        error->code = "INVALID_PARAMETER";
+        error->message = "sinceVersion must be a non-negative integer";
+        resp.error = error;
+        return resp;
+    }
+
     // Collect all device information (fast; no probe)
-    auto devices = deviceManager_.getAllDeviceInfo();
+    auto devices = collectDeviceInfo();
+    uint64_t version = stateTracker_.update(devices);
+
+    // 다른 서비스 실행의 버전이면(epoch 불일치, 또는 클라이언트 버전이 더 큼) 전체 스냅샷으로 재동기화
+    std::string epoch = std::to_string(stateTracker_.epoch());
+    auto epochIt = cmd.payload.find("epoch");
+    bool otherRun = epochIt != cmd.payload.end() && !epochIt->second.empty() && epochIt->second != epoch;
+    bool full = (sinceVersion == 0 || sinceVersion > version || otherRun);
+    if (full) sinceVersion = 0;
 
     bool anyNotReady = false;
     for (const auto& device : devices) {
         if (device.state != devices::DeviceState::STATE_READY) {
             anyNotReady = true;
         }
+    }
+
+    auto changed = stateTracker_.changedSince(sinceVersion);
+    // 아래 장치별 부가 정보(큐 깊이, heartbeat 경과, 회로 등)도 변경된 장치만 — 델타 응답을 작게 유지
+    std::set<std::string> changedIds;
+    for (const auto& entry : changed) changedIds.insert(entry.info.deviceId);
+
+    for (const auto& entry : changed) {
+        const auto& device = entry.info;
         resp.responseMap[device.deviceId + ".deviceType"] = devices::deviceTypeToString(device.deviceType);
         resp.responseMap[device.deviceId + ".deviceName"] = device.deviceName;
         resp.responseMap[device.deviceId + ".state"] = std::to_string(static_cast<int>(device.state));
         resp.responseMap[device.deviceId + ".stateString"] = devices::deviceStateToString(device.state);
         resp.responseMap[device.deviceId + ".lastError"] = device.lastError;
+        resp.responseMap[device.deviceId + ".version"] = std::to_string(entry.version);
+    }
+    // 프린터 큐 깊이
+    for (const auto& id : deviceManager_.getDeviceIds(devices::DeviceType::PRINTER)) {
+        if (!changedIds.count(id)) continue;
+        resp.responseMap[id + ".queueDepth"] = std::to_string(printerPool_.getQueueDepth(id));
+    }
+    // 마지막 heartbeat 이후 경과 시간 (상태가 얼마나 최신인지)
+    for (const auto& device : devices) {
+        if (!changedIds.count(device.deviceId)) continue;
+        long long age = heartbeatMonitor_.getHeartbeatAgeMs(device.deviceId);
+        if (age >= 0) resp.responseMap[device.deviceId + ".heartbeatAgeMs"] = std::to_string(age);
+    }
+    resp.responseMap["version"] = std::to_string(stateTracker_.currentVersion());
+    resp.responseMap["epoch"] = epoch;
+    resp.responseMap["full"] = full ? "true" : "false";
+
+    // watchdog가 감지한 멈춤 횟수 (한 번이라도 멈춘 장치만)
+    for (const auto& device : devices) {
+        if (!changedIds.count(device.deviceId)) continue;
+        uint64_t hangs = callWatchdog_.getHangCount(device.deviceId);
+        if (hangs > 0) resp.responseMap[device.deviceId + ".hangCount"] = std::to_string(hangs);
+    }
+
+    // 시리얼 결제 장치 회로 상태 (open이면 UI는 응답을 기다리지 않고 부재로 표시)
+    for (const auto& id : deviceManager_.getDeviceIds(devices::DeviceType::PAYMENT_TERMINAL)) {
+        if (!changedIds.count(id)) continue;
+        auto terminal = deviceManager_.getPaymentTerminal(id);
+        auto* breaker = terminal ? terminal->getCircuitBreaker() : nullptr;
+        if (!breaker) continue;
+        auto stats = breaker->getStats();
+        resp.responseMap[id + ".circuit"] = devices::CircuitBreaker::stateToString(stats.state);
+        resp.responseMap[id + ".circuitTrips"] = std::to_string(stats.trips);
+        if (stats.state == devices::CircuitBreaker::State::OPEN) {
+            resp.responseMap[id + ".circuitRetryMs"] = std::to_string(stats.retryInMs);
+        }
     }
 
-    // READY가 아닌 장치가 있으면 백그라운드에서 재연결 시도 (응답은 즉시 반환)
+    // 병합된 상태 이벤트 수 (창 안에서 더 새로운 상태로 대체된 것) — 전체 스냅샷에만
+    if (full) {
+        auto eventStats = eventCoalescer_.getStats();
+        resp.responseMap["events.published"] = std::to_string(eventStats.published);
+        resp.responseMap["events.emitted"] = std::to_string(eventStats.emitted);
+        resp.responseMap["events.coalesced"] = std::to_string(eventStats.coalesced);
+        for (const auto& entry : eventCoalescer_.getCoalescedByType()) {
+            resp.responseMap["events.coalesced." + entry.first] = std::to_string(entry.second);
+        }
+    }
+
+    // 재연결 시도 횟수/백오프 (시도한 적 있는 장치만)
+    for (const auto& device : devices) {
+        if (!changedIds.count(device.deviceId)) continue;
+        auto stats = reconnectCoordinator_.getStats(device.deviceId);
+        if (stats.attempts == 0 && stats.skippedBackoff == 0) continue;
+        resp.responseMap[device.deviceId + ".reconnectAttempts"] = std::to_string(stats.attempts);
+        resp.responseMap[device.deviceId + ".reconnectFailures"] = std::to_string(stats.consecutiveFailures);
+        resp.responseMap[device.deviceId + ".reconnectBackoffMs"] = std::to_string(stats.backoffRemainingMs);
+    }
+
+    // 끊긴/오류 장치는 백그라운드에서 재연결 (장치당 하나만, 실패 시 지수 백오프; 응답은 즉시 반환)
     if (anyNotReady) {
-        std::thread([this]() {
-            try {
-                logging::Logger::getInstance().info("State snapshot had non-READY device(s), starting background reconnect");
-                tryReconnectDevicesBeforeDetect();
-            } catch (const std::exception& e) {
-                logging::Logger::getInstance().error("Background reconnect failed: " + std::string(e.what()));
+        for (const auto& device : devices) {
+            if (device.state != devices::DeviceState::DISCONNECTED && device.state != devices::DeviceState::STATE_ERROR
+                && device.state != devices::DeviceState::HUNG) continue;
+            if (device.deviceType == devices::DeviceType::CAMERA) {
+                auto camera = deviceManager_.getCamera(device.deviceId);
+                if (camera) {
+                    reconnectCoordinator_.runAsync(device.deviceId, [this, camera]() { return reconnectCamera(camera); });
+                }
+            } else if (device.deviceId == kCardTerminalId) {
+                auto terminal = deviceManager_.getPaymentTerminal(device.deviceId);
+                if (terminal) {
+                    reconnectCoordinator_.runAsync(device.deviceId, [terminal]() { return terminal->checkDevice(); });
+                }
             }
-        }).detach();
+        }
     }
 
     return resp;
@@ -297,6 +453,94 @@ ipc::Response ServiceCore::handleGetDeviceList(const ipc::Command& cmd) {
     return resp;
 }
 
+ipc::Response ServiceCore::handleGetDeviceHistory(const ipc::Command& cmd) {
+    ipc::Response resp;
+    resp.protocolVersion = cmd.protocolVersion;
+    resp.kind = ipc::MessageKind::RESPONSE;
+    resp.commandId = cmd.commandId;
+    resp.status = ipc::ResponseStatus::OK;
+    resp.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::string requestedId;
+    auto it = cmd.payload.find("deviceId");
+    if (it != cmd.payload.end()) requestedId = it->second;
+    size_t limit = devices::StateHistory::kCapacity;
+    it = cmd.payload.find("limit");
+    if (it != cmd.payload.end() && !it->second.empty()) {
+        try {
+            limit = static_cast<size_t>((std::max)(1L, std::stol(it->second)));
+        } catch (...) {}
+    }
+
+    // 기록은 어댑터가 갖고 있지만 상태 잠금과 무관 — 멈춘(HUNG) 장치도 바로 조회됨
+    // watchdog의 HUNG/복구 전이는 hangHistory_에 따로 있으므로 시간순으로 합침
+    std::string ids;
+    auto emit = [&](const std::string& id, const devices::StateHistory* history) {
+        if (!requestedId.empty() && id != requestedId) return;
+        std::vector<devices::StateHistory::Entry> entries;
+        uint64_t total = 0;
+        if (history) {
+            entries = history->getEntries(limit);
+            total = history->getTotal();
+        }
+        {
+            std::lock_guard<std::mutex> lock(hangHistoryMutex_);
+            auto hang = hangHistory_.find(id);
+            if (hang != hangHistory_.end()) {
+                auto hangEntries = hang->second.getEntries(limit);
+                std::vector<devices::StateHistory::Entry> merged;
+                merged.reserve(entries.size() + hangEntries.size());
+                std::merge(entries.begin(), entries.end(), hangEntries.begin(), hangEntries.end(),
+                           std::back_inserter(merged),
+                           [](const devices::StateHistory::Entry& a, const devices::StateHistory::Entry& b) {
+                               return a.timestampMs < b.timestampMs;
+                           });
+                if (merged.size() > limit) merged.erase(merged.begin(), merged.end() - static_cast<std::ptrdiff_t>(limit));
+                entries.swap(merged);
+                total += hang->second.getTotal();
+            } else if (!history) {
+                return;
+            }
+        }
+        resp.responseMap[id + ".transitions"] = std::to_string(total);
+        resp.responseMap[id + ".count"] = std::to_string(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const auto& e = entries[i];
+            std::string prefix = id + "." + std::to_string(i);
+            resp.responseMap[prefix + ".timestampMs"] = std::to_string(e.timestampMs);
+            resp.responseMap[prefix + ".from"] = devices::deviceStateToString(e.from);
+            resp.responseMap[prefix + ".to"] = devices::deviceStateToString(e.to);
+            resp.responseMap[prefix + ".error"] = devices::stateErrorCodeToString(e.error);
+        }
+        if (!ids.empty()) ids += ",";
+        ids += id;
+    };
+    for (const auto& id : deviceManager_.getDeviceIds(devices::DeviceType::PAYMENT_TERMINAL)) {
+        auto terminal = deviceManager_.getPaymentTerminal(id);
+        if (terminal) emit(id, terminal->getStateHistory());
+    }
+    for (const auto& id : deviceManager_.getDeviceIds(devices::DeviceType::CAMERA)) {
+        auto camera = deviceManager_.getCamera(id);
+        if (camera) emit(id, camera->getStateHistory());
+    }
+    for (const auto& id : deviceManager_.getDeviceIds(devices::DeviceType::PRINTER)) {
+        auto printer = deviceManager_.getPrinter(id);
+        if (printer) emit(id, printer->getStateHistory());
+    }
+
+    if (!requestedId.empty() && ids.empty()) {
+        resp.status = ipc::ResponseStatus::REJECTED;
+        auto error = std::make_shared<ipc::Error>();
+        error->code = "DEVICE_NOT_FOUND";
+        error->message = "No state history for device: " + requestedId;
+        resp.error = error;
+        return resp;
+    }
+    resp.responseMap["devices"] = ids;
+    return resp;
+}
+
 ipc::Response ServiceCore::handleGetConfig(const ipc::Command& cmd) {
     ipc::Response resp;
     resp.protocolVersion = cmd.protocolVersion;
@@ -348,7 +592,13 @@ ipc::Response ServiceCore::handleCashTestStart(const ipc::Command& cmd) {
     }
     cashTestMode_ = true;
     cashTestTotal_ = 0;
-    if (cashTerminal->startPayment(0)) {
+    auto started = std::make_shared<bool>(false);
+    if (!guardedDeviceCall(kCashDeviceId, devices::DeviceType::PAYMENT_TERMINAL, "cash_test_start", kDeviceCallTimeoutMs,
+                           [cashTerminal, started]() { *started = cashTerminal->startPayment(0); }, resp)) {
+        cashTestMode_ = false;
+        return resp;
+    }
+    if (*started) {
         resp.status = ipc::ResponseStatus::OK;
         auto info = cashTerminal->getDeviceInfo();
         resp.responseMap["deviceId"] = info.deviceId;
@@ -391,7 +641,12 @@ ipc::Response ServiceCore::handleCashPaymentStart(const ipc::Command& cmd) {
         return resp;
     }
     uint32_t amount = std::stoul(it->second);
-    if (cashTerminal->startPayment(amount)) {
+    auto started = std::make_shared<bool>(false);
+    if (!guardedDeviceCall(kCashDeviceId, devices::DeviceType::PAYMENT_TERMINAL, "cash_payment_start", kDeviceCallTimeoutMs,
+                           [cashTerminal, amount, started]() { *started = cashTerminal->startPayment(amount); }, resp)) {
+        return resp;
+    }
+    if (*started) {
         resp.status = ipc::ResponseStatus::OK;
         auto info = cashTerminal->getDeviceInfo();
         resp.responseMap["deviceId"] = info.deviceId;
@@ -484,8 +739,7 @@ ipc::Response ServiceCore::handlePrinterPrint(const ipc::Command& cmd) {
     resp.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
 
-    auto printer = deviceManager_.getDefaultPrinter();
-    if (!printer) {
+    if (deviceManager_.getDeviceIds(devices::DeviceType::PRINTER).empty()) {
         resp.status = ipc::ResponseStatus::REJECTED;
         auto err = std::make_shared<ipc::Error>();
         err->code = "DEVICE_NOT_FOUND";
@@ -502,32 +756,27 @@ ipc::Response ServiceCore::handlePrinterPrint(const ipc::Command& cmd) {
         resp.error = err;
         return resp;
     }
-    const std::string jobId = itJob->second;
+    // deviceId (optional): 특정 프린터 지정. 생략 시 READY 중 큐가 가장 짧은 프린터로 분배
+    std::string requestedDeviceId;
+    auto itDevice = cmd.payload.find("deviceId");
+    if (itDevice != cmd.payload.end()) requestedDeviceId = itDevice->second;
+
+    PrintJob job;
+    job.jobId = itJob->second;
     auto itPath = cmd.payload.find("filePath");
+    auto itData = cmd.payload.find("data");
     if (itPath != cmd.payload.end() && !itPath->second.empty()) {
         // filePath: print from file in background (Bitmap::FromFile; no stream/corrupt JPEG)
-        std::string path = itPath->second;
-        std::string orientation = "portrait";
+        job.filePath = itPath->second;
         auto itOri = cmd.payload.find("orientation");
         if (itOri != cmd.payload.end() && (itOri->second == "portrait" || itOri->second == "landscape"))
-            orientation = itOri->second;
-        logging::Logger::getInstance().info("printer_print: file path=" + path + " orientation=" + orientation + " (print in background)");
-        bool pathExists = std::filesystem::exists(std::filesystem::path(path));
+            job.orientation = itOri->second;
+        logging::Logger::getInstance().info("printer_print: file path=" + job.filePath + " orientation=" + job.orientation + " (print in background)");
+        bool pathExists = std::filesystem::exists(std::filesystem::path(job.filePath));
         logging::Logger::getInstance().info("printer_print: file exists=" + std::string(pathExists ? "yes" : "no"));
-        resp.status = ipc::ResponseStatus::OK;
-        resp.responseMap["jobId"] = jobId;
-        resp.responseMap["deviceId"] = printer->getDeviceInfo().deviceId;
-        std::shared_ptr<devices::IPrinter> pr = printer;
-        std::thread([pr, jobId, path, orientation]() {
-            pr->printFromFile(jobId, path, orientation);
-        }).detach();
-        return resp;
-    }
-    auto itData = cmd.payload.find("data");
-    if (itData != cmd.payload.end() && !itData->second.empty()) {
+    } else if (itData != cmd.payload.end() && !itData->second.empty()) {
         // base64 data: decode then print in background
-        std::vector<uint8_t> data;
-        if (!base64Decode(itData->second, data)) {
+        if (!base64Decode(itData->second, job.data)) {
             resp.status = ipc::ResponseStatus::REJECTED;
             auto err = std::make_shared<ipc::Error>();
             err->code = "INVALID_PAYLOAD";
@@ -535,20 +784,30 @@ ipc::Response ServiceCore::handlePrinterPrint(const ipc::Command& cmd) {
             resp.error = err;
             return resp;
         }
-        resp.status = ipc::ResponseStatus::OK;
-        resp.responseMap["jobId"] = jobId;
-        resp.responseMap["deviceId"] = printer->getDeviceInfo().deviceId;
-        std::shared_ptr<devices::IPrinter> pr = printer;
-        std::thread([pr, jobId, data]() {
-            pr->print(jobId, data);
-        }).detach();
+    } else {
+        resp.status = ipc::ResponseStatus::REJECTED;
+        auto err = std::make_shared<ipc::Error>();
+        err->code = "INVALID_PAYLOAD";
+        err->message = "Missing filePath or data";
+        resp.error = err;
         return resp;
     }
-    resp.status = ipc::ResponseStatus::REJECTED;
-    auto err = std::make_shared<ipc::Error>();
-    err->code = "INVALID_PAYLOAD";
-    err->message = "Missing filePath or data";
-    resp.error = err;
+
+    const std::string jobId = job.jobId;
+    std::string error;
+    std::string deviceId = printerPool_.submit(std::move(job), requestedDeviceId, error);
+    if (deviceId.empty()) {
+        resp.status = ipc::ResponseStatus::REJECTED;
+        auto err = std::make_shared<ipc::Error>();
+        err->code = "DEVICE_NOT_FOUND";
+        err->message = error;
+        resp.error = err;
+        return resp;
+    }
+    resp.status = ipc::ResponseStatus::OK;
+    resp.responseMap["jobId"] = jobId;
+    resp.responseMap["deviceId"] = deviceId;
+    resp.responseMap["queueDepth"] = std::to_string(printerPool_.getQueueDepth(deviceId));
     return resp;
 }
 
@@ -590,7 +849,13 @@ ipc::Response ServiceCore::handlePaymentStart(const ipc::Command& cmd) {
     uint32_t amount = std::stoul(it->second);
     logging::Logger::getInstance().info("Executing payment start immediately: " + cmd.commandId + ", amount: " + it->second);
     
-    if (terminal->startPayment(amount)) {
+    std::string deviceId = deviceManager_.getDefaultDeviceId(devices::DeviceType::PAYMENT_TERMINAL);
+    auto started = std::make_shared<bool>(false);
+    if (!guardedDeviceCall(deviceId, devices::DeviceType::PAYMENT_TERMINAL, "payment_start", kDeviceCallTimeoutMs,
+                           [terminal, amount, started]() { *started = terminal->startPayment(amount); }, resp)) {
+        return resp;
+    }
+    if (*started) {
         resp.status = ipc::ResponseStatus::OK;
         auto info = terminal->getDeviceInfo();
         resp.responseMap["commandId"] = cmd.commandId;
@@ -637,7 +902,14 @@ ipc::Response ServiceCore::handlePaymentCancel(const ipc::Command& cmd) {
     
     logging::Logger::getInstance().info("Executing payment cancel immediately: " + cmd.commandId);
     
-    if (terminal->cancelPayment()) {
+    std::string deviceId = cashTestMode_ ? std::string(kCashDeviceId)
+        : deviceManager_.getDefaultDeviceId(devices::DeviceType::PAYMENT_TERMINAL);
+    auto cancelled = std::make_shared<bool>(false);
+    if (!guardedDeviceCall(deviceId, devices::DeviceType::PAYMENT_TERMINAL, "payment_cancel", kDeviceCallTimeoutMs,
+                           [terminal, cancelled]() { *cancelled = terminal->cancelPayment(); }, resp)) {
+        return resp;
+    }
+    if (*cancelled) {
         if (cashTestMode_) cashTestMode_ = false;
         resp.status = ipc::ResponseStatus::OK;
         auto info = terminal->getDeviceInfo();
@@ -707,8 +979,14 @@ ipc::Response ServiceCore::handlePaymentReset(const ipc::Command& cmd) {
         return resp;
     }
     
-    // Execute immediately
-    if (terminal->reset()) {
+    // Execute immediately (watchdog: a wedged port answers DEVICE_HUNG instead of blocking the pipe)
+    auto ok = std::make_shared<bool>(false);
+    if (!guardedDeviceCall(deviceManager_.getDefaultDeviceId(devices::DeviceType::PAYMENT_TERMINAL),
+                           devices::DeviceType::PAYMENT_TERMINAL, "payment_reset", kDeviceCallTimeoutMs,
+                           [terminal, ok]() { *ok = terminal->reset(); }, resp)) {
+        return resp;
+    }
+    if (*ok) {
         resp.status = ipc::ResponseStatus::OK;
         auto info = terminal->getDeviceInfo();
         resp.responseMap["commandId"] = cmd.commandId;
@@ -746,8 +1024,14 @@ ipc::Response ServiceCore::handlePaymentDeviceCheck(const ipc::Command& cmd) {
         return resp;
     }
     
-    // Execute immediately
-    if (terminal->checkDevice()) {
+    // Execute immediately (watchdog: a wedged port answers DEVICE_HUNG instead of blocking the pipe)
+    auto ok = std::make_shared<bool>(false);
+    if (!guardedDeviceCall(deviceManager_.getDefaultDeviceId(devices::DeviceType::PAYMENT_TERMINAL),
+                           devices::DeviceType::PAYMENT_TERMINAL, "payment_device_check", kDeviceCallTimeoutMs,
+                           [terminal, ok]() { *ok = terminal->checkDevice(); }, resp)) {
+        return resp;
+    }
+    if (*ok) {
         resp.status = ipc::ResponseStatus::OK;
         auto info = terminal->getDeviceInfo();
         resp.responseMap["commandId"] = cmd.commandId;
@@ -786,7 +1070,13 @@ ipc::Response ServiceCore::handlePaymentCardUidRead(const ipc::Command& cmd) {
         return resp;
     }
     
-    auto uidResult = terminal->readCardUid();
+    auto uidHolder = std::make_shared<devices::CardUidResult>();
+    if (!guardedDeviceCall(deviceManager_.getDefaultDeviceId(devices::DeviceType::PAYMENT_TERMINAL),
+                           devices::DeviceType::PAYMENT_TERMINAL, "card_uid_read", kDeviceCallTimeoutMs,
+                           [terminal, uidHolder]() { *uidHolder = terminal->readCardUid(); }, resp)) {
+        return resp;
+    }
+    const auto& uidResult = *uidHolder;
     if (!uidResult.success) {
         resp.status = ipc::ResponseStatus::REJECTED;
         auto error = std::make_shared<ipc::Error>();
@@ -830,7 +1120,13 @@ ipc::Response ServiceCore::handlePaymentLastApproval(const ipc::Command& cmd) {
         return resp;
     }
     
-    auto lastApproval = terminal->getLastApproval("");
+    auto approvalHolder = std::make_shared<devices::PaymentCompleteEvent>();
+    if (!guardedDeviceCall(deviceManager_.getDefaultDeviceId(devices::DeviceType::PAYMENT_TERMINAL),
+                           devices::DeviceType::PAYMENT_TERMINAL, "last_approval", kLongDeviceCallTimeoutMs,
+                           [terminal, approvalHolder]() { *approvalHolder = terminal->getLastApproval(""); }, resp)) {
+        return resp;
+    }
+    const auto& lastApproval = *approvalHolder;
     if (lastApproval.status != "OK") {
         resp.status = ipc::ResponseStatus::REJECTED;
         auto error = std::make_shared<ipc::Error>();
@@ -868,7 +1164,13 @@ ipc::Response ServiceCore::handlePaymentIcCardCheck(const ipc::Command& cmd) {
         return resp;
     }
     
-    auto icResult = terminal->checkIcCard();
+    auto icHolder = std::make_shared<devices::IcCardCheckResult>();
+    if (!guardedDeviceCall(deviceManager_.getDefaultDeviceId(devices::DeviceType::PAYMENT_TERMINAL),
+                           devices::DeviceType::PAYMENT_TERMINAL, "ic_card_check", kDeviceCallTimeoutMs,
+                           [terminal, icHolder]() { *icHolder = terminal->checkIcCard(); }, resp)) {
+        return resp;
+    }
+    const auto& icResult = *icHolder;
     if (!icResult.success) {
         resp.status = ipc::ResponseStatus::REJECTED;
         auto error = std::make_shared<ipc::Error>();
@@ -933,8 +1235,17 @@ ipc::Response ServiceCore::handlePaymentScreenSoundSetting(const ipc::Command& c
         return resp;
     }
     
-    devices::ScreenSoundSettings settingResponse;
-    if (!terminal->setScreenSound(request, settingResponse)) {
+    auto settingHolder = std::make_shared<devices::ScreenSoundSettings>();
+    auto settingOk = std::make_shared<bool>(false);
+    if (!guardedDeviceCall(deviceManager_.getDefaultDeviceId(devices::DeviceType::PAYMENT_TERMINAL),
+                           devices::DeviceType::PAYMENT_TERMINAL, "screen_sound_setting", kDeviceCallTimeoutMs,
+                           [terminal, request, settingHolder, settingOk]() {
+                               *settingOk = terminal->setScreenSound(request, *settingHolder);
+                           }, resp)) {
+        return resp;
+    }
+    const auto& settingResponse = *settingHolder;
+    if (!*settingOk) {
         resp.status = ipc::ResponseStatus::REJECTED;
         auto error = std::make_shared<ipc::Error>();
         error->code = "SCREEN_SOUND_SETTING_FAILED";
@@ -1015,7 +1326,13 @@ ipc::Response ServiceCore::handlePaymentTransactionCancel(const ipc::Command& cm
         return resp;
     }
     
-    auto cancelResult = terminal->cancelTransaction(cancelRequest);
+    auto cancelHolder = std::make_shared<devices::TransactionCancelResult>();
+    if (!guardedDeviceCall(deviceManager_.getDefaultDeviceId(devices::DeviceType::PAYMENT_TERMINAL),
+                           devices::DeviceType::PAYMENT_TERMINAL, "transaction_cancel", kLongDeviceCallTimeoutMs,
+                           [terminal, cancelRequest, cancelHolder]() { *cancelHolder = terminal->cancelTransaction(cancelRequest); }, resp)) {
+        return resp;
+    }
+    const auto& cancelResult = *cancelHolder;
     if (!cancelResult.success) {
         resp.status = ipc::ResponseStatus::REJECTED;
         auto error = std::make_shared<ipc::Error>();
@@ -1049,22 +1366,7 @@ void ServiceCore::setupEventCallbacks() {
     auto terminalIds = deviceManager_.getDeviceIds(devices::DeviceType::PAYMENT_TERMINAL);
     for (const auto& id : terminalIds) {
         auto terminal = deviceManager_.getPaymentTerminal(id);
-        if (terminal) {
-            terminal->setPaymentCompleteCallback([this](const devices::PaymentCompleteEvent& event) {
-                publishPaymentCompleteEvent(event);
-            });
-            terminal->setPaymentFailedCallback([this](const devices::PaymentFailedEvent& event) {
-                publishPaymentFailedEvent(event);
-            });
-            terminal->setPaymentCancelledCallback([this](const devices::PaymentCancelledEvent& event) {
-                publishPaymentCancelledEvent(event);
-            });
-            // Separate event deviceType: card terminal → "payment", cash device → "cash"
-            std::string eventDeviceType = (id == kCashDeviceId) ? "cash" : "payment";
-            terminal->setStateChangedCallback([this, eventDeviceType](devices::DeviceState state) {
-                publishDeviceStateChangedEvent(eventDeviceType, state);
-            });
-        }
+        if (terminal) wirePaymentTerminalCallbacks(id, terminal);
     }
     // 현금결제(LV77) 목표 금액 도달 시 0x5E(DISABLE) 후 cash_payment_target_reached 이벤트 전송
     auto cashTerminal = deviceManager_.getPaymentTerminal(kCashDeviceId);
@@ -1081,34 +1383,62 @@ void ServiceCore::setupEventCallbacks() {
     // Setup camera event callbacks
     auto camera = deviceManager_.getDefaultCamera();
     if (camera) {
-        camera->setCaptureCompleteCallback([this](const devices::CaptureCompleteEvent& event) {
+        std::string cameraId = deviceManager_.getDefaultDeviceId(devices::DeviceType::CAMERA);
+        camera->setCaptureCompleteCallback([this, cameraId](const devices::CaptureCompleteEvent& event) {
+            // watchdog가 이미 실패로 보고한 촬영이면 늦은 결과는 보내지 않음
+            if (!callWatchdog_.endByTag(cameraId, event.captureId)) {
+                logging::Logger::getInstance().warn("Late capture_complete for " + event.captureId + " dropped (already reported as timed out)");
+                return;
+            }
             publishCameraCaptureCompleteEvent(event);
         });
-        camera->setStateChangedCallback([this](devices::DeviceState state) {
-            publishDeviceStateChangedEvent("camera", state);
+        camera->setStateChangedCallback([this, cameraId](devices::DeviceState state) {
+            publishDeviceStateChangedEvent("camera", cameraId, state);
         });
         logging::Logger::getInstance().info("Camera capture_complete and state_changed callbacks registered");
     } else {
         logging::Logger::getInstance().warn("setupEventCallbacks: no camera available, capture_complete will not be sent");
     }
 
-    // Setup printer event callback
-    auto printer = deviceManager_.getDefaultPrinter();
-    if (printer) {
-        printer->setPrintJobCompleteCallback([this](const devices::PrintJobCompleteEvent& event) {
+    // Setup printer event callbacks for every pooled printer.
+    // 실패한 작업을 PrinterPool이 다른 프린터로 넘긴 경우 중간 실패 이벤트는 보내지 않음.
+    for (const auto& id : deviceManager_.getDeviceIds(devices::DeviceType::PRINTER)) {
+        auto printer = deviceManager_.getPrinter(id);
+        if (!printer) continue;
+        printer->setPrintJobCompleteCallback([this, id](const devices::PrintJobCompleteEvent& event) {
+            if (printerPool_.handleJobComplete(id, event)) return;
             publishPrinterJobCompleteEvent(event);
         });
-        printer->setStateChangedCallback([this](devices::DeviceState state) {
-            publishDeviceStateChangedEvent("printer", state);
+        printer->setStateChangedCallback([this, id](devices::DeviceState state) {
+            printerPool_.handleStateChanged(id, state);
+            publishDeviceStateChangedEvent("printer", id, state);
         });
     }
 }
 
+void ServiceCore::wirePaymentTerminalCallbacks(const std::string& deviceId,
+                                               const std::shared_ptr<devices::IPaymentTerminal>& terminal) {
+    terminal->setPaymentCompleteCallback([this](const devices::PaymentCompleteEvent& event) {
+        publishPaymentCompleteEvent(event);
+    });
+    terminal->setPaymentFailedCallback([this](const devices::PaymentFailedEvent& event) {
+        publishPaymentFailedEvent(event);
+    });
+    terminal->setPaymentCancelledCallback([this](const devices::PaymentCancelledEvent& event) {
+        publishPaymentCancelledEvent(event);
+    });
+    // Separate event deviceType: card terminal → "payment", cash device → "cash"
+    std::string eventDeviceType = (deviceId == kCashDeviceId) ? "cash" : "payment";
+    terminal->setStateChangedCallback([this, eventDeviceType, deviceId](devices::DeviceState state) {
+        publishDeviceStateChangedEvent(eventDeviceType, deviceId, state);
+    });
+}
+
 void ServiceCore::publishPrinterJobCompleteEvent(const devices::PrintJobCompleteEvent& event) {
     ipc::Event ipcEvent;
     ipcEvent.protocolVersion = ipc::PROTOCOL_VERSION;
     ipcEvent.kind = ipc::MessageKind::EVENT;
-    ipcEvent.eventId = generateUUID();
+    ipcEvent.eventId = IdGenerator::next();
     ipcEvent.eventType = ipc::EventType::PRINTER_JOB_COMPLETE;
     ipcEvent.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
@@ -1117,7 +1447,7 @@ void ServiceCore::publishPrinterJobCompleteEvent(const devices::PrintJobComplete
     ipcEvent.data["success"] = event.success ? "true" : "false";
     ipcEvent.data["errorMessage"] = event.errorMessage;
     ipcEvent.data["state"] = std::to_string(static_cast<int>(event.state));
-    ipcServer_.broadcastEvent(ipcEvent);
+    eventCoalescer_.publish(ipcEvent);
 }
 
 void ServiceCore::publishPaymentCompleteEvent(const devices::PaymentCompleteEvent& event) {
@@ -1135,7 +1465,7 @@ void ServiceCore::publishPaymentCompleteEvent(const devices::PaymentCompleteEven
     ipc::Event ipcEvent;
     ipcEvent.protocolVersion = ipc::PROTOCOL_VERSION;
     ipcEvent.kind = ipc::MessageKind::EVENT;
-    ipcEvent.eventId = generateUUID();
+    ipcEvent.eventId = IdGenerator::next();
     ipcEvent.eventType = ipc::EventType::PAYMENT_COMPLETE;
     ipcEvent.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
@@ -1162,7 +1492,7 @@ void ServiceCore::publishPaymentCompleteEvent(const devices::PaymentCompleteEven
     ipcEvent.data["acquirer"] = event.acquirer;
     
     logging::Logger::getInstance().info("Broadcasting PAYMENT_COMPLETE event to IPC clients");
-    ipcServer_.broadcastEvent(ipcEvent);
+    eventCoalescer_.publish(ipcEvent);
     logging::Logger::getInstance().info("PAYMENT_COMPLETE event broadcasted");
 }
 
@@ -1170,26 +1500,26 @@ void ServiceCore::publishCashTestAmountEvent(uint32_t totalAmount) {
     ipc::Event ipcEvent;
     ipcEvent.protocolVersion = ipc::PROTOCOL_VERSION;
     ipcEvent.kind = ipc::MessageKind::EVENT;
-    ipcEvent.eventId = generateUUID();
+    ipcEvent.eventId = IdGenerator::next();
     ipcEvent.eventType = ipc::EventType::CASH_TEST_AMOUNT;
     ipcEvent.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
     ipcEvent.deviceType = "cash";
     ipcEvent.data["totalAmount"] = std::to_string(totalAmount);
-    ipcServer_.broadcastEvent(ipcEvent);
+    eventCoalescer_.publish(ipcEvent);
 }
 
 void ServiceCore::publishCashPaymentTargetReachedEvent(uint32_t totalAmount) {
     ipc::Event ipcEvent;
     ipcEvent.protocolVersion = ipc::PROTOCOL_VERSION;
     ipcEvent.kind = ipc::MessageKind::EVENT;
-    ipcEvent.eventId = generateUUID();
+    ipcEvent.eventId = IdGenerator::next();
     ipcEvent.eventType = ipc::EventType::CASH_PAYMENT_TARGET_REACHED;
     ipcEvent.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
     ipcEvent.deviceType = "cash";
     ipcEvent.data["totalAmount"] = std::to_string(totalAmount);
-    ipcServer_.broadcastEvent(ipcEvent);
+    eventCoalescer_.publish(ipcEvent);
     logging::Logger::getInstance().info("[LV77] cash_payment_target_reached event sent, total=" + std::to_string(totalAmount));
 }
 
@@ -1202,14 +1532,14 @@ void ServiceCore::publishCashBillStackedEvent(uint32_t amount, uint32_t currentT
     ipc::Event ipcEvent;
     ipcEvent.protocolVersion = ipc::PROTOCOL_VERSION;
     ipcEvent.kind = ipc::MessageKind::EVENT;
-    ipcEvent.eventId = generateUUID();
+    ipcEvent.eventId = IdGenerator::next();
     ipcEvent.eventType = ipc::EventType::CASH_BILL_STACKED;
     ipcEvent.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
     ipcEvent.deviceType = "cash";
     ipcEvent.data["amount"] = std::to_string(amount);
     ipcEvent.data["currentTotal"] = std::to_string(currentTotal);
-    ipcServer_.broadcastEvent(ipcEvent);
+    eventCoalescer_.publish(ipcEvent);
 }
 
 void ServiceCore::publishPaymentFailedEvent(const devices::PaymentFailedEvent& event) {
@@ -1220,7 +1550,7 @@ void ServiceCore::publishPaymentFailedEvent(const devices::PaymentFailedEvent& e
     ipc::Event ipcEvent;
     ipcEvent.protocolVersion = ipc::PROTOCOL_VERSION;
     ipcEvent.kind = ipc::MessageKind::EVENT;
-    ipcEvent.eventId = generateUUID();
+    ipcEvent.eventId = IdGenerator::next();
     ipcEvent.eventType = ipc::EventType::PAYMENT_FAILED;
     ipcEvent.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
@@ -1232,7 +1562,7 @@ void ServiceCore::publishPaymentFailedEvent(const devices::PaymentFailedEvent& e
     ipcEvent.data["state"] = std::to_string(static_cast<int>(event.state));
     
     logging::Logger::getInstance().info("Broadcasting PAYMENT_FAILED event to IPC clients");
-    ipcServer_.broadcastEvent(ipcEvent);
+    eventCoalescer_.publish(ipcEvent);
     logging::Logger::getInstance().info("PAYMENT_FAILED event broadcasted");
 }
 
@@ -1240,7 +1570,7 @@ void ServiceCore::publishPaymentCancelledEvent(const devices::PaymentCancelledEv
     ipc::Event ipcEvent;
     ipcEvent.protocolVersion = ipc::PROTOCOL_VERSION;
     ipcEvent.kind = ipc::MessageKind::EVENT;
-    ipcEvent.eventId = generateUUID();
+    ipcEvent.eventId = IdGenerator::next();
     ipcEvent.eventType = ipc::EventType::PAYMENT_CANCELLED;
     ipcEvent.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
@@ -1248,27 +1578,31 @@ void ServiceCore::publishPaymentCancelledEvent(const devices::PaymentCancelledEv
     
     ipcEvent.data["state"] = std::to_string(static_cast<int>(event.state));
     
-    ipcServer_.broadcastEvent(ipcEvent);
+    eventCoalescer_.publish(ipcEvent);
 }
 
-void ServiceCore::publishDeviceStateChangedEvent(const std::string& deviceType, devices::DeviceState state) {
+void ServiceCore::publishDeviceStateChangedEvent(const std::string& deviceType, const std::string& deviceId, devices::DeviceState state) {
     logging::Logger::getInstance().info("=== Publishing DEVICE_STATE_CHANGED event ===");
-    logging::Logger::getInstance().info("Device Type: " + deviceType + ", State: " + devices::deviceStateToString(state));
+    logging::Logger::getInstance().info("Device Type: " + deviceType + ", Device: " + deviceId + ", State: " + devices::deviceStateToString(state));
     
     ipc::Event ipcEvent;
     ipcEvent.protocolVersion = ipc::PROTOCOL_VERSION;
     ipcEvent.kind = ipc::MessageKind::EVENT;
-    ipcEvent.eventId = generateUUID();
+    ipcEvent.eventId = IdGenerator::next();
     ipcEvent.eventType = ipc::EventType::DEVICE_STATE_CHANGED;
     ipcEvent.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
     ipcEvent.deviceType = deviceType;
     
+    ipcEvent.data["deviceId"] = deviceId;
     ipcEvent.data["state"] = std::to_string(static_cast<int>(state));
     ipcEvent.data["stateString"] = devices::deviceStateToString(state);
+    // 폴링 사이에 READY→ERROR→READY로 돌아와도 델타 조회에 잡히도록 전이마다 버전 증가
+    // (이벤트 data에는 넣지 않음 — 병합기가 data 전체로 "원래 상태로 돌아옴"을 판단)
+    stateTracker_.recordState(deviceId, state);
     
     logging::Logger::getInstance().info("Broadcasting DEVICE_STATE_CHANGED event to IPC clients");
-    ipcServer_.broadcastEvent(ipcEvent);
+    eventCoalescer_.publish(ipcEvent);
     logging::Logger::getInstance().info("DEVICE_STATE_CHANGED event broadcasted");
 }
 
@@ -1296,12 +1630,18 @@ void ServiceCore::performSystemStatusCheck() {
     
     std::map<std::string, devices::DeviceInfo> deviceStatuses;
     bool allHealthy = true;
+    std::vector<HealthProbe> probes;
     
-    // Check all payment terminals
+    // Check all payment terminals (병렬 — 각 단말기 checkDevice가 서로를 기다리지 않음)
     auto paymentIds = deviceManager_.getDeviceIds(devices::DeviceType::PAYMENT_TERMINAL);
     for (const auto& deviceId : paymentIds) {
         auto terminal = deviceManager_.getPaymentTerminal(deviceId);
-        if (terminal) {
+        if (!terminal) continue;
+        HealthProbe p;
+        p.deviceId = deviceId;
+        p.deviceType = (deviceId == kCashDeviceId) ? "cash" : "payment";
+        p.snapshot = [terminal]() { return terminal->getDeviceInfo(); };
+        p.probe = [terminal, deviceId]() {
             auto info = terminal->getDeviceInfo();
             logging::Logger::getInstance().info("Checking payment terminal: " + deviceId + ", state: " + devices::deviceStateToString(info.state));
             
@@ -1312,58 +1652,49 @@ void ServiceCore::performSystemStatusCheck() {
                 
                 // Wait a bit for cancellation to complete
                 std::this_thread::sleep_for(std::chrono::milliseconds(500));
-                
-                // Recheck status
-                info = terminal->getDeviceInfo();
-                logging::Logger::getInstance().info("Payment terminal " + deviceId + " status after cancel: " + devices::deviceStateToString(info.state));
             }
             
             // Perform device check
             logging::Logger::getInstance().info("Performing device check for: " + deviceId);
             if (!terminal->checkDevice()) {
                 logging::Logger::getInstance().error("Device check failed for payment terminal: " + deviceId);
-                allHealthy = false;
-            } else {
-                info = terminal->getDeviceInfo();
-                logging::Logger::getInstance().info("Device check completed for " + deviceId + ", final state: " + devices::deviceStateToString(info.state));
             }
-            
-            deviceStatuses[deviceId] = info;
-            
-            // Check if device is in error state
-            if (info.state == devices::DeviceState::STATE_ERROR || info.state == devices::DeviceState::DISCONNECTED) {
-                allHealthy = false;
-            }
-        }
+            return terminal->getDeviceInfo();
+        };
+        guardHealthProbe(p, devices::DeviceType::PAYMENT_TERMINAL, (std::max)(kHealthProbeDeadlineMs, kDeviceCallTimeoutMs));
+        probes.push_back(std::move(p));
     }
     
-    // Check all printers (future)
-    auto printerIds = deviceManager_.getDeviceIds(devices::DeviceType::PRINTER);
-    for (const auto& deviceId : printerIds) {
+    // Printers and cameras: cached state only (no hardware access)
+    for (const auto& deviceId : deviceManager_.getDeviceIds(devices::DeviceType::PRINTER)) {
         auto printer = deviceManager_.getPrinter(deviceId);
-        if (printer) {
-            auto info = printer->getDeviceInfo();
-            logging::Logger::getInstance().info("Checking printer: " + deviceId + ", state: " + devices::deviceStateToString(info.state));
-            deviceStatuses[deviceId] = info;
-            
-            if (info.state == devices::DeviceState::STATE_ERROR || info.state == devices::DeviceState::DISCONNECTED) {
-                allHealthy = false;
-            }
-        }
-    }
-    
-    // Check all cameras (future)
-    auto cameraIds = deviceManager_.getDeviceIds(devices::DeviceType::CAMERA);
-    for (const auto& deviceId : cameraIds) {
+        if (!printer) continue;
+        HealthProbe p;
+        p.deviceId = deviceId;
+        p.deviceType = "printer";
+        p.probe = [printer]() { return printer->getDeviceInfo(); };
+        p.snapshot = p.probe;
+        guardHealthProbe(p, devices::DeviceType::PRINTER, kDeviceCallTimeoutMs);
+        probes.push_back(std::move(p));
+    }
+    for (const auto& deviceId : deviceManager_.getDeviceIds(devices::DeviceType::CAMERA)) {
         auto camera = deviceManager_.getCamera(deviceId);
-        if (camera) {
-            auto info = camera->getDeviceInfo();
-            logging::Logger::getInstance().info("Checking camera: " + deviceId + ", state: " + devices::deviceStateToString(info.state));
-            deviceStatuses[deviceId] = info;
-            
-            if (info.state == devices::DeviceState::STATE_ERROR || info.state == devices::DeviceState::DISCONNECTED) {
-                allHealthy = false;
-            }
+        if (!camera) continue;
+        HealthProbe p;
+        p.deviceId = deviceId;
+        p.deviceType = "camera";
+        p.probe = [camera]() { return camera->getDeviceInfo(); };
+        p.snapshot = p.probe;
+        guardHealthProbe(p, devices::DeviceType::CAMERA, kDeviceCallTimeoutMs);
+        probes.push_back(std::move(p));
+    }
+    
+    auto results = healthProbes_.run(std::move(probes), std::chrono::milliseconds(kHealthProbeDeadlineMs),
+        [this](const HealthProbeResult& r) { publishHealthProbeEvent(r, ""); });
+    for (const auto& r : results) {
+        deviceStatuses[r.deviceId] = r.info;
+        if (r.timedOut || r.info.state == devices::DeviceState::STATE_ERROR || r.info.state == devices::DeviceState::DISCONNECTED) {
+            allHealthy = false;
         }
     }
     
@@ -1373,11 +1704,31 @@ void ServiceCore::performSystemStatusCheck() {
     publishSystemStatusCheckEvent(deviceStatuses, allHealthy);
 }
 
+void ServiceCore::publishHealthProbeEvent(const HealthProbeResult& result, const std::string& commandId) {
+    ipc::Event ipcEvent;
+    ipcEvent.protocolVersion = ipc::PROTOCOL_VERSION;
+    ipcEvent.kind = ipc::MessageKind::EVENT;
+    ipcEvent.eventId = IdGenerator::next();
+    ipcEvent.eventType = ipc::EventType::DEVICE_HEALTH_PROBE;
+    ipcEvent.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    ipcEvent.deviceType = result.deviceType;
+
+    ipcEvent.data["commandId"] = commandId;
+    ipcEvent.data["deviceId"] = result.deviceId;
+    ipcEvent.data["state"] = std::to_string(static_cast<int>(result.info.state));
+    ipcEvent.data["stateString"] = devices::deviceStateToString(result.info.state);
+    ipcEvent.data["lastError"] = result.info.lastError;
+    ipcEvent.data["timedOut"] = result.timedOut ? "true" : "false";
+    ipcEvent.data["elapsedMs"] = std::to_string(result.elapsedMs);
+    eventCoalescer_.publish(ipcEvent);
+}
+
 void ServiceCore::publishSystemStatusCheckEvent(const std::map<std::string, devices::DeviceInfo>& deviceStatuses, bool allHealthy) {
     ipc::Event ipcEvent;
     ipcEvent.protocolVersion = ipc::PROTOCOL_VERSION;
     ipcEvent.kind = ipc::MessageKind::EVENT;
-    ipcEvent.eventId = generateUUID();
+    ipcEvent.eventId = IdGenerator::next();
     ipcEvent.eventType = ipc::EventType::SYSTEM_STATUS_CHECK;
     ipcEvent.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
@@ -1401,24 +1752,7 @@ void ServiceCore::publishSystemStatusCheckEvent(const std::map<std::string, devi
         index++;
     }
     
-    ipcServer_.broadcastEvent(ipcEvent);
-}
-
-std::string ServiceCore::generateUUID() {
-    // Simple UUID generation
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(0, 15);
-    
-    std::ostringstream oss;
-    oss << std::hex;
-    for (int i = 0; i < 32; ++i) {
-        oss << dis(gen);
-        if (i == 7 || i == 11 || i == 15 || i == 19) {
-            oss << "-";
-        }
-    }
-    return oss.str();
+    eventCoalescer_.publish(ipcEvent);
 }
 
 void ServiceCore::startTaskWorker() {
@@ -1675,9 +2009,24 @@ ipc::Response ServiceCore::handleCameraCapture(const ipc::Command& cmd) {
         return resp;
     }
     
-    // Execute capture (async)
+    // Execute capture (async). The watchdog deadline covers capture → capture_complete (EdsDownload);
+    // on overrun a failed capture_complete is sent and the late real one is dropped.
     std::string captureId = it->second;
-    if (camera->capture(captureId)) {
+    std::string cameraId = deviceManager_.getDefaultDeviceId(devices::DeviceType::CAMERA);
+    if (callWatchdog_.isHung(cameraId)) {
+        setDeviceHungError(resp, cameraId, "capture");
+        return resp;
+    }
+    uint64_t captureToken = callWatchdog_.begin(cameraId, devices::DeviceType::CAMERA, "capture",
+                                                std::chrono::milliseconds(kCaptureTimeoutMs), captureId);
+    auto accepted = std::make_shared<bool>(false);
+    if (!guardedDeviceCall(cameraId, devices::DeviceType::CAMERA, "capture_start", kDeviceCallTimeoutMs,
+                           [camera, captureId, accepted]() { *accepted = camera->capture(captureId); }, resp)) {
+        callWatchdog_.end(captureToken);
+        return resp;
+    }
+    if (!*accepted) callWatchdog_.end(captureToken);
+    if (*accepted) {
         resp.status = ipc::ResponseStatus::OK;
         auto info = camera->getDeviceInfo();
         resp.responseMap["commandId"] = cmd.commandId;
@@ -1744,7 +2093,13 @@ ipc::Response ServiceCore::handleCameraStartPreview(const ipc::Command& cmd) {
         return resp;
     }
     
-    if (camera->startPreview()) {
+    auto started = std::make_shared<bool>(false);
+    if (!guardedDeviceCall(deviceManager_.getDefaultDeviceId(devices::DeviceType::CAMERA), devices::DeviceType::CAMERA,
+                           "start_preview", kDeviceCallTimeoutMs,
+                           [camera, started]() { *started = camera->startPreview(); }, resp)) {
+        return resp;
+    }
+    if (*started) {
         resp.status = ipc::ResponseStatus::OK;
         auto* edsdkCam = dynamic_cast<canon::EdsdkCameraAdapter*>(camera.get());
         if (edsdkCam)
@@ -1778,7 +2133,13 @@ ipc::Response ServiceCore::handleCameraStopPreview(const ipc::Command& cmd) {
         return resp;
     }
     
-    if (camera->stopPreview()) {
+    auto stopped = std::make_shared<bool>(false);
+    if (!guardedDeviceCall(deviceManager_.getDefaultDeviceId(devices::DeviceType::CAMERA), devices::DeviceType::CAMERA,
+                           "stop_preview", kDeviceCallTimeoutMs,
+                           [camera, stopped]() { *stopped = camera->stopPreview(); }, resp)) {
+        return resp;
+    }
+    if (*stopped) {
         resp.status = ipc::ResponseStatus::OK;
     } else {
         resp.status = ipc::ResponseStatus::FAILED;
@@ -1834,7 +2195,13 @@ ipc::Response ServiceCore::handleCameraSetSettings(const ipc::Command& cmd) {
         settings.autoFocus = (autoFocusIt->second == "true" || autoFocusIt->second == "1");
     }
     
-    if (camera->setSettings(settings)) {
+    auto applied = std::make_shared<bool>(false);
+    if (!guardedDeviceCall(deviceManager_.getDefaultDeviceId(devices::DeviceType::CAMERA), devices::DeviceType::CAMERA,
+                           "set_settings", kDeviceCallTimeoutMs,
+                           [camera, settings, applied]() { *applied = camera->setSettings(settings); }, resp)) {
+        return resp;
+    }
+    if (*applied) {
         resp.status = ipc::ResponseStatus::OK;
         resp.responseMap["resolutionWidth"] = std::to_string(settings.resolutionWidth);
         resp.responseMap["resolutionHeight"] = std::to_string(settings.resolutionHeight);
@@ -1852,8 +2219,9 @@ ipc::Response ServiceCore::handleCameraSetSettings(const ipc::Command& cmd) {
     return resp;
 }
 
-void ServiceCore::tryReconnectDevicesBeforeDetect(
-        const std::map<std::string, std::string>& payloadOverrides) {
+std::vector<HealthProbeResult> ServiceCore::tryReconnectDevicesBeforeDetect(
+        const std::map<std::string, std::string>& payloadOverrides,
+        const std::string& commandId) {
     using namespace devices;
 
     // Reload config so enable flags reflect the latest state (manual edit / other save).
@@ -1861,68 +2229,336 @@ void ServiceCore::tryReconnectDevicesBeforeDetect(
     auto cfg = config::ConfigManager::getInstance().getAll();
     bool paymentEnabled = isEnabled(payloadOverrides, cfg, "payment.enabled");
 
+    // deadlineMs: 전체 프로브 제한 시간, streamPartial=true: 장치별 결과를 device_health_probe 이벤트로 즉시 전송
+    long long deadlineMs = kHealthProbeDeadlineMs;
+    auto dlIt = payloadOverrides.find("deadlineMs");
+    if (dlIt != payloadOverrides.end()) {
+        try {
+            deadlineMs = std::stoll(dlIt->second);
+        } catch (...) {}
+        if (deadlineMs <= 0 || deadlineMs > kMaxHealthProbeDeadlineMs) deadlineMs = kHealthProbeDeadlineMs;
+    }
+    auto spIt = payloadOverrides.find("streamPartial");
+    bool streamPartial = (spIt != payloadOverrides.end() && spIt->second == "true");
+
+    std::vector<HealthProbe> probes;
+
     // 1. Camera — 항상 shutdown + initialize로 실제 연결 여부 확인 (EDSDK만 지원)
     auto camera = deviceManager_.getDefaultCamera();
-    if (camera) {
-        auto* edsdkCam = dynamic_cast<canon::EdsdkCameraAdapter*>(camera.get());
-        if (edsdkCam) {
+    if (camera && dynamic_cast<canon::EdsdkCameraAdapter*>(camera.get())) {
+        HealthProbe p;
+        p.deviceId = camera->getDeviceInfo().deviceId;
+        p.deviceType = "camera";
+        p.probe = [this, camera, id = p.deviceId]() {
             logging::Logger::getInstance().info("Detect hardware: probing camera (shutdown + re-init)");
-            edsdkCam->shutdown();
-            bool ok = edsdkCam->initialize();
-            if (ok) {
+            auto outcome = reconnectCoordinator_.run(id, [this, camera]() { return reconnectCamera(camera); }, true);
+            if (outcome == ReconnectCoordinator::Outcome::SUCCEEDED) {
                 logging::Logger::getInstance().info("Detect hardware: camera probe succeeded (READY)");
             } else {
                 logging::Logger::getInstance().info("Detect hardware: camera probe failed (disconnected/error), will report current state");
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(300));
-        }
+            return camera->getDeviceInfo();
+        };
+        p.snapshot = [camera]() { return camera->getDeviceInfo(); };
+        guardHealthProbe(p, DeviceType::CAMERA, (std::max)(deadlineMs, kDeviceCallTimeoutMs));
+        probes.push_back(std::move(p));
     }
 
     // 2. Payment (card terminal) — paymentEnabled일 때만 checkDevice()로 실제 연결 상태 확인
     if (paymentEnabled) {
         auto payment = deviceManager_.getPaymentTerminal(kCardTerminalId);
+        HealthProbe p;
+        p.deviceId = kCardTerminalId;
+        p.deviceType = "payment";
+        p.snapshot = [this]() {
+            auto t = deviceManager_.getPaymentTerminal(kCardTerminalId);
+            if (t) return t->getDeviceInfo();
+            DeviceInfo info{};
+            info.deviceId = kCardTerminalId;
+            info.deviceType = DeviceType::PAYMENT_TERMINAL;
+            info.state = DeviceState::DISCONNECTED;
+            info.lastError = "Payment terminal not detected";
+            return info;
+        };
         if (payment) {
-            logging::Logger::getInstance().info("Detect hardware: probing payment terminal (" + payment->getVendorName() + ")");
-            bool ok = payment->checkDevice();
-            if (ok) {
-                logging::Logger::getInstance().info("Detect hardware: payment probe succeeded");
-            } else {
-                logging::Logger::getInstance().info("Detect hardware: payment probe failed, will report current state");
-            }
+            p.probe = [this, payment]() {
+                logging::Logger::getInstance().info("Detect hardware: probing payment terminal (" + payment->getVendorName() + ")");
+                bool ok = reconnectCoordinator_.run(kCardTerminalId, [payment]() { return payment->checkDevice(); }, true)
+                    == ReconnectCoordinator::Outcome::SUCCEEDED;
+                if (ok) {
+                    logging::Logger::getInstance().info("Detect hardware: payment probe succeeded");
+                } else {
+                    logging::Logger::getInstance().info("Detect hardware: payment probe failed, will report current state");
+                }
+                return payment->getDeviceInfo();
+            };
         } else {
             // No card terminal registered yet (e.g. payment was disabled at startup but enabled now).
             // Try auto-detect via factory — scan available COM ports to find a payment terminal.
-            logging::Logger::getInstance().info("Detect hardware: no card terminal registered, trying factory auto-detect on COM ports");
-            auto ports = smartro::SerialPort::getAvailablePorts(true);
-            // Exclude the cash device port if known
             std::string cashCom;
             auto cashIt = cfg.find("cash.com_port");
             if (cashIt != cfg.end()) cashCom = cashIt->second;
-            auto [vendor, adapter] = devices::PaymentTerminalFactory::detectOnPorts(kCardTerminalId, ports, cashCom, "card");
-            if (adapter) {
-                logging::Logger::getInstance().info("Detect hardware: factory detected payment terminal (" + vendor + ") on " + adapter->getComPort());
-                deviceManager_.registerPaymentTerminal(kCardTerminalId, adapter);
-                // Now run the event callback setup for the newly registered terminal
-                adapter->setPaymentCompleteCallback([this](const devices::PaymentCompleteEvent& event) {
-                    publishPaymentCompleteEvent(event);
-                });
-                adapter->setPaymentFailedCallback([this](const devices::PaymentFailedEvent& event) {
-                    publishPaymentFailedEvent(event);
-                });
-                adapter->setPaymentCancelledCallback([this](const devices::PaymentCancelledEvent& event) {
-                    publishPaymentCancelledEvent(event);
-                });
-                adapter->setStateChangedCallback([this](devices::DeviceState state) {
-                    publishDeviceStateChangedEvent("payment", state);
-                });
-            } else {
-                logging::Logger::getInstance().info("Detect hardware: factory could not find a payment terminal on any COM port");
-            }
+            auto snapshot = p.snapshot;
+            p.probe = [this, cashCom, snapshot]() {
+                logging::Logger::getInstance().info("Detect hardware: no card terminal registered, trying factory auto-detect on COM ports");
+                reconnectCoordinator_.run(kCardTerminalId, [this, cashCom]() {
+                    // Exclude the cash device port if known
+                    return detectCardTerminal(getKnownPorts(), cashCom);
+                }, true);
+                return snapshot();
+            };
         }
+        guardHealthProbe(p, DeviceType::PAYMENT_TERMINAL, (std::max)(deadlineMs, kDeviceCallTimeoutMs));
+        probes.push_back(std::move(p));
     } else {
         logging::Logger::getInstance().info("Detect hardware: payment terminal disabled, skipping probe");
     }
     // Note: cash device (LV77) probing is handled inside handleDetectHardware via port scanning.
+
+    return healthProbes_.run(std::move(probes), std::chrono::milliseconds(deadlineMs),
+        [this, streamPartial, commandId](const HealthProbeResult& r) {
+            if (streamPartial) publishHealthProbeEvent(r, commandId);
+        });
+}
+
+std::vector<std::string> ServiceCore::getKnownPorts() {
+    if (hotplugWatcher_.isRunning()) return hotplugWatcher_.getPorts();
+    return smartro::SerialPort::getAvailablePorts(true);
+}
+
+bool ServiceCore::reconnectCamera(const std::shared_ptr<devices::ICamera>& camera) {
+    auto* edsdkCam = camera ? dynamic_cast<canon::EdsdkCameraAdapter*>(camera.get()) : nullptr;
+    if (!edsdkCam) return false;
+    edsdkCam->shutdown();
+    return edsdkCam->initialize();
+}
+
+bool ServiceCore::detectCardTerminal(const std::vector<std::string>& ports, const std::string& excludePort) {
+    if (deviceManager_.getPaymentTerminal(kCardTerminalId)) return true;  // 합류 대기 중 다른 경로가 등록함
+    auto [vendor, adapter] = devices::PaymentTerminalFactory::detectOnPorts(kCardTerminalId, ports, excludePort, "card");
+    if (!adapter) {
+        logging::Logger::getInstance().info("Card terminal auto-detect: no payment terminal found on " + std::to_string(ports.size()) + " port(s)");
+        return false;
+    }
+    logging::Logger::getInstance().info("Card terminal auto-detect: " + vendor + " on " + adapter->getComPort());
+    deviceManager_.registerPaymentTerminal(kCardTerminalId, adapter);
+    wirePaymentTerminalCallbacks(kCardTerminalId, adapter);
+    publishDeviceStateChangedEvent("payment", kCardTerminalId, adapter->getDeviceInfo().state);
+    return true;
+}
+
+bool ServiceCore::guardedDeviceCall(const std::string& deviceId, devices::DeviceType deviceType,
+                                    const std::string& operation, long long timeoutMs,
+                                    std::function<void()> fn, ipc::Response& resp) {
+    if (callWatchdog_.call(deviceId, deviceType, operation, std::chrono::milliseconds(timeoutMs), std::move(fn))) {
+        return true;
+    }
+    setDeviceHungError(resp, deviceId, operation);
+    return false;
+}
+
+void ServiceCore::setDeviceHungError(ipc::Response& resp, const std::string& deviceId, const std::string& operation) {
+    resp.status = ipc::ResponseStatus::FAILED;
+    auto error = std::make_shared<ipc::Error>();
+    error->code = "DEVICE_HUNG";
+    error->message = deviceId + " not responding (" + operation + "), recovery in progress";
+    resp.error = error;
+    resp.responseMap["deviceId"] = deviceId;
+    resp.responseMap["state"] = std::to_string(static_cast<int>(devices::DeviceState::HUNG));
+    resp.responseMap["stateString"] = devices::deviceStateToString(devices::DeviceState::HUNG);
+    resp.responseMap["hangCount"] = std::to_string(callWatchdog_.getHangCount(deviceId));
+}
+
+namespace {
+    std::string eventDeviceTypeFor(const std::string& deviceId, devices::DeviceType type) {
+        switch (type) {
+            case devices::DeviceType::CAMERA: return "camera";
+            case devices::DeviceType::PRINTER: return "printer";
+            default: return deviceId == kCashDeviceId ? "cash" : "payment";
+        }
+    }
+} // namespace
+
+void ServiceCore::handleDeviceHang(const CallWatchdog::HangInfo& hang) {
+    using namespace devices;
+    DeviceInfo last;
+    DeviceState from = stateTracker_.getLastInfo(hang.deviceId, last) ? last.state : DeviceState::DISCONNECTED;
+    recordHangTransition(hang.deviceId, from, DeviceState::HUNG, StateErrorCode::NO_RESPONSE);
+    publishDeviceStateChangedEvent(eventDeviceTypeFor(hang.deviceId, hang.deviceType), hang.deviceId, DeviceState::HUNG);
+
+    // 촬영 대기 중인 클라이언트에는 실패한 capture_complete로 즉시 알림 (늦게 도착한 실제 결과는 버림)
+    if (hang.operation == "capture" && !hang.tag.empty()) {
+        CaptureCompleteEvent failed{};
+        failed.captureId = hang.tag;
+        failed.success = false;
+        failed.errorMessage = "Capture timed out after " + std::to_string(hang.elapsedMs) + " ms (camera not responding)";
+        failed.state = DeviceState::HUNG;
+        publishCameraCaptureCompleteEvent(failed);
+    }
+
+    // 복구는 별도 스레드에서 (멈춘 호출이 잡고 있는 잠금을 watchdog 스레드가 기다리지 않도록)
+    switch (hang.deviceType) {
+        case DeviceType::CAMERA: {
+            auto camera = deviceManager_.getCamera(hang.deviceId);
+            if (camera) {
+                reconnectCoordinator_.runAsync(hang.deviceId, [this, camera]() { return reconnectCamera(camera); });
+            }
+            break;
+        }
+        case DeviceType::PAYMENT_TERMINAL: {
+            auto terminal = deviceManager_.getPaymentTerminal(hang.deviceId);
+            if (terminal) {
+                reconnectCoordinator_.runAsync(hang.deviceId, [terminal]() { return terminal->checkDevice(); });
+            }
+            break;
+        }
+        case DeviceType::PRINTER:
+            // 스풀러 호출은 취소할 수 없음 → 대기 중인 작업만 다른 프린터로
+            printerPool_.handleStateChanged(hang.deviceId, DeviceState::HUNG);
+            break;
+    }
+}
+
+void ServiceCore::handleDeviceRecovered(const CallWatchdog::HangInfo& hang) {
+    using namespace devices;
+    DeviceState state = DeviceState::DISCONNECTED;
+    switch (hang.deviceType) {
+        case DeviceType::CAMERA:
+            if (auto camera = deviceManager_.getCamera(hang.deviceId)) state = camera->getState();
+            break;
+        case DeviceType::PAYMENT_TERMINAL:
+            if (auto terminal = deviceManager_.getPaymentTerminal(hang.deviceId)) state = terminal->getState();
+            break;
+        case DeviceType::PRINTER:
+            if (auto printer = deviceManager_.getPrinter(hang.deviceId)) state = printer->getState();
+            break;
+    }
+    logging::Logger::getInstance().info("Device " + hang.deviceId + " responsive again (" + hang.operation
+        + " returned after " + std::to_string(hang.elapsedMs) + " ms), state " + deviceStateToString(state));
+    recordHangTransition(hang.deviceId, DeviceState::HUNG, state, StateErrorCode::NONE);
+    publishDeviceStateChangedEvent(eventDeviceTypeFor(hang.deviceId, hang.deviceType), hang.deviceId, state);
+}
+
+void ServiceCore::recordHangTransition(const std::string& deviceId, devices::DeviceState from,
+                                       devices::DeviceState to, devices::StateErrorCode error) {
+    std::lock_guard<std::mutex> lock(hangHistoryMutex_);
+    hangHistory_[deviceId].record(from, to, error);
+}
+
+bool ServiceCore::hungDeviceInfo(devices::DeviceInfo& info) {
+    CallWatchdog::HangInfo hang;
+    if (!callWatchdog_.getHang(info.deviceId, hang)) return false;
+    devices::DeviceInfo last;
+    if (stateTracker_.getLastInfo(info.deviceId, last)) info.deviceName = last.deviceName;
+    info.state = devices::DeviceState::HUNG;
+    // elapsed는 넣지 않음 — lastError가 바뀌면 스냅샷 버전이 매번 올라감
+    info.lastError = hang.operation + " not responding";
+    info.lastUpdateTime = std::chrono::system_clock::now();
+    return true;
+}
+
+std::vector<devices::DeviceInfo> ServiceCore::collectDeviceInfo() {
+    return deviceManager_.getAllDeviceInfo([this](devices::DeviceInfo& info) { return hungDeviceInfo(info); });
+}
+
+void ServiceCore::guardHealthProbe(HealthProbe& p, devices::DeviceType deviceType, long long timeoutMs) {
+    auto inFlight = std::make_shared<std::atomic<bool>>(false);
+    auto probe = std::move(p.probe);
+    auto snapshot = std::move(p.snapshot);
+    std::string deviceId = p.deviceId;
+    p.probe = [this, deviceId, deviceType, timeoutMs, probe, inFlight]() {
+        devices::DeviceInfo info;
+        info.deviceId = deviceId;
+        info.deviceType = deviceType;
+        if (hungDeviceInfo(info)) return info;  // 멈춘 장치는 다시 건드리지 않음 (복구는 watchdog 쪽)
+        *inFlight = true;
+        CallWatchdog::Scope guard(&callWatchdog_, deviceId, deviceType, "health_probe", std::chrono::milliseconds(timeoutMs));
+        info = probe();
+        *inFlight = false;
+        return info;
+    };
+    p.snapshot = [this, deviceId, deviceType, snapshot, inFlight]() {
+        devices::DeviceInfo info;
+        info.deviceId = deviceId;
+        info.deviceType = deviceType;
+        if (hungDeviceInfo(info)) return info;
+        // 프로브가 아직 장치를 잡고 있으면 어댑터 잠금을 기다리지 않고 마지막 관측값으로 보고
+        if (*inFlight && stateTracker_.getLastInfo(deviceId, info)) return info;
+        return snapshot();
+    };
+}
+
+void ServiceCore::handleHotplugChange(const HotplugWatcher::Change& change) {
+    using namespace devices;
+    std::lock_guard<std::mutex> lock(hotplugMutex_);
+    heartbeatMonitor_.pause();
+    struct ResumeOnExit {
+        HeartbeatMonitor& monitor;
+        ~ResumeOnExit() { monitor.resume(); }
+    } resumeOnExit{heartbeatMonitor_};
+
+    config::ConfigManager::getInstance().reloadFromFileIfExists();
+    auto cfg = config::ConfigManager::getInstance().getAll();
+    bool paymentEnabled = isEnabled({}, cfg, "payment.enabled");
+    bool cashEnabled = isEnabled({}, cfg, "cash.enabled");
+    auto contains = [](const std::vector<std::string>& v, const std::string& s) {
+        return !s.empty() && std::find(v.begin(), v.end(), s) != v.end();
+    };
+
+    // 등록된 단말기: 자기 포트가 사라졌거나(→ 끊김 반영) 다시 나타났으면(→ 재연결) checkDevice.
+    // 거래 중(PROCESSING)에는 건드리지 않음.
+    auto recheck = [&](const std::string& id, bool enabled) -> bool {
+        if (!enabled) return false;
+        auto terminal = deviceManager_.getPaymentTerminal(id);
+        if (!terminal) return false;
+        std::string port = terminal->getComPort();
+        bool removed = contains(change.removedPorts, port);
+        bool readded = contains(change.addedPorts, port);
+        if (!removed && !readded) return false;
+        auto state = terminal->getDeviceInfo().state;
+        if (state == DeviceState::STATE_PROCESSING) return true;
+        if (readded && state == DeviceState::STATE_READY) return true;
+        logging::Logger::getInstance().info("Hotplug: " + id + " port " + port + (removed ? " removed" : " re-appeared") + ", re-checking");
+        // 포트가 다시 나타남 = 분리 중 쌓인 실패 이력 무효 → 쿨다운 기다리지 않고 즉시 확인
+        if (readded) {
+            if (auto* breaker = terminal->getCircuitBreaker()) breaker->reset();
+        }
+        reconnectCoordinator_.run(id, [terminal]() { return terminal->checkDevice(); }, true);
+        return true;
+    };
+    bool cardHandled = recheck(kCardTerminalId, paymentEnabled);
+    recheck(kCashDeviceId, cashEnabled);
+
+    // 카드 단말기가 없거나 READY가 아니면 새로 나타난 포트만 팩토리 탐지
+    if (paymentEnabled && !cardHandled && !change.addedPorts.empty()) {
+        auto payment = deviceManager_.getPaymentTerminal(kCardTerminalId);
+        if (!payment || payment->getDeviceInfo().state != DeviceState::STATE_READY) {
+            std::string cashCom;
+            auto cash = deviceManager_.getPaymentTerminal(kCashDeviceId);
+            if (cash) cashCom = cash->getComPort();
+            else if (cfg.count("cash.com_port")) cashCom = cfg["cash.com_port"];
+            if (payment) {
+                // 등록된 단말기가 새 포트로 옮겨졌을 수 있음 — checkDevice가 선호 포트부터 확인
+                logging::Logger::getInstance().info("Hotplug: new port(s), re-checking payment terminal");
+                if (auto* breaker = payment->getCircuitBreaker()) breaker->reset();
+                reconnectCoordinator_.run(kCardTerminalId, [payment]() { return payment->checkDevice(); }, true);
+            } else {
+                logging::Logger::getInstance().info("Hotplug: new port(s), trying card terminal auto-detect");
+                reconnectCoordinator_.run(kCardTerminalId, [this, &change, cashCom]() {
+                    return detectCardTerminal(change.addedPorts, cashCom);
+                }, true);
+            }
+        }
+    }
+
+    // 카메라(USB, COM 아님): READY가 아니면 재초기화 — camera_reconnect 없이 재연결
+    if (change.usbChanged) {
+        auto camera = deviceManager_.getDefaultCamera();
+        if (camera && camera->getDeviceInfo().state != DeviceState::STATE_READY) {
+            logging::Logger::getInstance().info("Hotplug: USB change, re-initializing camera");
+            reconnectCoordinator_.run(camera->getDeviceInfo().deviceId, [this, camera]() { return reconnectCamera(camera); }, true);
+        }
+    }
 }
 
 ipc::Response ServiceCore::handleCameraReconnect(const ipc::Command& cmd) {
@@ -1953,9 +2589,10 @@ ipc::Response ServiceCore::handleCameraReconnect(const ipc::Command& cmd) {
         return resp;
     }
     
+    // 동시에 들어온 재연결 요청(detect_hardware, hotplug 등)은 진행 중인 시도에 합류
     logging::Logger::getInstance().info("Camera reconnect: shutting down then re-initializing");
-    edsdkCam->shutdown();
-    bool ok = edsdkCam->initialize();
+    bool ok = reconnectCoordinator_.run(camera->getDeviceInfo().deviceId,
+        [this, camera]() { return reconnectCamera(camera); }, true) == ReconnectCoordinator::Outcome::SUCCEEDED;
     if (ok) {
         resp.status = ipc::ResponseStatus::OK;
         resp.responseMap["status"] = "ok";
@@ -1977,7 +2614,7 @@ void ServiceCore::publishCameraCaptureCompleteEvent(const devices::CaptureComple
     ipc::Event ipcEvent;
     ipcEvent.protocolVersion = ipc::PROTOCOL_VERSION;
     ipcEvent.kind = ipc::MessageKind::EVENT;
-    ipcEvent.eventId = generateUUID();
+    ipcEvent.eventId = IdGenerator::next();
     ipcEvent.eventType = ipc::EventType::CAMERA_CAPTURE_COMPLETE;
     ipcEvent.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
@@ -1994,7 +2631,7 @@ void ServiceCore::publishCameraCaptureCompleteEvent(const devices::CaptureComple
     if (!event.success) {
         ipcEvent.data["errorMessage"] = event.errorMessage;
     }
-    ipcServer_.broadcastEvent(ipcEvent);
+    eventCoalescer_.publish(ipcEvent);
 }
 
 } // namespace core
@@ -38,14 +38,25 @@ ipc::Response ServiceCore::handleDetectHardware(const ipc::Command& cmd) {
     // probe=false: 현재 상태만 수집 (checkDevice/COM 스캔 생략 → 빠름)
     auto it = cmd.payload.find("probe");
     bool doProbe = (it == cmd.payload.end() || it->second != "false");
+    // 핫플러그 감시 중이면 실시간 포트 목록 사용 (probe=false여도 스캔 없이 최신)
+    bool livePorts = hotplugWatcher_.isRunning();
     std::vector<std::string> availablePorts;
-    if (doProbe)
-        availablePorts = smartro::SerialPort::getAvailablePorts(true);
+    if (doProbe || livePorts)
+        availablePorts = getKnownPorts();
+
+    // HUNG 장치는 어댑터를 조회하지 않고 watchdog 정보로 보고 (멈춘 호출이 잠금을 잡고 있을 수 있음)
+    auto infoOf = [this](const std::string& deviceId, devices::DeviceType type, const auto& device) {
+        devices::DeviceInfo info;
+        info.deviceId = deviceId;
+        info.deviceType = type;
+        if (hungDeviceInfo(info)) return info;
+        return device->getDeviceInfo();
+    };
 
     // 1. Camera
     auto camera = deviceManager_.getDefaultCamera();
     if (camera) {
-        auto info = camera->getDeviceInfo();
+        auto info = infoOf(deviceManager_.getDefaultDeviceId(devices::DeviceType::CAMERA), devices::DeviceType::CAMERA, camera);
         resp.responseMap["camera.model"] = info.deviceName;
         resp.responseMap["camera.state"] = std::to_string(static_cast<int>(info.state));
         resp.responseMap["camera.stateString"] = devices::deviceStateToString(info.state);
@@ -55,13 +66,27 @@ ipc::Response ServiceCore::handleDetectHardware(const ipc::Command& cmd) {
     // 2. Printer
     auto printer = deviceManager_.getDefaultPrinter();
     if (printer) {
-        auto info = printer->getDeviceInfo();
+        auto info = infoOf(deviceManager_.getDefaultDeviceId(devices::DeviceType::PRINTER), devices::DeviceType::PRINTER, printer);
         resp.responseMap["printer.name"] = info.deviceName;
         resp.responseMap["printer.state"] = std::to_string(static_cast<int>(info.state));
         resp.responseMap["printer.stateString"] = devices::deviceStateToString(info.state);
         resp.responseMap["printer.lastError"] = info.lastError;
         logging::Logger::getInstance().debug("Detect hardware: printer \"" + info.deviceName + "\" state=" + devices::deviceStateToString(info.state));
     }
+    // 2-1. Printer pool: 프린터별 상태와 큐 깊이
+    auto printerIds = deviceManager_.getDeviceIds(devices::DeviceType::PRINTER);
+    resp.responseMap["printers.count"] = std::to_string(printerIds.size());
+    for (size_t i = 0; i < printerIds.size(); ++i) {
+        auto pr = deviceManager_.getPrinter(printerIds[i]);
+        if (!pr) continue;
+        auto info = infoOf(printerIds[i], devices::DeviceType::PRINTER, pr);
+        std::string prefix = "printers[" + std::to_string(i) + "].";
+        resp.responseMap[prefix + "deviceId"] = printerIds[i];
+        resp.responseMap[prefix + "name"] = info.deviceName;
+        resp.responseMap[prefix + "state"] = std::to_string(static_cast<int>(info.state));
+        resp.responseMap[prefix + "stateString"] = devices::deviceStateToString(info.state);
+        resp.responseMap[prefix + "queueDepth"] = std::to_string(printerPool_.getQueueDepth(printerIds[i]));
+    }
 
     // 3. Payment (카드 결제 단말기 — LV77와 완전 분리)
     //    tryReconnectDevicesBeforeDetect()가 이미 checkDevice()를 호출했으므로 여기서는 상태만 수집.
@@ -74,14 +99,10 @@ ipc::Response ServiceCore::handleDetectHardware(const ipc::Command& cmd) {
             std::string cashCom;
             if (config.count("cash.com_port")) cashCom = config["cash.com_port"];
             logging::Logger::getInstance().info("Detect hardware: payment terminal not registered, trying factory auto-detect");
-            auto [vendor, adapter] = devices::PaymentTerminalFactory::detectOnPorts(
-                kCardTerminalId, availablePorts, cashCom, "card");
-            if (adapter) {
-                logging::Logger::getInstance().info(
-                    "Detect hardware: factory detected payment terminal (" + vendor + ") on " + adapter->getComPort());
-                deviceManager_.registerPaymentTerminal(kCardTerminalId, adapter);
-                paymentTerminal = adapter;
-            }
+            reconnectCoordinator_.run(kCardTerminalId, [this, &availablePorts, &cashCom]() {
+                return detectCardTerminal(availablePorts, cashCom);
+            }, true);
+            paymentTerminal = deviceManager_.getPaymentTerminal(kCardTerminalId);
         }
 
         if (paymentTerminal) {
@@ -90,7 +111,7 @@ ipc::Response ServiceCore::handleDetectHardware(const ipc::Command& cmd) {
             if (!port.empty())
                 resp.responseMap["payment.com_port"] = port;
 
-            auto info = paymentTerminal->getDeviceInfo();
+            auto info = infoOf(kCardTerminalId, devices::DeviceType::PAYMENT_TERMINAL, paymentTerminal);
             resp.responseMap["payment.state"] = std::to_string(static_cast<int>(info.state));
             resp.responseMap["payment.stateString"] = devices::deviceStateToString(info.state);
             resp.responseMap["payment.lastError"] = info.lastError;
@@ -130,7 +151,7 @@ ipc::Response ServiceCore::handleDetectHardware(const ipc::Command& cmd) {
 
         auto cashTerminal = deviceManager_.getPaymentTerminal(kCashDeviceId);
         if (cashTerminal) {
-            auto info = cashTerminal->getDeviceInfo();
+            auto info = infoOf(kCashDeviceId, devices::DeviceType::PAYMENT_TERMINAL, cashTerminal);
             resp.responseMap["cash.state"] = std::to_string(static_cast<int>(info.state));
             resp.responseMap["cash.stateString"] = devices::deviceStateToString(info.state);
             resp.responseMap["cash.lastError"] = info.lastError;
@@ -138,8 +159,9 @@ ipc::Response ServiceCore::handleDetectHardware(const ipc::Command& cmd) {
         }
     }
 
-    // 5. Available COM ports — probe=true일 때 위에서 구한 목록 사용
-    if (doProbe) {
+    // 5. Available COM ports — probe=true 또는 핫플러그 감시 중이면 위에서 구한 목록 사용
+    resp.responseMap["available_ports.source"] = livePorts ? "hotplug" : (doProbe ? "scan" : "config");
+    if (doProbe || livePorts) {
         std::ostringstream oss;
         for (size_t i = 0; i < availablePorts.size(); ++i) {
             if (i > 0) oss << ",";
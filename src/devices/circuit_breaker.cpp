@@ -0,0 +1,111 @@
+// src/devices/circuit_breaker.cpp
+#include "devices/circuit_breaker.h"
+#include "logging/logger.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace devices {
+
+CircuitBreaker::CircuitBreaker(std::string name, uint32_t failureThreshold, std::chrono::milliseconds cooldown,
+                               std::chrono::milliseconds maxCooldown)
+    : name_(std::move(name))
+    , failureThreshold_((std::max)(failureThreshold, 1u))
+    , baseCooldown_(cooldown)
+    , maxCooldown_((std::max)(cooldown, maxCooldown))
+    , cooldown_(cooldown) {
+}
+
+bool CircuitBreaker::allow() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = std::chrono::steady_clock::now();
+    switch (state_) {
+        case State::CLOSED:
+            return true;
+        case State::OPEN:
+            if (now < retryAt_) {
+                ++rejected_;
+                return false;
+            }
+            // 쿨다운 종료 → 시험 호출 하나만 통과
+            state_ = State::HALF_OPEN;
+            retryAt_ = now + cooldown_;
+            return true;
+        case State::HALF_OPEN:
+            // 시험 호출 결과가 보고되지 않은 채 쿨다운이 지나면 다음 호출을 새 시험으로
+            if (now >= retryAt_) {
+                retryAt_ = now + cooldown_;
+                return true;
+            }
+            ++rejected_;
+            return false;
+    }
+    return true;
+}
+
+void CircuitBreaker::recordSuccess() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state_ != State::CLOSED) {
+        logging::Logger::getInstance().info("Circuit breaker " + name_ + " closed (device answered)");
+    }
+    state_ = State::CLOSED;
+    consecutiveFailures_ = 0;
+    cooldown_ = baseCooldown_;
+}
+
+void CircuitBreaker::recordFailure() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++consecutiveFailures_;
+    if (state_ == State::HALF_OPEN) {
+        cooldown_ = (std::min)(cooldown_ * 2, maxCooldown_);
+        tripLocked();
+    } else if (state_ == State::CLOSED && consecutiveFailures_ >= failureThreshold_) {
+        tripLocked();
+    }
+}
+
+void CircuitBreaker::tripLocked() {
+    state_ = State::OPEN;
+    ++trips_;
+    retryAt_ = std::chrono::steady_clock::now() + cooldown_;
+    logging::Logger::getInstance().warn("Circuit breaker " + name_ + " open after " + std::to_string(consecutiveFailures_)
+        + " failures, next trial in " + std::to_string(cooldown_.count()) + " ms");
+}
+
+void CircuitBreaker::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    state_ = State::CLOSED;
+    consecutiveFailures_ = 0;
+    cooldown_ = baseCooldown_;
+}
+
+CircuitBreaker::State CircuitBreaker::getState() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return state_;
+}
+
+CircuitBreaker::Stats CircuitBreaker::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats s;
+    s.state = state_;
+    s.consecutiveFailures = consecutiveFailures_;
+    s.trips = trips_;
+    s.rejected = rejected_;
+    if (state_ == State::OPEN) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            retryAt_ - std::chrono::steady_clock::now()).count();
+        s.retryInMs = remaining > 0 ? remaining : 0;
+    }
+    return s;
+}
+
+std::string CircuitBreaker::stateToString(State state) {
+    switch (state) {
+        case State::CLOSED: return "closed";
+        case State::OPEN: return "open";
+        case State::HALF_OPEN: return "half_open";
+    }
+    return "unknown";
+}
+
+} // namespace devices
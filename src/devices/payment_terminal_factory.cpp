@@ -1,6 +1,12 @@
 // src/devices/payment_terminal_factory.cpp
 #include "devices/payment_terminal_factory.h"
+#include "devices/probe_cache.h"
 #include "logging/logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <thread>
 
 namespace devices {
 
@@ -14,12 +20,32 @@ std::vector<PaymentTerminalFactory::VendorProbe>& PaymentTerminalFactory::vendor
     return v;
 }
 
+PaymentTerminalFactory::VendorOrderPolicy& PaymentTerminalFactory::orderPolicy() {
+    static VendorOrderPolicy p;
+    return p;
+}
+
+size_t& PaymentTerminalFactory::maxConcurrentProbes() {
+    static size_t n = 4;
+    return n;
+}
+
 void PaymentTerminalFactory::registerVendor(VendorProbe probe) {
     std::lock_guard<std::mutex> lock(mutex());
     vendors().push_back(std::move(probe));
     logging::Logger::getInstance().info("PaymentTerminalFactory: registered vendor \"" + vendors().back().vendorName + "\"");
 }
 
+void PaymentTerminalFactory::setVendorOrderPolicy(VendorOrderPolicy policy) {
+    std::lock_guard<std::mutex> lock(mutex());
+    orderPolicy() = std::move(policy);
+}
+
+void PaymentTerminalFactory::setMaxConcurrentProbes(size_t count) {
+    std::lock_guard<std::mutex> lock(mutex());
+    maxConcurrentProbes() = (std::max)(count, static_cast<size_t>(1));
+}
+
 std::vector<std::string> PaymentTerminalFactory::getRegisteredVendors() {
     std::lock_guard<std::mutex> lock(mutex());
     std::vector<std::string> names;
@@ -28,13 +54,36 @@ std::vector<std::string> PaymentTerminalFactory::getRegisteredVendors() {
     return names;
 }
 
+std::vector<PaymentTerminalFactory::VendorProbe>
+PaymentTerminalFactory::orderedVendorsFor(const std::string& port, const std::string& category) {
+    std::vector<VendorProbe> candidates;
+    VendorOrderPolicy policy;
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        for (const auto& v : vendors()) {
+            // Skip vendors that don't match the requested category
+            if (!category.empty() && v.category != category) continue;
+            candidates.push_back(v);
+        }
+        policy = orderPolicy();
+    }
+    if (!policy || candidates.size() < 2) return candidates;
+
+    // Preferred vendors first (policy order), the rest keep registration order
+    std::vector<std::string> preferred = policy(port);
+    std::stable_sort(candidates.begin(), candidates.end(),
+        [&preferred](const VendorProbe& a, const VendorProbe& b) {
+            auto ia = std::find(preferred.begin(), preferred.end(), a.vendorName);
+            auto ib = std::find(preferred.begin(), preferred.end(), b.vendorName);
+            return ia < ib;
+        });
+    return candidates;
+}
+
 std::pair<std::string, std::shared_ptr<IPaymentTerminal>>
 PaymentTerminalFactory::createForPort(const std::string& deviceId, const std::string& port,
                                        const std::string& category) {
-    std::lock_guard<std::mutex> lock(mutex());
-    for (const auto& v : vendors()) {
-        // Skip vendors that don't match the requested category
-        if (!category.empty() && v.category != category) continue;
+    for (const auto& v : orderedVendorsFor(port, category)) {
         try {
             logging::Logger::getInstance().debug(
                 "PaymentTerminalFactory: trying vendor \"" + v.vendorName + "\" (category=" + v.category + ") on " + port);
@@ -54,17 +103,144 @@ PaymentTerminalFactory::createForPort(const std::string& deviceId, const std::st
     return {"", nullptr};
 }
 
+std::pair<std::string, std::shared_ptr<IPaymentTerminal>>
+PaymentTerminalFactory::tryCachedAssignment(const std::string& deviceId,
+                                             const std::vector<std::string>& targets,
+                                             const std::string& category) {
+    ProbeCacheEntry cached;
+    if (category.empty() || !ProbeCache::getInstance().get(category, cached)) return {"", nullptr};
+
+    std::string port = ProbeCache::getInstance().resolvePort(cached);
+    if (std::find(targets.begin(), targets.end(), port) == targets.end()) {
+        logging::Logger::getInstance().info("PaymentTerminalFactory: cached " + category + " port " + port + " not available, full scan");
+        return {"", nullptr};
+    }
+    for (const auto& v : orderedVendorsFor(port, category)) {
+        if (v.vendorName != cached.vendor) continue;
+        try {
+            auto t0 = std::chrono::steady_clock::now();
+            bool ok = v.tryPort(port);
+            auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+            if (!ok) break;
+            auto adapter = v.create(deviceId, port);
+            if (!adapter) break;
+            logging::Logger::getInstance().info("PaymentTerminalFactory: cached vendor \"" + v.vendorName + "\" confirmed on "
+                + port + " (" + std::to_string(latency) + " ms)");
+            ProbeCacheEntry entry;
+            entry.category = category;
+            entry.port = port;
+            entry.hardwareId = (port == cached.port) ? cached.hardwareId : "";
+            entry.vendor = v.vendorName;
+            entry.baudRate = v.baudRate;
+            entry.probeLatencyMs = static_cast<uint32_t>(latency);
+            ProbeCache::getInstance().recordSuccess(entry);
+            return {v.vendorName, adapter};
+        } catch (const std::exception& e) {
+            logging::Logger::getInstance().debug("PaymentTerminalFactory: cached probe failed on " + port + ": " + e.what());
+        }
+        break;
+    }
+    logging::Logger::getInstance().info("PaymentTerminalFactory: cached " + category + " assignment (" + cached.vendor + " on " + port + ") mismatch, full scan");
+    return {"", nullptr};
+}
+
 std::pair<std::string, std::shared_ptr<IPaymentTerminal>>
 PaymentTerminalFactory::detectOnPorts(const std::string& deviceId,
                                        const std::vector<std::string>& ports,
                                        const std::string& excludePort,
                                        const std::string& category) {
+    std::vector<std::string> targets;
     for (const auto& port : ports) {
         if (!excludePort.empty() && port == excludePort) continue;
-        auto result = createForPort(deviceId, port, category);
-        if (result.second) return result;
+        targets.push_back(port);
     }
-    return {"", nullptr};
+    if (targets.empty()) return {"", nullptr};
+
+    auto cachedResult = tryCachedAssignment(deviceId, targets, category);
+    if (cachedResult.second) return cachedResult;
+
+    size_t maxConcurrent;
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        maxConcurrent = maxConcurrentProbes();
+    }
+    const size_t workerCount = (std::min)(maxConcurrent, targets.size());
+
+    // firstHit: 어댑터까지 만들어진 포트 중 목록상 가장 앞선 인덱스. 이보다 뒤 포트는 시작하지 않거나 다음 벤더를 건너뜀.
+    // create()도 워커 안에서 — 응답은 했지만 create가 실패한 포트는 firstHit이 되지 않으므로 뒤 포트 탐색이 계속됨
+    // (순차 스캔과 같은 결과: 목록상 첫 "tryPort + create" 성공)
+    constexpr size_t kNone = (std::numeric_limits<size_t>::max)();
+    std::atomic<size_t> nextIndex{0};
+    std::atomic<size_t> firstHit{kNone};
+    std::vector<const VendorProbe*> hitVendor(targets.size(), nullptr);
+    std::vector<std::shared_ptr<IPaymentTerminal>> hitAdapter(targets.size());
+    std::vector<uint32_t> hitLatencyMs(targets.size(), 0);
+    std::vector<std::vector<VendorProbe>> portVendors(targets.size());
+
+    auto worker = [&]() {
+        while (true) {
+            size_t i = nextIndex.fetch_add(1);
+            if (i >= targets.size()) return;
+            if (i > firstHit.load()) continue;  // cancelled: an earlier port already responded
+            const std::string& port = targets[i];
+            portVendors[i] = orderedVendorsFor(port, category);
+            for (const auto& v : portVendors[i]) {
+                if (i > firstHit.load()) break;
+                bool ok = false;
+                auto t0 = std::chrono::steady_clock::now();
+                try {
+                    logging::Logger::getInstance().debug(
+                        "PaymentTerminalFactory: trying vendor \"" + v.vendorName + "\" (category=" + v.category + ") on " + port);
+                    ok = v.tryPort(port);
+                } catch (const std::exception& e) {
+                    logging::Logger::getInstance().debug(
+                        "PaymentTerminalFactory: vendor \"" + v.vendorName + "\" probe failed on " + port + ": " + e.what());
+                }
+                if (!ok) continue;
+                auto latencyMs = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - t0).count());
+                std::shared_ptr<IPaymentTerminal> adapter;
+                try {
+                    adapter = v.create(deviceId, port);
+                } catch (const std::exception& e) {
+                    logging::Logger::getInstance().warn(
+                        "PaymentTerminalFactory: vendor \"" + v.vendorName + "\" create failed on " + port + ": " + e.what());
+                }
+                if (!adapter) continue;  // 순차 스캔처럼 같은 포트의 다음 벤더로
+                hitVendor[i] = &v;
+                hitAdapter[i] = std::move(adapter);
+                hitLatencyMs[i] = latencyMs;
+                size_t cur = firstHit.load();
+                while (i < cur && !firstHit.compare_exchange_weak(cur, i)) {}
+                break;
+            }
+        }
+    };
+
+    if (workerCount <= 1) {
+        worker();
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(workerCount);
+        for (size_t t = 0; t < workerCount; ++t) threads.emplace_back(worker);
+        for (auto& th : threads) th.join();
+    }
+
+    size_t hit = firstHit.load();
+    if (hit == kNone) return {"", nullptr};
+    const VendorProbe& v = *hitVendor[hit];
+    logging::Logger::getInstance().info(
+        "PaymentTerminalFactory: vendor \"" + v.vendorName + "\" detected on " + targets[hit]);
+    if (!category.empty()) {
+        ProbeCacheEntry entry;
+        entry.category = category;
+        entry.port = targets[hit];
+        entry.vendor = v.vendorName;
+        entry.baudRate = v.baudRate;
+        entry.probeLatencyMs = hitLatencyMs[hit];
+        ProbeCache::getInstance().recordSuccess(entry);
+    }
+    return {v.vendorName, hitAdapter[hit]};
 }
 
 void PaymentTerminalFactory::clearVendors() {
@@ -0,0 +1,169 @@
+// src/devices/probe_cache.cpp
+#include "devices/probe_cache.h"
+#include "logging/logger.h"
+#include <fstream>
+#include <chrono>
+
+namespace devices {
+
+namespace {
+
+int64_t nowEpochMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+bool sameIdentity(const ProbeCacheEntry& a, const ProbeCacheEntry& b) {
+    return a.port == b.port && a.vendor == b.vendor && a.baudRate == b.baudRate;
+}
+
+} // namespace
+
+ProbeCache& ProbeCache::getInstance() {
+    static ProbeCache instance;
+    return instance;
+}
+
+void ProbeCache::initialize(const std::string& filePath) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    filePath_ = filePath;
+    entries_.clear();
+    dirty_ = false;
+    lastSaveMs_ = nowEpochMs();
+
+    std::ifstream file(filePath_);
+    if (!file.is_open()) {
+        logging::Logger::getInstance().info("Probe cache not found, starting empty: " + filePath_);
+        return;
+    }
+    // Format: <category>.<field>=<value>
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        size_t eq = line.find('=');
+        size_t dot = line.find('.');
+        if (eq == std::string::npos || dot == std::string::npos || dot > eq) continue;
+        std::string category = line.substr(0, dot);
+        std::string key = line.substr(dot + 1, eq - dot - 1);
+        std::string value = line.substr(eq + 1);
+        ProbeCacheEntry& e = entries_[category];
+        e.category = category;
+        try {
+            if (key == "port") e.port = value;
+            else if (key == "hardware_id") e.hardwareId = value;
+            else if (key == "vendor") e.vendor = value;
+            else if (key == "baud") e.baudRate = static_cast<uint32_t>(std::stoul(value));
+            else if (key == "last_success_ms") e.lastSuccessMs = std::stoll(value);
+            else if (key == "latency_ms") e.probeLatencyMs = static_cast<uint32_t>(std::stoul(value));
+        } catch (...) {}
+    }
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->second.port.empty() || it->second.vendor.empty()) it = entries_.erase(it);
+        else ++it;
+    }
+    logging::Logger::getInstance().info("Probe cache loaded: " + std::to_string(entries_.size()) + " entries from " + filePath_);
+}
+
+void ProbeCache::setPortIdentityResolver(PortIdentityResolver resolver) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    resolver_ = std::move(resolver);
+}
+
+bool ProbeCache::get(const std::string& category, ProbeCacheEntry& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(category);
+    if (it == entries_.end()) return false;
+    out = it->second;
+    return true;
+}
+
+void ProbeCache::recordSuccess(ProbeCacheEntry entry) {
+    if (entry.category.empty() || entry.port.empty()) return;
+    if (entry.lastSuccessMs == 0) entry.lastSuccessMs = nowEpochMs();
+
+    PortIdentityResolver resolver;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(entry.category);
+        // 같은 장치가 같은 포트에서 다시 응답: 하드웨어 ID 재조회(SetupAPI)와 파일 저장 생략
+        if (it != entries_.end() && sameIdentity(it->second, entry)
+            && (entry.hardwareId.empty() || entry.hardwareId == it->second.hardwareId)) {
+            it->second.lastSuccessMs = entry.lastSuccessMs;
+            it->second.probeLatencyMs = entry.probeLatencyMs;
+            dirty_ = true;
+            if (entry.lastSuccessMs - lastSaveMs_ >= kFlushIntervalMs) saveLocked();
+            return;
+        }
+        resolver = resolver_;
+    }
+    if (entry.hardwareId.empty() && resolver) {
+        auto ids = resolver();
+        auto it = ids.find(entry.port);
+        if (it != ids.end()) entry.hardwareId = it->second;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(entry.category);
+    bool changed = it == entries_.end() || !sameIdentity(it->second, entry)
+        || it->second.hardwareId != entry.hardwareId;
+    entries_[entry.category] = entry;
+    dirty_ = true;
+    if (changed || entry.lastSuccessMs - lastSaveMs_ >= kFlushIntervalMs) saveLocked();
+}
+
+void ProbeCache::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dirty_) saveLocked();
+}
+
+std::vector<std::string> ProbeCache::vendorsForPort(const std::string& port) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> result;
+    for (const auto& pair : entries_) {
+        if (pair.second.port == port) result.push_back(pair.second.vendor);
+    }
+    return result;
+}
+
+std::string ProbeCache::resolvePort(const ProbeCacheEntry& entry) const {
+    PortIdentityResolver resolver;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        resolver = resolver_;
+    }
+    if (entry.hardwareId.empty() || !resolver) return entry.port;
+    for (const auto& pair : resolver()) {
+        if (pair.second == entry.hardwareId) {
+            if (pair.first != entry.port) {
+                logging::Logger::getInstance().info("Probe cache: " + entry.category + " device moved "
+                    + entry.port + " -> " + pair.first + " (" + entry.hardwareId + ")");
+            }
+            return pair.first;
+        }
+    }
+    return entry.port;
+}
+
+void ProbeCache::saveLocked() {
+    if (filePath_.empty()) return;
+    lastSaveMs_ = nowEpochMs();
+    std::ofstream file(filePath_, std::ios::trunc);
+    if (!file.is_open()) {
+        logging::Logger::getInstance().warn("Failed to save probe cache: " + filePath_);
+        return;
+    }
+    file << "# Device probe cache (auto-generated by detect_hardware / device check)\n";
+    for (const auto& pair : entries_) {
+        const auto& e = pair.second;
+        file << e.category << ".port=" << e.port << "\n";
+        file << e.category << ".hardware_id=" << e.hardwareId << "\n";
+        file << e.category << ".vendor=" << e.vendor << "\n";
+        file << e.category << ".baud=" << e.baudRate << "\n";
+        file << e.category << ".last_success_ms=" << e.lastSuccessMs << "\n";
+        file << e.category << ".latency_ms=" << e.probeLatencyMs << "\n";
+    }
+    dirty_ = false;
+}
+
+} // namespace devices
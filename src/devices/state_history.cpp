@@ -0,0 +1,59 @@
+// src/devices/state_history.cpp
+#include "devices/state_history.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace devices {
+
+namespace {
+    const char* const kErrorCodeNames[] = {
+        "NONE",
+        "PORT_OPEN_FAILED",
+        "NO_RESPONSE",
+        "DEVICE_FAULT",
+        "SEND_FAILED",
+        "CIRCUIT_OPEN",
+        "NOT_FOUND",
+        "SDK_ERROR",
+        "TIMEOUT_RECOVERY",
+    };
+    static_assert(sizeof(kErrorCodeNames) / sizeof(kErrorCodeNames[0]) == static_cast<size_t>(StateErrorCode::COUNT),
+                  "kErrorCodeNames must match StateErrorCode");
+} // namespace
+
+const char* stateErrorCodeToString(StateErrorCode code) {
+    auto index = static_cast<size_t>(code);
+    return index < static_cast<size_t>(StateErrorCode::COUNT) ? kErrorCodeNames[index] : "UNKNOWN";
+}
+
+void StateHistory::record(DeviceState from, DeviceState to, StateErrorCode error) {
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& e = entries_[total_ % kCapacity];
+    e.timestampMs = now;
+    e.from = from;
+    e.to = to;
+    e.error = error;
+    ++total_;
+}
+
+std::vector<StateHistory::Entry> StateHistory::getEntries(size_t maxEntries) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = static_cast<size_t>((std::min)(total_, static_cast<uint64_t>(kCapacity)));
+    count = (std::min)(count, maxEntries);
+    std::vector<Entry> out;
+    out.reserve(count);
+    for (uint64_t i = total_ - count; i < total_; ++i) {
+        out.push_back(entries_[i % kCapacity]);
+    }
+    return out;
+}
+
+uint64_t StateHistory::getTotal() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_;
+}
+
+} // namespace devices
@@ -0,0 +1,39 @@
+// src/ipc/event_log.cpp
+#include "ipc/event_log.h"
+
+#include <algorithm>
+
+namespace ipc {
+
+EventLog::EventLog(size_t capacity)
+    : entries_((std::max)(capacity, static_cast<size_t>(1))) {
+}
+
+void EventLog::append(uint64_t seq, std::string json) {
+    Entry& e = entries_[seq % entries_.size()];
+    e.seq = seq;
+    e.json = std::move(json);
+    lastSeq_ = seq;
+}
+
+uint64_t EventLog::oldestSeq() const {
+    if (lastSeq_ == 0) return 0;
+    return lastSeq_ > entries_.size() ? lastSeq_ - entries_.size() + 1 : 1;
+}
+
+bool EventLog::since(uint64_t sinceSeq, std::vector<std::string>& out) const {
+    out.clear();
+    if (sinceSeq > lastSeq_) return false;              // 서비스 재시작 (번호가 되돌아감)
+    if (sinceSeq == lastSeq_) return true;
+    uint64_t oldest = oldestSeq();
+    bool complete = sinceSeq + 1 >= oldest;             // 그 사이 이벤트가 링에서 밀려났으면 불완전
+    uint64_t from = (std::max)(sinceSeq + 1, oldest);
+    out.reserve(static_cast<size_t>(lastSeq_ - from + 1));
+    for (uint64_t seq = from; seq <= lastSeq_; ++seq) {
+        const Entry& e = entries_[seq % entries_.size()];
+        if (e.seq == seq) out.push_back(e.json);
+    }
+    return complete;
+}
+
+} // namespace ipc
@@ -11,7 +11,9 @@ namespace ipc {
 
 IpcServer::IpcServer(core::DeviceManager& deviceManager)
     : pipeServer_(std::make_unique<NamedPipeServer>(PIPE_NAME))
-    , deviceManager_(deviceManager) {
+    , deviceManager_(deviceManager)
+    , epochMs_(std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count()) {
 }
 
 IpcServer::~IpcServer() {
@@ -45,20 +47,109 @@ void IpcServer::registerHandler(CommandType type, CommandHandler handler) {
 void IpcServer::broadcastEvent(const Event& event) {
     logging::Logger::getInstance().info("IpcServer::broadcastEvent called - EventType: " + eventTypeToString(event.eventType));
     
-    std::string json = MessageParser::serializeEvent(event);
-    if (json.empty()) {
-        logging::Logger::getInstance().error("Failed to serialize event to JSON");
-        return;
+    // 잠금은 번호 부여와 기록까지만 — 전송은 outbox 순서대로 잠금 밖에서 (느린 클라이언트가 발행을 막지 않음)
+    {
+        std::lock_guard<std::mutex> lock(eventMutex_);
+        Event stamped = event;
+        stamped.seq = eventLog_.nextSeq();
+        stamped.epoch = epochMs_;
+        std::string json = MessageParser::serializeEvent(stamped);
+        if (json.empty()) {
+            logging::Logger::getInstance().error("Failed to serialize event to JSON");
+            return;
+        }
+        eventLog_.append(stamped.seq, json);
+        logging::Logger::getInstance().debug("Event JSON: " + json);
+        outbox_.push_back(Outgoing{std::move(json), nullptr});
+        ++queuedCount_;
     }
-    
-    logging::Logger::getInstance().debug("Event JSON: " + json);
-    
-    if (pipeServer_) {
-        pipeServer_->broadcast(json);
-        logging::Logger::getInstance().info("Event broadcasted via NamedPipeServer");
-    } else {
-        logging::Logger::getInstance().error("pipeServer_ is null, cannot broadcast event");
+    drainOutbox();
+}
+
+void IpcServer::drainOutbox() {
+    std::unique_lock<std::mutex> lock(eventMutex_);
+    if (draining_) return;  // 전송 중인 스레드가 방금 넣은 것까지 순서대로 보냄
+    draining_ = true;
+    PipeClient* failed = nullptr;
+    while (!outbox_.empty()) {
+        Outgoing out = std::move(outbox_.front());
+        outbox_.pop_front();
+        lock.unlock();
+        if (!pipeServer_) {
+            logging::Logger::getInstance().error("pipeServer_ is null, cannot send event");
+        } else if (!out.client) {
+            pipeServer_->broadcast(out.json);
+        } else if (out.client != failed && !pipeServer_->sendToClient(*out.client, out.json)) {
+            failed = out.client;    // 끊긴 클라이언트: 남은 재전송은 건너뜀
+        }
+        lock.lock();
+        ++writtenCount_;
+        writtenCv_.notify_all();
     }
+    draining_ = false;
+}
+
+uint64_t IpcServer::getLastEventSeq() const {
+    std::lock_guard<std::mutex> lock(eventMutex_);
+    return eventLog_.lastSeq();
+}
+
+void IpcServer::handleResume(PipeClient& client, const Command& command) {
+    Response response;
+    response.protocolVersion = command.protocolVersion;
+    response.kind = MessageKind::RESPONSE;
+    response.commandId = command.commandId;
+    response.status = ResponseStatus::OK;
+    response.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    uint64_t sinceSeq = 0;
+    auto it = command.payload.find("sinceSeq");
+    if (it != command.payload.end() && !it->second.empty()) {
+        try {
+            sinceSeq = std::stoull(it->second);
+        } catch (...) {
+            response.status = ResponseStatus::REJECTED;
+            auto error = std::make_shared<Error>();
+            error->code = "INVALID_PARAMETER";
+            error->message = "sinceSeq must be a number";
+            response.error = error;
+            pipeServer_->sendToClient(client, MessageParser::serializeResponse(response));
+            return;
+        }
+    }
+    // 다른 서비스 실행에서 받은 번호면 전체 재동기화 필요
+    it = command.payload.find("epoch");
+    bool sameEpoch = it == command.payload.end() || it->second.empty() || it->second == std::to_string(epochMs_);
+
+    // 기록 조회와 outbox 적재를 한 잠금 안에서: 이후 브로드캐스트는 재전송 뒤에 나감
+    std::vector<std::string> missed;
+    bool complete = false;
+    uint64_t ticket = 0;
+    {
+        std::lock_guard<std::mutex> lock(eventMutex_);
+        complete = sameEpoch && eventLog_.since(sinceSeq, missed);
+        if (!sameEpoch) missed.clear();
+        response.responseMap["epoch"] = std::to_string(epochMs_);
+        response.responseMap["lastSeq"] = std::to_string(eventLog_.lastSeq());
+        response.responseMap["oldestSeq"] = std::to_string(eventLog_.oldestSeq());
+        response.responseMap["replayed"] = std::to_string(missed.size());
+        response.responseMap["complete"] = complete ? "true" : "false";
+        outbox_.push_back(Outgoing{MessageParser::serializeResponse(response), &client});
+        for (auto& json : missed) {
+            outbox_.push_back(Outgoing{std::move(json), &client});
+        }
+        queuedCount_ += 1 + missed.size();
+        ticket = queuedCount_;
+    }
+    drainOutbox();
+    {
+        // client는 이 스레드가 돌아갈 때까지만 유효 — 다른 스레드가 전송 중이면 끝날 때까지 기다림
+        std::unique_lock<std::mutex> lock(eventMutex_);
+        writtenCv_.wait(lock, [&] { return writtenCount_ >= ticket; });
+    }
+    logging::Logger::getInstance().info("resume: sinceSeq=" + std::to_string(sinceSeq) + ", replayed "
+        + std::to_string(missed.size()) + " event(s)" + (complete ? "" : " (incomplete, client must resync)"));
 }
 
 void IpcServer::handlePipeMessage(PipeClient& client, const std::string& message) {
@@ -92,6 +183,11 @@ void IpcServer::handlePipeMessage(PipeClient& client, const std::string& message
             return;
         }
         
+        if (command->type == CommandType::RESUME) {
+            handleResume(client, *command);
+            return;
+        }
+        
         // Process command
         Response response = processCommand(*command);
         
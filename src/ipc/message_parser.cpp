@@ -151,6 +151,8 @@ std::shared_ptr<Event> MessageParser::parseEvent(const std::string& json) {
         event->kind = stringToMessageKind(getJsonString(json, "kind"));
         event->eventId = getJsonString(json, "eventId");
         event->eventType = stringToEventType(getJsonString(json, "eventType"));
+        event->seq = static_cast<uint64_t>(getJsonInt64(json, "seq"));
+        event->epoch = getJsonInt64(json, "epoch");
         event->timestampMs = getJsonInt64(json, "timestampMs");
         event->deviceType = getJsonString(json, "deviceType");
         event->data = getJsonObject(json, "data");
@@ -246,6 +248,8 @@ std::string MessageParser::serializeEvent(const Event& event) {
         << "\"kind\":\"" << messageKindToString(event.kind) << "\","
         << "\"eventId\":\"" << event.eventId << "\","
         << "\"eventType\":\"" << eventTypeToString(event.eventType) << "\","
+        << "\"seq\":" << event.seq << ","
+        << "\"epoch\":" << event.epoch << ","
         << "\"timestampMs\":" << event.timestampMs << ","
         << "\"deviceType\":\"" << event.deviceType << "\","
         << "\"data\":" << buildJsonObject(event.data)
@@ -7,6 +7,8 @@
 #include "core/device_constants.h"
 #include "config/config_manager.h"
 #include "devices/payment_terminal_factory.h"
+#include "devices/probe_cache.h"
+#include "vendor_adapters/smartro/serial_port.h"
 #include "vendor_adapters/smartro/smartro_payment_adapter.h"
 #include "vendor_adapters/lv77/lv77_bill_adapter.h"
 #include "vendor_adapters/canon/edsdk_camera_adapter.h"
@@ -18,6 +20,7 @@
 #include <csignal>
 #include <atomic>
 #include <filesystem>
+#include <cstdio>
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -72,12 +75,38 @@ int main(int argc, char* argv[]) {
         } else {
             logging::Logger::getInstance().info("No printer selected in config (use Admin auto-detect to select one)");
         }
+        // Printer pool: printer.pool에 지정된 추가 프린터 (windows_printer_002, 003, ...)
+        {
+            int poolIndex = 2;
+            for (const auto& poolName : config.getPrinterPoolNames()) {
+                char idBuf[32];
+                std::snprintf(idBuf, sizeof(idBuf), "windows_printer_%03d", poolIndex++);
+                std::string poolDeviceId = idBuf;
+                logging::Logger::getInstance().info("Registering pooled printer: " + poolDeviceId + " (" + poolName + ")");
+                auto poolAdapter = std::make_shared<windows::WindowsGdiPrinterAdapter>(poolDeviceId, poolName);
+                serviceCore.getDeviceManager().registerPrinter(poolDeviceId, poolAdapter);
+            }
+        }
+
+        // Probe cache (config.ini와 같은 폴더): 마지막으로 감지된 벤더/포트를 한 번의 프로브로 검증
+        {
+            std::filesystem::path cacheDir = configPath.empty()
+                ? std::filesystem::current_path()
+                : std::filesystem::path(configPath).parent_path();
+            auto& probeCache = devices::ProbeCache::getInstance();
+            probeCache.setPortIdentityResolver([]() { return smartro::SerialPort::getPortHardwareIds(); });
+            probeCache.initialize((cacheDir / "probe_cache.ini").string());
+            devices::PaymentTerminalFactory::setVendorOrderPolicy([](const std::string& port) {
+                return devices::ProbeCache::getInstance().vendorsForPort(port);
+            });
+        }
 
         // --- Register vendor probes for auto-detect (add new vendors here) ---
         {
             devices::PaymentTerminalFactory::VendorProbe smartroProbe;
             smartroProbe.vendorName = "smartro";
             smartroProbe.category   = "card";  // 카드 결제 단말기
+            smartroProbe.baudRate   = 115200;
             smartroProbe.tryPort    = [](const std::string& port) { return smartro::SmartroPaymentAdapter::tryPort(port); };
             smartroProbe.create     = [](const std::string& deviceId, const std::string& port) -> std::shared_ptr<devices::IPaymentTerminal> {
                 return std::make_shared<smartro::SmartroPaymentAdapter>(deviceId, port, "DEFAULT_TERM");
@@ -88,6 +117,7 @@ int main(int argc, char* argv[]) {
             devices::PaymentTerminalFactory::VendorProbe lv77Probe;
             lv77Probe.vendorName = "lv77";
             lv77Probe.category   = "cash";  // 현금결제기
+            lv77Probe.baudRate   = 9600;
             lv77Probe.tryPort    = [](const std::string& port) { return lv77::Lv77BillAdapter::tryPort(port); };
             lv77Probe.create     = [](const std::string& deviceId, const std::string& port) -> std::shared_ptr<devices::IPaymentTerminal> {
                 return std::make_shared<lv77::Lv77BillAdapter>(deviceId, port);
@@ -165,6 +195,7 @@ int main(int argc, char* argv[]) {
         
         // Stop service
         serviceCore.stop();
+        devices::ProbeCache::getInstance().flush();  // 마지막 성공 시각/지연은 메모리에만 있음
         logging::Logger::getInstance().info("Device Controller Service stopped");
         
     } catch (const std::exception& e) {
@@ -52,7 +52,7 @@ bool EdsdkCameraAdapter::initialize() {
     commandProcessor_ = std::make_unique<EdsdkCommandProcessor>();
     if (!commandProcessor_->start()) {
         setLastError("Failed to start command processor");
-        updateState(devices::DeviceState::STATE_ERROR);
+        updateState(devices::DeviceState::STATE_ERROR, devices::StateErrorCode::SDK_ERROR);
         return false;
     }
 
@@ -75,7 +75,7 @@ bool EdsdkCameraAdapter::initialize() {
         logging::Logger::getInstance().error("InitializeCameraCommand exception: " + std::string(e.what()));
     }
     if (!ok) {
-        updateState(devices::DeviceState::DISCONNECTED);
+        updateState(devices::DeviceState::DISCONNECTED, devices::StateErrorCode::NOT_FOUND);
         return false;
     }
     logging::Logger::getInstance().info("EDSDK Camera Adapter init command completed (READY set by onSessionOpened): " + deviceId_);
@@ -179,6 +179,8 @@ bool EdsdkCameraAdapter::capture(const std::string& captureId) {
             if (elapsed >= 30) {
                 state_ = devices::DeviceState::STATE_READY;
                 lastUpdateTime_ = std::chrono::system_clock::now();
+                history_.record(devices::DeviceState::STATE_PROCESSING, devices::DeviceState::STATE_READY,
+                                devices::StateErrorCode::TIMEOUT_RECOVERY);
                 {
                     std::lock_guard<std::mutex> captureLock(captureMutex_);
                     pendingCaptures_.clear();
@@ -215,6 +217,7 @@ bool EdsdkCameraAdapter::capture(const std::string& captureId) {
         devices::DeviceState oldState = state_;
         state_ = devices::DeviceState::STATE_PROCESSING;
         lastUpdateTime_ = std::chrono::system_clock::now();
+        history_.record(oldState, state_);
         stateCb = stateChangedCallback_;
     }
     
@@ -388,6 +391,15 @@ void EdsdkCameraAdapter::onDownloadComplete(const std::string& filePath, const s
     updateState(devices::DeviceState::STATE_READY);
 }
 
+bool EdsdkCameraAdapter::heartbeat() {
+    // 배터리 레벨 속성 읽기를 명령 큐에 넣음 (비동기). 통신 오류는 onError → ERROR로 반영.
+    // 촬영/라이브뷰 중에는 큐를 막지 않도록 건너뜀.
+    if (getState() != devices::DeviceState::STATE_READY) return false;
+    if (evfPumpRunning_ || !cameraModel_ || !commandProcessor_ || !commandProcessor_->isRunning()) return true;
+    commandProcessor_->enqueue(std::make_shared<GetPropertyCommand>(cameraModel_.get(), kEdsPropID_BatteryLevel));
+    return true;
+}
+
 void EdsdkCameraAdapter::onError(EdsError error) {
     std::string errorMsg = "EDSDK error: " + std::to_string(error);
     setLastError(errorMsg);
@@ -398,7 +410,7 @@ void EdsdkCameraAdapter::onError(EdsError error) {
         logging::Logger::getInstance().warn("Ignoring DEVICE_BUSY in onError - keeping current state for next capture");
         return;
     }
-    updateState(devices::DeviceState::STATE_ERROR);
+    updateState(devices::DeviceState::STATE_ERROR, devices::StateErrorCode::SDK_ERROR);
 }
 
 void EdsdkCameraAdapter::onObjectEvent(EdsUInt32 event, EdsBaseRef ref) {
@@ -447,13 +459,14 @@ void EdsdkCameraAdapter::onObjectEvent(EdsUInt32 event, EdsBaseRef ref) {
     }
 }
 
-void EdsdkCameraAdapter::updateState(devices::DeviceState newState) {
+void EdsdkCameraAdapter::updateState(devices::DeviceState newState, devices::StateErrorCode error) {
     std::lock_guard<std::mutex> lock(stateMutex_);
     
     if (state_ != newState) {
         devices::DeviceState oldState = state_;
         state_ = newState;
         lastUpdateTime_ = std::chrono::system_clock::now();
+        history_.record(oldState, newState, error);
         
         logging::Logger::getInstance().info(
             "Camera state changed: " + devices::deviceStateToString(oldState) +
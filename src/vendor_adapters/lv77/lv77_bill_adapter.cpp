@@ -20,27 +20,68 @@ Lv77BillAdapter::Lv77BillAdapter(const std::string& deviceId, const std::string&
     : deviceId_(deviceId)
     , comPort_(comPort)
     , state_(devices::DeviceState::DISCONNECTED)
+    , circuit_(deviceId)
     , paymentInProgress_(false)
     , paymentCancelled_(false)
     , lastUpdateTime_(std::chrono::system_clock::now()) {
     serialPort_ = std::make_unique<smartro::SerialPort>();
     comm_ = std::make_unique<Lv77Comm>(*serialPort_);
+    comm_->setCircuitBreaker(&circuit_);
+    notifyThread_ = std::thread(&Lv77BillAdapter::notificationThread, this);
 }
 
 Lv77BillAdapter::~Lv77BillAdapter() {
     comm_->stopPollLoop();
+    // 남은 알림(이미 수락된 지폐 등)은 보내고 종료
+    {
+        std::lock_guard<std::mutex> lock(notifyMutex_);
+        notifyStopping_ = true;
+    }
+    notifyCondition_.notify_all();
+    if (notifyThread_.joinable()) notifyThread_.join();
     comm_->close();
 }
 
-void Lv77BillAdapter::updateState(devices::DeviceState newState) {
+void Lv77BillAdapter::postNotification(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(notifyMutex_);
+        notifyQueue_.push_back(std::move(task));
+    }
+    notifyCondition_.notify_one();
+}
+
+void Lv77BillAdapter::notificationThread() {
+    std::unique_lock<std::mutex> lock(notifyMutex_);
+    while (true) {
+        notifyCondition_.wait(lock, [this]() { return notifyStopping_ || !notifyQueue_.empty(); });
+        if (notifyQueue_.empty()) return;  // stopping, drained
+        auto task = std::move(notifyQueue_.front());
+        notifyQueue_.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+void Lv77BillAdapter::updateState(devices::DeviceState newState, devices::StateErrorCode error) {
     std::lock_guard<std::mutex> lock(stateMutex_);
     if (state_ != newState) {
+        history_.record(state_, newState, error);
         state_ = newState;
         lastUpdateTime_ = std::chrono::system_clock::now();
         if (stateChangedCallback_) stateChangedCallback_(state_);
     }
 }
 
+bool Lv77BillAdapter::circuitAllows(const std::string& operation) {
+    if (circuit_.allow()) return true;
+    auto stats = circuit_.getStats();
+    lastError_ = "Circuit open (" + std::to_string(stats.consecutiveFailures) + " consecutive failures), "
+        + operation + " rejected, retry in " + std::to_string(stats.retryInMs) + " ms";
+    logging::Logger::getInstance().debug("[LV77] " + lastError_);
+    return false;
+}
+
 devices::DeviceInfo Lv77BillAdapter::getDeviceInfo() const {
     std::lock_guard<std::mutex> lock(stateMutex_);
     devices::DeviceInfo info;
@@ -54,17 +95,22 @@ devices::DeviceInfo Lv77BillAdapter::getDeviceInfo() const {
 }
 
 bool Lv77BillAdapter::startPayment(uint32_t amount) {
+    std::lock_guard<std::mutex> ioLock(ioMutex_);
     if (!comm_->isOpen()) {
+        if (!circuitAllows("payment")) return false;
         if (!comm_->open(comPort_)) {
             lastError_ = "Failed to open " + comPort_;
+            circuit_.recordFailure();
             logging::Logger::getInstance().warn("[LV77] startPayment: " + lastError_);
             return false;
         }
         if (!comm_->syncAfterPowerUp(2000)) {
             comm_->close();
             lastError_ = "Sync failed";
+            circuit_.recordFailure();
             return false;
         }
+        circuit_.recordSuccess();
     }
     if (paymentInProgress_) {
         lastError_ = "Payment already in progress";
@@ -77,24 +123,27 @@ bool Lv77BillAdapter::startPayment(uint32_t amount) {
     updateState(devices::DeviceState::STATE_PROCESSING);
     comm_->setBillStackedCallback([this](uint32_t amt) { onBillStacked(amt); });
     // 잔돈 없음: 남은 금액보다 큰 지폐 들어오면 반환 + Flutter에 전달
+    // (리액터 스레드: 판정은 원자값으로 즉시, 이벤트 발행은 알림 스레드에서 — 0x0F 응답을 늦추지 않음)
     comm_->setEscrowCallback([this](uint32_t billAmount) {
         uint32_t target = targetAmount_.load();
         uint32_t current = currentTotal_.load();
         if (target == 0) return true;  // 테스트 모드(0원 결제): 전 수락
         if (current + billAmount <= target) return true;
-        devices::PaymentFailedEvent ev;
-        ev.errorCode = "CASH_BILL_RETURNED";
-        ev.errorMessage = "Exceed target amount (no change); bill returned";
-        ev.amount = billAmount;
-        ev.state = devices::DeviceState::STATE_PROCESSING;
-        if (paymentFailedCallback_) paymentFailedCallback_(ev);
-        logging::Logger::getInstance().info("[LV77] Bill returned (exceed target): " + std::to_string(billAmount) + " KRW, target=" + std::to_string(target) + " current=" + std::to_string(current));
+        postNotification([this, billAmount, target, current]() {
+            devices::PaymentFailedEvent ev;
+            ev.errorCode = "CASH_BILL_RETURNED";
+            ev.errorMessage = "Exceed target amount (no change); bill returned";
+            ev.amount = billAmount;
+            ev.state = devices::DeviceState::STATE_PROCESSING;
+            if (paymentFailedCallback_) paymentFailedCallback_(ev);
+            logging::Logger::getInstance().info("[LV77] Bill returned (exceed target): " + std::to_string(billAmount) + " KRW, target=" + std::to_string(target) + " current=" + std::to_string(current));
+        });
         return false;
     });
     if (!comm_->enable()) {
         lastError_ = comm_->getLastError();
         paymentInProgress_ = false;
-        updateState(devices::DeviceState::STATE_ERROR);
+        updateState(devices::DeviceState::STATE_ERROR, devices::StateErrorCode::SEND_FAILED);
         return false;
     }
     comm_->startPollLoop(100);
@@ -125,15 +174,19 @@ devices::DeviceState Lv77BillAdapter::getState() const {
 }
 
 bool Lv77BillAdapter::reset() {
+    std::lock_guard<std::mutex> ioLock(ioMutex_);
     if (!comm_->isOpen()) {
         lastError_ = "Device not connected";
         return false;
     }
+    if (!circuitAllows("reset")) return false;
     comm_->stopPollLoop();
     if (!comm_->reset(3000)) {
         lastError_ = comm_->getLastError();
+        circuit_.recordFailure();
         return false;
     }
+    circuit_.recordSuccess();
     paymentInProgress_ = false;
     paymentCancelled_ = false;
     updateState(devices::DeviceState::STATE_READY);
@@ -148,17 +201,25 @@ bool Lv77BillAdapter::reconnect(const std::string& newPort) {
     comm_->stopPollLoop();
     comm_->close();
     comPort_ = newPort;
+    circuit_.reset();
     updateState(devices::DeviceState::DISCONNECTED);
     logging::Logger::getInstance().info("[LV77] Reconnected to " + newPort + " (next startPayment will use this port)");
     return true;
 }
 
 bool Lv77BillAdapter::checkDevice() {
+    std::lock_guard<std::mutex> ioLock(ioMutex_);
+    // 회로 열림: 모든 COM 포트 순회(포트당 sync 2초) 없이 즉시 실패
+    if (!circuitAllows("device check")) {
+        updateState(devices::DeviceState::DISCONNECTED, devices::StateErrorCode::CIRCUIT_OPEN);
+        return false;
+    }
     lastError_.clear();
     if (comm_->isOpen()) comm_->close();
     std::vector<std::string> ports = smartro::SerialPort::getAvailablePorts();
     if (ports.empty()) {
         lastError_ = "No COM ports available";
+        circuit_.recordFailure();
         return false;
     }
     for (const auto& port : ports) {
@@ -169,6 +230,7 @@ bool Lv77BillAdapter::checkDevice() {
                 if (comm_->poll(status, 500)) {
                     if (status == STATUS_ENABLE || status == STATUS_INHIBIT) {
                         comPort_ = port;
+                        circuit_.recordSuccess();
                         updateState(devices::DeviceState::STATE_READY);
                         logging::Logger::getInstance().info("[LV77] checkDevice OK on " + port);
                         return true;
@@ -179,7 +241,30 @@ bool Lv77BillAdapter::checkDevice() {
         }
     }
     lastError_ = "LV77 not found on any COM port";
-    updateState(devices::DeviceState::DISCONNECTED);
+    circuit_.recordFailure();
+    updateState(devices::DeviceState::DISCONNECTED, devices::StateErrorCode::NOT_FOUND);
+    return false;
+}
+
+bool Lv77BillAdapter::heartbeat() {
+    std::unique_lock<std::mutex> ioLock(ioMutex_, std::try_to_lock);
+    if (!ioLock.owns_lock() || paymentInProgress_) return true;  // 결제 중에는 poll loop가 상태 확인
+    if (!comm_->isOpen()) return getState() == devices::DeviceState::STATE_READY;
+    if (!circuitAllows("heartbeat")) return false;
+    // 상태 poll 1회 (현재 포트만, sync/enable 없음)
+    uint8_t status = 0;
+    if (comm_->poll(status, 500) && (status == STATUS_ENABLE || status == STATUS_INHIBIT)) {
+        lastError_.clear();
+        circuit_.recordSuccess();
+        updateState(devices::DeviceState::STATE_READY);
+        return true;
+    }
+    lastError_ = "Heartbeat: no status response on " + comPort_;
+    circuit_.recordFailure();
+    if (getState() == devices::DeviceState::STATE_READY) {
+        logging::Logger::getInstance().warn("[LV77] " + lastError_);
+        updateState(devices::DeviceState::DISCONNECTED, devices::StateErrorCode::NO_RESPONSE);
+    }
     return false;
 }
 
@@ -216,49 +301,50 @@ void Lv77BillAdapter::setStateChangedCallback(std::function<void(devices::Device
 }
 
 void Lv77BillAdapter::onBillStacked(uint32_t amount) {
+    // 리액터 스레드: 누적/완료 판정만 하고 이벤트·상태 전이·DISABLE은 알림 스레드로 (순서 유지)
     if (paymentCancelled_ || !paymentInProgress_) return;
-    currentTotal_ += amount;
-    uint32_t currentTotal = currentTotal_.load();
-    if (cashBillStackedCallback_) {
-        cashBillStackedCallback_(amount, currentTotal);
-    } else if (paymentCompleteCallback_) {
-        devices::PaymentCompleteEvent ev;
-        ev.transactionId = makeTransactionId();
-        ev.amount = amount;
-        ev.cardNumber = "";
-        ev.approvalNumber = "";
-        ev.salesDate = "";
-        ev.salesTime = "";
-        ev.transactionMedium = "CASH";
-        ev.state = devices::DeviceState::STATE_READY;
-        ev.status = "SUCCESS";
-        ev.transactionType = "Cash";
-        ev.approvalAmount = std::to_string(amount);
-        ev.tax = "";
-        ev.serviceCharge = "";
-        ev.installments = "";
-        ev.merchantNumber = "";
-        ev.terminalNumber = "";
-        ev.issuer = "";
-        ev.acquirer = "";
-        paymentCompleteCallback_(ev);
-    }
-    logging::Logger::getInstance().info("[LV77] Bill accepted: " + std::to_string(amount) + " KRW (total " + std::to_string(currentTotal) + ")");
-
-    // 목표 금액 도달: 폴 스레드에서는 stopPollLoop 호출 금지(자기 join → deadlock/abort). 디테치 스레드에서 처리.
+    uint32_t currentTotal = (currentTotal_ += amount);
     uint32_t target = targetAmount_.load();
-    if (target > 0 && currentTotal_.load() >= target) {
+    bool targetReached = (target > 0 && currentTotal >= target);
+    if (targetReached) {
         paymentInProgress_ = false;
-        updateState(devices::DeviceState::STATE_READY);
-        uint32_t total = currentTotal_.load();
-        logging::Logger::getInstance().info("[LV77] Target reached: " + std::to_string(total) + " KRW, deferring stopPollLoop/disable to worker thread");
-        std::thread([this, total]() {
-            comm_->stopPollLoop();
-            comm_->disable();  // 0x5E → 현금결제기 DISABLE
-            if (paymentTargetReachedCallback_) paymentTargetReachedCallback_(total);
-            logging::Logger::getInstance().info("[LV77] DISABLE (0x5E) sent, cash_payment_target_reached event sent");
-        }).detach();
     }
+    postNotification([this, amount, currentTotal, targetReached]() {
+        if (cashBillStackedCallback_) {
+            cashBillStackedCallback_(amount, currentTotal);
+        } else if (paymentCompleteCallback_) {
+            devices::PaymentCompleteEvent ev;
+            ev.transactionId = makeTransactionId();
+            ev.amount = amount;
+            ev.cardNumber = "";
+            ev.approvalNumber = "";
+            ev.salesDate = "";
+            ev.salesTime = "";
+            ev.transactionMedium = "CASH";
+            ev.state = devices::DeviceState::STATE_READY;
+            ev.status = "SUCCESS";
+            ev.transactionType = "Cash";
+            ev.approvalAmount = std::to_string(amount);
+            ev.tax = "";
+            ev.serviceCharge = "";
+            ev.installments = "";
+            ev.merchantNumber = "";
+            ev.terminalNumber = "";
+            ev.issuer = "";
+            ev.acquirer = "";
+            paymentCompleteCallback_(ev);
+        }
+        logging::Logger::getInstance().info("[LV77] Bill accepted: " + std::to_string(amount) + " KRW (total " + std::to_string(currentTotal) + ")");
+
+        if (!targetReached) return;
+        // 목표 금액 도달: 폴 중지 → DISABLE(0x5E) → 이벤트 (리액터 밖이므로 stopPollLoop 대기 가능)
+        updateState(devices::DeviceState::STATE_READY);
+        logging::Logger::getInstance().info("[LV77] Target reached: " + std::to_string(currentTotal) + " KRW");
+        comm_->stopPollLoop();
+        comm_->disable();
+        if (paymentTargetReachedCallback_) paymentTargetReachedCallback_(currentTotal);
+        logging::Logger::getInstance().info("[LV77] DISABLE (0x5E) sent, cash_payment_target_reached event sent");
+    });
 }
 
 void Lv77BillAdapter::setPaymentTargetReachedCallback(std::function<void(uint32_t totalAmount)> callback) {
@@ -1,8 +1,8 @@
 // src/vendor_adapters/lv77/lv77_comm.cpp
 #include "logging/logger.h"
 #include "vendor_adapters/lv77/lv77_comm.h"
+#include <algorithm>
 #include <chrono>
-#include <thread>
 
 namespace lv77 {
 
@@ -21,6 +21,7 @@ void Lv77Comm::setError(const std::string& msg) {
 bool Lv77Comm::open(const std::string& portName) {
     std::lock_guard<std::mutex> lock(mutex_);
     lastError_.clear();
+    pollRtt_.reset();  // 포트(장치)가 바뀔 수 있음 — 응답 시간은 새로 측정
     if (port_.isOpen()) port_.close();
     if (!port_.open(portName, LV77_BAUD)) {
         setError("Failed to open port: " + portName);
@@ -41,9 +42,9 @@ void Lv77Comm::close() {
 }
 
 bool Lv77Comm::readByte(uint8_t& byte, uint32_t timeoutMs) {
-    size_t n = 0;
-    if (!port_.read(&byte, 1, n, timeoutMs) || n == 0) return false;
-    return true;
+    // 동기 명령 전용 (폴 루프 중에는 리액터가 유일한 리더).
+    // 포트의 수신 링에서 꺼냄 — 이미 같이 들어온 바이트는 syscall 없이 반환
+    return port_.readExact(&byte, 1, timeoutMs);
 }
 
 bool Lv77Comm::syncAfterPowerUp(uint32_t timeoutMs) {
@@ -175,86 +176,149 @@ bool Lv77Comm::rejectBill() {
     return true;
 }
 
-void Lv77Comm::pollLoopThread() {
+void Lv77Comm::schedulePoll(std::chrono::milliseconds delay) {
+    smartro::SerialReactor::getInstance().addTimer(delay, [this]() { onPollTimer(); }, &port_);
+}
+
+void Lv77Comm::onPollTimer() {
+    // 0x0C는 정해진 주기로 보내고, 응답/에스크로 바이트는 도착하는 대로 onBytes에서 처리
     const auto pollInterval = std::chrono::milliseconds(pollIntervalMs_);
-    int noResponseCount = 0;
-    while (pollLoopRunning_) {
-        uint8_t resp = 0;
-        auto loopStart = std::chrono::steady_clock::now();
-        {
+    if (pollOutstanding_) {
+        schedulePoll(pollInterval);  // 응답 한도가 주기보다 길어진 경우 — 이전 0x0C 판정이 먼저
+        return;
+    }
+    // 회로 열림(장치 분리 등): 쿨다운 동안 0x0C 전송 없이 대기, 이후 시험 poll 1회
+    if (breaker_ && !breaker_->allow()) {
+        schedulePoll(std::chrono::milliseconds(500));
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!port_.isOpen()) return;  // 포트 닫힘: stopPollLoop까지 폴 중단
+        uint8_t cmd = CMD_POLL_STATUS;
+        port_.write(&cmd, 1);
+    }
+    pollOutstanding_ = true;
+    pollLate_ = false;
+    pollSentAt_ = std::chrono::steady_clock::now();
+    // 응답 한도는 측정된 왕복 시간에서 (처음에는 주기 전체, 최대도 주기)
+    const smartro::RttEstimator::Bounds bounds{pollIntervalMs_, (std::min)(POLL_RESPONSE_FLOOR_MS, pollIntervalMs_), pollIntervalMs_};
+    pollDeadlineTimer_ = smartro::SerialReactor::getInstance().addTimer(
+        std::chrono::milliseconds(pollRtt_.timeoutMs(bounds)), [this]() { onPollDeadline(); }, &port_);
+    schedulePoll((!breaker_ && noResponseCount_ > 10) ? pollInterval + std::chrono::milliseconds(1500) : pollInterval);
+}
+
+void Lv77Comm::onPollDeadline() {
+    pollDeadlineTimer_ = 0;
+    if (!pollOutstanding_) return;
+    // 보낸 0x0C에 응답 없음 (다음 0x0C 전에 늦게 오면 그 시간도 표본으로 씀 — 재전송이 없어 모호하지 않음)
+    pollOutstanding_ = false;
+    pollLate_ = true;
+    pollRtt_.onTimeout();
+    noResponseCount_++;
+    if (breaker_) {
+        breaker_->recordFailure();
+    } else if (noResponseCount_ == 10) {
+        logging::Logger::getInstance().warn("[LV77] No response to poll (check COM/cable). Slowing poll to 2s.");
+    }
+}
+
+void Lv77Comm::onBytes(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        handleByte(data[i]);
+    }
+}
+
+void Lv77Comm::handleByte(uint8_t byte) {
+    // 3.2 Escrow: 0x81 수신 → 지폐코드 → 수락/반환 결정 → 0x02 또는 0x0F 전송 (초과 반환 확실히 동작)
+    if (escrowState_ == EscrowState::WaitingBillType) {
+        smartro::SerialReactor::getInstance().cancelTimer(escrowTimer_);
+        escrowTimer_ = 0;
+        if (!isBillTypeCode(byte)) {
+            logging::Logger::getInstance().warn("[LV77] Escrow: failed to read bill type after 0x81, sending reject");
             std::lock_guard<std::mutex> lock(mutex_);
-            if (!port_.isOpen()) break;
-            uint8_t cmd = CMD_POLL_STATUS;
+            uint8_t cmd = CMD_REJECT_BILL;  // 0x0F
             port_.write(&cmd, 1);
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(3));
-        size_t n = 0;
-        if (!port_.read(&resp, 1, n, pollIntervalMs_)) {
-            noResponseCount++;
-            if (noResponseCount == 10) {
-                logging::Logger::getInstance().warn("[LV77] No response to poll (check COM/cable). Slowing poll to 2s.");
-            } else if (noResponseCount > 10) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(1500));
-            }
-            std::this_thread::sleep_for(pollInterval);
-            continue;
-        }
-        noResponseCount = 0;
-        if (n == 0) continue;
-
-        // 3.2 Escrow: 0x81 수신 → 지폐코드 읽기 → 수락/반환 결정 → 0x02 또는 0x0F 전송 (초과 반환 확실히 동작)
-        if (resp == RSP_BILL_VALIDATED) {
-            uint8_t billType = 0;
-            if (!readByte(billType, 500) || !isBillTypeCode(billType)) {
-                logging::Logger::getInstance().warn("[LV77] Escrow: failed to read bill type after 0x81, sending reject");
-                std::lock_guard<std::mutex> lock(mutex_);
-                uint8_t cmd = CMD_REJECT_BILL;  // 0x0F
-                port_.write(&cmd, 1);
-                escrowState_ = EscrowState::Idle;
-                continue;
-            }
-            uint32_t amount = billCodeToAmount(billType);
-            escrowAmount_ = amount;
-            escrowState_ = EscrowState::WaitingAcceptReject;
-            bool accept = true;
-            if (escrowCallback_) accept = escrowCallback_(amount);
-            {
-                std::lock_guard<std::mutex> lock(mutex_);
-                uint8_t cmd = accept ? CMD_SYNC_ACK : CMD_REJECT_BILL;  // 0x02 or 0x0F
-                port_.write(&cmd, 1);
-            }
-            if (accept) {
-                logging::Logger::getInstance().info("[LV77] Escrow accept (0x02): " + std::to_string(amount) + " KRW");
-            } else {
-                logging::Logger::getInstance().info("[LV77] Escrow reject (0x0F): " + std::to_string(amount) + " KRW");
-            }
             escrowState_ = EscrowState::Idle;
-            continue;
+            return;
         }
-        if (resp == RSP_STACKING && billStackedCallback_) {
-            billStackedCallback_(escrowAmount_);
-        } else if (statusCallback_) {
-            statusCallback_(resp);
+        uint32_t amount = billCodeToAmount(byte);
+        escrowAmount_ = amount;
+        escrowState_ = EscrowState::WaitingAcceptReject;
+        bool accept = true;
+        if (escrowCallback_) accept = escrowCallback_(amount);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            uint8_t cmd = accept ? CMD_SYNC_ACK : CMD_REJECT_BILL;  // 0x02 or 0x0F
+            port_.write(&cmd, 1);
         }
-        auto elapsed = std::chrono::steady_clock::now() - loopStart;
-        if (elapsed < pollInterval) {
-            std::this_thread::sleep_for(pollInterval - elapsed);
+        if (accept) {
+            logging::Logger::getInstance().info("[LV77] Escrow accept (0x02): " + std::to_string(amount) + " KRW");
+        } else {
+            logging::Logger::getInstance().info("[LV77] Escrow reject (0x0F): " + std::to_string(amount) + " KRW");
         }
+        escrowState_ = EscrowState::Idle;
+        return;
+    }
+
+    if (pollOutstanding_ || pollLate_) {
+        pollOutstanding_ = false;
+        pollLate_ = false;
+        pollRtt_.addSample(std::chrono::steady_clock::now() - pollSentAt_);
+        smartro::SerialReactor::getInstance().cancelTimer(pollDeadlineTimer_);
+        pollDeadlineTimer_ = 0;
+    }
+    noResponseCount_ = 0;
+    if (breaker_) breaker_->recordSuccess();
+
+    if (byte == RSP_BILL_VALIDATED) {
+        // 지폐코드는 보통 같은 읽기에 함께 들어옴 — 500ms 안에 안 오면 반환
+        escrowState_ = EscrowState::WaitingBillType;
+        escrowTimer_ = smartro::SerialReactor::getInstance().addTimer(std::chrono::milliseconds(500),
+                                                                      [this]() { onEscrowTimeout(); }, &port_);
+        return;
+    }
+    if (byte == RSP_STACKING && billStackedCallback_) {
+        billStackedCallback_(escrowAmount_);
+    } else if (statusCallback_) {
+        statusCallback_(byte);
     }
 }
 
+void Lv77Comm::onEscrowTimeout() {
+    escrowTimer_ = 0;
+    if (escrowState_ != EscrowState::WaitingBillType) return;
+    logging::Logger::getInstance().warn("[LV77] Escrow: failed to read bill type after 0x81, sending reject");
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint8_t cmd = CMD_REJECT_BILL;  // 0x0F
+    port_.write(&cmd, 1);
+    escrowState_ = EscrowState::Idle;
+}
+
 void Lv77Comm::startPollLoop(uint32_t pollIntervalMs) {
     if (pollLoopRunning_) return;
     pollIntervalMs_ = pollIntervalMs;
+    pollOutstanding_ = false;
+    pollLate_ = false;
+    noResponseCount_ = 0;
+    pollDeadlineTimer_ = 0;
+    escrowTimer_ = 0;
+    escrowState_ = EscrowState::Idle;
     pollLoopRunning_ = true;
-    pollLoopThread_ = std::thread(&Lv77Comm::pollLoopThread, this);
+    // 모든 시리얼 장치가 하나의 리액터 스레드를 공유 — 장치별 폴 스레드 없음
+    smartro::SerialReactor::getInstance().addPort(port_, [this](const uint8_t* data, size_t length) {
+        onBytes(data, length);
+    });
+    schedulePoll(std::chrono::milliseconds(0));
     logging::Logger::getInstance().info("[LV77] Poll loop started, interval " + std::to_string(pollIntervalMs) + " ms");
 }
 
 void Lv77Comm::stopPollLoop() {
-    if (!pollLoopRunning_) return;
-    pollLoopRunning_ = false;
-    if (pollLoopThread_.joinable()) pollLoopThread_.join();
+    if (!pollLoopRunning_.exchange(false)) return;
+    // 반환 후에는 바이트 콜백/폴 타이머가 실행 중이지도, 다시 실행되지도 않음 (리액터 스레드에서 호출해도 안전)
+    smartro::SerialReactor::getInstance().removePort(port_);
+    pollDeadlineTimer_ = 0;
+    escrowTimer_ = 0;
     logging::Logger::getInstance().info("[LV77] Poll loop stopped");
 }
 
@@ -0,0 +1,138 @@
+// src/vendor_adapters/smartro/frame_decoder.cpp
+#include "vendor_adapters/smartro/frame_decoder.h"
+
+#include <algorithm>
+
+namespace smartro {
+
+namespace {
+    uint16_t dataLengthOf(const uint8_t* header) {
+        return static_cast<uint16_t>(header[33] | (header[34] << 8));  // Header 33-34, little endian
+    }
+} // namespace
+
+bool FrameDecoder::frameValid(const uint8_t* frame, size_t size) {
+    if (frame[size - TAIL_SIZE] != ETX) {
+        return false;
+    }
+    uint8_t bcc = 0;
+    for (size_t i = 0; i + 1 < size; ++i) {  // STX..ETX 포함
+        bcc ^= frame[i];
+    }
+    return bcc == frame[size - 1];
+}
+
+void FrameDecoder::reset() {
+    state_ = State::HUNT;
+    assembly_.clear();
+    expected_ = 0;
+}
+
+void FrameDecoder::feed(const uint8_t* data, size_t length, const Sink& sink) {
+    feedInternal(data, length, sink, 0);
+}
+
+void FrameDecoder::abandonPartial(const Sink& sink) {
+    // 끝까지 오지 않은 프레임: STX가 잡음이었을 수 있으므로 STX 다음부터 받은 바이트를 다시 훑음
+    // (다시 훑는 중 또 미완성 프레임이 생기면 같은 방식으로 반복)
+    while (state_ != State::HUNT) {
+        std::vector<uint8_t> rest(assembly_.begin() + 1, assembly_.end());
+        ++stats_.discardedBytes;
+        reset();
+        feedInternal(rest.data(), rest.size(), sink, 0);
+    }
+}
+
+void FrameDecoder::feedInternal(const uint8_t* data, size_t length, const Sink& sink, size_t quietUntil) {
+    size_t i = 0;
+    while (i < length) {
+        if (state_ == State::HUNT) {
+            uint8_t byte = data[i];
+            if ((byte == ACK || byte == NACK) && i >= quietUntil) {
+                sink(Token{byte == ACK ? TokenType::ACK : TokenType::NACK, FrameView()});
+                ++i;
+                continue;
+            }
+            if (byte != STX) {
+                ++stats_.discardedBytes;
+                ++i;
+                continue;
+            }
+            
+            // 프레임 전체가 이 청크 안에 있으면 복사 없이 바로 전달
+            size_t remaining = length - i;
+            if (remaining >= HEADER_SIZE) {
+                size_t dataLength = dataLengthOf(data + i);
+                size_t total = HEADER_SIZE + dataLength + TAIL_SIZE;
+                if (dataLength > MAX_DATA_LENGTH) {
+                    ++stats_.discardedBytes;  // 잡음 속의 0x02
+                    ++i;
+                    continue;
+                }
+                if (remaining >= total) {
+                    FrameView frame(data + i, total);
+                    if (frameValid(data + i, total)) {
+                        ++stats_.frames;
+                        ++stats_.zeroCopyFrames;
+                        sink(Token{TokenType::FRAME, frame});
+                        i += total;
+                    } else {
+                        if (i >= quietUntil) {
+                            ++stats_.badFrames;
+                            sink(Token{TokenType::BAD_FRAME, frame});
+                            quietUntil = i + total;
+                        }
+                        ++i;  // STX 다음부터 다시 탐색
+                    }
+                    continue;
+                }
+            }
+            
+            // 나뉘어 도착하는 프레임: 나머지가 올 때까지 조립
+            assembly_.assign(1, STX);
+            state_ = State::HEADER;
+            ++i;
+            continue;
+        }
+        
+        size_t target = (state_ == State::HEADER) ? HEADER_SIZE : expected_;
+        size_t take = (std::min)(target - assembly_.size(), length - i);
+        assembly_.insert(assembly_.end(), data + i, data + i + take);
+        i += take;
+        if (assembly_.size() < target) {
+            continue;
+        }
+        
+        if (state_ == State::HEADER) {
+            size_t dataLength = dataLengthOf(assembly_.data());
+            if (dataLength > MAX_DATA_LENGTH) {
+                // 가짜 STX: 헤더로 받은 바이트를 다시 훑음
+                std::vector<uint8_t> rest(assembly_.begin() + 1, assembly_.end());
+                ++stats_.discardedBytes;
+                reset();
+                feedInternal(rest.data(), rest.size(), sink, 0);
+                continue;
+            }
+            expected_ = HEADER_SIZE + dataLength + TAIL_SIZE;
+            state_ = State::BODY;
+            if (assembly_.size() < expected_) {
+                continue;
+            }
+        }
+        
+        // BODY 완료
+        if (frameValid(assembly_.data(), assembly_.size())) {
+            ++stats_.frames;
+            sink(Token{TokenType::FRAME, FrameView(assembly_.data(), assembly_.size())});
+            reset();
+        } else {
+            ++stats_.badFrames;
+            sink(Token{TokenType::BAD_FRAME, FrameView(assembly_.data(), assembly_.size())});
+            std::vector<uint8_t> rest(assembly_.begin() + 1, assembly_.end());
+            reset();
+            feedInternal(rest.data(), rest.size(), sink, rest.size());
+        }
+    }
+}
+
+} // namespace smartro
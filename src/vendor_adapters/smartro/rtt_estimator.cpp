@@ -0,0 +1,61 @@
+// src/vendor_adapters/smartro/rtt_estimator.cpp
+#include "vendor_adapters/smartro/rtt_estimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace smartro {
+
+void RttEstimator::addSample(std::chrono::steady_clock::duration rtt) {
+    double ms = std::chrono::duration<double, std::milli>(rtt).count();
+    if (ms < 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (samples_ == 0) {
+        srttMs_ = ms;
+        rttvarMs_ = ms / 2;
+    } else {
+        // alpha = 1/8, beta = 1/4 (RFC 6298)
+        rttvarMs_ = 0.75 * rttvarMs_ + 0.25 * std::fabs(srttMs_ - ms);
+        srttMs_ = 0.875 * srttMs_ + 0.125 * ms;
+    }
+    ++samples_;
+    backoffShift_ = 0;
+}
+
+void RttEstimator::onTimeout() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (backoffShift_ < MAX_BACKOFF_SHIFT) {
+        ++backoffShift_;
+    }
+}
+
+uint32_t RttEstimator::timeoutMs(const Bounds& bounds) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    double ms = (samples_ == 0) ? bounds.initialMs
+                                : srttMs_ + (std::max)(GRANULARITY_MS, 4 * rttvarMs_);
+    ms *= static_cast<double>(1u << backoffShift_);
+    ms = (std::min)((std::max)(ms, static_cast<double>(bounds.floorMs)), static_cast<double>(bounds.ceilingMs));
+    return static_cast<uint32_t>(std::ceil(ms));
+}
+
+void RttEstimator::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    srttMs_ = 0;
+    rttvarMs_ = 0;
+    samples_ = 0;
+    backoffShift_ = 0;
+}
+
+RttEstimator::Stats RttEstimator::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.srttMs = srttMs_;
+    stats.rttvarMs = rttvarMs_;
+    stats.samples = samples_;
+    stats.backoffShift = backoffShift_;
+    return stats;
+}
+
+} // namespace smartro
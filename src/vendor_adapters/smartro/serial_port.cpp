@@ -2,7 +2,25 @@
 // logger.h�?가??먼�? include?�여 Windows SDK 충돌 방�?
 #include "logging/logger.h"
 #include "vendor_adapters/smartro/serial_port.h"
+#ifdef _WIN32
 #include <windows.h>
+#include <initguid.h>
+#include <devguid.h>
+#include <setupapi.h>
+#else
+#include <termios.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#ifdef __linux__
+#include <linux/serial.h>
+#endif
+#endif
 #include <string>
 #include <algorithm>
 #include <vector>
@@ -12,8 +30,15 @@
 
 namespace smartro {
 
+#ifdef _WIN32
 SerialPort::SerialPort() 
     : handle_(INVALID_HANDLE_VALUE)
+    , readEvent_(CreateEventA(nullptr, TRUE, FALSE, nullptr))
+    , writeEvent_(CreateEventA(nullptr, TRUE, FALSE, nullptr))
+    , wakeEvent_(CreateEventA(nullptr, FALSE, FALSE, nullptr))
+    , readinessEvent_(CreateEventA(nullptr, TRUE, FALSE, nullptr))
+    , readinessOverlapped_(new OVERLAPPED())
+    , rxRing_(RX_RING_SIZE)
     , baudRate_(115200)
     , dataBits_(8)
     , stopBits_(1)
@@ -22,6 +47,11 @@ SerialPort::SerialPort()
 
 SerialPort::~SerialPort() {
     close();
+    if (readEvent_) CloseHandle(static_cast<HANDLE>(readEvent_));
+    if (writeEvent_) CloseHandle(static_cast<HANDLE>(writeEvent_));
+    if (wakeEvent_) CloseHandle(static_cast<HANDLE>(wakeEvent_));
+    if (readinessEvent_) CloseHandle(static_cast<HANDLE>(readinessEvent_));
+    delete static_cast<OVERLAPPED*>(readinessOverlapped_);
 }
 
 bool SerialPort::open(const std::string& portName, uint32_t baudRate) {
@@ -30,6 +60,7 @@ bool SerialPort::open(const std::string& portName, uint32_t baudRate) {
         close();
     }
     
+    std::unique_lock<std::shared_mutex> lock(handleMutex_);
     portName_ = portName;
     baudRate_ = baudRate;
     
@@ -53,7 +84,7 @@ bool SerialPort::open(const std::string& portName, uint32_t baudRate) {
             0,
             nullptr,
             OPEN_EXISTING,
-            0,
+            FILE_FLAG_OVERLAPPED,  // 읽기 대기 중에도 쓰기가 막히지 않도록 (동기 핸들은 커널에서 직렬화됨)
             nullptr
         );
         
@@ -94,25 +125,53 @@ bool SerialPort::open(const std::string& portName, uint32_t baudRate) {
     
     if (!configurePort()) {
         logError("Failed to configure serial port");
-        CloseHandle(static_cast<HANDLE>(handle_));
+        CloseHandle(static_cast<HANDLE>(handle_.load()));
         handle_ = INVALID_HANDLE_VALUE;
         return false;
     }
     
+    ++openGeneration_;
     logging::Logger::getInstance().debug("Serial port opened successfully: " + portName_);
+    lock.unlock();
+    notifyOpenChanged();
     return true;
 }
 
 void SerialPort::close() {
+    if (!isOpen()) return;
+    // 수신 대기(무기한일 수 있음)를 깨우고, 잠금을 얻을 때까지 새 읽기는 바로 반환
+    closing_ = true;
+    SetEvent(static_cast<HANDLE>(wakeEvent_));
+    CancelIoEx(static_cast<HANDLE>(handle_.load()), nullptr);
+    {
+        std::unique_lock<std::shared_mutex> lock(handleMutex_);
+        closeLocked();
+        closing_ = false;
+    }
+    notifyOpenChanged();
+}
+
+void SerialPort::closeLocked() {
     if (isOpen()) {
         logging::Logger::getInstance().debug("Closing serial port: " + portName_);
-        CloseHandle(static_cast<HANDLE>(handle_));
+        if (readinessPending_) {
+            // 리액터의 EV_RXCHAR 대기를 거둬들인 뒤 닫음 (OVERLAPPED가 닫힌 핸들을 가리키지 않도록)
+            DWORD ignored = 0;
+            CancelIoEx(static_cast<HANDLE>(handle_.load()), static_cast<OVERLAPPED*>(readinessOverlapped_));
+            GetOverlappedResult(static_cast<HANDLE>(handle_.load()), static_cast<OVERLAPPED*>(readinessOverlapped_), &ignored, TRUE);
+            readinessPending_ = false;
+        }
+        CloseHandle(static_cast<HANDLE>(handle_.load()));
         handle_ = INVALID_HANDLE_VALUE;
         portName_.clear();
     }
+    // 이전 포트의 잔여 입력은 새 포트와 무관
+    rxHead_ = rxTail_ = 0;
 }
 
 bool SerialPort::write(const uint8_t* data, size_t length) {
+    std::shared_lock<std::shared_mutex> handleLock(handleMutex_);
+    std::lock_guard<std::mutex> lock(writeMutex_);
     if (!isOpen()) {
         logging::Logger::getInstance().error("Cannot write: serial port not open");
         return false;
@@ -125,14 +184,17 @@ bool SerialPort::write(const uint8_t* data, size_t length) {
     
     logging::Logger::getInstance().debugHex("Serial TX", data, length);
     
+    HANDLE handle = static_cast<HANDLE>(handle_.load());
+    OVERLAPPED ov = {0};
+    ov.hEvent = static_cast<HANDLE>(writeEvent_);
+    ResetEvent(ov.hEvent);
+    
     DWORD bytesWritten = 0;
-    BOOL result = WriteFile(
-        static_cast<HANDLE>(handle_),
-        data,
-        static_cast<DWORD>(length),
-        &bytesWritten,
-        nullptr
-    );
+    ++writeCalls_;
+    BOOL result = WriteFile(handle, data, static_cast<DWORD>(length), nullptr, &ov);
+    if (result || GetLastError() == ERROR_IO_PENDING) {
+        result = GetOverlappedResult(handle, &ov, &bytesWritten, TRUE);
+    }
     
     if (!result || bytesWritten != length) {
         logError("Failed to write data");
@@ -142,8 +204,161 @@ bool SerialPort::write(const uint8_t* data, size_t length) {
     logging::Logger::getInstance().debug("Written " + std::to_string(bytesWritten) + " bytes");
     return true;
 }
+#else
+SerialPort::SerialPort()
+    : rxRing_(RX_RING_SIZE)
+    , baudRate_(115200)
+    , dataBits_(8)
+    , stopBits_(1)
+    , parity_(0) {  // NOPARITY
+    if (pipe(wakePipe_) != 0) {
+        wakePipe_[0] = wakePipe_[1] = -1;
+        logging::Logger::getInstance().warn("SerialPort: pipe() failed, close() cannot interrupt a pending read");
+        return;
+    }
+    for (int fd : wakePipe_) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+}
+
+SerialPort::~SerialPort() {
+    close();
+    for (int& fd : wakePipe_) {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+}
+
+bool SerialPort::open(const std::string& portName, uint32_t baudRate) {
+    if (isOpen()) {
+        logging::Logger::getInstance().warn("Serial port already open: " + portName_);
+        close();
+    }
+    
+    std::unique_lock<std::shared_mutex> lock(handleMutex_);
+    portName_ = portName;
+    baudRate_ = baudRate;
+    
+    // ttyUSB0 -> /dev/ttyUSB0
+    std::string devicePath = (portName.find('/') == std::string::npos) ? "/dev/" + portName : portName;
+    
+    logging::Logger::getInstance().debug("Opening serial port: " + devicePath + " (Baud: " + std::to_string(baudRate) + ")");
+    
+    // O_NONBLOCK: 모뎀 DCD를 기다리지 않고 바로 열림 (Windows처럼 열기 타임아웃 스레드 불필요),
+    // 이후 읽기/쓰기 대기는 poll로. O_NOCTTY: 서비스의 제어 터미널이 되지 않도록
+    int fd = ::open(devicePath.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        int error = errno;
+        if (error == EACCES || error == ENOENT || error == EBUSY) {
+            logging::Logger::getInstance().warn("Port " + portName + " is not available (error: " + std::strerror(error) + ")");
+        } else {
+            logError("Failed to open serial port");
+        }
+        return false;
+    }
+    
+    // Windows의 배타 열기(dwShareMode=0)에 해당: 다른 프로세스가 같은 포트를 열지 못하게 함
+    if (ioctl(fd, TIOCEXCL) != 0) {
+        logging::Logger::getInstance().debug("TIOCEXCL not supported on " + devicePath);
+    }
+    
+    fd_ = fd;
+    
+    if (!configurePort()) {
+        logError("Failed to configure serial port");
+        ::close(fd);
+        fd_ = -1;
+        return false;
+    }
+    setLowLatency();
+    
+    ++openGeneration_;
+    logging::Logger::getInstance().debug("Serial port opened successfully: " + portName_);
+    lock.unlock();
+    notifyOpenChanged();
+    return true;
+}
+
+void SerialPort::close() {
+    if (!isOpen()) return;
+    // poll()에서 대기 중인 읽기(무기한일 수 있음)를 깨우고, 잠금을 얻을 때까지 새 읽기는 바로 반환
+    closing_ = true;
+    if (wakePipe_[1] >= 0) {
+        char c = 1;
+        (void)::write(wakePipe_[1], &c, 1);
+    }
+    {
+        std::unique_lock<std::shared_mutex> lock(handleMutex_);
+        closeLocked();
+        closing_ = false;
+    }
+    notifyOpenChanged();
+}
+
+void SerialPort::closeLocked() {
+    if (isOpen()) {
+        logging::Logger::getInstance().debug("Closing serial port: " + portName_);
+        ::close(fd_.load());
+        fd_ = -1;
+        portName_.clear();
+    }
+    // 깨우기 바이트를 비워서 다음에 연 포트의 읽기가 바로 깨지 않도록
+    if (wakePipe_[0] >= 0) {
+        char drain[16];
+        while (::read(wakePipe_[0], drain, sizeof(drain)) > 0) {}
+    }
+    // 이전 포트의 잔여 입력은 새 포트와 무관
+    rxHead_ = rxTail_ = 0;
+}
+
+bool SerialPort::write(const uint8_t* data, size_t length) {
+    std::shared_lock<std::shared_mutex> handleLock(handleMutex_);
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    if (!isOpen()) {
+        logging::Logger::getInstance().error("Cannot write: serial port not open");
+        return false;
+    }
+    
+    if (!data || length == 0) {
+        logging::Logger::getInstance().warn("Attempted to write empty data");
+        return false;
+    }
+    
+    logging::Logger::getInstance().debugHex("Serial TX", data, length);
+    
+    int fd = fd_.load();
+    size_t bytesWritten = 0;
+    while (bytesWritten < length) {
+        ++writeCalls_;
+        ssize_t n = ::write(fd, data + bytesWritten, length - bytesWritten);
+        if (n > 0) {
+            bytesWritten += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            // 드라이버 송신 버퍼가 가득 참 — 빌 때까지 대기 (프레임은 수백 바이트라 보통 발생하지 않음)
+            pollfd pfd = {fd, POLLOUT, 0};
+            if (poll(&pfd, 1, 1000) > 0 && !(pfd.revents & (POLLERR | POLLHUP | POLLNVAL))) {
+                continue;
+            }
+        }
+        logError("Failed to write data");
+        return false;
+    }
+    
+    logging::Logger::getInstance().debug("Written " + std::to_string(bytesWritten) + " bytes");
+    return true;
+}
+#endif
 
 bool SerialPort::read(uint8_t* buffer, size_t bufferSize, size_t& bytesRead, uint32_t timeoutMs) {
+    bytesRead = 0;
+    std::shared_lock<std::shared_mutex> handleLock(handleMutex_);
+    std::lock_guard<std::mutex> lock(readMutex_);
     if (!isOpen()) {
         logging::Logger::getInstance().error("Cannot read: serial port not open");
         return false;
@@ -154,35 +369,170 @@ bool SerialPort::read(uint8_t* buffer, size_t bufferSize, size_t& bytesRead, uin
         return false;
     }
     
-    // ?�?�아???�정
-    COMMTIMEOUTS timeouts = {0};
-    timeouts.ReadIntervalTimeout = 0;
-    timeouts.ReadTotalTimeoutConstant = timeoutMs;
-    timeouts.ReadTotalTimeoutMultiplier = 0;
-    timeouts.WriteTotalTimeoutConstant = 0;
-    timeouts.WriteTotalTimeoutMultiplier = 0;
+    if (bufferedLocked() == 0 && !fillLocked(timeoutMs)) {
+        return false;
+    }
+    bytesRead = (std::min)(bufferSize, bufferedLocked());
+    copyOutLocked(buffer, bytesRead);
+    rxHead_ += bytesRead;
+    return bytesRead > 0;
+}
+
+size_t SerialPort::available() {
+    std::shared_lock<std::shared_mutex> handleLock(handleMutex_);
+    std::lock_guard<std::mutex> lock(readMutex_);
+    return bufferedLocked();
+}
+
+size_t SerialPort::peek(uint8_t* buffer, size_t maxLength, uint32_t timeoutMs) {
+    std::shared_lock<std::shared_mutex> handleLock(handleMutex_);
+    std::lock_guard<std::mutex> lock(readMutex_);
+    if (!isOpen() || !buffer || maxLength == 0) {
+        return 0;
+    }
+    if (bufferedLocked() == 0 && !fillLocked(timeoutMs)) {
+        return 0;
+    }
+    size_t length = (std::min)(maxLength, bufferedLocked());
+    copyOutLocked(buffer, length);
+    return length;
+}
+
+size_t SerialPort::peekView(const uint8_t*& data, uint32_t timeoutMs) {
+    std::shared_lock<std::shared_mutex> handleLock(handleMutex_);
+    std::lock_guard<std::mutex> lock(readMutex_);
+    data = nullptr;
+    if (!isOpen()) {
+        return 0;
+    }
+    if (bufferedLocked() == 0 && !fillLocked(timeoutMs)) {
+        return 0;
+    }
+    // 링 끝에서 잘리는 부분은 다음 호출에서 (디코더가 이어 붙임)
+    size_t start = rxHead_ & (RX_RING_SIZE - 1);
+    data = rxRing_.data() + start;
+    return (std::min)(bufferedLocked(), RX_RING_SIZE - start);
+}
+
+void SerialPort::consume(size_t length) {
+    std::shared_lock<std::shared_mutex> handleLock(handleMutex_);
+    std::lock_guard<std::mutex> lock(readMutex_);
+    rxHead_ += (std::min)(length, bufferedLocked());
+}
+
+bool SerialPort::readExact(uint8_t* buffer, size_t length, uint32_t timeoutMs) {
+    std::shared_lock<std::shared_mutex> handleLock(handleMutex_);
+    std::lock_guard<std::mutex> lock(readMutex_);
+    if (!isOpen() || !buffer || length > RX_RING_SIZE) {
+        return false;
+    }
     
-    SetCommTimeouts(static_cast<HANDLE>(handle_), &timeouts);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (bufferedLocked() < length) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (remaining <= 0) {
+            return false;  // 받은 바이트는 링에 남겨둠 (다음 호출에서 사용)
+        }
+        if (!fillLocked(static_cast<uint32_t>(remaining))) {
+            return false;  // 남은 시간 동안 한 바이트도 안 옴, 또는 포트 오류
+        }
+    }
+    copyOutLocked(buffer, length);
+    rxHead_ += length;
+    return true;
+}
+
+void SerialPort::copyOutLocked(uint8_t* buffer, size_t length) const {
+    size_t start = rxHead_ & (RX_RING_SIZE - 1);
+    size_t first = (std::min)(length, RX_RING_SIZE - start);
+    std::copy(rxRing_.data() + start, rxRing_.data() + start + first, buffer);
+    std::copy(rxRing_.data(), rxRing_.data() + (length - first), buffer + first);
+}
+
+#ifdef _WIN32
+bool SerialPort::fillLocked(uint32_t timeoutMs) {
+    if (closing_) {
+        return false;
+    }
+    size_t used = bufferedLocked();
+    if (used == RX_RING_SIZE) {
+        return true;  // 링이 가득 참 — 소비자가 먼저 꺼내야 함
+    }
+    size_t tailIndex = rxTail_ & (RX_RING_SIZE - 1);
+    size_t space = (std::min)(RX_RING_SIZE - used, RX_RING_SIZE - tailIndex);
+    uint8_t* target = rxRing_.data() + tailIndex;
     
-    DWORD bytesReadDword = 0;
-    BOOL result = ReadFile(
-        static_cast<HANDLE>(handle_),
-        buffer,
-        static_cast<DWORD>(bufferSize),
-        &bytesReadDword,
-        nullptr
-    );
+    // 드라이버에 이미 있는 것부터 (ReadFile은 즉시 반환)
+    size_t received = 0;
+    if (!readNowLocked(target, space, received)) {
+        return false;
+    }
+    if (received == 0) {
+        if (timeoutMs == 0) {
+            return false;
+        }
+        // 문자 도착(EV_RXCHAR) 또는 wakeReader()/close()까지 커널에서 대기 — 유휴 시 깨어나지 않음
+        HANDLE handle = static_cast<HANDLE>(handle_.load());
+        OVERLAPPED ov = {0};
+        ov.hEvent = static_cast<HANDLE>(readEvent_);
+        ResetEvent(ov.hEvent);
+        DWORD mask = 0;
+        ++waits_;
+        if (!WaitCommEvent(handle, &mask, &ov)) {
+            if (GetLastError() != ERROR_IO_PENDING) {
+                logError("Failed to wait for comm event");
+                return false;
+            }
+            // 대기를 건 뒤 다시 확인: ReadFile과 WaitCommEvent 사이에 도착한 문자는 이벤트를 남기지 않음
+            COMSTAT stat = {0};
+            DWORD errors = 0;
+            bool queued = ClearCommError(handle, &errors, &stat) && stat.cbInQue > 0;
+            HANDLE events[2] = {ov.hEvent, static_cast<HANDLE>(wakeEvent_)};
+            DWORD rc = queued ? WAIT_OBJECT_0
+                              : WaitForMultipleObjects(2, events, FALSE, (timeoutMs == WAIT_FOREVER) ? INFINITE : timeoutMs);
+            if (queued || rc != WAIT_OBJECT_0) {
+                CancelIoEx(handle, &ov);
+            }
+            DWORD ignored = 0;
+            GetOverlappedResult(handle, &ov, &ignored, TRUE);  // 취소 완료까지 (ov는 스택 변수)
+            if (rc == WAIT_TIMEOUT || rc == WAIT_OBJECT_0 + 1) {
+                return false;  // 타임아웃 또는 깨우기
+            }
+            if (rc == WAIT_FAILED) {
+                logError("Failed to wait for data");
+                return false;
+            }
+        }
+        if (closing_ || !readNowLocked(target, space, received) || received == 0) {
+            return false;
+        }
+    }
+    commitLocked(target, received);
+    return true;
+}
+
+bool SerialPort::readNowLocked(uint8_t* target, size_t space, size_t& bytesRead) {
+    bytesRead = 0;
+    HANDLE handle = static_cast<HANDLE>(handle_.load());
+    OVERLAPPED ov = {0};
+    ov.hEvent = static_cast<HANDLE>(readEvent_);
+    ResetEvent(ov.hEvent);
     
-    bytesRead = static_cast<size_t>(bytesReadDword);
+    DWORD bytesReadDword = 0;
+    ++readCalls_;
+    BOOL result = ReadFile(handle, target, static_cast<DWORD>(space), nullptr, &ov);
+    if (result || GetLastError() == ERROR_IO_PENDING) {
+        result = GetOverlappedResult(handle, &ov, &bytesReadDword, TRUE);  // COMMTIMEOUTS: 즉시 완료
+    }
     
     if (!result) {
         DWORD error = GetLastError();
-        if (error == ERROR_OPERATION_ABORTED || error == WAIT_TIMEOUT) {
-            logging::Logger::getInstance().debug("Read timeout after " + std::to_string(timeoutMs) + "ms");
-            return false;
+        if (error == ERROR_OPERATION_ABORTED) {
+            return false;  // close()가 취소함
         }
-        // ERROR_ACCESS_DENIED (5): COM ??? ?? ????? ??????,
-        // ??? ?????, ?? ??. ?? ?? ??? ?? 5?? ? ?? ??.
+        // ERROR_ACCESS_DENIED (5): 포트가 다른 프로세스에 점유되었거나 장치가 분리됨.
+        // 읽기 스레드가 계속 재시도하므로 로그는 5초에 한 번만.
         if (error == 5) {
             static std::chrono::steady_clock::time_point lastLogTime;
             auto now = std::chrono::steady_clock::now();
@@ -197,14 +547,205 @@ bool SerialPort::read(uint8_t* buffer, size_t bufferSize, size_t& bytesRead, uin
         logError("Failed to read data");
         return false;
     }
+    bytesRead = bytesReadDword;
+    return true;
+}
+#else
+bool SerialPort::fillLocked(uint32_t timeoutMs) {
+    if (closing_) {
+        return false;
+    }
+    size_t used = bufferedLocked();
+    if (used == RX_RING_SIZE) {
+        return true;  // 링이 가득 참 — 소비자가 먼저 꺼내야 함
+    }
+    size_t tailIndex = rxTail_ & (RX_RING_SIZE - 1);
+    size_t space = (std::min)(RX_RING_SIZE - used, RX_RING_SIZE - tailIndex);
+    uint8_t* target = rxRing_.data() + tailIndex;
     
-    // 1바이???�기??로그 출력?��? ?�음 (?�무 많�? 로그 방�?)
-    // ?�러 바이???�을 ?�만 로그 출력
-    if (bytesRead > 0 && bytesRead > 1) {
-        logging::Logger::getInstance().debugHex("Serial RX", buffer, bytesRead);
+    // 읽을 수 있게 되거나 wakeReader()/close()까지 커널에서 대기 — 유휴 시 깨어나지 않음.
+    // 데이터가 이미 있으면 poll은 바로 반환. timeoutMs == 0: 드라이버에 있는 것만
+    int fd = fd_.load();
+    pollfd fds[2] = {{fd, POLLIN, 0}, {wakePipe_[0], POLLIN, 0}};
+    int rc;
+    ++waits_;
+    do {
+        rc = poll(fds, wakePipe_[0] >= 0 ? 2 : 1, (timeoutMs == WAIT_FOREVER) ? -1 : static_cast<int>(timeoutMs));
+    } while (rc < 0 && errno == EINTR);
+    if (rc == 0) {
+        return false;  // 타임아웃
+    }
+    if (rc < 0) {
+        logError("Failed to wait for data");
+        return false;
+    }
+    if (fds[1].revents & POLLIN) {
+        char drain[16];
+        while (::read(wakePipe_[0], drain, sizeof(drain)) > 0) {}
+        return false;  // 깨우기
     }
     
-    return bytesRead > 0;
+    size_t received = 0;
+    if (!readNowLocked(target, space, received) || received == 0) {
+        return false;
+    }
+    commitLocked(target, received);
+    return true;
+}
+
+bool SerialPort::readNowLocked(uint8_t* target, size_t space, size_t& bytesRead) {
+    bytesRead = 0;
+    ssize_t n;
+    do {
+        ++readCalls_;
+        n = ::read(fd_.load(), target, space);
+    } while (n < 0 && errno == EINTR);
+    if (n > 0) {
+        bytesRead = static_cast<size_t>(n);
+        return true;
+    }
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return true;
+    }
+    // n == 0: O_NONBLOCK tty에서는 행업 (USB-serial 분리). 읽기 스레드가 계속 재시도하므로 로그는 5초에 한 번만.
+    static std::chrono::steady_clock::time_point lastLogTime;
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastLogTime >= std::chrono::seconds(5)) {
+        lastLogTime = now;
+        if (n == 0) {
+            logging::Logger::getInstance().warn("Serial read failed: device hung up or disconnected (" + portName_ + ")");
+        } else {
+            logError("Failed to read data");
+        }
+    }
+    return false;
+}
+#endif
+
+void SerialPort::commitLocked(const uint8_t* target, size_t bytesRead) {
+    bytesRead_ += bytesRead;
+    rxTail_ += bytesRead;
+    // 1바이트(ACK/폴링 응답) 읽기는 로그 생략
+    if (bytesRead > 1) {
+        logging::Logger::getInstance().debugHex("Serial RX", target, bytesRead);
+    }
+}
+
+void SerialPort::wakeReader() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        wakePending_ = true;
+    }
+    stateCondition_.notify_all();
+#ifdef _WIN32
+    SetEvent(static_cast<HANDLE>(wakeEvent_));
+#else
+    if (wakePipe_[1] >= 0) {
+        char c = 1;
+        (void)::write(wakePipe_[1], &c, 1);
+    }
+#endif
+}
+
+bool SerialPort::waitUntilOpen(uint32_t timeoutMs) {
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    auto ready = [this] { return isOpen() || wakePending_; };
+    if (timeoutMs == WAIT_FOREVER) {
+        stateCondition_.wait(lock, ready);
+    } else {
+        stateCondition_.wait_for(lock, std::chrono::milliseconds(timeoutMs), ready);
+    }
+    wakePending_ = false;
+    return isOpen();
+}
+
+void SerialPort::setOpenListener(std::function<void()> listener) {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    openListener_ = std::move(listener);
+}
+
+void SerialPort::notifyOpenChanged() {
+    std::function<void()> listener;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        listener = openListener_;
+    }
+    stateCondition_.notify_all();  // waitUntilOpen()
+    if (listener) {
+        listener();
+    }
+}
+
+#ifdef _WIN32
+void* SerialPort::armReadiness(bool& ready) {
+    ready = false;
+    std::shared_lock<std::shared_mutex> handleLock(handleMutex_);
+    std::lock_guard<std::mutex> lock(readMutex_);
+    if (!isOpen() || closing_) {
+        return nullptr;
+    }
+    ready = bufferedLocked() > 0;
+    
+    HANDLE handle = static_cast<HANDLE>(handle_.load());
+    OVERLAPPED* ov = static_cast<OVERLAPPED*>(readinessOverlapped_);
+    if (!readinessPending_) {
+        *ov = OVERLAPPED();
+        ov->hEvent = static_cast<HANDLE>(readinessEvent_);
+        ResetEvent(ov->hEvent);
+        ++waits_;
+        if (WaitCommEvent(handle, &readinessMask_, ov)) {
+            ready = true;  // 이미 발생 (이벤트도 신호 상태)
+        } else if (GetLastError() == ERROR_IO_PENDING) {
+            readinessPending_ = true;
+        } else {
+            logError("Failed to wait for comm event");
+            return nullptr;
+        }
+    }
+    // 대기를 건 뒤 다시 확인: 그 전에 도착해 있던 바이트는 이벤트를 남기지 않음
+    COMSTAT stat = {0};
+    DWORD errors = 0;
+    if (ClearCommError(handle, &errors, &stat) && stat.cbInQue > 0) {
+        ready = true;
+    }
+    return readinessEvent_;
+}
+
+void SerialPort::completeReadiness() {
+    std::shared_lock<std::shared_mutex> handleLock(handleMutex_);
+    std::lock_guard<std::mutex> lock(readMutex_);
+    if (!readinessPending_ || !isOpen()) {
+        return;
+    }
+    DWORD ignored = 0;
+    if (GetOverlappedResult(static_cast<HANDLE>(handle_.load()), static_cast<OVERLAPPED*>(readinessOverlapped_), &ignored, FALSE)
+        || GetLastError() != ERROR_IO_INCOMPLETE) {
+        readinessPending_ = false;
+    }
+}
+
+void SerialPort::cancelReadiness() {
+    std::shared_lock<std::shared_mutex> handleLock(handleMutex_);
+    std::lock_guard<std::mutex> lock(readMutex_);
+    if (!readinessPending_ || !isOpen()) {
+        return;
+    }
+    HANDLE handle = static_cast<HANDLE>(handle_.load());
+    OVERLAPPED* ov = static_cast<OVERLAPPED*>(readinessOverlapped_);
+    CancelIoEx(handle, ov);
+    DWORD ignored = 0;
+    GetOverlappedResult(handle, ov, &ignored, TRUE);
+    readinessPending_ = false;
+}
+#endif
+
+SerialPort::IoStats SerialPort::getIoStats() const {
+    IoStats stats;
+    stats.readCalls = readCalls_;
+    stats.bytesRead = bytesRead_;
+    stats.waits = waits_;
+    stats.writeCalls = writeCalls_;
+    return stats;
 }
 
 bool SerialPort::setBaudRate(uint32_t baudRate) {
@@ -236,11 +777,12 @@ bool SerialPort::setParity(uint8_t parity) {
     return true;
 }
 
+#ifdef _WIN32
 bool SerialPort::configurePort() {
     DCB dcb = {0};
     dcb.DCBlength = sizeof(DCB);
     
-    if (!GetCommState(static_cast<HANDLE>(handle_), &dcb)) {
+    if (!GetCommState(static_cast<HANDLE>(handle_.load()), &dcb)) {
         logError("Failed to get comm state");
         return false;
     }
@@ -264,13 +806,13 @@ bool SerialPort::configurePort() {
     dcb.fRtsControl = RTS_CONTROL_ENABLE;
     dcb.fAbortOnError = FALSE;
     
-    if (!SetCommState(static_cast<HANDLE>(handle_), &dcb)) {
+    if (!SetCommState(static_cast<HANDLE>(handle_.load()), &dcb)) {
         logError("Failed to set comm state");
         return false;
     }
     
     // 버퍼 ?�기 ?�정
-    SetupComm(static_cast<HANDLE>(handle_), 4096, 4096);
+    SetupComm(static_cast<HANDLE>(handle_.load()), 4096, 4096);
     
     // ?�?�아???�정
     COMMTIMEOUTS timeouts = {0};
@@ -280,11 +822,17 @@ bool SerialPort::configurePort() {
     timeouts.WriteTotalTimeoutConstant = 0;
     timeouts.WriteTotalTimeoutMultiplier = 0;
     
-    if (!SetCommTimeouts(static_cast<HANDLE>(handle_), &timeouts)) {
+    if (!SetCommTimeouts(static_cast<HANDLE>(handle_.load()), &timeouts)) {
         logError("Failed to set comm timeouts");
         return false;
     }
     
+    // 수신 대기는 EV_RXCHAR 이벤트로 (위 타임아웃 설정으로 ReadFile은 드라이버에 있는 것만 즉시 반환)
+    if (!SetCommMask(static_cast<HANDLE>(handle_.load()), EV_RXCHAR)) {
+        logError("Failed to set comm mask");
+        return false;
+    }
+    
     logging::Logger::getInstance().debug("Serial port configured: BaudRate=" + std::to_string(baudRate_));
     return true;
 }
@@ -365,62 +913,186 @@ std::vector<std::string> SerialPort::getAvailablePorts(bool registryOnly) {
     return ports;
 }
 
-bool SerialPort::saveWorkingPort(const std::string& portName) {
-    // Windows API�??�용?�여 ?�일 ?�기 (fstream ?�??
-    HANDLE hFile = CreateFileA(
-        "smartro_port.cfg",
-        GENERIC_WRITE,
-        0,
-        nullptr,
-        CREATE_ALWAYS,
-        FILE_ATTRIBUTE_NORMAL,
-        nullptr
-    );
-    
-    if (hFile == INVALID_HANDLE_VALUE) {
-        logging::Logger::getInstance().warn("Failed to save working port to file");
+std::map<std::string, std::string> SerialPort::getPortHardwareIds() {
+    std::map<std::string, std::string> ids;
+    HDEVINFO devs = SetupDiGetClassDevsA(&GUID_DEVCLASS_PORTS, nullptr, nullptr, DIGCF_PRESENT);
+    if (devs == INVALID_HANDLE_VALUE) {
+        return ids;
+    }
+    SP_DEVINFO_DATA info;
+    info.cbSize = sizeof(info);
+    for (DWORD i = 0; SetupDiEnumDeviceInfo(devs, i, &info); ++i) {
+        HKEY key = SetupDiOpenDevRegKey(devs, &info, DICS_FLAG_GLOBAL, 0, DIREG_DEV, KEY_READ);
+        if (key == INVALID_HANDLE_VALUE) continue;
+        char portName[64] = {0};
+        DWORD size = sizeof(portName) - 1;
+        DWORD type = 0;
+        LONG rc = RegQueryValueExA(key, "PortName", nullptr, &type, reinterpret_cast<LPBYTE>(portName), &size);
+        RegCloseKey(key);
+        if (rc != ERROR_SUCCESS || type != REG_SZ) continue;
+        std::string port(portName);
+        if (port.find("COM") != 0) continue;
+        // e.g. USB\VID_0403&PID_6001\A50285BI, FTDIBUS\VID_0403+PID_6001+A50285BIA\0000
+        char instanceId[512] = {0};
+        if (SetupDiGetDeviceInstanceIdA(devs, &info, instanceId, sizeof(instanceId), nullptr)) {
+            ids[port] = instanceId;
+        }
+    }
+    SetupDiDestroyDeviceInfoList(devs);
+    return ids;
+}
+#else
+namespace {
+    bool toSpeed(uint32_t baudRate, speed_t& speed) {
+        switch (baudRate) {
+            case 1200: speed = B1200; return true;
+            case 2400: speed = B2400; return true;
+            case 4800: speed = B4800; return true;
+            case 9600: speed = B9600; return true;
+            case 19200: speed = B19200; return true;
+            case 38400: speed = B38400; return true;
+            case 57600: speed = B57600; return true;
+            case 115200: speed = B115200; return true;
+            case 230400: speed = B230400; return true;
+#ifdef B460800
+            case 460800: speed = B460800; return true;
+#endif
+#ifdef B921600
+            case 921600: speed = B921600; return true;
+#endif
+            default: return false;
+        }
+    }
+
+    bool hasPrefix(const std::string& name, const char* prefix) {
+        return name.compare(0, std::strlen(prefix), prefix) == 0;
+    }
+
+    // 빈 슬롯도 항상 존재하는 /dev/ttyS* 중 실제 UART가 있는 것만
+    bool isUartPresent(const std::string& path) {
+#ifdef __linux__
+        int fd = ::open(path.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) return false;
+        serial_struct serial;
+        bool present = ioctl(fd, TIOCGSERIAL, &serial) == 0 && serial.type != PORT_UNKNOWN;
+        ::close(fd);
+        return present;
+#else
+        (void)path;
         return false;
+#endif
     }
-    
-    DWORD bytesWritten = 0;
-    WriteFile(hFile, portName.c_str(), static_cast<DWORD>(portName.length()), &bytesWritten, nullptr);
-    CloseHandle(hFile);
-    
-    logging::Logger::getInstance().info("Saved working port: " + portName);
-    return true;
 }
 
-std::string SerialPort::loadWorkingPort() {
-    // Windows API�??�용?�여 ?�일 ?�기 (fstream ?�??
-    HANDLE hFile = CreateFileA(
-        "smartro_port.cfg",
-        GENERIC_READ,
-        0,
-        nullptr,
-        OPEN_EXISTING,
-        FILE_ATTRIBUTE_NORMAL,
-        nullptr
-    );
+bool SerialPort::configurePort() {
+    int fd = fd_.load();
+    termios tio;
+    if (tcgetattr(fd, &tio) != 0) {
+        logError("Failed to get comm state");
+        return false;
+    }
     
-    if (hFile == INVALID_HANDLE_VALUE) {
-        return "";
+    speed_t speed;
+    if (!toSpeed(baudRate_, speed)) {
+        logging::Logger::getInstance().error("Unsupported baud rate: " + std::to_string(baudRate_));
+        return false;
     }
     
-    char buffer[256] = {0};
-    DWORD bytesRead = 0;
-    ReadFile(hFile, buffer, sizeof(buffer) - 1, &bytesRead, nullptr);
-    CloseHandle(hFile);
+    // raw 모드: 줄 단위 처리/에코/문자 변환 없음 (Windows fBinary)
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    tio.c_cflag &= ~(CSIZE | PARENB | PARODD | CSTOPB);
+#ifdef CRTSCTS
+    tio.c_cflag &= ~CRTSCTS;  // fOutxCtsFlow = FALSE
+#endif
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag |= (dataBits_ == 5) ? CS5 : (dataBits_ == 6) ? CS6 : (dataBits_ == 7) ? CS7 : CS8;
+    if (parity_ == 1) tio.c_cflag |= PARENB | PARODD;
+    else if (parity_ == 2) tio.c_cflag |= PARENB;
+    if (stopBits_ == 2) tio.c_cflag |= CSTOPB;
+    tio.c_iflag &= ~(IXON | IXOFF | IXANY);  // fOutX / fInX = FALSE
+    if (parity_ != 0) tio.c_iflag |= INPCK;
+    // 대기는 poll이 담당하므로 read()는 드라이버에 있는 만큼 즉시 반환 (VMIN=0, VTIME=0)
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
     
-    std::string portName(buffer, bytesRead);
+    if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+        logError("Failed to set comm state");
+        return false;
+    }
     
-    // 공백 ?�거
-    portName.erase(portName.find_last_not_of(" \t\n\r\f\v") + 1);
+    // DTR_CONTROL_ENABLE / RTS_CONTROL_ENABLE
+    int lines = TIOCM_DTR | TIOCM_RTS;
+    ioctl(fd, TIOCMBIS, &lines);
     
-    if (!portName.empty()) {
-        logging::Logger::getInstance().info("Loaded saved port: " + portName);
+    logging::Logger::getInstance().debug("Serial port configured: BaudRate=" + std::to_string(baudRate_));
+    return true;
+}
+
+void SerialPort::setLowLatency() {
+#ifdef __linux__
+    // USB-serial 칩(FTDI 등)은 수신 바이트를 기본 16ms까지 모아서 올려보내므로 1바이트 ACK에도 지연이 생김.
+    // ASYNC_LOW_LATENCY로 즉시 전달 요청 (지원하지 않는 드라이버는 무시)
+    int fd = fd_.load();
+    serial_struct serial;
+    if (ioctl(fd, TIOCGSERIAL, &serial) == 0 && !(serial.flags & ASYNC_LOW_LATENCY)) {
+        serial.flags |= ASYNC_LOW_LATENCY;
+        if (ioctl(fd, TIOCSSERIAL, &serial) != 0) {
+            logging::Logger::getInstance().debug("ASYNC_LOW_LATENCY not supported on " + portName_);
+        }
+    }
+    // 최근 커널의 ftdi_sio는 위 플래그 대신 sysfs latency_timer(ms)를 따름 (쓰기 권한은 udev 규칙으로)
+    std::string name = portName_.substr(portName_.rfind('/') + 1);
+    std::ofstream latencyTimer("/sys/bus/usb-serial/devices/" + name + "/latency_timer");
+    if (latencyTimer) {
+        latencyTimer << 1;
+    }
+#endif
+}
+
+void SerialPort::logError(const std::string& operation) {
+    int error = errno;
+    std::string errorMsg = operation + " failed. Error code: " + std::to_string(error) + " (" + std::strerror(error) + ")";
+    logging::Logger::getInstance().error(errorMsg);
+}
+
+std::vector<std::string> SerialPort::getAvailablePorts(bool registryOnly) {
+    std::vector<std::string> ports;
+    
+    // by-id 링크가 가리키는 장치 (USB-serial). 이름은 /dev/ttyUSB0 형태로 통일
+    for (const auto& id : getPortHardwareIds()) {
+        ports.push_back(id.first);
     }
     
-    return portName;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("/dev", ec)) {
+        std::string name = entry.path().filename().string();
+        bool usbSerial = hasPrefix(name, "ttyUSB") || hasPrefix(name, "ttyACM");
+        // ttyS*는 장치가 없어도 슬롯마다 존재 — 레지스트리 전용 모드(핫플러그 감시)에서는 제외
+        bool uart = !registryOnly && hasPrefix(name, "ttyS") && isUartPresent(entry.path().string());
+        if (usbSerial || uart) {
+            ports.push_back(entry.path().string());
+        }
+    }
+    
+    std::sort(ports.begin(), ports.end());
+    ports.erase(std::unique(ports.begin(), ports.end()), ports.end());
+    return ports;
+}
+
+std::map<std::string, std::string> SerialPort::getPortHardwareIds() {
+    std::map<std::string, std::string> ids;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("/dev/serial/by-id", ec)) {
+        std::error_code linkError;
+        std::filesystem::path device = std::filesystem::canonical(entry.path(), linkError);
+        if (linkError) continue;
+        // e.g. usb-FTDI_FT232R_USB_UART_A50285BI-if00-port0
+        ids[device.string()] = entry.path().filename().string();
+    }
+    return ids;
 }
+#endif
 
 } // namespace smartro
@@ -0,0 +1,416 @@
+// src/vendor_adapters/smartro/serial_reactor.cpp
+// logger.h를 가장 먼저 include하여 Windows SDK 충돌 방지
+#include "logging/logger.h"
+#include "vendor_adapters/smartro/serial_reactor.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+#include <algorithm>
+#include <string>
+
+namespace smartro {
+
+SerialReactor& SerialReactor::getInstance() {
+    static SerialReactor instance;
+    return instance;
+}
+
+#ifdef _WIN32
+SerialReactor::SerialReactor()
+    : wakeEvent_(CreateEventA(nullptr, FALSE, FALSE, nullptr)) {
+}
+#else
+SerialReactor::SerialReactor() {
+    if (pipe(wakePipe_) != 0) {
+        wakePipe_[0] = wakePipe_[1] = -1;
+        logging::Logger::getInstance().error("SerialReactor: pipe() failed, port changes are only seen on the next event");
+        return;
+    }
+    for (int fd : wakePipe_) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+}
+#endif
+
+SerialReactor::~SerialReactor() {
+    running_ = false;
+    wake();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+#ifdef _WIN32
+    if (wakeEvent_) CloseHandle(static_cast<HANDLE>(wakeEvent_));
+#else
+    for (int& fd : wakePipe_) {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+#endif
+}
+
+void SerialReactor::wake() {
+#ifdef _WIN32
+    if (wakeEvent_) SetEvent(static_cast<HANDLE>(wakeEvent_));
+#else
+    if (wakePipe_[1] >= 0) {
+        char c = 1;
+        (void)::write(wakePipe_[1], &c, 1);  // 파이프가 가득 차 있으면 이미 깨어날 예정
+    }
+#endif
+}
+
+void SerialReactor::ensureThreadLocked() {
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    thread_ = std::thread(&SerialReactor::run, this);
+}
+
+void SerialReactor::addPort(SerialPort& port, DataHandler handler) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& kv : entries_) {
+            if (kv.second->port == &port) {
+                logging::Logger::getInstance().warn("SerialReactor: port already registered: " + port.getPortName());
+                return;
+            }
+        }
+        auto entry = std::make_shared<Entry>();
+        entry->id = nextId_++;
+        entry->port = &port;
+        entry->handler = std::move(handler);
+        entries_[entry->id] = entry;
+        ensureThreadLocked();
+    }
+    // 열림/닫힘이 바뀌면 대기 목록을 다시 만들도록
+    port.setOpenListener([this]() { wake(); });
+    wake();
+    logging::Logger::getInstance().debug("SerialReactor: watching " + port.getPortName());
+}
+
+void SerialReactor::removePort(SerialPort& port) {
+    const bool self = inReactorThread();
+    std::unique_lock<std::mutex> dispatchLock(dispatchMutex_, std::defer_lock);
+    if (!self) {
+        dispatchLock.lock();  // 실행 중인 핸들러/타이머가 끝날 때까지
+    }
+    bool found = false;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            if (it->second->port == &port) {
+                entries_.erase(it);
+                found = true;
+                break;
+            }
+        }
+        for (auto it = timers_.begin(); it != timers_.end();) {
+            it = (it->second.owner == &port) ? timers_.erase(it) : std::next(it);
+        }
+        // 리액터가 OS 대기 중이면 이 포트의 핸들을 아직 쥐고 있음 — 대기에서 나올 때까지 기다려야
+        // 호출자가 포트를 닫거나 파괴해도 안전
+        if (found && !self && waiting_) {
+            uint64_t seq = waitSeq_;
+            wake();
+            waitCondition_.wait(lock, [this, seq]() { return waitSeq_ != seq || !running_; });
+        }
+    }
+    if (found) {
+#ifdef _WIN32
+        port.cancelReadiness();  // 남은 WaitCommEvent가 이후 동기 읽기의 대기와 충돌하지 않도록
+#endif
+        port.setOpenListener(nullptr);
+        logging::Logger::getInstance().debug("SerialReactor: stopped watching " + port.getPortName());
+    }
+}
+
+SerialReactor::TimerId SerialReactor::addTimer(std::chrono::milliseconds delay, std::function<void()> callback, SerialPort* owner) {
+    TimerId id;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        id = nextId_++;
+        Timer& timer = timers_[id];
+        timer.deadline = std::chrono::steady_clock::now() + delay;
+        timer.callback = std::move(callback);
+        timer.owner = owner;
+        ensureThreadLocked();
+    }
+    if (!inReactorThread()) {
+        wake();  // 리액터 스레드에서 추가한 타이머는 다음 대기 계산에 자연히 반영됨
+    }
+    return id;
+}
+
+void SerialReactor::cancelTimer(TimerId id) {
+    if (id == 0) {
+        return;
+    }
+    std::unique_lock<std::mutex> dispatchLock(dispatchMutex_, std::defer_lock);
+    if (!inReactorThread()) {
+        dispatchLock.lock();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    timers_.erase(id);
+}
+
+SerialReactor::Stats SerialReactor::getStats() const {
+    Stats stats;
+    stats.wakeups = wakeups_;
+    stats.dispatches = dispatches_;
+    stats.timersFired = timersFired_;
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.ports = entries_.size();
+    return stats;
+}
+
+int SerialReactor::msUntilNextTimerLocked() const {
+    if (timers_.empty()) {
+        return -1;
+    }
+    auto next = std::chrono::steady_clock::time_point::max();
+    for (const auto& kv : timers_) {
+        next = (std::min)(next, kv.second.deadline);
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (next <= now) {
+        return 0;
+    }
+    // 올림: 내림하면 기한 직전에 깨어나 한 번 더 헛돌게 됨
+    long long us = std::chrono::duration_cast<std::chrono::microseconds>(next - now).count();
+    return static_cast<int>((std::min)((us + 999) / 1000, 24LL * 60 * 60 * 1000));
+}
+
+void SerialReactor::run() {
+    threadId_ = std::this_thread::get_id();
+    logging::Logger::getInstance().info("SerialReactor: I/O thread started");
+    std::vector<std::shared_ptr<Entry>> ready;
+    while (running_) {
+        ready.clear();
+        waitForEvents(ready);
+        if (!running_) {
+            break;
+        }
+        ++wakeups_;
+
+        std::lock_guard<std::mutex> dispatchLock(dispatchMutex_);
+        for (const auto& entry : ready) {
+            dispatch(entry);
+        }
+        runDueTimers();
+    }
+    logging::Logger::getInstance().info("SerialReactor: I/O thread stopped");
+}
+
+void SerialReactor::dispatch(const std::shared_ptr<Entry>& entry) {
+    auto registered = [this, &entry]() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.find(entry->id) != entries_.end();
+    };
+    if (!registered()) {
+        return;  // 같은 회차의 앞선 핸들러/타이머가 제거함
+    }
+    SerialPort& port = *entry->port;
+    // 첫 조각은 드라이버에서 읽어 오고, 링이 경계에서 감겨 남은 부분은 이미 링에 있음
+    const uint8_t* data = nullptr;
+    size_t length = port.peekView(data, 0);
+    // 읽을 게 있다고 깨어났는데 계속 못 읽음 (ReadFile 오류 등) — 헛돌며 같은 오류를 찍지 않도록 제외
+    entry->emptyReads = (length == 0) ? entry->emptyReads + 1 : 0;
+    if (entry->emptyReads >= MAX_EMPTY_READS && port.isOpen()) {
+        entry->emptyReads = 0;
+        entry->parked = true;
+        logging::Logger::getInstance().warn("SerialReactor: " + port.getPortName() + " is signalled but unreadable, waiting for reopen");
+        return;
+    }
+    while (length > 0) {
+        ++dispatches_;
+        try {
+            entry->handler(data, length);
+        } catch (const std::exception& e) {
+            logging::Logger::getInstance().error("SerialReactor: handler for " + port.getPortName() + " threw: " + e.what());
+        }
+        port.consume(length);  // 예외여도 버림 — 같은 바이트로 무한 재시도하지 않도록
+        if (!registered()) {
+            return;  // 핸들러가 스스로 제거함
+        }
+        length = (port.available() > 0) ? port.peekView(data, 0) : 0;
+    }
+    if (entry->hangup) {
+        entry->hangup = false;
+        entry->parked = true;  // 다시 열릴 때(세대 변경)까지 대기 목록에서 제외 — 헛돌기 방지
+        if (port.isOpen()) {
+            logging::Logger::getInstance().warn("SerialReactor: " + port.getPortName() + " hung up, waiting for reopen");
+        }
+    }
+}
+
+void SerialReactor::runDueTimers() {
+    for (;;) {
+        std::function<void()> callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto now = std::chrono::steady_clock::now();
+            auto due = timers_.end();
+            for (auto it = timers_.begin(); it != timers_.end(); ++it) {
+                if (it->second.deadline <= now && (due == timers_.end() || it->second.deadline < due->second.deadline)) {
+                    due = it;
+                }
+            }
+            if (due == timers_.end()) {
+                return;
+            }
+            callback = std::move(due->second.callback);
+            timers_.erase(due);
+        }
+        ++timersFired_;
+        try {
+            callback();
+        } catch (const std::exception& e) {
+            logging::Logger::getInstance().error(std::string("SerialReactor: timer callback threw: ") + e.what());
+        }
+    }
+}
+
+#ifdef _WIN32
+void SerialReactor::waitForEvents(std::vector<std::shared_ptr<Entry>>& ready) {
+    std::vector<HANDLE> handles{static_cast<HANDLE>(wakeEvent_)};
+    std::vector<std::shared_ptr<Entry>> owners{nullptr};
+    int timeoutMs;
+    {
+        std::lock_guard<std::mutex> dispatchLock(dispatchMutex_);
+        std::vector<std::shared_ptr<Entry>> entries;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& kv : entries_) entries.push_back(kv.second);
+        }
+        for (const auto& entry : entries) {
+            uint64_t generation = entry->port->getOpenGeneration();
+            if (entry->parked && generation == entry->generation) {
+                continue;
+            }
+            entry->parked = false;
+            entry->generation = generation;
+            bool isReady = false;
+            void* event = entry->port->armReadiness(isReady);
+            if (!event) {
+                entry->parked = entry->port->isOpen();  // 열려 있는데 대기 실패 — 다시 열릴 때까지 제외
+                continue;
+            }
+            if (isReady) {
+                ready.push_back(entry);
+            } else if (handles.size() < MAXIMUM_WAIT_OBJECTS) {
+                handles.push_back(static_cast<HANDLE>(event));
+                owners.push_back(entry);
+            } else {
+                logging::Logger::getInstance().warn("SerialReactor: too many ports, " + entry->port->getPortName() + " not waited on");
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        timeoutMs = ready.empty() ? msUntilNextTimerLocked() : 0;
+        waiting_ = true;
+    }
+
+    DWORD rc = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE,
+                                      timeoutMs < 0 ? INFINITE : static_cast<DWORD>(timeoutMs));
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        waiting_ = false;
+        ++waitSeq_;
+    }
+    waitCondition_.notify_all();
+
+    if (rc == WAIT_FAILED) {
+        logging::Logger::getInstance().error("SerialReactor: wait failed (error: " + std::to_string(GetLastError()) + ")");
+        Sleep(10);  // 핸들이 무효가 된 경우 다음 회차에서 다시 만들어짐
+        return;
+    }
+    if (rc > WAIT_OBJECT_0 && rc < WAIT_OBJECT_0 + handles.size()) {
+        const auto& entry = owners[rc - WAIT_OBJECT_0];
+        std::lock_guard<std::mutex> dispatchLock(dispatchMutex_);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (entries_.find(entry->id) == entries_.end()) {
+                return;  // 대기 중에 제거됨 — 포트에 손대지 않음
+            }
+        }
+        entry->port->completeReadiness();
+        if (std::find(ready.begin(), ready.end(), entry) == ready.end()) {
+            ready.push_back(entry);
+        }
+    }
+}
+#else
+void SerialReactor::waitForEvents(std::vector<std::shared_ptr<Entry>>& ready) {
+    std::vector<pollfd> fds{{wakePipe_[0], POLLIN, 0}};
+    std::vector<std::shared_ptr<Entry>> owners{nullptr};
+    int timeoutMs;
+    {
+        std::lock_guard<std::mutex> dispatchLock(dispatchMutex_);
+        std::vector<std::shared_ptr<Entry>> entries;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& kv : entries_) entries.push_back(kv.second);
+        }
+        for (const auto& entry : entries) {
+            uint64_t generation = entry->port->getOpenGeneration();
+            if (entry->parked && generation == entry->generation) {
+                continue;
+            }
+            entry->parked = false;
+            entry->generation = generation;
+            int fd = entry->port->readinessFd();
+            if (fd < 0) {
+                continue;  // 닫힘 — 열리면 open listener가 깨움
+            }
+            if (entry->port->available() > 0) {
+                ready.push_back(entry);  // 링에 남은 바이트는 poll에 보이지 않음
+            }
+            fds.push_back({fd, POLLIN, 0});
+            owners.push_back(entry);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        timeoutMs = ready.empty() ? msUntilNextTimerLocked() : 0;
+        waiting_ = true;
+    }
+
+    int rc;
+    do {
+        rc = poll(fds.data(), static_cast<nfds_t>(fds.size()), timeoutMs);
+    } while (rc < 0 && errno == EINTR);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        waiting_ = false;
+        ++waitSeq_;
+    }
+    waitCondition_.notify_all();
+
+    if (rc < 0) {
+        logging::Logger::getInstance().error("SerialReactor: poll failed (errno " + std::to_string(errno) + ")");
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return;
+    }
+    if (fds[0].revents & POLLIN) {
+        char drain[64];
+        while (::read(wakePipe_[0], drain, sizeof(drain)) > 0) {}
+    }
+    for (size_t i = 1; i < fds.size(); ++i) {
+        if (fds[i].revents == 0) {
+            continue;
+        }
+        const auto& entry = owners[i];
+        // POLLNVAL: 대기 중에 닫힌 fd — 세대가 바뀌었으면 다음 회차에 다시 등록됨
+        entry->hangup = (fds[i].revents & (POLLHUP | POLLERR | POLLNVAL)) != 0;
+        if (std::find(ready.begin(), ready.end(), entry) == ready.end()) {
+            ready.push_back(entry);
+        }
+    }
+}
+#endif
+
+} // namespace smartro
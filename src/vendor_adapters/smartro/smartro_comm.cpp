@@ -1,5 +1,5 @@
 // src/vendor_adapters/smartro/smartro_comm.cpp
-// logger.h???????? include??? Windows SDK ?? ???
+// logger.h를 먼저 include하여 Windows SDK 충돌 방지
 #include "logging/logger.h"
 #include "vendor_adapters/smartro/smartro_comm.h"
 #include <algorithm>
@@ -11,860 +11,590 @@ namespace smartro {
 SmartroComm::SmartroComm(SerialPort& serialPort)
     : serialPort_(serialPort)
     , state_(CommState::IDLE)
-    , receiverRunning_(false) {
+    , receiverRunning_(false)
+    , tokenSink_([this](const FrameDecoder::Token& token) { handleToken(token); }) {
 }
 
 SmartroComm::~SmartroComm() {
     stopResponseReceiver();
 }
 
-bool SmartroComm::sendDeviceCheckRequest(const std::string& terminalId,
-                                         DeviceCheckResponse& response,
-                                         uint32_t /*timeoutMs*/,
-                                         const std::string& preferredPort) {
-    std::lock_guard<std::mutex> lock(commMutex_);
-    state_ = CommState::IDLE;
-    lastError_.clear();
+// ====================================================================
+// Request/response correlation (writer side)
+// ====================================================================
 
-    if (serialPort_.isOpen()) {
-        serialPort_.close();
+bool SmartroComm::beginRequest(PendingRequest& request, char responseJobCode, uint32_t timeoutMs) {
+    request.responseJobCode = responseJobCode;
+    if (responseJobCode == 0) {
+        return true;
     }
-
-    std::vector<std::string> availablePorts = SerialPort::getAvailablePorts();
-
-    if (availablePorts.empty()) {
-        setError("No COM ports available");
-        state_ = CommState::ERROR;
+    std::unique_lock<std::mutex> lock(pendingMutex_);
+    // 같은 응답 Job Code를 기다리는 요청이 이미 있으면 응답을 구분할 수 없음 → 끝날 때까지 대기
+    if (!pendingCondition_.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                                    [&] { return pendingByJobCode_.count(responseJobCode) == 0; })) {
         return false;
     }
+    pendingByJobCode_[responseJobCode] = &request;
+    return true;
+}
 
-    if (!preferredPort.empty()) {
-        auto it = std::find(availablePorts.begin(), availablePorts.end(), preferredPort);
-        if (it != availablePorts.end()) {
-            std::rotate(availablePorts.begin(), it, it + 1);
-            logging::Logger::getInstance().info("Device check: Trying preferred port " + preferredPort + " first");
-        }
-    }
-    if (preferredPort.empty()) {
-        logging::Logger::getInstance().info("Device check: Testing all available COM ports");
-    }
-    
-    // ??????????????????
-    std::string currentPort;
-    std::vector<std::string> triedPorts;
-    
-    for (const auto& portToTry : availablePorts) {
-        // ??? ??? ???
-        if (serialPort_.isOpen()) {
-            serialPort_.close();
-        }
-        
-        logging::Logger::getInstance().info("Testing port: " + portToTry);
-        
-        // ??? ??? ???
-        bool portOpened = false;
-        try {
-            portOpened = serialPort_.open(portToTry, 115200);  // ?? ??????????
-        } catch (...) {
-            logging::Logger::getInstance().warn("Exception while opening port: " + portToTry);
-            portOpened = false;
-        }
-        
-        if (!portOpened) {
-            logging::Logger::getInstance().warn("Failed to open port: " + portToTry + ", trying next port...");
-            triedPorts.push_back(portToTry);
-            continue;
-        }
-        
-        currentPort = portToTry;
-        triedPorts.push_back(currentPort);
-        
-        // ??? ???
-        auto packet = SmartroProtocol::createDeviceCheckRequest(terminalId);
-        
-        // ??? ???
-        state_ = CommState::SENDING_REQUEST;
-        logging::Logger::getInstance().debug("Sending device check request on " + currentPort + "...");
-        
-        // ??? ??? ??? ?? ????
-        flushSerialBuffer();
-        
-        if (!serialPort_.write(packet.data(), packet.size())) {
-            logging::Logger::getInstance().warn("Failed to send request packet on " + currentPort);
-            serialPort_.close();  // ??? ???
-            currentPort.clear();  // ??? ??? ???????? ????
-            continue;
-        }
-        
-        // ACK ????(??? ??? ????? ??????????)
-        state_ = CommState::WAITING_ACK;
-        logging::Logger::getInstance().debug("Waiting for ACK on " + currentPort + "...");
-        
-        // ??? ??? ???????? ?????????? (1.5??
-        uint32_t ackTimeout = 1500;
-        
-        std::vector<uint8_t> responsePacket;
-        if (!waitForAck(ackTimeout, responsePacket)) {
-            logging::Logger::getInstance().warn("ACK timeout or NACK received on " + currentPort + " (timeout: " + std::to_string(ackTimeout) + "ms)");
-            serialPort_.close();  // ??? ???
-            currentPort.clear();  // ??? ??? ???????? ????
-            continue;
-        }
-        
-        // ??? ??? (??? ??? ????? ??????????)
-        state_ = CommState::RECEIVING_RESPONSE;
-        logging::Logger::getInstance().debug("Receiving response on " + currentPort + "...");
-        
-        // ??? ??? ???????? ?????????? (2??
-        uint32_t responseTimeout = 2000;
-        
-        if (!receiveResponse(responsePacket, responseTimeout)) {
-            logging::Logger::getInstance().warn("Failed to receive response on " + currentPort + " (timeout: " + std::to_string(responseTimeout) + "ms)");
-            serialPort_.close();  // ??? ???
-            currentPort.clear();  // ??? ??? ???????? ????
-            continue;
-        }
-        
-        // ??? ???
-        std::vector<uint8_t> header;
-        std::vector<uint8_t> payload;
-        
-        if (responsePacket.empty()) {
-            logging::Logger::getInstance().warn("Empty response packet on " + currentPort);
-            sendNack();
-            serialPort_.close();  // ??? ???
-            currentPort.clear();  // ??? ??? ???????? ????
-            continue;
-        }
-        
-        if (!SmartroProtocol::parsePacket(responsePacket.data(), responsePacket.size(), 
-                                         header, payload)) {
-            logging::Logger::getInstance().warn("Failed to parse response on " + currentPort);
-            sendNack();
-            serialPort_.close();  // ??? ???
-            currentPort.clear();  // ??? ??? ???????? ????
-            continue;
-        }
-        
-        // Job Code ???
-        if (header.size() < HEADER_SIZE) {
-            logging::Logger::getInstance().warn("Invalid header size on " + currentPort);
-            sendNack();
-            serialPort_.close();  // ??? ???
-            currentPort.clear();  // ??? ??? ???????? ????
-            continue;
-        }
-        
-        char jobCode = SmartroProtocol::extractJobCode(header.data());
-        if (jobCode != JOB_CODE_DEVICE_CHECK_RESPONSE) {
-            logging::Logger::getInstance().warn("Unexpected job code on " + currentPort + ": " + std::string(1, jobCode));
-            sendNack();
-            serialPort_.close();  // ??? ???
-            currentPort.clear();  // ??? ??? ???????? ????
-            continue;
-        }
-        
-        // ??? ????????
-        if (!SmartroProtocol::parseDeviceCheckResponse(payload.data(), payload.size(), response)) {
-            logging::Logger::getInstance().warn("Failed to parse device check response on " + currentPort);
-            sendNack();
-            serialPort_.close();  // ??? ???
-            currentPort.clear();  // ??? ??? ???????? ????
-            continue;
-        }
-        
-        // ???! ACK ?????? ??? ????
-        state_ = CommState::SENDING_ACK;
-        if (!sendAck()) {
-            logging::Logger::getInstance().warn("Failed to send ACK, but response was valid");
+void SmartroComm::endRequest(PendingRequest& request) {
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    auto it = pendingByJobCode_.find(request.responseJobCode);
+    if (it != pendingByJobCode_.end() && it->second == &request) {
+        pendingByJobCode_.erase(it);
+    }
+    // ACK 전에 포기한 요청(타임아웃)은 자리를 비워 둠 — 늦게 온 ACK가 다음 요청의 ACK로 잡히지 않도록
+    auto now = std::chrono::steady_clock::now();
+    for (auto waiter = ackWaiters_.begin(); waiter != ackWaiters_.end(); ++waiter) {
+        if (waiter->request != &request) continue;
+        bool answered = request.acked || request.nacked || request.completed;
+        if (!answered && now - waiter->writtenAt < std::chrono::milliseconds(STALE_ACK_WINDOW_MS)) {
+            waiter->request = nullptr;
+        } else {
+            ackWaiters_.erase(waiter);
         }
-        
-        // ???????? ????
-        SerialPort::saveWorkingPort(currentPort);
-        logging::Logger::getInstance().info("Device check successful on port: " + currentPort);
-        
-        state_ = CommState::COMPLETED;
-        logging::Logger::getInstance().debug("Device check request completed successfully");
-        return true;
+        break;
     }
-    
-    // ?? ??? ??? ???
-    if (serialPort_.isOpen()) {
-        serialPort_.close();
-    }
-    setError("Device check failed on all attempted ports: " + std::to_string(triedPorts.size()) + " ports tried");
-    state_ = CommState::ERROR;
-    return false;
+    pendingCondition_.notify_all();
 }
 
-bool smartro::SmartroComm::sendPaymentWaitRequest(const std::string& terminalId, 
-                                                  PaymentWaitResponse& response,
-                                                  uint32_t /*timeoutMs*/) {
-    std::lock_guard<std::mutex> lock(commMutex_);
-    state_ = CommState::IDLE;
-    lastError_.clear();
-    
-    if (!serialPort_.isOpen()) {
-        setError("Serial port is not open");
-        return false;
+void SmartroComm::eraseAckWaiterLocked(PendingRequest* request) {
+    ackWaiters_.erase(std::remove_if(ackWaiters_.begin(), ackWaiters_.end(),
+                                     [request](const AckWaiter& waiter) { return waiter.request == request; }),
+                      ackWaiters_.end());
+}
+
+bool SmartroComm::writeRequest(PendingRequest& request, const RequestPacket& packet) {
+    // 쓰기 순서 = 장치 ACK 순서: 등록과 쓰기를 한 번에 (읽기 스레드와는 무관하게 즉시 진행)
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    {
+        std::lock_guard<std::mutex> pendingLock(pendingMutex_);
+        ackWaiters_.push_back(AckWaiter{&request, std::chrono::steady_clock::now()});
     }
-    
-    // ??? ???
-    auto packet = SmartroProtocol::createPaymentWaitRequest(terminalId);
-    
-    // ??? ??? (???????? 1?? ???)
-    state_ = CommState::SENDING_REQUEST;
-    logging::Logger::getInstance().debug("Sending payment wait request...");
-    
     if (!serialPort_.write(packet.data(), packet.size())) {
-        setError("Failed to send request packet");
-        state_ = CommState::ERROR;
+        std::lock_guard<std::mutex> pendingLock(pendingMutex_);
+        eraseAckWaiterLocked(&request);  // 쓰지 못했으니 ACK도 오지 않음
         return false;
     }
-    
-    // ??? ??? ??? ?? ????(??? ????????)
-    flushSerialBuffer();
-    
-    // ACK ????(ACK ??? ???? ??? ?????????????????? ??)
-    state_ = CommState::WAITING_ACK;
-    logging::Logger::getInstance().debug("Waiting for ACK...");
-    
-    std::vector<uint8_t> responsePacket;
-    if (!waitForAck(ACK_TIMEOUT_MS, responsePacket)) {
-        setError("ACK timeout or NACK received");
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // ??? ??? (???? STX???????????)
-    state_ = CommState::RECEIVING_RESPONSE;
-    logging::Logger::getInstance().debug("Receiving response...");
-    
-    if (!receiveResponse(responsePacket, RESPONSE_TIMEOUT_MS)) {
-        setError("Failed to receive response");
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // ??? ???
-    std::vector<uint8_t> header;
-    std::vector<uint8_t> payload;
-    
-    if (responsePacket.empty()) {
-        setError("Empty response packet");
-        sendNack();
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    if (!SmartroProtocol::parsePacket(responsePacket.data(), responsePacket.size(), 
-                                     header, payload)) {
-        setError("Failed to parse response");
-        sendNack();
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // Job Code ???
-    if (header.size() < HEADER_SIZE) {
-        setError("Invalid header size: " + std::to_string(header.size()));
-        sendNack();
-        state_ = CommState::ERROR;
+    return true;
+}
+
+bool SmartroComm::waitForAck(PendingRequest& request, uint32_t timeoutMs) {
+    std::unique_lock<std::mutex> lock(pendingMutex_);
+    pendingCondition_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&] {
+        return request.acked || request.nacked || request.completed || !receiverRunning_;
+    });
+    if (request.nacked) {
+        logging::Logger::getInstance().warn("NACK received (0x15)");
         return false;
     }
-    
-    char jobCode = SmartroProtocol::extractJobCode(header.data());
-    if (jobCode != JOB_CODE_PAYMENT_WAIT_RESPONSE) {
-        setError("Unexpected job code: " + std::string(1, jobCode) + 
-                ", expected: " + std::string(1, JOB_CODE_PAYMENT_WAIT_RESPONSE));
-        sendNack();
-        state_ = CommState::ERROR;
+    if (!request.acked && !request.completed) {
+        logging::Logger::getInstance().error("Timeout waiting for ACK/NACK");
         return false;
     }
-    
-    // ??? ????????
-    if (!SmartroProtocol::parsePaymentWaitResponse(payload.data(), payload.size(), response)) {
-        setError("Failed to parse payment wait response data");
-        sendNack();
-        state_ = CommState::ERROR;
-        return false;
+    return true;
+}
+
+bool SmartroComm::waitForResponse(PendingRequest& request, uint32_t timeoutMs) {
+    std::unique_lock<std::mutex> lock(pendingMutex_);
+    auto ready = [&] { return request.completed || !receiverRunning_; };
+    if (timeoutMs == 0) {
+        pendingCondition_.wait(lock, ready);
+    } else {
+        pendingCondition_.wait_for(lock, std::chrono::milliseconds(timeoutMs), ready);
     }
-    
-    // ???! ACK ?????? ?? ??
-    state_ = CommState::SENDING_ACK;
-    if (!sendAck()) {
-        logging::Logger::getInstance().warn("Failed to send ACK, but response was valid");
+    return request.completed;
+}
+
+void SmartroComm::syncLatencyPort() {
+    // 추정치는 포트(장치)별 — 다른 포트로 바뀌면 처음부터 다시 측정
+    std::string port = serialPort_.getPortName();
+    std::lock_guard<std::mutex> lock(latencyMutex_);
+    if (port != latencyPort_) {
+        latencyPort_ = port;
+        ackRtt_.reset();
+        for (auto& kv : responseRtt_) {
+            kv.second.reset();
+        }
     }
-    
-    state_ = CommState::COMPLETED;
-    logging::Logger::getInstance().debug("Payment wait request completed successfully");
-    return true;
 }
 
-bool SmartroComm::sendCardUidReadRequest(const std::string& terminalId, 
-                                         CardUidReadResponse& response,
-                                         uint32_t /*timeoutMs*/) {
-    std::lock_guard<std::mutex> lock(commMutex_);
-    state_ = CommState::IDLE;
-    lastError_.clear();
-    
-    if (!serialPort_.isOpen()) {
-        setError("Serial port is not open");
+RttEstimator& SmartroComm::responseRttFor(char jobCode) {
+    // 명령마다 단말 처리 시간이 다르므로 응답 Job Code별로 따로 측정 (노드는 지우지 않으므로 참조 유효)
+    std::lock_guard<std::mutex> lock(latencyMutex_);
+    return responseRtt_[jobCode];
+}
+
+bool SmartroComm::transact(const RequestPacket& packet, char responseJobCode,
+                           uint32_t ackTimeoutMs, uint32_t responseTimeoutMs,
+                           std::vector<uint8_t>& responsePacket, bool ackBeforeResponse,
+                           uint32_t ceilingMs) {
+    responsePacket.clear();
+    ensureReceiver();
+    
+    // 정상 단말은 수십 ms 안에 응답 — 측정된 지연(SRTT + 4·RTTVAR)으로 대기해 고장을 빨리 판정
+    syncLatencyPort();
+    const bool adaptiveAck = (ackTimeoutMs == ADAPTIVE_TIMEOUT);
+    const bool adaptiveResponse = (responseTimeoutMs == ADAPTIVE_TIMEOUT);
+    if (adaptiveAck) {
+        ackTimeoutMs = ackRtt_.timeoutMs(ACK_BOUNDS);
+    }
+    RttEstimator* responseRtt = nullptr;
+    if (adaptiveResponse) {
+        responseRtt = &responseRttFor(responseJobCode);
+        responseTimeoutMs = responseRtt->timeoutMs(QUICK_RESPONSE_BOUNDS);
+    }
+    // 호출자의 timeoutMs가 추정치보다 작으면 그만큼만 기다림 — 그때의 타임아웃은 추정치를 늘리지 않음
+    bool ackCapped = false;
+    bool responseCapped = false;
+    if (ceilingMs > 0) {
+        ackCapped = adaptiveAck && ackTimeoutMs > ceilingMs;
+        if (ackCapped) ackTimeoutMs = ceilingMs;
+        responseCapped = adaptiveResponse && responseTimeoutMs > ceilingMs;
+        if (responseCapped) responseTimeoutMs = ceilingMs;
+    }
+    
+    PendingRequest request;
+    if (!beginRequest(request, responseJobCode, ackTimeoutMs)) {
+        setError("Another request waiting for job code '" + std::string(1, responseJobCode) + "' is still pending");
+        state_ = CommState::ERROR;
         return false;
     }
     
-    // ??? ???
-    auto packet = SmartroProtocol::createCardUidReadRequest(terminalId);
-    
-    // ??? ??? (???????? 1?? ???)
     state_ = CommState::SENDING_REQUEST;
-    logging::Logger::getInstance().debug("Sending card UID read request...");
-    
-    if (!serialPort_.write(packet.data(), packet.size())) {
+    if (!writeRequest(request, packet)) {
+        endRequest(request);
         setError("Failed to send request packet");
         state_ = CommState::ERROR;
         return false;
     }
+    auto sentAt = std::chrono::steady_clock::now();
     
-    // ??? ??? ??? ?? ????(??? ????????)
-    flushSerialBuffer();
-    
-    // ACK ????(ACK ??? ???? ??? ?????????????????? ??)
     state_ = CommState::WAITING_ACK;
-    logging::Logger::getInstance().debug("Waiting for ACK...");
-    
-    std::vector<uint8_t> responsePacket;
-    if (!waitForAck(ACK_TIMEOUT_MS, responsePacket)) {
-        setError("ACK timeout or NACK received");
+    if (!waitForAck(request, ackTimeoutMs)) {
+        bool timedOut = !request.nacked;
+        endRequest(request);
+        if (adaptiveAck && !ackCapped && timedOut && receiverRunning_) {
+            ackRtt_.onTimeout();
+        }
+        setError(timedOut ? "ACK timeout (" + std::to_string(ackTimeoutMs) + " ms)" : "NACK received");
         state_ = CommState::ERROR;
         return false;
     }
-    
-    // ??? ??? (???? STX???????????)
-    state_ = CommState::RECEIVING_RESPONSE;
-    logging::Logger::getInstance().debug("Receiving response...");
-    
-    if (!receiveResponse(responsePacket, RESPONSE_TIMEOUT_MS)) {
-        setError("Failed to receive response");
-        state_ = CommState::ERROR;
-        return false;
+    auto ackedAt = std::chrono::steady_clock::now();
+    if (adaptiveAck) {
+        ackRtt_.addSample(ackedAt - sentAt);
     }
     
-    // ??? ???
-    std::vector<uint8_t> header;
-    std::vector<uint8_t> payload;
-    
-    if (responsePacket.empty()) {
-        setError("Empty response packet");
-        sendNack();
-        state_ = CommState::ERROR;
-        return false;
+    if (ackBeforeResponse) {
+        state_ = CommState::SENDING_ACK;
+        if (!sendAck()) {
+            logging::Logger::getInstance().warn("Failed to send ACK");
+        }
     }
     
-    if (!SmartroProtocol::parsePacket(responsePacket.data(), responsePacket.size(), 
-                                     header, payload)) {
-        setError("Failed to parse response");
-        sendNack();
-        state_ = CommState::ERROR;
-        return false;
+    if (responseJobCode == 0) {
+        endRequest(request);
+        return true;
     }
     
-    // Job Code ???
-    if (header.size() < HEADER_SIZE) {
-        setError("Invalid header size: " + std::to_string(header.size()));
-        sendNack();
+    state_ = CommState::RECEIVING_RESPONSE;
+    bool received = waitForResponse(request, responseTimeoutMs);
+    endRequest(request);
+    if (!received) {
+        if (adaptiveResponse && !responseCapped && receiverRunning_) {
+            responseRtt->onTimeout();
+        }
+        setError("Failed to receive response (" + std::to_string(responseTimeoutMs) + " ms)");
         state_ = CommState::ERROR;
         return false;
     }
+    if (adaptiveResponse) {
+        responseRtt->addSample(std::chrono::steady_clock::now() - ackedAt);
+    }
+    responsePacket = std::move(request.packet);
+    return true;
+}
+
+bool SmartroComm::exchange(const RequestPacket& packet, char responseJobCode, const std::string& what,
+                           std::vector<uint8_t>& responsePacket,
+                           uint32_t ackTimeoutMs, uint32_t responseTimeoutMs, uint32_t ceilingMs) {
+    state_ = CommState::IDLE;
+    clearError();
     
-    char jobCode = SmartroProtocol::extractJobCode(header.data());
-    if (jobCode != JOB_CODE_CARD_UID_READ_RESPONSE) {
-        setError("Unexpected job code: " + std::string(1, jobCode) + 
-                ", expected: " + std::string(1, JOB_CODE_CARD_UID_READ_RESPONSE));
-        sendNack();
-        state_ = CommState::ERROR;
+    if (!serialPort_.isOpen()) {
+        setError("Serial port is not open");
         return false;
     }
     
-    // ??? ????????
-    if (!SmartroProtocol::parseCardUidReadResponse(payload.data(), payload.size(), response)) {
-        setError("Failed to parse card UID read response data");
+    logging::Logger::getInstance().debug("Sending " + what + " request...");
+    
+    // ETX/BCC는 읽기 스레드의 디코더가, Job Code는 슬롯 매칭이 이미 확인함
+    return transact(packet, responseJobCode, ackTimeoutMs, responseTimeoutMs, responsePacket, false, ceilingMs);
+}
+
+bool SmartroComm::completeResponse(bool parsed, const std::string& what) {
+    if (!parsed) {
+        setError("Failed to parse " + what + " response data");
         sendNack();
         state_ = CommState::ERROR;
         return false;
     }
     
-    // ???! ACK ?????? ?? ??
     state_ = CommState::SENDING_ACK;
     if (!sendAck()) {
         logging::Logger::getInstance().warn("Failed to send ACK, but response was valid");
     }
     
     state_ = CommState::COMPLETED;
-    logging::Logger::getInstance().debug("Card UID read request completed successfully");
+    logging::Logger::getInstance().debug(what + " request completed successfully");
     return true;
 }
 
-bool SmartroComm::waitForEvent(EventResponse& event, uint32_t timeoutMs) {
-    // ????????? ??? ???????????????????????? ????? ???????
-    // STX???? ?????? ??? ????? ??? ?????????????? ??
-    
-    if (!serialPort_.isOpen()) {
-        std::lock_guard<std::mutex> lock(commMutex_);
-        setError("Serial port is not open");
+// ====================================================================
+// Requests
+// ====================================================================
+
+bool SmartroComm::sendDeviceCheckRequest(const std::string& terminalId,
+                                         DeviceCheckResponse& response,
+                                         uint32_t timeoutMs,
+                                         const std::string& preferredPort,
+                                         const std::string& excludePort) {
+    state_ = CommState::IDLE;
+    clearError();
+
+    // 세션 유지: 열린 포트가 있으면 그 핸들로 요청/ACK 한 번 (닫고 다시 열지 않음)
+    if (serialPort_.isOpen()) {
+        std::string sessionPort = serialPort_.getPortName();
+        if (deviceCheckOnOpenPort(terminalId, response, sessionPort, ADAPTIVE_TIMEOUT, ADAPTIVE_TIMEOUT, timeoutMs)) {
+            return true;
+        }
+        // 한 번의 NACK/늦은 응답(측정 하한보다 느림)은 세션 실패가 아님 → 상한 타임아웃으로 한 번 더
+        // (호출자의 timeoutMs가 더 작으면 그것이 상한)
+        uint32_t ackCeiling = timeoutMs > 0 ? (std::min)(ACK_TIMEOUT_MS, timeoutMs) : ACK_TIMEOUT_MS;
+        uint32_t responseCeiling = timeoutMs > 0 ? (std::min)(RESPONSE_TIMEOUT_MS, timeoutMs) : RESPONSE_TIMEOUT_MS;
+        logging::Logger::getInstance().info("Device check: retrying on " + sessionPort + " with ceiling timeouts");
+        if (deviceCheckOnOpenPort(terminalId, response, sessionPort, ackCeiling, responseCeiling)) {
+            return true;
+        }
+        // 세션 실패 → 포트 재탐색
+        logging::Logger::getInstance().warn("Device check: session on " + sessionPort + " failed twice, rescanning ports");
+    }
+    return scanForDevice(terminalId, response, preferredPort, excludePort, timeoutMs);
+}
+
+bool SmartroComm::scanForDevice(const std::string& terminalId,
+                                DeviceCheckResponse& response,
+                                const std::string& preferredPort,
+                                const std::string& excludePort,
+                                uint32_t timeoutMs) {
+    state_ = CommState::IDLE;
+    clearError();
+
+    if (serialPort_.isOpen()) {
+        serialPort_.close();
+    }
+
+    std::vector<std::string> availablePorts = SerialPort::getAvailablePorts();
+    // 다른 장치(현금결제기 등)가 쓰는 포트에는 'A' 패킷을 보내지 않음
+    if (!excludePort.empty()) {
+        availablePorts.erase(std::remove(availablePorts.begin(), availablePorts.end(), excludePort),
+                             availablePorts.end());
+    }
+
+    if (availablePorts.empty()) {
+        setError("No COM ports available");
+        state_ = CommState::ERROR;
         return false;
     }
+
+    if (!preferredPort.empty()) {
+        auto it = std::find(availablePorts.begin(), availablePorts.end(), preferredPort);
+        if (it != availablePorts.end()) {
+            std::rotate(availablePorts.begin(), it, it + 1);
+            logging::Logger::getInstance().info("Device check: Trying preferred port " + preferredPort + " first");
+        }
+    }
+    if (preferredPort.empty()) {
+        logging::Logger::getInstance().info("Device check: Testing all available COM ports");
+    }
     
-    // ?????????(?????? ????? ?????? ???)
-    logging::Logger::getInstance().debug("Waiting for event...");
-    
-    std::vector<uint8_t> eventPacket;
-    
-    // STX??????(??????????: 0??? ?? ????
-    // ??? ???????????????????? ????? ???????
-    uint32_t stxTimeout = 100;  // 100ms????
-    uint32_t totalElapsed = 0;
+    std::vector<std::string> triedPorts;
     
-    while (timeoutMs == 0 || totalElapsed < timeoutMs) {
-        uint8_t byte = 0;
-        bool foundStx = false;
-        
-        // ??? ??? ???????? ??? ??? ???
-        {
-            std::lock_guard<std::mutex> lock(commMutex_);
-            if (readByte(byte, stxTimeout)) {
-                if (byte == STX) {
-                    eventPacket.push_back(STX);
-                    logging::Logger::getInstance().debug("STX received, reading event packet...");
-                    foundStx = true;
-                }
-            }
+    for (const auto& portToTry : availablePorts) {
+        if (serialPort_.isOpen()) {
+            serialPort_.close();
         }
         
-        if (foundStx) {
-            break;
+        logging::Logger::getInstance().info("Testing port: " + portToTry);
+        
+        bool portOpened = false;
+        try {
+            portOpened = serialPort_.open(portToTry, 115200);
+        } catch (...) {
+            logging::Logger::getInstance().warn("Exception while opening port: " + portToTry);
+            portOpened = false;
         }
         
-        // ???????(?? ????????????? ???)
-        if (timeoutMs == 0) {
-            continue;  // ?? ????????????? ???
+        triedPorts.push_back(portToTry);
+        if (!portOpened) {
+            logging::Logger::getInstance().warn("Failed to open port: " + portToTry + ", trying next port...");
+            continue;
         }
-        // ???????? ???????
-        totalElapsed += stxTimeout;
-        if (totalElapsed >= timeoutMs) {
-            std::lock_guard<std::mutex> lock(commMutex_);
-            setError("Timeout waiting for event");
-            state_ = CommState::ERROR;
-            return false;
+        
+        if (!deviceCheckOnOpenPort(terminalId, response, portToTry, ADAPTIVE_TIMEOUT, ADAPTIVE_TIMEOUT, timeoutMs)) {
+            serialPort_.close();
+            continue;
         }
+        
+        logging::Logger::getInstance().info("Device check successful on port: " + portToTry);
+        return true;
     }
     
-    // STX??????? ??? ??? ??? ???
-    std::lock_guard<std::mutex> lock(commMutex_);
-    state_ = CommState::IDLE;
-    lastError_.clear();
-    state_ = CommState::RECEIVING_RESPONSE;
-    
-    // ???????? ??? (STX?????? ???????????? ???)
-    if (!receiveResponse(eventPacket, RESPONSE_TIMEOUT_MS)) {
-        setError("Failed to receive event packet");
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // ???????? ???
-    std::vector<uint8_t> header;
-    std::vector<uint8_t> payload;
-    
-    if (eventPacket.empty()) {
-        setError("Empty event packet");
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    if (!SmartroProtocol::parsePacket(eventPacket.data(), eventPacket.size(), 
-                                     header, payload)) {
-        setError("Failed to parse event packet");
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // Job Code ???
-    if (header.size() < HEADER_SIZE) {
-        setError("Invalid header size: " + std::to_string(header.size()));
-        state_ = CommState::ERROR;
-        return false;
+    if (serialPort_.isOpen()) {
+        serialPort_.close();
     }
-    
-    char jobCode = SmartroProtocol::extractJobCode(header.data());
-    if (jobCode != JOB_CODE_EVENT) {
-        setError("Unexpected job code: " + std::string(1, jobCode) + 
-                ", expected: " + std::string(1, JOB_CODE_EVENT));
-        state_ = CommState::ERROR;
-        return false;
+    setError("Device check failed on all attempted ports: " + std::to_string(triedPorts.size()) + " ports tried");
+    state_ = CommState::ERROR;
+    return false;
+}
+
+bool SmartroComm::sendDeviceCheckOnPort(const std::string& terminalId,
+                                        DeviceCheckResponse& response,
+                                        const std::string& port) {
+    state_ = CommState::IDLE;
+    clearError();
+
+    if (!serialPort_.isOpen() || serialPort_.getPortName() != port) {
+        if (serialPort_.isOpen()) serialPort_.close();
+        bool portOpened = false;
+        try {
+            portOpened = serialPort_.open(port, 115200);
+        } catch (...) {
+            portOpened = false;
+        }
+        if (!portOpened) {
+            setError("Failed to open port: " + port);
+            state_ = CommState::ERROR;
+            return false;
+        }
     }
-    
-    // ?????????????
-    if (!SmartroProtocol::parseEventResponse(payload.data(), payload.size(), event)) {
-        setError("Failed to parse event response data");
+
+    if (!deviceCheckOnOpenPort(terminalId, response, port)) {
         state_ = CommState::ERROR;
         return false;
     }
-    
-    // ???! ?????? ACK/NACK ??????? ???
-    state_ = CommState::COMPLETED;
-    logging::Logger::getInstance().debug("Event received successfully");
     return true;
 }
 
-bool SmartroComm::sendResetRequest(const std::string& terminalId, uint32_t /*timeoutMs*/) {
-    std::lock_guard<std::mutex> lock(commMutex_);
-    state_ = CommState::IDLE;
-    lastError_.clear();
-    
-    if (!serialPort_.isOpen()) {
-        setError("Serial port is not open");
-        return false;
-    }
-    
-    // ??? ???
-    auto packet = SmartroProtocol::createResetRequest(terminalId);
-    
-    // ??? ???
-    state_ = CommState::SENDING_REQUEST;
-    logging::Logger::getInstance().debug("Sending reset request...");
-    
-    if (!serialPort_.write(packet.data(), packet.size())) {
-        setError("Failed to send request packet");
-        state_ = CommState::ERROR;
+bool SmartroComm::deviceCheckOnOpenPort(const std::string& terminalId,
+                                        DeviceCheckResponse& response,
+                                        const std::string& currentPort,
+                                        uint32_t ackTimeoutMs, uint32_t responseTimeoutMs,
+                                        uint32_t ceilingMs) {
+    // 아직 측정치가 없는 포트(탐색 중)는 ACK 1.5초, 응답 2초 안에 판별 (ACK_BOUNDS/QUICK_RESPONSE_BOUNDS 초기값)
+    RequestPacket packet;
+    SmartroProtocol::createDeviceCheckRequest(terminalId, packet);
+    std::vector<uint8_t> responsePacket;
+    if (!exchange(packet, JOB_CODE_DEVICE_CHECK_RESPONSE, "device check", responsePacket,
+                  ackTimeoutMs, responseTimeoutMs, ceilingMs)) {
+        std::string error = getLastError() + " on " + currentPort;
+        logging::Logger::getInstance().warn("Device check: " + error);
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        lastError_ = error;
         return false;
     }
-    
-    // ??? ??? ??? ?? ????
-    flushSerialBuffer();
-    
-    // ACK ????
-    state_ = CommState::WAITING_ACK;
-    logging::Logger::getInstance().debug("Waiting for ACK...");
-    
+    FrameView frame(responsePacket.data(), responsePacket.size());
+    return completeResponse(SmartroProtocol::parseDeviceCheckResponse(frame.payload(), frame.payloadSize(), response),
+                            "device check");
+}
+
+bool SmartroComm::sendPaymentWaitRequest(const std::string& terminalId, 
+                                         PaymentWaitResponse& response,
+                                         uint32_t timeoutMs) {
+    RequestPacket packet;
+    SmartroProtocol::createPaymentWaitRequest(terminalId, packet);
     std::vector<uint8_t> responsePacket;
-    if (!waitForAck(ACK_TIMEOUT_MS, responsePacket)) {
-        setError("ACK timeout or NACK received");
-        state_ = CommState::ERROR;
+    if (!exchange(packet, JOB_CODE_PAYMENT_WAIT_RESPONSE, "payment wait", responsePacket,
+                  ADAPTIVE_TIMEOUT, ADAPTIVE_TIMEOUT, timeoutMs)) {
         return false;
     }
-    
-    // ??? ??? (?? ????? ?????????)
-    state_ = CommState::RECEIVING_RESPONSE;
-    logging::Logger::getInstance().debug("Receiving response...");
-    
-    if (!receiveResponse(responsePacket, RESPONSE_TIMEOUT_MS)) {
-        setError("Failed to receive response");
-        state_ = CommState::ERROR;
+    FrameView frame(responsePacket.data(), responsePacket.size());
+    return completeResponse(SmartroProtocol::parsePaymentWaitResponse(frame.payload(), frame.payloadSize(), response),
+                            "payment wait");
+}
+
+bool SmartroComm::sendCardUidReadRequest(const std::string& terminalId, 
+                                         CardUidReadResponse& response,
+                                         uint32_t timeoutMs) {
+    RequestPacket packet;
+    SmartroProtocol::createCardUidReadRequest(terminalId, packet);
+    std::vector<uint8_t> responsePacket;
+    // 응답은 카드를 댄 뒤에야 옴 (고객 조작 대기) → 측정하지 않고 호출자의 timeoutMs가 고정 한도
+    uint32_t responseTimeoutMs = timeoutMs > 0 ? timeoutMs : RESPONSE_TIMEOUT_MS;
+    if (!exchange(packet, JOB_CODE_CARD_UID_READ_RESPONSE, "card UID read", responsePacket,
+                  ADAPTIVE_TIMEOUT, responseTimeoutMs, timeoutMs)) {
         return false;
     }
-    
-    // ??? ??? (?? ????? Job Code?????)
-    std::vector<uint8_t> header;
-    std::vector<uint8_t> payload;
-    
-    if (responsePacket.empty()) {
-        setError("Empty response packet");
-        sendNack();
-        state_ = CommState::ERROR;
+    FrameView frame(responsePacket.data(), responsePacket.size());
+    return completeResponse(SmartroProtocol::parseCardUidReadResponse(frame.payload(), frame.payloadSize(), response),
+                            "card UID read");
+}
+
+bool SmartroComm::waitForEvent(EventResponse& event, uint32_t timeoutMs) {
+    // 이벤트는 장치가 자발적으로 보냄: 송신 없이 '@' 슬롯만 등록하고 읽기 스레드의 전달을 기다림
+    if (!serialPort_.isOpen()) {
+        setError("Serial port is not open");
         return false;
     }
+    ensureReceiver();
     
-    if (!SmartroProtocol::parsePacket(responsePacket.data(), responsePacket.size(), 
-                                     header, payload)) {
-        setError("Failed to parse response");
-        sendNack();
-        state_ = CommState::ERROR;
+    logging::Logger::getInstance().debug("Waiting for event...");
+    
+    PendingRequest request;
+    if (!beginRequest(request, JOB_CODE_EVENT, RESPONSE_TIMEOUT_MS)) {
+        setError("Another event wait is already pending");
         return false;
     }
+    state_ = CommState::RECEIVING_RESPONSE;
+    bool received = waitForResponse(request, timeoutMs);
+    endRequest(request);
     
-    // Job Code ???
-    if (header.size() < HEADER_SIZE) {
-        setError("Invalid header size: " + std::to_string(header.size()));
-        sendNack();
+    if (!received) {
+        setError("Timeout waiting for event");
         state_ = CommState::ERROR;
         return false;
     }
+    clearError();
     
-    char jobCode = SmartroProtocol::extractJobCode(header.data());
-    if (jobCode != JOB_CODE_RESET_RESPONSE) {
-        setError("Unexpected job code: " + std::string(1, jobCode) + 
-                ", expected: " + std::string(1, JOB_CODE_RESET_RESPONSE));
-        sendNack();
+    FrameView frame(request.packet.data(), request.packet.size());
+    if (!SmartroProtocol::parseEventResponse(frame.payload(), frame.payloadSize(), event)) {
+        setError("Failed to parse event response data");
         state_ = CommState::ERROR;
         return false;
     }
     
-    // ???! ACK ???
-    state_ = CommState::SENDING_ACK;
-    if (!sendAck()) {
-        logging::Logger::getInstance().warn("Failed to send ACK, but response was valid");
-    }
-    
+    // 이벤트에는 ACK/NACK를 보내지 않음
     state_ = CommState::COMPLETED;
-    logging::Logger::getInstance().debug("Reset request completed successfully");
+    logging::Logger::getInstance().debug("Event received successfully");
     return true;
 }
 
+bool SmartroComm::sendResetRequest(const std::string& terminalId, uint32_t timeoutMs) {
+    RequestPacket packet;
+    SmartroProtocol::createResetRequest(terminalId, packet);
+    std::vector<uint8_t> responsePacket;
+    // 리셋 완료까지는 단말 상태에 따라 오래 걸릴 수 있음 — 응답은 고정 한도 (빠른 명령 추정치를 흐리지 않도록)
+    uint32_t responseTimeoutMs = timeoutMs > 0 ? timeoutMs : RESPONSE_TIMEOUT_MS;
+    if (!exchange(packet, JOB_CODE_RESET_RESPONSE, "reset", responsePacket,
+                  ADAPTIVE_TIMEOUT, responseTimeoutMs, timeoutMs)) {
+        return false;
+    }
+    return completeResponse(true, "reset");  // 리셋 응답에는 데이터 없음
+}
+
 bool SmartroComm::sendPaymentApprovalRequest(const std::string& terminalId, 
                                             const PaymentApprovalRequest& request,
                                             PaymentApprovalResponse& response,
                                             uint32_t timeoutMs) {
-    std::unique_lock<std::mutex> lock(commMutex_);
-    
-    const uint32_t userInactivityTimeoutMs = 30000;  // 30??(?????, ?? 60000??? ???
+    const uint32_t userInactivityTimeoutMs = 30000;  // 30초 (고객 무응답 한도)
     
-    // ???? ???? ?????(??????? ?? ?? ???)
+    // 거절 시 재시도 루프 (매 시도마다 30초 한도를 새로 시작)
     while (true) {
         state_ = CommState::IDLE;
-        lastError_.clear();
+        clearError();
         
         if (!serialPort_.isOpen()) {
             setError("Serial port is not open");
             return false;
         }
         
-        // ???? ????? 30???????????? ??? (??? ???)
         auto requestStartTime = std::chrono::steady_clock::now();
         logging::Logger::getInstance().info("Payment approval request started, 30s timeout begins");
         
-        // ??? ???
-        auto packet = SmartroProtocol::createPaymentApprovalRequest(terminalId, request);
-        
-        // ??? ???
-        state_ = CommState::SENDING_REQUEST;
-        logging::Logger::getInstance().debug("Sending payment approval request...");
-        
-        if (!serialPort_.write(packet.data(), packet.size())) {
-            setError("Failed to send request packet");
-            state_ = CommState::ERROR;
-            return false;
-        }
-        
-        // ??? ??? ??? ?? ????
-        flushSerialBuffer();
-        
-        // ACK ????(30??????????????
-        state_ = CommState::WAITING_ACK;
-        logging::Logger::getInstance().debug("Waiting for ACK...");
-        
-        // ???? ?????????? ??
-        auto elapsed = std::chrono::steady_clock::now() - requestStartTime;
-        uint32_t elapsedMs = static_cast<uint32_t>(
-            std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
-        
-        uint32_t remainingSeconds = (userInactivityTimeoutMs - elapsedMs) / 1000;
-        logging::Logger::getInstance().debug("Timeout check: elapsed=" + 
-                                             std::to_string(elapsedMs / 1000) + "s, remaining=" + 
-                                             std::to_string(remainingSeconds) + "s");
-        
-        uint32_t ackRemainingTimeout = (elapsedMs < userInactivityTimeoutMs) ? 
-                                    (userInactivityTimeoutMs - elapsedMs) : 1000;  // ?? 1??
-        
-        // ACK ????????????? ???? ??????? ACK ????????????? ?????
-        uint32_t ackTimeout = (ackRemainingTimeout < ACK_TIMEOUT_MS) ? ackRemainingTimeout : ACK_TIMEOUT_MS;
-        
-        std::vector<uint8_t> responsePacket;
-        if (!waitForAck(ackTimeout, responsePacket)) {
-            // ACK ?????????? ??? ?????????
-            elapsed = std::chrono::steady_clock::now() - requestStartTime;
-            elapsedMs = static_cast<uint32_t>(
-                std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
-            
-            if (elapsedMs >= userInactivityTimeoutMs) {
-                // ??? ????????? - Payment Wait??? ???
-                logging::Logger::getInstance().warn("Request timeout reached: elapsed=" + 
-                                                   std::to_string(elapsedMs / 1000) + "s (limit=" + 
-                                                   std::to_string(userInactivityTimeoutMs / 1000) + 
-                                                   "s), sending Payment Wait");
-                lock.unlock();
-                PaymentWaitResponse waitResponse;
-                bool waitSuccess = sendPaymentWaitRequest(terminalId, waitResponse, 3000);
-                lock.lock();
-                if (waitSuccess) {
-                    logging::Logger::getInstance().info("Payment Wait sent successfully");
-                }
-                setError("User inactivity timeout");
-                state_ = CommState::ERROR;
-                return false;
-            }
-            
-            setError("ACK timeout or NACK received");
+        RequestPacket packet;
+        if (!SmartroProtocol::createPaymentApprovalRequest(terminalId, request, packet)) {
+            setError("Payment approval request does not fit the packet layout");
             state_ = CommState::ERROR;
             return false;
         }
+        logging::Logger::getInstance().debug("Sending payment approval request...");
         
-        // ??? ??? (30??????????????
-        state_ = CommState::RECEIVING_RESPONSE;
-        logging::Logger::getInstance().debug("Receiving response...");
-        
-        // ???? ?????????? ?????
-        elapsed = std::chrono::steady_clock::now() - requestStartTime;
-        elapsedMs = static_cast<uint32_t>(
-            std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
-        
-        remainingSeconds = (userInactivityTimeoutMs - elapsedMs) / 1000;
-        logging::Logger::getInstance().debug("Timeout check before response: elapsed=" + 
-                                             std::to_string(elapsedMs / 1000) + "s, remaining=" + 
-                                             std::to_string(remainingSeconds) + "s");
-        
-        uint32_t remainingTimeout = (elapsedMs < userInactivityTimeoutMs) ? 
-                          (userInactivityTimeoutMs - elapsedMs) : 1000;  // ?? 1??
-        
-        if (timeoutMs > 0 && timeoutMs < remainingTimeout) {
-            remainingTimeout = timeoutMs;
+        // ACK는 단말 자체 응답이라 측정값으로, 승인 결과는 고객 조작을 기다리므로 고정 한도
+        uint32_t ackTimeout = ADAPTIVE_TIMEOUT;
+        uint32_t responseTimeout = userInactivityTimeoutMs;
+        if (timeoutMs > 0 && timeoutMs < responseTimeout) {
+            responseTimeout = timeoutMs;
         }
         
-        if (!receiveResponse(responsePacket, remainingTimeout)) {
-            // ????????? - ??? ?????????
-            elapsed = std::chrono::steady_clock::now() - requestStartTime;
-            elapsedMs = static_cast<uint32_t>(
-                std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
-            
+        std::vector<uint8_t> responsePacket;
+        if (!transact(packet, JOB_CODE_PAYMENT_APPROVAL_RESPONSE, ackTimeout, responseTimeout, responsePacket)) {
+            auto elapsedMs = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - requestStartTime).count());
             if (elapsedMs >= userInactivityTimeoutMs) {
-                // ??? ????????? - Payment Wait??? ??? (????????)
+                // 고객 무응답 한도 도달 - Payment Wait로 단말 상태 복귀
                 logging::Logger::getInstance().warn("Request timeout reached: elapsed=" + 
                                                    std::to_string(elapsedMs / 1000) + "s (limit=" + 
                                                    std::to_string(userInactivityTimeoutMs / 1000) + 
                                                    "s), sending Payment Wait to reset state");
-                
-                // Payment Wait ?????? ??????
-                lock.unlock();
-                
                 PaymentWaitResponse waitResponse;
-                bool waitSuccess = sendPaymentWaitRequest(terminalId, waitResponse, 3000);
-                
-                lock.lock();
-                
-                if (waitSuccess) {
+                if (sendPaymentWaitRequest(terminalId, waitResponse, 3000)) {
                     logging::Logger::getInstance().info("Payment Wait sent successfully, state reset");
                 } else {
                     logging::Logger::getInstance().warn("Failed to send Payment Wait");
                 }
-                
                 setError("User inactivity timeout");
                 state_ = CommState::ERROR;
-                return false;
-            } else {
-                // ??????????(??? ??? ???) - ????????
-                setError("Failed to receive response");
-                state_ = CommState::ERROR;
-                return false;
             }
-        }
-        
-        // ??? ???
-        std::vector<uint8_t> header;
-        std::vector<uint8_t> payload;
-        
-        if (responsePacket.empty()) {
-            setError("Empty response packet");
-            sendNack();
-            state_ = CommState::ERROR;
-            return false;
-        }
-        
-        if (!SmartroProtocol::parsePacket(responsePacket.data(), responsePacket.size(), 
-                                         header, payload)) {
-            setError("Failed to parse response");
-            sendNack();
-            state_ = CommState::ERROR;
             return false;
         }
         
-        // Job Code ???
-        if (header.size() < HEADER_SIZE) {
-            setError("Invalid header size: " + std::to_string(header.size()));
+        FrameView frame(responsePacket.data(), responsePacket.size());
+        if (!SmartroProtocol::parsePaymentApprovalResponse(frame.payload(), frame.payloadSize(), response)) {
+            setError("Failed to parse payment approval response data");
             sendNack();
             state_ = CommState::ERROR;
             return false;
         }
         
-        char jobCode = SmartroProtocol::extractJobCode(header.data());
-        if (jobCode != JOB_CODE_PAYMENT_APPROVAL_RESPONSE) {
-            setError("Unexpected job code: " + std::string(1, jobCode) + 
-                    ", expected: " + std::string(1, JOB_CODE_PAYMENT_APPROVAL_RESPONSE));
-            sendNack();
-            state_ = CommState::ERROR;
-            return false;
-        }
+        auto elapsedMs = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - requestStartTime).count());
         
-        // ??? ????????
-        if (!SmartroProtocol::parsePaymentApprovalResponse(payload.data(), payload.size(), response)) {
-            setError("Failed to parse payment approval response data");
-            sendNack();
-            state_ = CommState::ERROR;
-            return false;
+        state_ = CommState::SENDING_ACK;
+        if (!sendAck()) {
+            logging::Logger::getInstance().warn("Failed to send ACK");
         }
         
-        // ???????? Transaction Medium????? ??? ??
         if (response.isRejected()) {
-            // ??? ??????? ??? ??
-            elapsed = std::chrono::steady_clock::now() - requestStartTime;
-            elapsedMs = static_cast<uint32_t>(
-                std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
-            
-            // ACK ??? (????? ????????
-            state_ = CommState::SENDING_ACK;
-            if (!sendAck()) {
-                logging::Logger::getInstance().warn("Failed to send ACK");
-            }
-            
-            // Transaction Medium ???
-            if (response.transactionMedium == '1') {
-                // IC (?? ???)????: ?? ??? ??????? ????? ??
-                // ??? ?????IPC/Flutter)??? IC_CARD_REMOVED ??????? ??????? ?? ???????????
+            // 거래 매체(Transaction Medium)별 처리
+            if (response.transactionMedium() == '1') {
+                // IC: 카드를 뺐다 다시 꽂아야 재시도 가능 (상위에서 IC_CARD_REMOVED 이벤트 후 재요청)
                 logging::Logger::getInstance().warn("Payment approval rejected (IC, elapsed=" + 
                                                    std::to_string(elapsedMs / 1000) + "s). " +
                                                    "Waiting for card removal event to retry...");
                 setError("Payment rejected (IC). Card removal event required for retry");
                 state_ = CommState::ERROR;
-                return false;  // ??? ??, ??? ?????????? ??? ????????????
-            } else if (response.transactionMedium == '3') {
-                // RF (??)????: 3?????????????
-                const uint32_t rfRetryDelayMs = 3000;  // 3??
+                return false;
+            } else if (response.transactionMedium() == '3') {
+                // RF: 3초 후 재시도
+                const uint32_t rfRetryDelayMs = 3000;
                 logging::Logger::getInstance().warn("Payment approval rejected (RF, elapsed=" + 
                                                    std::to_string(elapsedMs / 1000) + "s). " +
                                                    "Retrying after " + std::to_string(rfRetryDelayMs / 1000) + "s...");
-                
-                // 3??????(Flutter?? ???????????? ??? ??? ??)
-                auto retryStartTime = std::chrono::steady_clock::now();
                 std::this_thread::sleep_for(std::chrono::milliseconds(rfRetryDelayMs));
-                auto retryElapsed = std::chrono::steady_clock::now() - retryStartTime;
-                uint32_t retryElapsedMs = static_cast<uint32_t>(
-                    std::chrono::duration_cast<std::chrono::milliseconds>(retryElapsed).count());
-                logging::Logger::getInstance().info("RF retry delay completed: " + 
-                                                   std::to_string(retryElapsedMs / 1000) + "s");
-                
-                continue;  // ?????(??? ????? ?????30????? ???)
+                continue;
             } else {
-                // ??? ?? (MS, QR, KEYIN ??????: ?? ???????
+                // 그 외 (MS, QR, KEYIN 등): 같은 금액으로 즉시 재시도
                 logging::Logger::getInstance().warn("Payment approval rejected (Medium=" + 
-                                                   std::string(1, response.transactionMedium) + 
+                                                   std::string(1, response.transactionMedium()) + 
                                                    ", elapsed=" + std::to_string(elapsedMs / 1000) + 
                                                    "s), retrying with same amount...");
-                
-                // ??? ???????????
                 std::this_thread::sleep_for(std::chrono::milliseconds(500));
-                continue;  // ?? ?????(??? ????? ?????30????? ???)
+                continue;
             }
         }
         
-        // ???! ACK ???
-        elapsed = std::chrono::steady_clock::now() - requestStartTime;
-        elapsedMs = static_cast<uint32_t>(
-            std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
-        
-        state_ = CommState::SENDING_ACK;
-        if (!sendAck()) {
-            logging::Logger::getInstance().warn("Failed to send ACK, but response was valid");
-        }
-        
         state_ = CommState::COMPLETED;
         logging::Logger::getInstance().info("Payment approval request completed successfully (elapsed=" + 
                                            std::to_string(elapsedMs / 1000) + "s)");
@@ -875,87 +605,34 @@ bool SmartroComm::sendPaymentApprovalRequest(const std::string& terminalId,
 bool SmartroComm::sendLastApprovalResponseRequest(const std::string& terminalId, 
                                                   LastApprovalResponse& response,
                                                   uint32_t timeoutMs) {
-    {
-        std::lock_guard<std::mutex> lock(commMutex_);
-        state_ = CommState::IDLE;
-        lastError_.clear();
-        
-        if (!serialPort_.isOpen()) {
-            setError("Serial port is not open");
-            return false;
-        }
-        
-        // Create request packet
-        auto packet = SmartroProtocol::createLastApprovalResponseRequest(terminalId);
-        
-        // Send packet
-        state_ = CommState::SENDING_REQUEST;
-        logging::Logger::getInstance().debug("Sending last approval response request...");
-        
-        if (!serialPort_.write(packet.data(), packet.size())) {
-            setError("Failed to send request packet");
-            state_ = CommState::ERROR;
-            return false;
-        }
-        
-        // Flush serial buffer
-        flushSerialBuffer();
-        
-        // Wait for ACK
-        state_ = CommState::WAITING_ACK;
-        logging::Logger::getInstance().debug("Waiting for ACK...");
-        
-        std::vector<uint8_t> responsePacket;
-        if (!waitForAck(ACK_TIMEOUT_MS, responsePacket)) {
-            setError("ACK timeout or NACK received");
-            state_ = CommState::ERROR;
-            return false;
-        }
-        
-        // Send ACK (prepare for response reception)
-        state_ = CommState::SENDING_ACK;
-        if (!sendAck()) {
-            logging::Logger::getInstance().warn("Failed to send ACK");
-        }
-    }
-    
-    // Response will be queued by responseReceiverThread, so get it from queue
-    state_ = CommState::RECEIVING_RESPONSE;
-    logging::Logger::getInstance().debug("Waiting for last approval response from queue...");
+    state_ = CommState::IDLE;
+    clearError();
     
-    uint32_t actualTimeout = (timeoutMs == 0) ? (RESPONSE_TIMEOUT_MS * 3) : timeoutMs;
-    ResponseData responseData;
-    if (!pollResponse(responseData, actualTimeout)) {
-        std::lock_guard<std::mutex> lock(commMutex_);
-        setError("Timeout waiting for last approval response");
-        state_ = CommState::ERROR;
+    if (!serialPort_.isOpen()) {
+        setError("Serial port is not open");
         return false;
     }
     
-    // Verify Job Code
-    if (responseData.jobCode != JOB_CODE_LAST_APPROVAL_RESPONSE_RESPONSE) {
-        std::lock_guard<std::mutex> lock(commMutex_);
-        setError("Unexpected job code: " + std::string(1, responseData.jobCode) + 
-                ", expected: " + std::string(1, JOB_CODE_LAST_APPROVAL_RESPONSE_RESPONSE));
-        state_ = CommState::ERROR;
+    logging::Logger::getInstance().debug("Sending last approval response request...");
+    
+    // 장치 ACK 직후 ACK를 먼저 보내고, 응답('l')은 나중에 도착 (응답에는 ACK 없음)
+    uint32_t actualTimeout = (timeoutMs == 0) ? (RESPONSE_TIMEOUT_MS * 3) : timeoutMs;
+    RequestPacket packet;
+    SmartroProtocol::createLastApprovalResponseRequest(terminalId, packet);
+    std::vector<uint8_t> responsePacket;
+    if (!transact(packet, JOB_CODE_LAST_APPROVAL_RESPONSE_RESPONSE, ADAPTIVE_TIMEOUT, actualTimeout,
+                  responsePacket, true)) {
         return false;
     }
     
-    // Copy response data
-    if (responseData.type != ResponseType::LAST_APPROVAL) {
-        std::lock_guard<std::mutex> lock(commMutex_);
-        setError("Unexpected response type");
+    FrameView frame(responsePacket.data(), responsePacket.size());
+    if (!SmartroProtocol::parseLastApprovalResponse(frame.payload(), frame.payloadSize(), response)) {
+        setError("Failed to parse last approval response data");
         state_ = CommState::ERROR;
         return false;
     }
     
-    response = responseData.lastApproval;
-    
-    {
-        std::lock_guard<std::mutex> lock(commMutex_);
-        state_ = CommState::COMPLETED;
-    }
-    
+    state_ = CommState::COMPLETED;
     logging::Logger::getInstance().info("Last approval response request completed successfully: " + 
                                        std::to_string(response.data.size()) + " bytes");
     return true;
@@ -964,265 +641,96 @@ bool SmartroComm::sendLastApprovalResponseRequest(const std::string& terminalId,
 bool SmartroComm::sendScreenSoundSettingRequest(const std::string& terminalId, 
                                                 const ScreenSoundSettingRequest& request,
                                                 ScreenSoundSettingResponse& response,
-                                                uint32_t /*timeoutMs*/) {
-    std::lock_guard<std::mutex> lock(commMutex_);
-    state_ = CommState::IDLE;
-    lastError_.clear();
-    
-    if (!serialPort_.isOpen()) {
-        setError("Serial port is not open");
-        return false;
-    }
-    
-    // ??? ???
-    auto packet = SmartroProtocol::createScreenSoundSettingRequest(terminalId, request);
-    
-    // ??? ???
-    state_ = CommState::SENDING_REQUEST;
-    logging::Logger::getInstance().debug("Sending screen/sound setting request...");
-    
-    if (!serialPort_.write(packet.data(), packet.size())) {
-        setError("Failed to send request packet");
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // ??? ??? ??? ?? ????
-    flushSerialBuffer();
-    
-    // ACK ????
-    state_ = CommState::WAITING_ACK;
-    logging::Logger::getInstance().debug("Waiting for ACK...");
-    
+                                                uint32_t timeoutMs) {
+    RequestPacket packet;
+    SmartroProtocol::createScreenSoundSettingRequest(terminalId, request, packet);
     std::vector<uint8_t> responsePacket;
-    if (!waitForAck(ACK_TIMEOUT_MS, responsePacket)) {
-        setError("ACK timeout or NACK received");
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // ??? ???
-    state_ = CommState::RECEIVING_RESPONSE;
-    logging::Logger::getInstance().debug("Receiving response...");
-    
-    if (!receiveResponse(responsePacket, RESPONSE_TIMEOUT_MS)) {
-        setError("Failed to receive response");
-        state_ = CommState::ERROR;
+    if (!exchange(packet, JOB_CODE_SCREEN_SOUND_SETTING_RESPONSE, "screen/sound setting", responsePacket,
+                  ADAPTIVE_TIMEOUT, ADAPTIVE_TIMEOUT, timeoutMs)) {
         return false;
     }
-    
-    // ??? ???
-    std::vector<uint8_t> header;
-    std::vector<uint8_t> payload;
-    
-    if (responsePacket.empty()) {
-        setError("Empty response packet");
-        sendNack();
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    if (!SmartroProtocol::parsePacket(responsePacket.data(), responsePacket.size(), 
-                                     header, payload)) {
-        setError("Failed to parse response");
-        sendNack();
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // Job Code ???
-    if (header.size() < HEADER_SIZE) {
-        setError("Invalid header size: " + std::to_string(header.size()));
-        sendNack();
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    char jobCode = SmartroProtocol::extractJobCode(header.data());
-    if (jobCode != JOB_CODE_SCREEN_SOUND_SETTING_RESPONSE) {
-        setError("Unexpected job code: " + std::string(1, jobCode) + 
-                ", expected: " + std::string(1, JOB_CODE_SCREEN_SOUND_SETTING_RESPONSE));
-        sendNack();
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // ??? ????????
-    if (!SmartroProtocol::parseScreenSoundSettingResponse(payload.data(), payload.size(), response)) {
-        setError("Failed to parse screen/sound setting response data");
-        sendNack();
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // ???! ACK ???
-    state_ = CommState::SENDING_ACK;
-    if (!sendAck()) {
-        logging::Logger::getInstance().warn("Failed to send ACK, but response was valid");
-    }
-    
-    state_ = CommState::COMPLETED;
-    logging::Logger::getInstance().debug("Screen/sound setting request completed successfully");
-    return true;
+    FrameView frame(responsePacket.data(), responsePacket.size());
+    return completeResponse(SmartroProtocol::parseScreenSoundSettingResponse(frame.payload(), frame.payloadSize(), response),
+                            "screen/sound setting");
 }
 
 bool SmartroComm::sendIcCardCheckRequest(const std::string& terminalId, 
                                          IcCardCheckResponse& response,
-                                         uint32_t /*timeoutMs*/) {
-    std::lock_guard<std::mutex> lock(commMutex_);
-    state_ = CommState::IDLE;
-    lastError_.clear();
-    
-    if (!serialPort_.isOpen()) {
-        setError("Serial port is not open");
-        return false;
-    }
-    
-    // ??? ???
-    auto packet = SmartroProtocol::createIcCardCheckRequest(terminalId);
-    
-    // ??? ???
-    state_ = CommState::SENDING_REQUEST;
-    logging::Logger::getInstance().debug("Sending IC card check request...");
-    
-    if (!serialPort_.write(packet.data(), packet.size())) {
-        setError("Failed to send request packet");
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // ??? ??? ??? ?? ????
-    flushSerialBuffer();
-    
-    // ACK ????
-    state_ = CommState::WAITING_ACK;
-    logging::Logger::getInstance().debug("Waiting for ACK...");
-    
+                                         uint32_t timeoutMs) {
+    RequestPacket packet;
+    SmartroProtocol::createIcCardCheckRequest(terminalId, packet);
     std::vector<uint8_t> responsePacket;
-    if (!waitForAck(ACK_TIMEOUT_MS, responsePacket)) {
-        setError("ACK timeout or NACK received");
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // ??? ???
-    state_ = CommState::RECEIVING_RESPONSE;
-    logging::Logger::getInstance().debug("Receiving response...");
-    
-    if (!receiveResponse(responsePacket, RESPONSE_TIMEOUT_MS)) {
-        setError("Failed to receive response");
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // ??? ???
-    std::vector<uint8_t> header;
-    std::vector<uint8_t> payload;
-    
-    if (responsePacket.empty()) {
-        setError("Empty response packet");
-        sendNack();
-        state_ = CommState::ERROR;
+    if (!exchange(packet, JOB_CODE_IC_CARD_CHECK_RESPONSE, "IC card check", responsePacket,
+                  ADAPTIVE_TIMEOUT, ADAPTIVE_TIMEOUT, timeoutMs)) {
         return false;
     }
+    FrameView frame(responsePacket.data(), responsePacket.size());
+    return completeResponse(SmartroProtocol::parseIcCardCheckResponse(frame.payload(), frame.payloadSize(), response),
+                            "IC card check");
+}
+
+bool SmartroComm::sendPaymentApprovalRequestAsync(const std::string& terminalId, 
+                                                  const PaymentApprovalRequest& request) {
+    state_ = CommState::IDLE;
+    clearError();
     
-    if (!SmartroProtocol::parsePacket(responsePacket.data(), responsePacket.size(), 
-                                     header, payload)) {
-        setError("Failed to parse response");
-        sendNack();
-        state_ = CommState::ERROR;
+    if (!serialPort_.isOpen()) {
+        setError("Serial port is not open");
         return false;
     }
     
-    // Job Code ???
-    if (header.size() < HEADER_SIZE) {
-        setError("Invalid header size: " + std::to_string(header.size()));
-        sendNack();
-        state_ = CommState::ERROR;
-        return false;
-    }
+    logging::Logger::getInstance().debug("Sending payment approval request (async)...");
     
-    char jobCode = SmartroProtocol::extractJobCode(header.data());
-    if (jobCode != JOB_CODE_IC_CARD_CHECK_RESPONSE) {
-        setError("Unexpected job code: " + std::string(1, jobCode) + 
-                ", expected: " + std::string(1, JOB_CODE_IC_CARD_CHECK_RESPONSE));
-        sendNack();
-        state_ = CommState::ERROR;
+    RequestPacket packet;
+    if (!SmartroProtocol::createPaymentApprovalRequest(terminalId, request, packet)) {
+        setError("Payment approval request does not fit the packet layout");
         return false;
     }
     
-    // ??? ????????
-    if (!SmartroProtocol::parseIcCardCheckResponse(payload.data(), payload.size(), response)) {
-        setError("Failed to parse IC card check response data");
-        sendNack();
-        state_ = CommState::ERROR;
+    // ACK까지만 기다림 — 승인 결과('b')는 대기 슬롯이 없으므로 응답 큐로 감 (eventMonitorThread)
+    std::vector<uint8_t> unused;
+    if (!transact(packet, 0, ADAPTIVE_TIMEOUT, 0, unused, true)) {
         return false;
     }
     
-    // ???! ACK ???
-    state_ = CommState::SENDING_ACK;
-    if (!sendAck()) {
-        logging::Logger::getInstance().warn("Failed to send ACK, but response was valid");
-    }
-    
-    state_ = CommState::COMPLETED;
-    logging::Logger::getInstance().debug("IC card check request completed successfully");
+    state_ = CommState::IDLE;
+    logging::Logger::getInstance().debug("Payment approval request sent (async), waiting for response in background");
     return true;
 }
 
-bool SmartroComm::waitForAck(uint32_t timeoutMs, std::vector<uint8_t>& responsePacket) {
-    responsePacket.clear();
-    uint8_t byte = 0;
-    
-    if (!readByte(byte, timeoutMs)) {
-        logging::Logger::getInstance().error("Timeout waiting for ACK/NACK");
+bool SmartroComm::sendTransactionCancelRequest(const std::string& terminalId,
+                                               const TransactionCancelRequest& request,
+                                               TransactionCancelResponse& response,
+                                               uint32_t timeoutMs) {
+    RequestPacket packet;
+    if (!SmartroProtocol::createTransactionCancelRequest(terminalId, request, packet)) {
+        setError("Transaction cancel request does not fit the packet layout");
         return false;
     }
-    
-    if (byte == ACK) {
-        logging::Logger::getInstance().debug("ACK received (0x06)");
-        
-        // ACK????? ?? ??? ??????? ????????????? ??????????STX ???
-        uint8_t nextByte = 0;
-        if (readByte(nextByte, 1000)) {  // 1?????????(????????????????)
-            if (nextByte == STX) {
-                logging::Logger::getInstance().debug("STX received immediately after ACK");
-                responsePacket.push_back(STX);
-                return true;
-            } else {
-                // STX? ???????????? ??? ????????????????
-                logging::Logger::getInstance().warn("Unexpected byte after ACK: 0x" + 
-                                                   std::to_string(static_cast<int>(nextByte)));
-            }
-        }
-        // STX? ???????ACK????????????? (receiveResponse??? STX???? ??
-        return true;
-    } else if (byte == NACK) {
-        logging::Logger::getInstance().warn("NACK received (0x15)");
-        return false;
-    } else if (byte == STX) {
-        // STX? ??? ??? (ACK ??? ??????? ???)
-        logging::Logger::getInstance().debug("STX received instead of ACK, treating as response start");
-        responsePacket.push_back(STX);
-        return true;
-    } else {
-        logging::Logger::getInstance().warn("Unexpected byte received while waiting for ACK: 0x" + 
-                                           std::to_string(static_cast<int>(byte)) + 
-                                           ", discarding...");
-        // ??????? ????? ?????????? ??????????????? ????
-        uint8_t dummy;
-        while (readByte(dummy, 10)) {
-            // ?? ????
-        }
+    std::vector<uint8_t> responsePacket;
+    if (!exchange(packet, JOB_CODE_TRANSACTION_CANCEL_RESPONSE, "transaction cancel", responsePacket,
+                  ADAPTIVE_TIMEOUT, timeoutMs)) {
         return false;
     }
+    FrameView frame(responsePacket.data(), responsePacket.size());
+    return completeResponse(SmartroProtocol::parseTransactionCancelResponse(frame.payload(), frame.payloadSize(), response),
+                            "transaction cancel");
+}
+
+// ====================================================================
+// ACK/NACK (writer side)
+// ====================================================================
+
+bool SmartroComm::writeFrame(const uint8_t* data, size_t length) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return serialPort_.write(data, length);
 }
 
 bool SmartroComm::sendAck() {
     uint8_t ack = ACK;
     logging::Logger::getInstance().debug("Sending ACK (0x06)");
     
-    if (!serialPort_.write(&ack, 1)) {
+    if (!writeFrame(&ack, 1)) {
         logging::Logger::getInstance().error("Failed to send ACK");
         return false;
     }
@@ -1234,7 +742,7 @@ bool SmartroComm::sendNack() {
     uint8_t nack = NACK;
     logging::Logger::getInstance().debug("Sending NACK (0x15)");
     
-    if (!serialPort_.write(&nack, 1)) {
+    if (!writeFrame(&nack, 1)) {
         logging::Logger::getInstance().error("Failed to send NACK");
         return false;
     }
@@ -1242,124 +750,21 @@ bool SmartroComm::sendNack() {
     return true;
 }
 
-bool SmartroComm::receiveResponse(std::vector<uint8_t>& responsePacket, uint32_t timeoutMs) {
-    uint32_t elapsed = 0;
-    const uint32_t readTimeout = 100;  // ????? ????? 100ms
-    
-    // STX ?? (???? ?????????)
-    bool foundStx = !responsePacket.empty() && responsePacket[0] == STX;
-    
-    if (!foundStx) {
-        while (elapsed < timeoutMs && !foundStx) {
-            uint8_t byte = 0;
-            if (readByte(byte, readTimeout)) {
-                if (byte == STX) {
-                    foundStx = true;
-                    responsePacket.push_back(byte);
-                    logging::Logger::getInstance().debug("STX found, reading packet...");
-                    break;
-                }
-            }
-            elapsed += readTimeout;
-        }
-        
-        if (!foundStx) {
-            logging::Logger::getInstance().error("STX not found within timeout");
-            return false;
-        }
-    } else {
-        logging::Logger::getInstance().debug("STX already received, continuing packet read...");
-    }
-    
-    // Header ???? ??? (34 bytes)
-    size_t headerRemaining = HEADER_SIZE - 1;
-    while (headerRemaining > 0 && elapsed < timeoutMs) {
-        uint8_t byte = 0;
-        if (readByte(byte, readTimeout)) {
-            responsePacket.push_back(byte);
-            headerRemaining--;
-        } else {
-            elapsed += readTimeout;
-        }
-    }
-    
-    if (headerRemaining > 0) {
-        logging::Logger::getInstance().error("Failed to read complete header");
-        return false;
-    }
-    
-    // ??? ??? ???
-    if (responsePacket.size() < HEADER_SIZE) {
-        logging::Logger::getInstance().error("Header size insufficient: " + 
-                                            std::to_string(responsePacket.size()) + 
-                                            " bytes, expected: " + 
-                                            std::to_string(HEADER_SIZE) + " bytes");
-        return false;
-    }
-    
-    // Data Length ??
-    uint16_t dataLength = SmartroProtocol::extractDataLength(responsePacket.data());
-    logging::Logger::getInstance().debug("Response data length: " + std::to_string(dataLength));
-    
-    // Data ???
-    for (uint16_t i = 0; i < dataLength && elapsed < timeoutMs; ++i) {
-        uint8_t byte = 0;
-        if (readByte(byte, readTimeout)) {
-            responsePacket.push_back(byte);
-        } else {
-            elapsed += readTimeout;
-        }
-    }
-    
-    // ETX?? BCC ???
-    uint8_t etx = 0;
-    uint8_t bcc = 0;
-    
-    if (!readByte(etx, readTimeout) || etx != ETX) {
-        logging::Logger::getInstance().error("Failed to read ETX");
-        return false;
-    }
-    responsePacket.push_back(etx);
-    
-    if (!readByte(bcc, readTimeout)) {
-        logging::Logger::getInstance().error("Failed to read BCC");
-        return false;
-    }
-    responsePacket.push_back(bcc);
-    
-    logging::Logger::getInstance().debug("Response packet received: " + 
-                                       std::to_string(responsePacket.size()) + " bytes");
-    
-    // ??? ????????? ?? ??
-    if (responsePacket.size() > 0) {
-        logging::Logger::getInstance().debugHex("Serial RX [Complete Packet]", 
-                                               responsePacket.data(), responsePacket.size());
-    }
-    
-    return true;
-}
+// ====================================================================
+// Reader side
+// ====================================================================
 
-bool SmartroComm::readByte(uint8_t& byte, uint32_t timeoutMs) {
-    size_t bytesRead = 0;
-    if (!serialPort_.read(&byte, 1, bytesRead, timeoutMs)) {
-        return false;
+void SmartroComm::setError(const std::string& error) {
+    {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        lastError_ = error;
     }
-    return bytesRead == 1;
-}
-
-void SmartroComm::flushSerialBuffer() {
-    // ??? ???????????????????? ??????????????
-    uint8_t dummy;
-    size_t bytesRead = 0;
-    while (serialPort_.read(&dummy, 1, bytesRead, 10) && bytesRead > 0) {
-        // ?? ????
-    }
-    logging::Logger::getInstance().debug("Serial buffer flushed");
+    logging::Logger::getInstance().error("SmartroComm error: " + error);
 }
 
-void SmartroComm::setError(const std::string& error) {
-    lastError_ = error;
-    logging::Logger::getInstance().error("SmartroComm error: " + error);
+void SmartroComm::clearError() {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    lastError_.clear();
 }
 
 CommState SmartroComm::getState() const {
@@ -1367,382 +772,291 @@ CommState SmartroComm::getState() const {
 }
 
 std::string SmartroComm::getLastError() const {
+    std::lock_guard<std::mutex> lock(errorMutex_);
     return lastError_;
 }
 
 void SmartroComm::startResponseReceiver() {
     if (receiverRunning_.exchange(true)) {
-        // ???? ??? ??
+        // 이미 실행 중
         return;
     }
     
-    receiverThread_ = std::thread(&SmartroComm::responseReceiverThread, this);
-    logging::Logger::getInstance().info("Response receiver thread started");
+    // 수신은 모든 시리얼 장치가 공유하는 리액터 스레드에서 콜백으로 처리됨
+    decoder_.reset();
+    decoderGeneration_ = serialPort_.getOpenGeneration();
+    frameTimer_ = 0;
+    SerialReactor::getInstance().addPort(serialPort_, [this](const uint8_t* data, size_t length) {
+        onReceive(data, length);
+    });
+    logging::Logger::getInstance().info("Response receiver started");
+}
+
+void SmartroComm::ensureReceiver() {
+    // 모든 수신은 리액터를 거치므로, 요청 전에 반드시 등록되어 있어야 함
+    if (!receiverRunning_) {
+        startResponseReceiver();
+    }
 }
 
 void SmartroComm::stopResponseReceiver() {
     if (!receiverRunning_.exchange(false)) {
-        // ???? ?????
+        // 실행 중 아님
         return;
     }
     
-    if (receiverThread_.joinable()) {
-        queueCondition_.notify_all();  // ?????? ?????????
-        receiverThread_.join();
+    // 반환 후에는 onReceive/onFrameTimeout이 실행 중이지도, 다시 호출되지도 않음 (타이머도 함께 취소)
+    SerialReactor::getInstance().removePort(serialPort_);
+    frameTimer_ = 0;
+    
+    // 대기 중인 송신자/폴링 스레드 깨움
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        eraseAckWaiterLocked(nullptr);  // 다음 수신기는 새로 시작 — 늦은 ACK 대기 자리 정리
+        pendingCondition_.notify_all();
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        queueCondition_.notify_all();
     }
     
-    logging::Logger::getInstance().info("Response receiver thread stopped");
+    logging::Logger::getInstance().info("Response receiver stopped");
 }
 
-void SmartroComm::responseReceiverThread() {
-    logging::Logger::getInstance().debug("Response receiver thread started");
-    
-    while (receiverRunning_) {
-        // STX ?? (??? ????????????)
-        uint8_t byte = 0;
-        bool foundStx = false;
-        
-        {
-            std::lock_guard<std::mutex> lock(commMutex_);
-            if (!serialPort_.isOpen()) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                continue;
-            }
-            
-            if (readByte(byte, 100)) {  // 100ms ???????
-                if (byte == STX) {
-                    foundStx = true;
-                }
-            }
-        }
-        
-        if (!foundStx) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-            continue;
-        }
-        
-        // STX??????? ??? ???
-        std::vector<uint8_t> packet;
-        packet.push_back(STX);
-        
-        {
-            std::lock_guard<std::mutex> lock(commMutex_);
-            if (!receiveResponse(packet, RESPONSE_TIMEOUT_MS)) {
-                logging::Logger::getInstance().warn("Failed to receive response in receiver thread");
-                continue;
-            }
-        }
-        
-        // ??? ?? ????? ???
-        processResponse(packet);
+void SmartroComm::onReceive(const uint8_t* data, size_t length) {
+    // 포트가 다시 열렸으면 이전 포트의 미완성 프레임은 무의미
+    uint64_t generation = serialPort_.getOpenGeneration();
+    if (generation != decoderGeneration_) {
+        decoder_.reset();
+        decoderGeneration_ = generation;
     }
+    lastByteTime_ = std::chrono::steady_clock::now();
     
-    logging::Logger::getInstance().debug("Response receiver thread exiting");
+    // 링 안의 바이트를 복사 없이 디코더에 넘김 (프레임은 링을 가리키는 뷰로 전달됨)
+    decoder_.feed(data, length, tokenSink_);
+    
+    if (decoder_.inFrame() && frameTimer_ == 0) {
+        frameTimer_ = SerialReactor::getInstance().addTimer(std::chrono::milliseconds(FRAME_TIMEOUT_MS),
+                                                            [this]() { onFrameTimeout(); }, &serialPort_);
+    }
 }
 
-void SmartroComm::processResponse(const std::vector<uint8_t>& packet) {
-    if (packet.empty()) {
+void SmartroComm::onFrameTimeout() {
+    frameTimer_ = 0;
+    if (!decoder_.inFrame()) {
         return;
     }
-    
-    // ??? ???
-    std::vector<uint8_t> header;
-    std::vector<uint8_t> payload;
-    
-    if (!SmartroProtocol::parsePacket(packet.data(), packet.size(), header, payload)) {
-        logging::Logger::getInstance().warn("Failed to parse response packet in receiver thread");
+    if (serialPort_.getOpenGeneration() != decoderGeneration_) {
+        decoder_.reset();  // 포트가 닫혔다 열림 — 다음 바이트에서 새로 시작
         return;
     }
-    
-    if (header.size() < HEADER_SIZE) {
-        logging::Logger::getInstance().warn("Invalid header size in receiver thread");
+    // 타이머는 프레임 시작 시 한 번만 걸고, 그 뒤 바이트가 왔으면 남은 시간만큼 다시 검
+    auto idle = std::chrono::steady_clock::now() - lastByteTime_;
+    if (idle < std::chrono::milliseconds(FRAME_TIMEOUT_MS)) {
+        auto remaining = std::chrono::milliseconds(FRAME_TIMEOUT_MS) - std::chrono::duration_cast<std::chrono::milliseconds>(idle);
+        frameTimer_ = SerialReactor::getInstance().addTimer(remaining, [this]() { onFrameTimeout(); }, &serialPort_);
         return;
     }
+    logging::Logger::getInstance().warn("Incomplete frame timed out in receiver");
+    decoder_.abandonPartial(tokenSink_);
+}
+
+void SmartroComm::handleToken(const FrameDecoder::Token& token) {
+    switch (token.type) {
+        case FrameDecoder::TokenType::ACK:
+            dispatchAck(true);
+            break;
+        case FrameDecoder::TokenType::NACK:
+            dispatchAck(false);
+            break;
+        case FrameDecoder::TokenType::FRAME:
+            dispatchFrame(token.frame);
+            break;
+        case FrameDecoder::TokenType::BAD_FRAME:
+            // ETX/BCC 오류: 즉시 NACK → 단말이 재전송, 기다리는 요청은 계속 대기
+            logging::Logger::getInstance().warn("Corrupt frame (ETX/BCC) received, Job Code=" +
+                                               std::string(1, token.frame.jobCode()) + ", sending NACK");
+            sendNack();
+            break;
+    }
+}
+
+void SmartroComm::dispatchAck(bool ack) {
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    // 창이 지난 자리는 응답이 영영 안 온 것으로 보고 버림
+    auto now = std::chrono::steady_clock::now();
+    while (!ackWaiters_.empty() && !ackWaiters_.front().request
+           && now - ackWaiters_.front().writtenAt >= std::chrono::milliseconds(STALE_ACK_WINDOW_MS)) {
+        ackWaiters_.pop_front();
+    }
+    if (ackWaiters_.empty()) {
+        logging::Logger::getInstance().debug(std::string(ack ? "ACK" : "NACK") + " received with no request waiting, ignored");
+        return;
+    }
+    PendingRequest* request = ackWaiters_.front().request;
+    ackWaiters_.pop_front();
+    if (!request) {
+        logging::Logger::getInstance().warn(std::string(ack ? "ACK" : "NACK") + " for a timed-out request arrived late, ignored");
+        return;
+    }
+    if (ack) {
+        logging::Logger::getInstance().debug("ACK received (0x06)");
+        request->acked = true;
+    } else {
+        request->nacked = true;
+    }
+    pendingCondition_.notify_all();
+}
+
+void SmartroComm::dispatchFrame(const FrameView& frame) {
+    char jobCode = frame.jobCode();
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        auto it = pendingByJobCode_.find(jobCode);
+        if (it != pendingByJobCode_.end() && !it->second->completed) {
+            PendingRequest* request = it->second;
+            // ACK 없이 응답이 바로 온 경우: 응답 자체를 ACK로 간주하고 ACK 대기열에서 제거.
+            // 단말은 요청 순서대로 답하므로 이 요청 앞에 남은 자리(늦은 ACK 대기)도 더는 의미 없음
+            auto waiter = std::find_if(ackWaiters_.begin(), ackWaiters_.end(),
+                                       [request](const AckWaiter& w) { return w.request == request; });
+            if (waiter != ackWaiters_.end()) {
+                ackWaiters_.erase(std::remove_if(ackWaiters_.begin(), waiter,
+                                                 [](const AckWaiter& w) { return !w.request; }),
+                                  waiter + 1);
+            }
+            request->packet.assign(frame.data, frame.data + frame.size);  // 링은 곧 재사용되므로 요청 쪽으로 한 번 복사
+            request->completed = true;
+            pendingCondition_.notify_all();
+            logging::Logger::getInstance().debug("Response delivered to waiting request: Job Code=" + std::string(1, jobCode));
+            return;
+        }
+    }
+    // 기다리는 요청이 없는 프레임(이벤트, 비동기 승인 결과) → 링 위에서 바로 파싱해 응답 큐로
+    processResponse(frame);
+}
+
+void SmartroComm::processResponse(const FrameView& frame) {
+    // 디코더가 ETX/BCC까지 검증한 프레임만 오므로 재파싱 없이 뷰에서 바로 읽음
+    char jobCode = frame.jobCode();
+    const uint8_t* payload = frame.payload();
+    size_t payloadSize = frame.payloadSize();
+    
+    // 큐 슬롯에 직접 생성하고 채운 뒤 게시 (실패하면 슬롯만 버림)
+    ResponseData* response = responseQueue_.prepare();
+    if (!response) {
+        logging::Logger::getInstance().error("Response queue full (" + std::to_string(responseQueue_.capacity()) +
+                                             " items), dropping response: Job Code=" + std::string(1, jobCode));
+        return;
+    }
+    response->jobCode = jobCode;
     
-    char jobCode = SmartroProtocol::extractJobCode(header.data());
-    
-    ResponseData response;
-    response.jobCode = jobCode;
-    response.rawData = packet;
-    
-    // Job Code????? ???
     bool parsed = false;
-    
     switch (jobCode) {
         case JOB_CODE_DEVICE_CHECK_RESPONSE:  // 'a'
-            response.type = ResponseType::DEVICE_CHECK;
-            parsed = SmartroProtocol::parseDeviceCheckResponse(payload.data(), payload.size(), 
-                                                              response.deviceCheck);
+            response->type = ResponseType::DEVICE_CHECK;
+            parsed = SmartroProtocol::parseDeviceCheckResponse(payload, payloadSize,
+                                                              response->payload.emplace<DeviceCheckResponse>());
             break;
             
         case JOB_CODE_PAYMENT_WAIT_RESPONSE:  // 'e'
-            response.type = ResponseType::PAYMENT_WAIT;
-            parsed = SmartroProtocol::parsePaymentWaitResponse(payload.data(), payload.size(), 
-                                                              response.paymentWait);
+            response->type = ResponseType::PAYMENT_WAIT;
+            parsed = SmartroProtocol::parsePaymentWaitResponse(payload, payloadSize,
+                                                              response->payload.emplace<PaymentWaitResponse>());
             break;
             
         case JOB_CODE_CARD_UID_READ_RESPONSE:  // 'f'
-            response.type = ResponseType::CARD_UID_READ;
-            parsed = SmartroProtocol::parseCardUidReadResponse(payload.data(), payload.size(), 
-                                                              response.cardUid);
+            response->type = ResponseType::CARD_UID_READ;
+            parsed = SmartroProtocol::parseCardUidReadResponse(payload, payloadSize,
+                                                              response->payload.emplace<CardUidReadResponse>());
             break;
             
         case JOB_CODE_RESET_RESPONSE:  // 'r'
-            response.type = ResponseType::RESET;
-            parsed = true;  // Reset?? ??????? ???
+            response->type = ResponseType::RESET;
+            parsed = true;  // 리셋 응답에는 데이터 없음 (monostate)
             break;
             
         case JOB_CODE_PAYMENT_APPROVAL_RESPONSE:  // 'b'
-            response.type = ResponseType::PAYMENT_APPROVAL;
-            parsed = SmartroProtocol::parsePaymentApprovalResponse(payload.data(), payload.size(), 
-                                                                  response.paymentApproval);
+        case JOB_CODE_TRANSACTION_CANCEL_RESPONSE:  // 'c' (same layout)
+            response->type = ResponseType::PAYMENT_APPROVAL;
+            parsed = SmartroProtocol::parsePaymentApprovalResponse(payload, payloadSize,
+                                                                  response->payload.emplace<PaymentApprovalResponse>());
             if (parsed) {
-                logging::Logger::getInstance().info("Payment approval response parsed successfully: " + 
-                                                   std::to_string(response.paymentApproval.data.size()) + " bytes");
-            } else {
-                logging::Logger::getInstance().error("Failed to parse payment approval response");
-            }
-            break;
-            
-        case JOB_CODE_TRANSACTION_CANCEL_RESPONSE:  // 'c'
-            response.type = ResponseType::PAYMENT_APPROVAL;  // Same structure as payment approval
-            parsed = SmartroProtocol::parsePaymentApprovalResponse(payload.data(), payload.size(), 
-                                                                  response.paymentApproval);
-            if (parsed) {
-                logging::Logger::getInstance().info("Transaction cancel response parsed successfully: " + 
-                                                   std::to_string(response.paymentApproval.data.size()) + " bytes");
-            } else {
-                logging::Logger::getInstance().error("Failed to parse transaction cancel response");
+                logging::Logger::getInstance().info(std::string(jobCode == JOB_CODE_PAYMENT_APPROVAL_RESPONSE
+                                                                    ? "Payment approval" : "Transaction cancel") +
+                                                    " response parsed successfully: " +
+                                                    std::to_string(payloadSize) + " bytes");
             }
             break;
             
         case JOB_CODE_LAST_APPROVAL_RESPONSE_RESPONSE:  // 'l'
-            response.type = ResponseType::LAST_APPROVAL;
-            parsed = SmartroProtocol::parseLastApprovalResponse(payload.data(), payload.size(), 
-                                                               response.lastApproval);
+            response->type = ResponseType::LAST_APPROVAL;
+            parsed = SmartroProtocol::parseLastApprovalResponse(payload, payloadSize,
+                                                               response->payload.emplace<LastApprovalResponse>());
             if (parsed) {
                 logging::Logger::getInstance().info("Last approval response parsed successfully: " + 
-                                                   std::to_string(response.lastApproval.data.size()) + " bytes");
-            } else {
-                logging::Logger::getInstance().error("Failed to parse last approval response");
+                                                   std::to_string(payloadSize) + " bytes");
             }
             break;
             
         case JOB_CODE_SCREEN_SOUND_SETTING_RESPONSE:  // 's'
-            response.type = ResponseType::SCREEN_SOUND_SETTING;
-            parsed = SmartroProtocol::parseScreenSoundSettingResponse(payload.data(), payload.size(), 
-                                                                     response.screenSound);
+            response->type = ResponseType::SCREEN_SOUND_SETTING;
+            parsed = SmartroProtocol::parseScreenSoundSettingResponse(payload, payloadSize,
+                                                                     response->payload.emplace<ScreenSoundSettingResponse>());
             break;
             
         case JOB_CODE_IC_CARD_CHECK_RESPONSE:  // 'm'
-            response.type = ResponseType::IC_CARD_CHECK;
-            parsed = SmartroProtocol::parseIcCardCheckResponse(payload.data(), payload.size(), 
-                                                               response.icCard);
+            response->type = ResponseType::IC_CARD_CHECK;
+            parsed = SmartroProtocol::parseIcCardCheckResponse(payload, payloadSize,
+                                                               response->payload.emplace<IcCardCheckResponse>());
             break;
             
         case JOB_CODE_EVENT:  // '@'
-            response.type = ResponseType::EVENT;
-            parsed = SmartroProtocol::parseEventResponse(payload.data(), payload.size(), 
-                                                        response.event);
+            response->type = ResponseType::EVENT;
+            parsed = SmartroProtocol::parseEventResponse(payload, payloadSize,
+                                                        response->payload.emplace<EventResponse>());
             break;
             
         default:
+            responseQueue_.discard();
             logging::Logger::getInstance().warn("Unknown job code in response: " + 
                                                std::string(1, jobCode));
             return;
     }
     
     if (!parsed) {
+        responseQueue_.discard();
         logging::Logger::getInstance().warn("Failed to parse response data for job code: " + 
                                            std::string(1, jobCode));
         return;
     }
     
-    // ??? ???
-    {
+    responseQueue_.publish();
+    // 잠들려는 소비자만 깨움 (publish의 seq_cst 저장 ↔ pollResponse의 consumerWaiting_ 저장 후 재확인)
+    if (consumerWaiting_.load()) {
         std::lock_guard<std::mutex> lock(queueMutex_);
-        responseQueue_.push(response);
+        queueCondition_.notify_one();
     }
-    
-    queueCondition_.notify_one();
     logging::Logger::getInstance().debug("Response queued: Job Code=" + std::string(1, jobCode));
 }
 
 bool SmartroComm::pollResponse(ResponseData& response, uint32_t timeoutMs) {
-    std::unique_lock<std::mutex> lock(queueMutex_);
-
-    if (timeoutMs == 0) {
-        queueCondition_.wait(lock, [this] { return !responseQueue_.empty() || !receiverRunning_; });
-    } else {
-        auto timeout = std::chrono::milliseconds(timeoutMs);
-        if (!queueCondition_.wait_for(lock, timeout,
-                                      [this] { return !responseQueue_.empty() || !receiverRunning_; })) {
-            return false;
-        }
-    }
-
-    if (responseQueue_.empty()) {
-        return false;
-    }
-
-    response = responseQueue_.front();
-    responseQueue_.pop();
-    return true;
-}
-
-bool SmartroComm::sendPaymentApprovalRequestAsync(const std::string& terminalId, 
-                                                  const PaymentApprovalRequest& request) {
-    std::lock_guard<std::mutex> lock(commMutex_);
-    state_ = CommState::IDLE;
-    lastError_.clear();
-    
-    if (!serialPort_.isOpen()) {
-        setError("Serial port is not open");
-        return false;
-    }
-    
-    // ??? ???
-    auto packet = SmartroProtocol::createPaymentApprovalRequest(terminalId, request);
-    
-    // ??? ???
-    state_ = CommState::SENDING_REQUEST;
-    logging::Logger::getInstance().debug("Sending payment approval request (async)...");
-    
-    // ??? ??? ??? ?? ????
-    flushSerialBuffer();
-    
-    if (!serialPort_.write(packet.data(), packet.size())) {
-        setError("Failed to send request packet");
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // ACK ????(??? ???????
-    state_ = CommState::WAITING_ACK;
-    logging::Logger::getInstance().debug("Waiting for ACK...");
-    
-    std::vector<uint8_t> responsePacket;
-    if (!waitForAck(ACK_TIMEOUT_MS, responsePacket)) {
-        setError("ACK timeout or NACK received");
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // ACK ???
-    state_ = CommState::SENDING_ACK;
-    if (!sendAck()) {
-        logging::Logger::getInstance().warn("Failed to send ACK");
-    }
-    
-    // ??? ??? ??? (????? ?????????????????)
-    state_ = CommState::IDLE;
-    logging::Logger::getInstance().debug("Payment approval request sent (async), waiting for response in background");
-    return true;
-}
-
-bool SmartroComm::sendTransactionCancelRequest(const std::string& terminalId,
-                                               const TransactionCancelRequest& request,
-                                               TransactionCancelResponse& response,
-                                               uint32_t timeoutMs) {
-    std::lock_guard<std::mutex> lock(commMutex_);
-    state_ = CommState::IDLE;
-    lastError_.clear();
-    
-    if (!serialPort_.isOpen()) {
-        setError("Serial port is not open");
-        return false;
-    }
-    
-    // ?? ??
-    auto packet = SmartroProtocol::createTransactionCancelRequest(terminalId, request);
-    
-    // ?? ??
-    state_ = CommState::SENDING_REQUEST;
-    logging::Logger::getInstance().debug("Sending transaction cancel request...");
-    
-    // ??? ?? ???
-    flushSerialBuffer();
-    
-    if (!serialPort_.write(packet.data(), packet.size())) {
-        setError("Failed to send request packet");
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // ACK ??
-    state_ = CommState::WAITING_ACK;
-    logging::Logger::getInstance().debug("Waiting for ACK...");
-    
-    std::vector<uint8_t> responsePacket;
-    if (!waitForAck(ACK_TIMEOUT_MS, responsePacket)) {
-        setError("ACK timeout or NACK received");
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // ?? ?? (STX? ?? ???)
-    state_ = CommState::RECEIVING_RESPONSE;
-    logging::Logger::getInstance().debug("Receiving response...");
-    
-    if (!receiveResponse(responsePacket, timeoutMs)) {
-        setError("Failed to receive response");
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // ?? ??
-    std::vector<uint8_t> header;
-    std::vector<uint8_t> payload;
-    
-    if (responsePacket.empty()) {
-        setError("Empty response packet");
-        sendNack();
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    if (!SmartroProtocol::parsePacket(responsePacket.data(), responsePacket.size(), 
-                                     header, payload)) {
-        setError("Failed to parse response");
-        sendNack();
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // Job Code ??
-    if (header.size() < HEADER_SIZE) {
-        setError("Invalid header size: " + std::to_string(header.size()));
-        sendNack();
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    char jobCode = SmartroProtocol::extractJobCode(header.data());
-    if (jobCode != JOB_CODE_TRANSACTION_CANCEL_RESPONSE) {
-        setError("Unexpected job code: " + std::string(1, jobCode) + 
-                ", expected: " + std::string(1, JOB_CODE_TRANSACTION_CANCEL_RESPONSE));
-        sendNack();
-        state_ = CommState::ERROR;
-        return false;
-    }
-    
-    // ?? ??? ??
-    if (!SmartroProtocol::parseTransactionCancelResponse(payload.data(), payload.size(), response)) {
-        setError("Failed to parse transaction cancel response data");
-        sendNack();
-        state_ = CommState::ERROR;
-        return false;
+    if (responseQueue_.tryPop(response)) {
+        return true;
     }
     
-    // ??! ACK ??
-    state_ = CommState::SENDING_ACK;
-    if (!sendAck()) {
-        logging::Logger::getInstance().warn("Failed to send ACK, but response was valid");
+    {
+        std::unique_lock<std::mutex> lock(queueMutex_);
+        consumerWaiting_.store(true);
+        auto ready = [this] { return !responseQueue_.empty() || !receiverRunning_; };
+        if (timeoutMs == 0) {
+            queueCondition_.wait(lock, ready);
+        } else {
+            queueCondition_.wait_for(lock, std::chrono::milliseconds(timeoutMs), ready);
+        }
+        consumerWaiting_.store(false);
     }
     
-    state_ = CommState::COMPLETED;
-    logging::Logger::getInstance().debug("Transaction cancel request completed successfully");
-    return true;
+    return responseQueue_.tryPop(response);
 }
 
 } // namespace smartro
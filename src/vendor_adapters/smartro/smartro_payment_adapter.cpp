@@ -1,10 +1,13 @@
 // src/vendor_adapters/smartro/smartro_payment_adapter.cpp
 #include "logging/logger.h"
 #include "config/config_manager.h"
+#include "devices/probe_cache.h"
 #include "vendor_adapters/smartro/smartro_payment_adapter.h"
 #include "vendor_adapters/smartro/smartro_protocol.h"
 #include <sstream>
+#include <chrono>
 #include <vector>
+#include <string_view>
 #ifdef _WIN32
     #ifndef WIN32_LEAN_AND_MEAN
         #define WIN32_LEAN_AND_MEAN
@@ -31,25 +34,43 @@ std::string transactionTypeToString(char type) {
 }
 
 // 응답전문 [b] 발급사/매입사는 CP949(한국어 Windows). IPC/Flutter는 UTF-8이므로 변환.
-std::string cp949ToUtf8(const std::string& cp949) {
-    if (cp949.empty()) return cp949;
+// 응답 필드 뷰에서 바로 변환 (중간 std::string 없음)
+std::string cp949ToUtf8(std::string_view cp949) {
+    if (cp949.empty()) return std::string();
 #ifdef _WIN32
     const int cp949_code_page = 949;
-    int wlen = MultiByteToWideChar(cp949_code_page, 0, cp949.c_str(), static_cast<int>(cp949.size()), nullptr, 0);
-    if (wlen <= 0) return cp949;
+    int wlen = MultiByteToWideChar(cp949_code_page, 0, cp949.data(), static_cast<int>(cp949.size()), nullptr, 0);
+    if (wlen <= 0) return std::string(cp949);
     std::vector<wchar_t> wbuf(static_cast<size_t>(wlen) + 1u, 0);
-    if (MultiByteToWideChar(cp949_code_page, 0, cp949.c_str(), static_cast<int>(cp949.size()), wbuf.data(), wlen) == 0)
-        return cp949;
+    if (MultiByteToWideChar(cp949_code_page, 0, cp949.data(), static_cast<int>(cp949.size()), wbuf.data(), wlen) == 0)
+        return std::string(cp949);
     int ulen = WideCharToMultiByte(CP_UTF8, 0, wbuf.data(), wlen, nullptr, 0, nullptr, nullptr);
-    if (ulen <= 0) return cp949;
+    if (ulen <= 0) return std::string(cp949);
     std::string utf8(static_cast<size_t>(ulen), '\0');
     if (WideCharToMultiByte(CP_UTF8, 0, wbuf.data(), wlen, &utf8[0], ulen, nullptr, nullptr) == 0)
-        return cp949;
+        return std::string(cp949);
     return utf8;
 #else
-    return cp949;
+    return std::string(cp949);
 #endif
 }
+
+// 장치체크 응답: 모든 모듈이 'O'(정상) 또는 'N'(미사용)이면 정상
+bool deviceCheckAllOk(const DeviceCheckResponse& response) {
+    return (response.cardModuleStatus == 'O' || response.cardModuleStatus == 'N') &&
+           (response.rfModuleStatus == 'O' || response.rfModuleStatus == 'N') &&
+           (response.vanServerStatus == 'O' || response.vanServerStatus == 'N') &&
+           (response.integrationServerStatus == 'O' || response.integrationServerStatus == 'N');
+}
+
+std::string deviceCheckError(const DeviceCheckResponse& response) {
+    std::ostringstream oss;
+    oss << "Device check failed: card=" << response.cardModuleStatus
+        << ", rf=" << response.rfModuleStatus
+        << ", van=" << response.vanServerStatus
+        << ", integration=" << response.integrationServerStatus;
+    return oss.str();
+}
 }  // namespace
 
 SmartroPaymentAdapter::SmartroPaymentAdapter(const std::string& deviceId,
@@ -59,6 +80,7 @@ SmartroPaymentAdapter::SmartroPaymentAdapter(const std::string& deviceId,
     , comPort_(comPort)
     , terminalId_(terminalId)
     , state_(devices::DeviceState::DISCONNECTED)
+    , circuit_(deviceId)
     , paymentInProgress_(false)
     , paymentCancelled_(false)
     , currentAmount_(0)
@@ -111,6 +133,8 @@ bool SmartroPaymentAdapter::startPayment(uint32_t amount) {
         return false;
     }
     
+    if (!circuitAllows("payment")) return false;
+    
     // Send payment approval request (async) - non-blocking
     // This matches test_integrated.cpp pattern: sendPaymentApprovalRequestAsync only
     PaymentApprovalRequest approvalReq;
@@ -123,9 +147,11 @@ bool SmartroPaymentAdapter::startPayment(uint32_t amount) {
     
     if (!smartroComm_->sendPaymentApprovalRequestAsync(terminalId_, approvalReq)) {
         lastError_ = "Failed to send payment approval request: " + smartroComm_->getLastError();
-        updateState(devices::DeviceState::STATE_ERROR);
+        circuit_.recordFailure();
+        updateState(devices::DeviceState::STATE_ERROR, devices::StateErrorCode::SEND_FAILED);
         return false;
     }
+    circuit_.recordSuccess();
     
     // Change to processing state immediately (non-blocking)
     paymentInProgress_ = true;
@@ -198,10 +224,13 @@ devices::DeviceState SmartroPaymentAdapter::getState() const {
 bool SmartroPaymentAdapter::reset() {
     std::lock_guard<std::mutex> lock(stateMutex_);
     
-    if (!smartroComm_->sendResetRequest(terminalId_, 3000)) {
+    if (!circuitAllows("reset")) return false;
+    if (!smartroComm_->sendResetRequest(terminalId_, 10000)) {
         lastError_ = "Failed to reset device: " + smartroComm_->getLastError();
+        circuit_.recordFailure();
         return false;
     }
+    circuit_.recordSuccess();
     
     paymentInProgress_ = false;
     paymentCancelled_ = false;
@@ -213,17 +242,14 @@ bool SmartroPaymentAdapter::reset() {
 bool SmartroPaymentAdapter::checkDevice() {
     std::lock_guard<std::mutex> lock(stateMutex_);
     
-    updateState(devices::DeviceState::STATE_CONNECTING);
-    
-    // Open serial port
-    if (!serialPort_->isOpen()) {
-        if (!serialPort_->open(comPort_, 115200)) {
-            lastError_ = "Failed to open serial port: " + comPort_;
-            updateState(devices::DeviceState::DISCONNECTED);
-            return false;
-        }
+    // 회로 열림: 전체 포트 스캔(포트당 타임아웃) 없이 즉시 실패
+    if (!circuitAllows("device check")) {
+        updateState(devices::DeviceState::DISCONNECTED, devices::StateErrorCode::CIRCUIT_OPEN);
+        return false;
     }
     
+    updateState(devices::DeviceState::STATE_CONNECTING);
+    
     // Start response receiver thread
     if (!monitorRunning_) {
         smartroComm_->startResponseReceiver();
@@ -231,43 +257,93 @@ bool SmartroPaymentAdapter::checkDevice() {
         monitorThread_ = std::thread(&SmartroPaymentAdapter::eventMonitorThread, this);
     }
     
-    // Send device check (tries comPort_ first if set, then other ports)
+    // 프로브 캐시에 기록된 장치가 다른 COM 번호로 옮겨갔으면 그 포트를 먼저 시도
+    // (세션 포트가 열려 있으면 스캔하지 않으므로 하드웨어 ID 조회 생략)
+    std::string preferredPort = comPort_;
+    devices::ProbeCacheEntry cached;
+    if (!(serialPort_->isOpen() && serialPort_->getPortName() == comPort_)
+        && devices::ProbeCache::getInstance().get("card", cached) && cached.vendor == "smartro" && cached.port == comPort_) {
+        preferredPort = devices::ProbeCache::getInstance().resolvePort(cached);
+    }
+
+    // 현금결제기 포트는 스캔에서 제외 (detectOnPorts와 같은 규칙)
+    std::string cashPort;
+    if (config::ConfigManager::getInstance().getCashEnabled()) {
+        cashPort = config::ConfigManager::getInstance().getCashComPort();
+    }
+
+    // Send device check: on the open session port if there is one (no reopen); otherwise, or if
+    // that port stops answering twice, scan (preferredPort first, then other ports)
     DeviceCheckResponse response;
-    if (!smartroComm_->sendDeviceCheckRequest(terminalId_, response, 3000, comPort_)) {
+    auto probeStart = std::chrono::steady_clock::now();
+    if (!smartroComm_->sendDeviceCheckRequest(terminalId_, response, 3000, preferredPort, cashPort)) {
         lastError_ = "Device check failed: " + smartroComm_->getLastError();
-        updateState(devices::DeviceState::STATE_ERROR);
+        circuit_.recordFailure();
+        updateState(devices::DeviceState::STATE_ERROR, devices::StateErrorCode::NO_RESPONSE);
         return false;
     }
+    circuit_.recordSuccess();  // 응답 수신 = 장치 존재 (상태 이상은 회로와 무관)
+    auto probeLatencyMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - probeStart).count();
     
-    // Sync adapter to the port we actually connected to (scan result)
+    // Sync adapter to the port we actually connected to (session port or scan result)
     std::string detectedPort = serialPort_->getPortName();
     if (!detectedPort.empty()) {
-        comPort_ = detectedPort;
-        config::ConfigManager::getInstance().setPaymentComPort(detectedPort);
-        config::ConfigManager::getInstance().saveIfInitialized();
-        logging::Logger::getInstance().info("Payment terminal detected on " + detectedPort + ", config updated");
+        if (detectedPort != comPort_) {
+            comPort_ = detectedPort;
+            config::ConfigManager::getInstance().setPaymentComPort(detectedPort);
+            config::ConfigManager::getInstance().saveIfInitialized();
+            logging::Logger::getInstance().info("Payment terminal detected on " + detectedPort + ", config updated");
+        }
+        devices::ProbeCacheEntry entry;
+        entry.category = "card";
+        entry.port = detectedPort;
+        entry.vendor = "smartro";
+        entry.baudRate = 115200;
+        entry.probeLatencyMs = static_cast<uint32_t>(probeLatencyMs);
+        devices::ProbeCache::getInstance().recordSuccess(entry);
     }
 
     // Check response
-    bool allOk = (response.cardModuleStatus == 'O' || response.cardModuleStatus == 'N') &&
-                 (response.rfModuleStatus == 'O' || response.rfModuleStatus == 'N') &&
-                 (response.vanServerStatus == 'O' || response.vanServerStatus == 'N') &&
-                 (response.integrationServerStatus == 'O' || response.integrationServerStatus == 'N');
-    
-    if (allOk) {
+    if (deviceCheckAllOk(response)) {
         updateState(devices::DeviceState::STATE_READY);
         lastError_.clear();
         return true;
     } else {
-        std::ostringstream oss;
-        oss << "Device check failed: card=" << response.cardModuleStatus
-            << ", rf=" << response.rfModuleStatus
-            << ", van=" << response.vanServerStatus
-            << ", integration=" << response.integrationServerStatus;
-        lastError_ = oss.str();
-        updateState(devices::DeviceState::STATE_ERROR);
+        lastError_ = deviceCheckError(response);
+        updateState(devices::DeviceState::STATE_ERROR, devices::StateErrorCode::DEVICE_FAULT);
+        return false;
+    }
+}
+
+bool SmartroPaymentAdapter::heartbeat() {
+    // 다른 명령(결제/장치체크) 수행 중이면 건너뜀 — 하트비트가 결제를 기다리게 하지 않음
+    std::unique_lock<std::mutex> lock(stateMutex_, std::try_to_lock);
+    if (!lock.owns_lock()) return true;
+    if (paymentInProgress_ || state_ == devices::DeviceState::STATE_PROCESSING) return true;
+    if (comPort_.empty()) return false;
+    if (!circuitAllows("heartbeat")) return false;
+
+    // 장치체크('A')를 현재 포트에만 전송 (포트 스캔/CONNECTING 전이 없음)
+    DeviceCheckResponse response;
+    if (!smartroComm_->sendDeviceCheckOnPort(terminalId_, response, comPort_)) {
+        lastError_ = "Heartbeat failed: " + smartroComm_->getLastError();
+        circuit_.recordFailure();
+        if (state_ == devices::DeviceState::STATE_READY) {
+            logging::Logger::getInstance().warn("Payment terminal heartbeat failed on " + comPort_ + ": " + smartroComm_->getLastError());
+            updateState(devices::DeviceState::DISCONNECTED, devices::StateErrorCode::NO_RESPONSE);
+        }
+        return false;
+    }
+    circuit_.recordSuccess();
+    if (!deviceCheckAllOk(response)) {
+        lastError_ = deviceCheckError(response);
+        updateState(devices::DeviceState::STATE_ERROR, devices::StateErrorCode::DEVICE_FAULT);
         return false;
     }
+    lastError_.clear();
+    updateState(devices::DeviceState::STATE_READY);
+    return true;
 }
 
 bool SmartroPaymentAdapter::reconnect(const std::string& newPort) {
@@ -283,6 +359,7 @@ bool SmartroPaymentAdapter::reconnect(const std::string& newPort) {
         smartroComm_->stopResponseReceiver();
         comPort_ = newPort;
     }
+    circuit_.reset();  // 새 포트 → 이전 실패 이력 무효
     logging::Logger::getInstance().info("Payment terminal reconnecting to " + newPort);
     return checkDevice();
 }
@@ -303,13 +380,23 @@ void SmartroPaymentAdapter::setStateChangedCallback(std::function<void(devices::
     stateChangedCallback_ = callback;
 }
 
-void SmartroPaymentAdapter::updateState(devices::DeviceState newState) {
+bool SmartroPaymentAdapter::circuitAllows(const std::string& operation) {
+    if (circuit_.allow()) return true;
+    auto stats = circuit_.getStats();
+    lastError_ = "Circuit open (" + std::to_string(stats.consecutiveFailures) + " consecutive failures), "
+        + operation + " rejected, retry in " + std::to_string(stats.retryInMs) + " ms";
+    logging::Logger::getInstance().debug("Payment terminal " + deviceId_ + ": " + lastError_);
+    return false;
+}
+
+void SmartroPaymentAdapter::updateState(devices::DeviceState newState, devices::StateErrorCode error) {
     devices::DeviceState oldState = state_;
     state_ = newState;
     lastUpdateTime_ = std::chrono::system_clock::now();
     
-    if (oldState != newState && stateChangedCallback_) {
-        stateChangedCallback_(newState);
+    if (oldState != newState) {
+        history_.record(oldState, newState, error);
+        if (stateChangedCallback_) stateChangedCallback_(newState);
     }
 }
 
@@ -343,7 +430,7 @@ void SmartroPaymentAdapter::processPaymentResponse(const PaymentApprovalResponse
         if (paymentFailedCallback_) {
             devices::PaymentFailedEvent event;
             event.errorCode = "VAN_REJECTED";
-            event.errorMessage = response.rejectionInfo.empty() ? "Payment rejected" : response.rejectionInfo;
+            event.errorMessage = response.rejectionInfo().empty() ? "Payment rejected" : cp949ToUtf8(response.rejectionInfo());
             event.amount = currentAmount_;
             event.state = devices::DeviceState::STATE_READY;
             logging::Logger::getInstance().info("Calling paymentFailedCallback_");
@@ -353,29 +440,30 @@ void SmartroPaymentAdapter::processPaymentResponse(const PaymentApprovalResponse
         }
     } else {
         // Payment success
-        logging::Logger::getInstance().info("Payment was successful - transactionId: " + response.transactionId);
+        logging::Logger::getInstance().info("Payment was successful - transactionId: " + std::string(response.transactionId()));
         updateState(devices::DeviceState::STATE_READY);
         
         if (paymentCompleteCallback_) {
+            // 응답은 프레임 바이트 위의 뷰 — 소유 문자열로 바꾸는 곳은 여기(이벤트 경계)뿐
             devices::PaymentCompleteEvent event;
-            event.transactionId = response.transactionId;
+            event.transactionId = std::string(response.transactionId());
             event.amount = currentAmount_;
-            event.cardNumber = response.cardNumber;
-            event.approvalNumber = response.approvalNumber;
-            event.salesDate = response.salesDate;
-            event.salesTime = response.salesTime;
-            event.transactionMedium = std::string(1, response.transactionMedium);
+            event.cardNumber = std::string(response.cardNumber());
+            event.approvalNumber = std::string(response.approvalNumber());
+            event.salesDate = std::string(response.salesDate());
+            event.salesTime = std::string(response.salesTime());
+            event.transactionMedium = std::string(1, response.transactionMedium());
             event.state = devices::DeviceState::STATE_READY;
             event.status = "SUCCESS";
-            event.transactionType = transactionTypeToString(response.transactionType);
-            event.approvalAmount = response.approvalAmount;
-            event.tax = response.tax;
-            event.serviceCharge = response.serviceCharge;
-            event.installments = response.installments;
-            event.merchantNumber = response.merchantNumber;
-            event.terminalNumber = response.terminalNumber;
-            event.issuer = cp949ToUtf8(response.issuer);
-            event.acquirer = cp949ToUtf8(response.acquirer);
+            event.transactionType = transactionTypeToString(response.transactionType());
+            event.approvalAmount = std::string(response.approvalAmount());
+            event.tax = std::string(response.tax());
+            event.serviceCharge = std::string(response.serviceCharge());
+            event.installments = std::string(response.installments());
+            event.merchantNumber = std::string(response.merchantNumber());
+            event.terminalNumber = std::string(response.terminalNumber());
+            event.issuer = cp949ToUtf8(response.issuer());
+            event.acquirer = cp949ToUtf8(response.acquirer());
             logging::Logger::getInstance().info("Calling paymentCompleteCallback_");
             paymentCompleteCallback_(event);
         } else {
@@ -434,12 +522,12 @@ void SmartroPaymentAdapter::eventMonitorThread() {
             switch (response.type) {
                 case smartro::ResponseType::PAYMENT_APPROVAL:
                     logging::Logger::getInstance().info("Processing PAYMENT_APPROVAL response");
-                    processPaymentResponse(response.paymentApproval);
+                    processPaymentResponse(std::get<PaymentApprovalResponse>(response.payload));
                     break;
                     
                 case smartro::ResponseType::EVENT:
                     logging::Logger::getInstance().info("Processing EVENT response");
-                    processEvent(response.event);
+                    processEvent(std::get<EventResponse>(response.payload));
                     break;
                     
                 default:
@@ -464,10 +552,13 @@ bool SmartroPaymentAdapter::readCardUidRaw(CardUidReadResponse& response) {
         return false;
     }
     
-    if (!smartroComm_->sendCardUidReadRequest(terminalId_, response, 3000)) {
+    if (!circuitAllows("card uid read")) return false;
+    if (!smartroComm_->sendCardUidReadRequest(terminalId_, response, 10000)) {
         lastError_ = "Card UID read failed: " + smartroComm_->getLastError();
+        circuit_.recordFailure();
         return false;
     }
+    circuit_.recordSuccess();
     
     return true;
 }
@@ -480,10 +571,13 @@ bool SmartroPaymentAdapter::getLastApprovalRaw(LastApprovalResponse& response) {
         return false;
     }
     
+    if (!circuitAllows("last approval request")) return false;
     if (!smartroComm_->sendLastApprovalResponseRequest(terminalId_, response, 30000)) {
         lastError_ = "Last approval request failed: " + smartroComm_->getLastError();
+        circuit_.recordFailure();
         return false;
     }
+    circuit_.recordSuccess();
     
     return true;
 }
@@ -496,10 +590,13 @@ bool SmartroPaymentAdapter::checkIcCardRaw(IcCardCheckResponse& response) {
         return false;
     }
     
+    if (!circuitAllows("ic card check")) return false;
     if (!smartroComm_->sendIcCardCheckRequest(terminalId_, response, 3000)) {
         lastError_ = "IC card check failed: " + smartroComm_->getLastError();
+        circuit_.recordFailure();
         return false;
     }
+    circuit_.recordSuccess();
     
     return true;
 }
@@ -512,10 +609,13 @@ bool SmartroPaymentAdapter::setScreenSoundRaw(const ScreenSoundSettingRequest& r
         return false;
     }
     
+    if (!circuitAllows("screen/sound setting")) return false;
     if (!smartroComm_->sendScreenSoundSettingRequest(terminalId_, request, response, 3000)) {
         lastError_ = "Screen/sound setting failed: " + smartroComm_->getLastError();
+        circuit_.recordFailure();
         return false;
     }
+    circuit_.recordSuccess();
     
     return true;
 }
@@ -528,10 +628,13 @@ bool SmartroPaymentAdapter::cancelTransactionRaw(const TransactionCancelRequest&
         return false;
     }
     
+    if (!circuitAllows("transaction cancel")) return false;
     if (!smartroComm_->sendTransactionCancelRequest(terminalId_, request, response, 30000)) {
         lastError_ = "Transaction cancel failed: " + smartroComm_->getLastError();
+        circuit_.recordFailure();
         return false;
     }
+    circuit_.recordSuccess();
     
     return true;
 }
@@ -545,7 +648,7 @@ devices::CardUidResult SmartroPaymentAdapter::readCardUid() {
     if (!readCardUidRaw(raw)) {
         return {false, {}, lastError_};
     }
-    return {true, raw.uid, ""};
+    return {true, std::vector<uint8_t>(raw.uid.begin(), raw.uid.end()), ""};
 }
 
 devices::IcCardCheckResult SmartroPaymentAdapter::checkIcCard() {
@@ -591,17 +694,17 @@ devices::TransactionCancelResult SmartroPaymentAdapter::cancelTransaction(const
 
     devices::TransactionCancelResult result;
     result.success = rawResp.isSuccess();
-    result.transactionType = std::string(1, rawResp.transactionType);
-    result.transactionMedium = std::string(1, rawResp.transactionMedium);
-    result.cardNumber = rawResp.cardNumber;
-    result.approvalAmount = rawResp.approvalAmount;
-    result.tax = rawResp.tax;
-    result.serviceCharge = rawResp.serviceCharge;
-    result.installments = rawResp.installments;
-    result.approvalNumber = rawResp.approvalNumber;
-    result.salesDate = rawResp.salesDate;
-    result.salesTime = rawResp.salesTime;
-    result.error = rawResp.isRejected() ? rawResp.rejectionInfo : "";
+    result.transactionType = std::string(1, rawResp.transactionType());
+    result.transactionMedium = std::string(1, rawResp.transactionMedium());
+    result.cardNumber = std::string(rawResp.cardNumber());
+    result.approvalAmount = std::string(rawResp.approvalAmount());
+    result.tax = std::string(rawResp.tax());
+    result.serviceCharge = std::string(rawResp.serviceCharge());
+    result.installments = std::string(rawResp.installments());
+    result.approvalNumber = std::string(rawResp.approvalNumber());
+    result.salesDate = std::string(rawResp.salesDate());
+    result.salesTime = std::string(rawResp.salesTime());
+    result.error = rawResp.isRejected() ? cp949ToUtf8(rawResp.rejectionInfo()) : "";
     return result;
 }
 
@@ -628,11 +731,12 @@ devices::PaymentCompleteEvent SmartroPaymentAdapter::getLastApproval(const std::
 // Static port probe: try Smartro protocol on a given COM port
 bool SmartroPaymentAdapter::tryPort(const std::string& port) {
     try {
+        // 지정 포트만 검사 (병렬 탐색 시 다른 포트를 열지 않도록 스캔 없는 단일 포트 체크)
         SerialPort sp;
         if (!sp.open(port, 115200)) return false;
         SmartroComm comm(sp);
         DeviceCheckResponse resp;
-        bool ok = comm.sendDeviceCheckRequest("DEFAULT_TERM", resp, 2000, port);
+        bool ok = comm.sendDeviceCheckOnPort("DEFAULT_TERM", resp, port);
         sp.close();
         return ok;
     } catch (...) {
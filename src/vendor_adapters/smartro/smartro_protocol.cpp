@@ -2,563 +2,225 @@
 // logger.h???????? include??? Windows SDK ?? ???
 #include "logging/logger.h"
 #include "vendor_adapters/smartro/smartro_protocol.h"
+#include "vendor_adapters/smartro/packet_layout.h"
 #include <ctime>
 #include <algorithm>
 #include <cstring>
 
 namespace smartro {
 
-std::vector<uint8_t> SmartroProtocol::createDeviceCheckRequest(const std::string& terminalId) {
-    std::vector<uint8_t> packet;
-    packet.reserve(MIN_PACKET_SIZE);
-    
-    // STX
-    packet.push_back(STX);
-    
-    // Terminal ID (16 bytes)
-    auto formattedTerminalId = formatTerminalId(terminalId);
-    packet.insert(packet.end(), formattedTerminalId.begin(), formattedTerminalId.end());
-    
-    // DateTime (14 bytes)
-    std::string dateTime = getCurrentDateTime();
-    for (size_t i = 0; i < 14; ++i) {
-        if (i < dateTime.length()) {
-            packet.push_back(static_cast<uint8_t>(dateTime[i]));
-        } else {
-            packet.push_back(0x00);
-        }
-    }
-    
-    // Job Code: 'A'
-    packet.push_back(static_cast<uint8_t>(JOB_CODE_DEVICE_CHECK));
-    
-    // Response Code: 0x00
-    packet.push_back(0x00);
-    
-    // Data Length: 0x0000 (Little Endian, USHORT)
-    packet.push_back(0x00);
-    packet.push_back(0x00);
-    
-    // ETX
-    packet.push_back(ETX);
-    
-    // BCC ?? (STX???ETX???)
-    uint8_t bcc = calculateBCC(packet.data(), packet.size());
-    packet.push_back(bcc);
-    
-    logging::Logger::getInstance().debug("Created device check request packet: " + 
-                                        std::to_string(packet.size()) + " bytes");
-    
-    return packet;
-}
+namespace {
 
-std::vector<uint8_t> SmartroProtocol::createPaymentWaitRequest(const std::string& terminalId) {
-    std::vector<uint8_t> packet;
-    packet.reserve(MIN_PACKET_SIZE);
-    
-    // STX
-    packet.push_back(STX);
-    
-    // Terminal ID (16 bytes)
-    auto formattedTerminalId = formatTerminalId(terminalId);
-    packet.insert(packet.end(), formattedTerminalId.begin(), formattedTerminalId.end());
-    
-    // DateTime (14 bytes)
-    std::string dateTime = getCurrentDateTime();
-    for (size_t i = 0; i < 14; ++i) {
-        if (i < dateTime.length()) {
-            packet.push_back(static_cast<uint8_t>(dateTime[i]));
-        } else {
-            packet.push_back(0x00);
-        }
+constexpr uint64_t maxValueForDigits(size_t width) {
+    uint64_t value = 1;
+    for (size_t i = 0; i < width; ++i) {
+        value *= 10;
     }
-    
-    // Job Code: 'E'
-    packet.push_back(static_cast<uint8_t>(JOB_CODE_PAYMENT_WAIT));
-    
-    // Response Code: 0x00
-    packet.push_back(0x00);
-    
-    // Data Length: 0x0000 (Little Endian, USHORT) - ?????????? ???????????? 0
-    packet.push_back(0x00);
-    packet.push_back(0x00);
-    
-    // ETX
-    packet.push_back(ETX);
-    
-    // BCC ?? (STX???ETX???)
-    uint8_t bcc = calculateBCC(packet.data(), packet.size());
-    packet.push_back(bcc);
-    
-    logging::Logger::getInstance().debug("Created payment wait request packet: " + 
-                                        std::to_string(packet.size()) + " bytes");
-    
-    return packet;
+    return value - 1;
 }
 
-std::vector<uint8_t> SmartroProtocol::createCardUidReadRequest(const std::string& terminalId) {
-    std::vector<uint8_t> packet;
-    packet.reserve(MIN_PACKET_SIZE);
-    
-    // STX
-    packet.push_back(STX);
-    
-    // Terminal ID (16 bytes)
-    auto formattedTerminalId = formatTerminalId(terminalId);
-    packet.insert(packet.end(), formattedTerminalId.begin(), formattedTerminalId.end());
-    
-    // DateTime (14 bytes)
-    std::string dateTime = getCurrentDateTime();
-    for (size_t i = 0; i < 14; ++i) {
-        if (i < dateTime.length()) {
-            packet.push_back(static_cast<uint8_t>(dateTime[i]));
-        } else {
-            packet.push_back(0x00);
-        }
+// Writes one request into a RequestPacket at the offsets of packet_layout.h. Every byte goes
+// through put(), which folds it into the running BCC, so finish() only appends ETX and BCC.
+class PacketWriter {
+public:
+    PacketWriter(RequestPacket& packet, const std::string& terminalId, char jobCode, uint16_t dataLength)
+        : PacketWriter(packet, terminalId, jobCode, dataLength, dataLength) {
     }
-    
-    // Job Code: 'F'
-    packet.push_back(static_cast<uint8_t>(JOB_CODE_CARD_UID_READ));
-    
-    // Response Code: 0x00
-    packet.push_back(0x00);
-    
-    // Data Length: 0x0000 (Little Endian, USHORT) - ?????????? ???????????? 0
-    packet.push_back(0x00);
-    packet.push_back(0x00);
-    
-    // ETX
-    packet.push_back(ETX);
-    
-    // BCC ?? (STX???ETX???)
-    uint8_t bcc = calculateBCC(packet.data(), packet.size());
-    packet.push_back(bcc);
-    
-    logging::Logger::getInstance().debug("Created card UID read request packet: " + 
-                                        std::to_string(packet.size()) + " bytes");
-    
-    return packet;
-}
 
-std::vector<uint8_t> SmartroProtocol::createResetRequest(const std::string& terminalId) {
-    std::vector<uint8_t> packet;
-    packet.reserve(MIN_PACKET_SIZE);
-    
-    // STX
-    packet.push_back(STX);
-    
-    // Terminal ID (16 bytes)
-    auto formattedTerminalId = formatTerminalId(terminalId);
-    packet.insert(packet.end(), formattedTerminalId.begin(), formattedTerminalId.end());
-    
-    // DateTime (14 bytes)
-    std::string dateTime = getCurrentDateTime();
-    for (size_t i = 0; i < 14; ++i) {
-        if (i < dateTime.length()) {
-            packet.push_back(static_cast<uint8_t>(dateTime[i]));
-        } else {
-            packet.push_back(0x00);
-        }
+    // declaredLength: Data Length written in the header when it differs from the bytes sent ('C')
+    PacketWriter(RequestPacket& packet, const std::string& terminalId, char jobCode, uint16_t dataLength,
+                 uint16_t declaredLength)
+        : packet_(packet.reset(dataLength))
+        , data_(packet_ + HEADER_SIZE)
+        , dataLength_(dataLength) {
+        using H = layout::Header;
+        put(packet_ + H::Stx::offset, STX);
+        writeText(packet_ + H::TerminalId::offset, H::TerminalId::width, terminalId.data(), terminalId.size(), 0x00);
+        writeDateTime(packet_ + H::DateTime::offset);
+        put(packet_ + H::JobCode::offset, static_cast<uint8_t>(jobCode));
+        put(packet_ + H::ResponseCode::offset, 0x00);
+        put(packet_ + H::DataLength::offset, static_cast<uint8_t>(declaredLength & 0xFF));
+        put(packet_ + H::DataLength::offset + 1, static_cast<uint8_t>((declaredLength >> 8) & 0xFF));
     }
-    
-    // Job Code: 'R'
-    packet.push_back(static_cast<uint8_t>(JOB_CODE_RESET));
-    
-    // Response Code: 0x00
-    packet.push_back(0x00);
-    
-    // Data Length: 0x0000 (Little Endian, USHORT) - ?????????? ???????????? 0
-    packet.push_back(0x00);
-    packet.push_back(0x00);
-    
-    // ETX
-    packet.push_back(ETX);
-    
-    // BCC ?? (STX???ETX???)
-    uint8_t bcc = calculateBCC(packet.data(), packet.size());
-    packet.push_back(bcc);
-    
-    logging::Logger::getInstance().debug("Created reset request packet: " + 
-                                        std::to_string(packet.size()) + " bytes");
-    
-    return packet;
-}
 
-std::vector<uint8_t> SmartroProtocol::createPaymentApprovalRequest(const std::string& terminalId,
-                                                                   const PaymentApprovalRequest& request) {
-    std::vector<uint8_t> packet;
-    packet.reserve(HEADER_SIZE + 30 + TAIL_SIZE);  // Data Length = 30
-    
-    // STX
-    packet.push_back(STX);
-    
-    // Terminal ID (16 bytes)
-    auto formattedTerminalId = formatTerminalId(terminalId);
-    packet.insert(packet.end(), formattedTerminalId.begin(), formattedTerminalId.end());
-    
-    // DateTime (14 bytes)
-    std::string dateTime = getCurrentDateTime();
-    for (size_t i = 0; i < 14; ++i) {
-        if (i < dateTime.length()) {
-            packet.push_back(static_cast<uint8_t>(dateTime[i]));
-        } else {
-            packet.push_back(0x00);
-        }
+    template <typename F>
+    void byte(uint8_t value) {
+        static_assert(F::width == 1, "byte field");
+        put(data_ + F::offset, value);
     }
-    
-    // Job Code: 'B'
-    packet.push_back(static_cast<uint8_t>(JOB_CODE_PAYMENT_APPROVAL));
-    
-    // Response Code: 0x00
-    packet.push_back(0x00);
-    
-    // Data Length: 0x001E (30 bytes, Little Endian, USHORT)
-    packet.push_back(0x1E);
-    packet.push_back(0x00);
-    
-    // Data (30 bytes)
-    // ?????? (1 byte)
-    packet.push_back(request.transactionType);
-    
-    // ????? (10 bytes, ??????? ??? ?? 0 ???)
-    std::string amountStr = std::to_string(request.amount);
-    for (size_t i = 0; i < 10; ++i) {
-        if (i < 10 - amountStr.length()) {
-            packet.push_back('0');
-        } else {
-            packet.push_back(static_cast<uint8_t>(amountStr[i - (10 - amountStr.length())]));
-        }
-    }
-    
-    // ??? (8 bytes, ??????? ??? ?? 0 ???)
-    std::string taxStr = std::to_string(request.tax);
-    for (size_t i = 0; i < 8; ++i) {
-        if (i < 8 - taxStr.length()) {
-            packet.push_back('0');
-        } else {
-            packet.push_back(static_cast<uint8_t>(taxStr[i - (8 - taxStr.length())]));
-        }
-    }
-    
-    // ????(8 bytes, ??????? ??? ?? 0 ???)
-    std::string serviceStr = std::to_string(request.service);
-    for (size_t i = 0; i < 8; ++i) {
-        if (i < 8 - serviceStr.length()) {
-            packet.push_back('0');
-        } else {
-            packet.push_back(static_cast<uint8_t>(serviceStr[i - (8 - serviceStr.length())]));
-        }
-    }
-    
-    // ?????? (2 bytes, ??????? ??? ?? 0 ???)
-    std::string installmentsStr = std::to_string(request.installments);
-    for (size_t i = 0; i < 2; ++i) {
-        if (i < 2 - installmentsStr.length()) {
-            packet.push_back('0');
+
+    // Right-aligned decimal, '0'-padded. The range check exists only for value types whose
+    // largest value has more digits than the field.
+    template <typename F, typename T>
+    bool digits(T value, const char* name) {
+        if constexpr (layout::maxDecimalDigits<T>() > F::width) {
+            if (static_cast<uint64_t>(value) > maxValueForDigits(F::width)) {
+                logging::Logger::getInstance().error(std::string("Request field ") + name + " (" +
+                                                     std::to_string(value) + ") exceeds " +
+                                                     std::to_string(F::width) + " digits");
+                return false;
+            }
         } else {
-            packet.push_back(static_cast<uint8_t>(installmentsStr[i - (2 - installmentsStr.length())]));
+            (void)name;
         }
+        writeDigits(data_ + F::offset, F::width, static_cast<uint64_t>(value));
+        return true;
     }
-    
-    // ??????? (1 byte)
-    packet.push_back(request.signatureRequired);
-    
-    // ETX
-    packet.push_back(ETX);
-    
-    // BCC ?? (STX???ETX???)
-    uint8_t bcc = calculateBCC(packet.data(), packet.size());
-    packet.push_back(bcc);
-    
-    logging::Logger::getInstance().debug("Created payment approval request packet: " + 
-                                        std::to_string(packet.size()) + " bytes");
-    
-    return packet;
-}
 
-std::vector<uint8_t> SmartroProtocol::createTransactionCancelRequest(const std::string& terminalId,
-                                                                     const TransactionCancelRequest& request) {
-    // Calculate data length: 57 bytes (base) + 2 bytes (additional info length) + N bytes (additional info)
-    size_t additionalInfoLength = request.additionalInfo.length();
-    size_t dataLength = 57;
-    if (additionalInfoLength > 0) {
-        dataLength += 2 + additionalInfoLength;
+    // Left-aligned, truncated or padded to the field
+    template <typename F>
+    void text(const std::string& value, uint8_t pad) {
+        writeText(data_ + F::offset, F::width, value.data(), value.size(), pad);
     }
-    
-    std::vector<uint8_t> packet;
-    packet.reserve(HEADER_SIZE + dataLength + TAIL_SIZE);
-    
-    // STX
-    packet.push_back(STX);
-    
-    // Terminal ID (16 bytes)
-    auto formattedTerminalId = formatTerminalId(terminalId);
-    packet.insert(packet.end(), formattedTerminalId.begin(), formattedTerminalId.end());
-    
-    // DateTime (14 bytes)
-    std::string dateTime = getCurrentDateTime();
-    for (size_t i = 0; i < 14; ++i) {
-        if (i < dateTime.length()) {
-            packet.push_back(static_cast<uint8_t>(dateTime[i]));
-        } else {
-            packet.push_back(0x00);
+
+    // Variable tail of the data section (offset..dataLength)
+    void bytes(size_t offset, const char* value, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            put(data_ + offset + i, static_cast<uint8_t>(value[i]));
         }
     }
-    
-    // Job Code: 'C'
-    packet.push_back(static_cast<uint8_t>(JOB_CODE_TRANSACTION_CANCEL));
-    
-    // Response Code: 0x00
-    packet.push_back(0x00);
-    
-    // Data Length (Little Endian, USHORT)
-    packet.push_back(static_cast<uint8_t>(dataLength & 0xFF));
-    packet.push_back(static_cast<uint8_t>((dataLength >> 8) & 0xFF));
-    
-    // Data
-    // ?????? (1 byte)
-    packet.push_back(static_cast<uint8_t>(request.cancelType));
-    
-    // ?????? (1 byte)
-    packet.push_back(request.transactionType);
-    
-    // ???? (10 bytes, ?? ?? ?? 0 ??)
-    std::string amountStr = std::to_string(request.amount);
-    for (size_t i = 0; i < 10; ++i) {
-        if (i < 10 - amountStr.length()) {
-            packet.push_back('0');
-        } else {
-            packet.push_back(static_cast<uint8_t>(amountStr[i - (10 - amountStr.length())]));
-        }
+
+    void finish() {
+        put(data_ + dataLength_, ETX);
+        data_[dataLength_ + 1] = bcc_;
     }
-    
-    // ?? (8 bytes, ?? ?? ?? 0 ??)
-    std::string taxStr = std::to_string(request.tax);
-    for (size_t i = 0; i < 8; ++i) {
-        if (i < 8 - taxStr.length()) {
-            packet.push_back('0');
-        } else {
-            packet.push_back(static_cast<uint8_t>(taxStr[i - (8 - taxStr.length())]));
-        }
+
+private:
+    uint8_t* packet_;
+    uint8_t* data_;
+    size_t dataLength_;
+    uint8_t bcc_ = 0;
+
+    void put(uint8_t* at, uint8_t value) {
+        *at = value;
+        bcc_ ^= value;
     }
-    
-    // ??? (8 bytes, ?? ?? ?? 0 ??)
-    std::string serviceStr = std::to_string(request.service);
-    for (size_t i = 0; i < 8; ++i) {
-        if (i < 8 - serviceStr.length()) {
-            packet.push_back('0');
-        } else {
-            packet.push_back(static_cast<uint8_t>(serviceStr[i - (8 - serviceStr.length())]));
+
+    void writeDigits(uint8_t* at, size_t width, uint64_t value) {
+        for (size_t i = width; i-- > 0;) {
+            put(at + i, static_cast<uint8_t>('0' + value % 10));
+            value /= 10;
         }
     }
-    
-    // ???? (2 bytes, ?? ?? ?? 0 ??)
-    std::string installmentsStr = std::to_string(request.installments);
-    for (size_t i = 0; i < 2; ++i) {
-        if (i < 2 - installmentsStr.length()) {
-            packet.push_back('0');
-        } else {
-            packet.push_back(static_cast<uint8_t>(installmentsStr[i - (2 - installmentsStr.length())]));
+
+    void writeText(uint8_t* at, size_t width, const char* value, size_t length, uint8_t pad) {
+        for (size_t i = 0; i < width; ++i) {
+            put(at + i, i < length ? static_cast<uint8_t>(value[i]) : pad);
         }
     }
-    
-    // ???? (12 bytes, ?? ?? ?? ?? ??)
-    std::string approvalNumber = request.approvalNumber;
-    approvalNumber.resize(12, ' ');
-    for (size_t i = 0; i < 12; ++i) {
-        packet.push_back(static_cast<uint8_t>(approvalNumber[i]));
+
+    // YYYYMMDDhhmmss (local time)
+    void writeDateTime(uint8_t* at) {
+        std::time_t now = std::time(nullptr);
+        std::tm tm_buf;
+#ifdef _WIN32
+        localtime_s(&tm_buf, &now);
+#else
+        localtime_r(&now, &tm_buf);
+#endif
+        writeDigits(at, 4, static_cast<uint64_t>(tm_buf.tm_year + 1900));
+        writeDigits(at + 4, 2, static_cast<uint64_t>(tm_buf.tm_mon + 1));
+        writeDigits(at + 6, 2, static_cast<uint64_t>(tm_buf.tm_mday));
+        writeDigits(at + 8, 2, static_cast<uint64_t>(tm_buf.tm_hour));
+        writeDigits(at + 10, 2, static_cast<uint64_t>(tm_buf.tm_min));
+        writeDigits(at + 12, 2, static_cast<uint64_t>(tm_buf.tm_sec));
+    }
+};
+static_assert(layout::Header::DateTime::width == 14, "writeDateTime fills YYYYMMDDhhmmss");
+
+} // namespace
+
+void SmartroProtocol::createDeviceCheckRequest(const std::string& terminalId, RequestPacket& packet) {
+    PacketWriter(packet, terminalId, JOB_CODE_DEVICE_CHECK, 0).finish();
+}
+
+void SmartroProtocol::createPaymentWaitRequest(const std::string& terminalId, RequestPacket& packet) {
+    PacketWriter(packet, terminalId, JOB_CODE_PAYMENT_WAIT, 0).finish();
+}
+
+void SmartroProtocol::createCardUidReadRequest(const std::string& terminalId, RequestPacket& packet) {
+    PacketWriter(packet, terminalId, JOB_CODE_CARD_UID_READ, 0).finish();
+}
+
+void SmartroProtocol::createResetRequest(const std::string& terminalId, RequestPacket& packet) {
+    PacketWriter(packet, terminalId, JOB_CODE_RESET, 0).finish();
+}
+
+bool SmartroProtocol::createPaymentApprovalRequest(const std::string& terminalId,
+                                                   const PaymentApprovalRequest& request,
+                                                   RequestPacket& packet) {
+    using L = layout::PaymentApproval;
+    PacketWriter writer(packet, terminalId, JOB_CODE_PAYMENT_APPROVAL, L::SIZE);
+    writer.byte<L::TransactionType>(request.transactionType);
+    bool fits = writer.digits<L::Amount>(request.amount, "amount") &&
+                writer.digits<L::Tax>(request.tax, "tax") &&
+                writer.digits<L::Service>(request.service, "service") &&
+                writer.digits<L::Installments>(request.installments, "installments");
+    if (!fits) {
+        return false;
     }
-    
-    // ????? (8 bytes, YYYYMMDD)
-    std::string originalDate = request.originalDate;
-    originalDate.resize(8, '0');
-    for (size_t i = 0; i < 8; ++i) {
-        packet.push_back(static_cast<uint8_t>(originalDate[i]));
+    writer.byte<L::SignatureRequired>(request.signatureRequired);
+    writer.finish();
+    return true;
+}
+
+bool SmartroProtocol::createTransactionCancelRequest(const std::string& terminalId,
+                                                     const TransactionCancelRequest& request,
+                                                     RequestPacket& packet) {
+    using L = layout::TransactionCancel;
+    // 부가정보는 있을 때만 길이(2) + 내용이 붙음
+    size_t additionalInfoLength = request.additionalInfo.length();
+    if (additionalInfoLength > L::MAX_ADDITIONAL_INFO) {
+        logging::Logger::getInstance().error("Request field additional info (" + std::to_string(additionalInfoLength) +
+                                             " bytes) exceeds " + std::to_string(L::MAX_ADDITIONAL_INFO) + " bytes");
+        return false;
     }
-    
-    // ????? (6 bytes, hhmmss)
-    std::string originalTime = request.originalTime;
-    originalTime.resize(6, '0');
-    for (size_t i = 0; i < 6; ++i) {
-        packet.push_back(static_cast<uint8_t>(originalTime[i]));
+    size_t dataLength = L::SIZE;
+    if (additionalInfoLength > 0) {
+        dataLength += L::AdditionalInfoLength::width + additionalInfoLength;
+    }
+    
+    PacketWriter writer(packet, terminalId, JOB_CODE_TRANSACTION_CANCEL, static_cast<uint16_t>(dataLength),
+                        static_cast<uint16_t>(dataLength + L::DECLARED_EXTRA));
+    writer.byte<L::CancelType>(static_cast<uint8_t>(request.cancelType));
+    writer.byte<L::TransactionType>(request.transactionType);
+    bool fits = writer.digits<L::Amount>(request.amount, "amount") &&
+                writer.digits<L::Tax>(request.tax, "tax") &&
+                writer.digits<L::Service>(request.service, "service") &&
+                writer.digits<L::Installments>(request.installments, "installments");
+    if (!fits) {
+        return false;
     }
-    
-    // ???? ?? ? ???? (????? ?? ??)
+    writer.text<L::ApprovalNumber>(request.approvalNumber, ' ');
+    writer.text<L::OriginalDate>(request.originalDate, '0');
+    writer.text<L::OriginalTime>(request.originalTime, '0');
     if (additionalInfoLength > 0) {
-        // ???? ?? (2 bytes, ?? ?? ?? 0 ??)
-        std::string infoLengthStr = std::to_string(additionalInfoLength);
-        for (size_t i = 0; i < 2; ++i) {
-            if (i < 2 - infoLengthStr.length()) {
-                packet.push_back('0');
-            } else {
-                packet.push_back(static_cast<uint8_t>(infoLengthStr[i - (2 - infoLengthStr.length())]));
-            }
-        }
-        
-        // ???? (N bytes)
-        for (size_t i = 0; i < additionalInfoLength; ++i) {
-            packet.push_back(static_cast<uint8_t>(request.additionalInfo[i]));
-        }
+        writer.digits<L::AdditionalInfoLength>(additionalInfoLength, "additional info length");
+        writer.bytes(L::AdditionalInfoLength::end, request.additionalInfo.data(), additionalInfoLength);
     }
-    
-    // ETX
-    packet.push_back(ETX);
-    
-    // BCC ?? (STX??ETX??)
-    uint8_t bcc = calculateBCC(packet.data(), packet.size());
-    packet.push_back(bcc);
-    
-    logging::Logger::getInstance().debug("Created transaction cancel request packet: " + 
-                                        std::to_string(packet.size()) + " bytes, data length: " + 
-                                        std::to_string(dataLength));
-    
-    return packet;
+    writer.finish();
+    return true;
 }
 
-std::vector<uint8_t> SmartroProtocol::createLastApprovalResponseRequest(const std::string& terminalId) {
-    std::vector<uint8_t> packet;
-    packet.reserve(MIN_PACKET_SIZE);
-    
-    // STX
-    packet.push_back(STX);
-    
-    // Terminal ID (16 bytes)
-    auto formattedTerminalId = formatTerminalId(terminalId);
-    packet.insert(packet.end(), formattedTerminalId.begin(), formattedTerminalId.end());
-    
-    // DateTime (14 bytes)
-    std::string dateTime = getCurrentDateTime();
-    for (size_t i = 0; i < 14; ++i) {
-        if (i < dateTime.length()) {
-            packet.push_back(static_cast<uint8_t>(dateTime[i]));
-        } else {
-            packet.push_back(0x00);
-        }
-    }
-    
-    // Job Code: 'L'
-    packet.push_back(static_cast<uint8_t>(JOB_CODE_LAST_APPROVAL_RESPONSE));
-    
-    // Response Code: 0x00
-    packet.push_back(0x00);
-    
-    // Data Length: 0x0000 (Little Endian, USHORT)
-    packet.push_back(0x00);
-    packet.push_back(0x00);
-    
-    // ETX
-    packet.push_back(ETX);
-    
-    // BCC ?? (STX???ETX???)
-    uint8_t bcc = calculateBCC(packet.data(), packet.size());
-    packet.push_back(bcc);
-    
-    logging::Logger::getInstance().debug("Created last approval response request packet: " + 
-                                        std::to_string(packet.size()) + " bytes");
-    
-    return packet;
+void SmartroProtocol::createLastApprovalResponseRequest(const std::string& terminalId, RequestPacket& packet) {
+    PacketWriter(packet, terminalId, JOB_CODE_LAST_APPROVAL_RESPONSE, 0).finish();
 }
 
-std::vector<uint8_t> SmartroProtocol::createScreenSoundSettingRequest(const std::string& terminalId,
-                                                                      const ScreenSoundSettingRequest& request) {
-    std::vector<uint8_t> packet;
-    packet.reserve(HEADER_SIZE + 3 + TAIL_SIZE);  // Data Length = 3
-    
-    // STX
-    packet.push_back(STX);
-    
-    // Terminal ID (16 bytes)
-    auto formattedTerminalId = formatTerminalId(terminalId);
-    packet.insert(packet.end(), formattedTerminalId.begin(), formattedTerminalId.end());
-    
-    // DateTime (14 bytes)
-    std::string dateTime = getCurrentDateTime();
-    for (size_t i = 0; i < 14; ++i) {
-        if (i < dateTime.length()) {
-            packet.push_back(static_cast<uint8_t>(dateTime[i]));
-        } else {
-            packet.push_back(0x00);
-        }
-    }
-    
-    // Job Code: 'S'
-    packet.push_back(static_cast<uint8_t>(JOB_CODE_SCREEN_SOUND_SETTING));
-    
-    // Response Code: 0x00
-    packet.push_back(0x00);
-    
-    // Data Length: 0x0003 (3 bytes, Little Endian, USHORT)
-    packet.push_back(0x03);
-    packet.push_back(0x00);
-    
-    // Data (3 bytes)
-    // ????? (0-9, CHAR)
-    uint8_t brightness = (request.screenBrightness > 9) ? '9' : ('0' + request.screenBrightness);
-    packet.push_back(brightness);
-    
-    // ????? (0-9, CHAR)
-    uint8_t volume = (request.soundVolume > 9) ? '9' : ('0' + request.soundVolume);
-    packet.push_back(volume);
-    
-    // ????????(0-9, CHAR)
-    uint8_t touchVolume = (request.touchSoundVolume > 9) ? '9' : ('0' + request.touchSoundVolume);
-    packet.push_back(touchVolume);
-    
-    // ETX
-    packet.push_back(ETX);
-    
-    // BCC ?? (STX???ETX???)
-    uint8_t bcc = calculateBCC(packet.data(), packet.size());
-    packet.push_back(bcc);
-    
-    logging::Logger::getInstance().debug("Created screen/sound setting request packet: " + 
-                                        std::to_string(packet.size()) + " bytes");
-    
-    return packet;
+void SmartroProtocol::createScreenSoundSettingRequest(const std::string& terminalId,
+                                                      const ScreenSoundSettingRequest& request,
+                                                      RequestPacket& packet) {
+    using L = layout::ScreenSoundSetting;
+    // 각 항목 0-9 (CHAR), 범위를 넘으면 '9'
+    auto level = [](uint8_t value) { return static_cast<uint8_t>(value > 9 ? '9' : '0' + value); };
+    PacketWriter writer(packet, terminalId, JOB_CODE_SCREEN_SOUND_SETTING, L::SIZE);
+    writer.byte<L::ScreenBrightness>(level(request.screenBrightness));
+    writer.byte<L::SoundVolume>(level(request.soundVolume));
+    writer.byte<L::TouchSoundVolume>(level(request.touchSoundVolume));
+    writer.finish();
 }
 
-std::vector<uint8_t> SmartroProtocol::createIcCardCheckRequest(const std::string& terminalId) {
-    std::vector<uint8_t> packet;
-    packet.reserve(MIN_PACKET_SIZE);
-    
-    // STX
-    packet.push_back(STX);
-    
-    // Terminal ID (16 bytes)
-    auto formattedTerminalId = formatTerminalId(terminalId);
-    packet.insert(packet.end(), formattedTerminalId.begin(), formattedTerminalId.end());
-    
-    // DateTime (14 bytes)
-    std::string dateTime = getCurrentDateTime();
-    for (size_t i = 0; i < 14; ++i) {
-        if (i < dateTime.length()) {
-            packet.push_back(static_cast<uint8_t>(dateTime[i]));
-        } else {
-            packet.push_back(0x00);
-        }
-    }
-    
-    // Job Code: 'M'
-    packet.push_back(static_cast<uint8_t>(JOB_CODE_IC_CARD_CHECK));
-    
-    // Response Code: 0x00
-    packet.push_back(0x00);
-    
-    // Data Length: 0x0000 (Little Endian, USHORT)
-    packet.push_back(0x00);
-    packet.push_back(0x00);
-    
-    // ETX
-    packet.push_back(ETX);
-    
-    // BCC ?? (STX???ETX???)
-    uint8_t bcc = calculateBCC(packet.data(), packet.size());
-    packet.push_back(bcc);
-    
-    logging::Logger::getInstance().debug("Created IC card check request packet: " + 
-                                        std::to_string(packet.size()) + " bytes");
-    
-    return packet;
+void SmartroProtocol::createIcCardCheckRequest(const std::string& terminalId, RequestPacket& packet) {
+    PacketWriter(packet, terminalId, JOB_CODE_IC_CARD_CHECK, 0).finish();
 }
 
 bool SmartroProtocol::parsePacket(const uint8_t* data, size_t length, 
@@ -660,16 +322,17 @@ bool SmartroProtocol::verifyBCC(const uint8_t* packet, size_t packetLength) {
 
 bool SmartroProtocol::parseDeviceCheckResponse(const uint8_t* data, size_t length, 
                                                DeviceCheckResponse& response) {
-    if (!data || length < 4) {
+    using L = layout::DeviceCheckResult;
+    if (!data || length < L::SIZE) {
         logging::Logger::getInstance().error("Device check response too short: " + 
                                             std::to_string(length) + " bytes");
         return false;
     }
     
-    response.cardModuleStatus = static_cast<char>(data[0]);
-    response.rfModuleStatus = static_cast<char>(data[1]);
-    response.vanServerStatus = static_cast<char>(data[2]);
-    response.integrationServerStatus = static_cast<char>(data[3]);
+    response.cardModuleStatus = static_cast<char>(data[L::CardModule::offset]);
+    response.rfModuleStatus = static_cast<char>(data[L::RfModule::offset]);
+    response.vanServerStatus = static_cast<char>(data[L::VanServer::offset]);
+    response.integrationServerStatus = static_cast<char>(data[L::IntegrationServer::offset]);
     
     // ??? ????INFO????
     std::string statusStr = std::string(1, response.cardModuleStatus) + "/" +
@@ -698,7 +361,10 @@ bool SmartroProtocol::parsePaymentWaitResponse(const uint8_t* data, size_t lengt
     }
     
     // ??? ?????????(??????????????? ???)
-    response.data.assign(data, data + length);
+    if (!response.data.assign(data, length)) {
+        logging::Logger::getInstance().warn("Payment wait response data cut to " +
+                                           std::to_string(response.data.size()) + " bytes");
+    }
     
     logging::Logger::getInstance().info("Payment wait response received: " + 
                                        std::to_string(length) + " bytes");
@@ -737,7 +403,11 @@ bool SmartroProtocol::parseCardUidReadResponse(const uint8_t* data, size_t lengt
     }
     
     // UID ????
-    response.uid.assign(data, data + length);
+    if (!response.uid.assign(data, length)) {
+        logging::Logger::getInstance().error("Card UID read response too long: " + std::to_string(length) +
+                                            " bytes, max " + std::to_string(response.uid.capacity()));
+        return false;
+    }
     
     // UID??16?? ????? ???????? ??
     std::string uidHex;
@@ -759,14 +429,15 @@ bool SmartroProtocol::parseCardUidReadResponse(const uint8_t* data, size_t lengt
 bool SmartroProtocol::parseEventResponse(const uint8_t* data, size_t length, 
                                         EventResponse& response) {
     // ?????? ?? 1????(????????? ??????????
-    if (!data || length < 1) {
+    using L = layout::EventResult;
+    if (!data || length < L::MIN_SIZE) {
         logging::Logger::getInstance().error("Event response too short: " + 
                                             std::to_string(length) + " bytes");
         return false;
     }
     
     // ???? ?????? ?????????
-    char eventType = static_cast<char>(data[0]);
+    char eventType = static_cast<char>(data[L::EventCode::offset]);
     
     switch (eventType) {
         case 'M':
@@ -797,8 +468,10 @@ bool SmartroProtocol::parseEventResponse(const uint8_t* data, size_t length,
     }
     
     // ???? ?????????
-    if (length > 1) {
-        response.data.assign(data + 1, data + length);
+    if (length > L::MIN_SIZE) {
+        if (!response.data.assign(data + L::MIN_SIZE, length - L::MIN_SIZE)) {
+            logging::Logger::getInstance().warn("Event data cut to " + std::to_string(response.data.size()) + " bytes");
+        }
         
         std::string hexDump;
         for (size_t i = 1; i < length && i < 33; ++i) {  // ??? 32????? ???
@@ -819,90 +492,28 @@ bool SmartroProtocol::parseEventResponse(const uint8_t* data, size_t length,
 
 bool SmartroProtocol::parsePaymentApprovalResponse(const uint8_t* data, size_t length, 
                                                   PaymentApprovalResponse& response) {
-    // ????? ????? 157 bytes (?? ??)
+    using L = layout::ApprovalResult;
     if (!data) {
         logging::Logger::getInstance().error("Payment approval response data is null");
         return false;
     }
     
-    if (length < 157) {
+    if (length < L::SIZE) {
         logging::Logger::getInstance().error("Payment approval response too short: " + 
-                                            std::to_string(length) + " bytes, expected 157");
+                                            std::to_string(length) + " bytes, expected " +
+                                            std::to_string(L::SIZE));
         return false;
     }
     
-    // ??? ?????????
-    response.data.assign(data, data + length);
-    
-    size_t offset = 0;
-    
-    // ?????? (1 byte)
-    response.transactionType = static_cast<char>(data[offset++]);
-    
-    // ???? (1 byte)
-    response.transactionMedium = static_cast<char>(data[offset++]);
-    
-    // ???? (20 bytes)
-    response.cardNumber.assign(reinterpret_cast<const char*>(data + offset), 20);
-    offset += 20;
-    
-    // ?????/???? (10 bytes)
-    response.approvalAmount.assign(reinterpret_cast<const char*>(data + offset), 10);
-    offset += 10;
-    
-    // ??? (8 bytes)
-    response.tax.assign(reinterpret_cast<const char*>(data + offset), 8);
-    offset += 8;
-    
-    // ????(8 bytes)
-    response.serviceCharge.assign(reinterpret_cast<const char*>(data + offset), 8);
-    offset += 8;
+    // 필드는 접근할 때 layout::ApprovalResult로 해석 — 여기서는 페이로드만 고정 버퍼로 복사 (힙 할당 없음).
+    // 매입사는 157 byte 뒤에 있을 때만 (기존 파서는 157 byte 응답에서 데이터 밖을 읽었음)
+    response.size = (std::min)(length, L::MAX_SIZE);
+    std::copy(data, data + response.size, response.data.begin());
     
-    // ?????? (2 bytes)
-    response.installments.assign(reinterpret_cast<const char*>(data + offset), 2);
-    offset += 2;
-    
-    // ?????/????? ??? (12 bytes)
-    response.approvalNumber.assign(reinterpret_cast<const char*>(data + offset), 12);
-    offset += 12;
-    
-    // ????? (8 bytes, YYYYMMDD)
-    response.salesDate.assign(reinterpret_cast<const char*>(data + offset), 8);
-    offset += 8;
-    
-    // ????? (6 bytes, hhmmss)
-    response.salesTime.assign(reinterpret_cast<const char*>(data + offset), 6);
-    offset += 6;
-    
-    // ?????? (12 bytes)
-    response.transactionId.assign(reinterpret_cast<const char*>(data + offset), 12);
-    offset += 12;
-    
-    // ????? (15 bytes)
-    response.merchantNumber.assign(reinterpret_cast<const char*>(data + offset), 15);
-    offset += 15;
-    
-    // ???????(14 bytes)
-    response.terminalNumber.assign(reinterpret_cast<const char*>(data + offset), 14);
-    offset += 14;
-    
-    // ????(20 bytes)
-    response.issuer.assign(reinterpret_cast<const char*>(data + offset), 20);
-    offset += 20;
-    
-    // ???? ??? (20 bytes, ????????)
-    response.rejectionInfo.assign(reinterpret_cast<const char*>(data + offset), 20);
-    offset += 20;
-    
-    // ????(20 bytes)
-    response.acquirer.assign(reinterpret_cast<const char*>(data + offset), 20);
-    offset += 20;
-    
-    // ??? ?? ?? ??
     std::string statusStr = response.isRejected() ? "FAILED (Transaction Rejected)" : "SUCCESS";
     
     std::string transactionTypeStr;
-    switch (response.transactionType) {
+    switch (response.transactionType()) {
         case '1': transactionTypeStr = "Credit Approval"; break;
         case '2': transactionTypeStr = "Cash Receipt"; break;
         case '3': transactionTypeStr = "Prepaid Card"; break;
@@ -914,75 +525,43 @@ bool SmartroProtocol::parsePaymentApprovalResponse(const uint8_t* data, size_t l
             transactionTypeStr = "Transaction Rejected"; 
             break;
         default: 
-            transactionTypeStr = "Unknown(" + std::string(1, response.transactionType) + ")"; 
+            transactionTypeStr = "Unknown(" + std::string(1, response.transactionType()) + ")"; 
             break;
     }
     
     std::string mediumStr;
-    switch (response.transactionMedium) {
+    switch (response.transactionMedium()) {
         case '1': mediumStr = "IC"; break;
         case '2': mediumStr = "MS"; break;
         case '3': mediumStr = "RF"; break;
         case '4': mediumStr = "QR"; break;
         case '5': mediumStr = "KEYIN"; break;
         default: 
-            mediumStr = "Unknown(" + std::string(1, response.transactionMedium) + ")"; 
+            mediumStr = "Unknown(" + std::string(1, response.transactionMedium()) + ")"; 
             break;
     }
     
-    logging::Logger::getInstance().info("Payment approval response parsed:");
-    logging::Logger::getInstance().info("  Status: " + statusStr);
-    logging::Logger::getInstance().info("  Transaction Type: " + transactionTypeStr);
-    logging::Logger::getInstance().info("  Transaction Medium: " + mediumStr);
-    logging::Logger::getInstance().info("  Card Number: " + response.cardNumber);
-    logging::Logger::getInstance().info("  Approval Amount: " + response.approvalAmount);
-    logging::Logger::getInstance().info("  Tax: " + response.tax);
-    logging::Logger::getInstance().info("  Service Charge: " + response.serviceCharge);
-    logging::Logger::getInstance().info("  Installments: " + response.installments);
-    logging::Logger::getInstance().info("  Approval Number: " + response.approvalNumber);
-    logging::Logger::getInstance().info("  Sales Date/Time: " + response.salesDate + " " + response.salesTime);
-    logging::Logger::getInstance().info("  Transaction ID: " + response.transactionId);
-    logging::Logger::getInstance().info("  Merchant Number: " + response.merchantNumber);
-    logging::Logger::getInstance().info("  Terminal Number: " + response.terminalNumber);
-    
-    if (response.isRejected()) {
-        logging::Logger::getInstance().info("  Rejection Info: " + response.rejectionInfo);
+    auto& logger = logging::Logger::getInstance();
+    logger.info("Payment approval response parsed:");
+    logger.info("  Status: " + statusStr);
+    logger.info("  Transaction Type: " + transactionTypeStr);
+    logger.info("  Transaction Medium: " + mediumStr);
+    for (const auto& field : layout::APPROVAL_RESULT_FIELDS) {
+        if (field.kind == layout::FieldKind::Code) {
+            continue;  // 위에서 이름으로 출력
+        }
+        logger.info(std::string("  ") + field.name + ": " +
+                    std::string(layout::trimField(response.field(field.offset, field.width))));
     }
-    
-    logging::Logger::getInstance().info("  Issuer: " + response.issuer);
-    logging::Logger::getInstance().info("  Acquirer: " + response.acquirer);
+    logger.info("  Acquirer: " + std::string(response.acquirer()));
     
     return true;
 }
 
 bool SmartroProtocol::parseTransactionCancelResponse(const uint8_t* data, size_t length,
                                                       TransactionCancelResponse& response) {
-    // Transaction cancel response is same structure as payment approval response
-    PaymentApprovalResponse tempResponse;
-    if (!parsePaymentApprovalResponse(data, length, tempResponse)) {
-        return false;
-    }
-    
-    // Copy to TransactionCancelResponse
-    response.transactionType = tempResponse.transactionType;
-    response.transactionMedium = tempResponse.transactionMedium;
-    response.cardNumber = tempResponse.cardNumber;
-    response.approvalAmount = tempResponse.approvalAmount;
-    response.tax = tempResponse.tax;
-    response.serviceCharge = tempResponse.serviceCharge;
-    response.installments = tempResponse.installments;
-    response.approvalNumber = tempResponse.approvalNumber;
-    response.salesDate = tempResponse.salesDate;
-    response.salesTime = tempResponse.salesTime;
-    response.transactionId = tempResponse.transactionId;
-    response.merchantNumber = tempResponse.merchantNumber;
-    response.terminalNumber = tempResponse.terminalNumber;
-    response.issuer = tempResponse.issuer;
-    response.rejectionInfo = tempResponse.rejectionInfo;
-    response.acquirer = tempResponse.acquirer;
-    response.data = tempResponse.data;
-    
-    return true;
+    // 취소 응답은 승인 응답과 같은 레이아웃
+    return parsePaymentApprovalResponse(data, length, response);
 }
 
 bool SmartroProtocol::parseLastApprovalResponse(const uint8_t* data, size_t length, 
@@ -994,7 +573,11 @@ bool SmartroProtocol::parseLastApprovalResponse(const uint8_t* data, size_t leng
     }
     
     // ??? ?????????
-    response.data.assign(data, data + length);
+    if (!response.data.assign(data, length)) {
+        logging::Logger::getInstance().warn("Last approval response longer than " +
+                                           std::to_string(response.data.capacity()) + " bytes: " +
+                                           std::to_string(length) + ", extra bytes dropped");
+    }
     
     logging::Logger::getInstance().info("Last approval response parsed successfully: " + 
                                        std::to_string(response.data.size()) + " bytes");
@@ -1017,27 +600,27 @@ bool SmartroProtocol::parseLastApprovalResponse(const uint8_t* data, size_t leng
 
 bool SmartroProtocol::parseScreenSoundSettingResponse(const uint8_t* data, size_t length, 
                                                       ScreenSoundSettingResponse& response) {
-    // ???/??? ??? ????? 3 bytes
-    if (!data || length < 3) {
+    using L = layout::ScreenSoundSettingResult;
+    if (!data || length < L::SIZE) {
         logging::Logger::getInstance().error("Screen/sound setting response too short: " + 
                                             std::to_string(length) + " bytes");
         return false;
     }
     
     // ????? (CHAR, 0-9)
-    response.screenBrightness = static_cast<uint8_t>(data[0] - '0');
+    response.screenBrightness = static_cast<uint8_t>(data[L::ScreenBrightness::offset] - '0');
     if (response.screenBrightness > 9) {
         response.screenBrightness = 0;
     }
     
     // ????? (CHAR, 0-9)
-    response.soundVolume = static_cast<uint8_t>(data[1] - '0');
+    response.soundVolume = static_cast<uint8_t>(data[L::SoundVolume::offset] - '0');
     if (response.soundVolume > 9) {
         response.soundVolume = 0;
     }
     
     // ????????(CHAR, 0-9)
-    response.touchSoundVolume = static_cast<uint8_t>(data[2] - '0');
+    response.touchSoundVolume = static_cast<uint8_t>(data[L::TouchSoundVolume::offset] - '0');
     if (response.touchSoundVolume > 9) {
         response.touchSoundVolume = 0;
     }
@@ -1052,14 +635,14 @@ bool SmartroProtocol::parseScreenSoundSettingResponse(const uint8_t* data, size_
 
 bool SmartroProtocol::parseIcCardCheckResponse(const uint8_t* data, size_t length, 
                                                IcCardCheckResponse& response) {
-    // IC ?? ?? ????? 1 byte
-    if (!data || length < 1) {
+    using L = layout::IcCardCheckResult;
+    if (!data || length < L::SIZE) {
         logging::Logger::getInstance().error("IC card check response too short: " + 
                                             std::to_string(length) + " bytes");
         return false;
     }
     
-    response.cardStatus = static_cast<char>(data[0]);
+    response.cardStatus = static_cast<char>(data[L::CardStatus::offset]);
     
     const char* statusStr = "Unknown";
     if (response.cardStatus == 'O') {
@@ -1075,34 +658,6 @@ bool SmartroProtocol::parseIcCardCheckResponse(const uint8_t* data, size_t lengt
     return true;
 }
 
-std::string SmartroProtocol::getCurrentDateTime() {
-    std::time_t now = std::time(nullptr);
-    std::tm tm_buf;
-    localtime_s(&tm_buf, &now);
-    
-    char buffer[15];
-    std::snprintf(buffer, sizeof(buffer), "%04d%02d%02d%02d%02d%02d",
-                 tm_buf.tm_year + 1900,
-                 tm_buf.tm_mon + 1,
-                 tm_buf.tm_mday,
-                 tm_buf.tm_hour,
-                 tm_buf.tm_min,
-                 tm_buf.tm_sec);
-    
-    return std::string(buffer, 14);
-}
-
-std::vector<uint8_t> SmartroProtocol::formatTerminalId(const std::string& terminalId) {
-    std::vector<uint8_t> result(16, 0x00);
-    
-    size_t copyLength = std::min(terminalId.length(), size_t(16));
-    for (size_t i = 0; i < copyLength; ++i) {
-        result[i] = static_cast<uint8_t>(terminalId[i]);
-    }
-    
-    return result;
-}
-
 void SmartroProtocol::writeUshortLE(uint16_t value, uint8_t* buffer) {
     buffer[0] = static_cast<uint8_t>(value & 0xFF);
     buffer[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
@@ -1120,7 +675,7 @@ uint16_t SmartroProtocol::extractDataLength(const uint8_t* header) {
         return 0;
     }
     // HEADER_SIZE??35???????????33, 34???????
-    return readUshortLE(header + 33);
+    return readUshortLE(header + layout::Header::DataLength::offset);
 }
 
 char SmartroProtocol::extractJobCode(const uint8_t* header) {
@@ -1129,7 +684,7 @@ char SmartroProtocol::extractJobCode(const uint8_t* header) {
         logging::Logger::getInstance().error("extractJobCode: header is null");
         return 0;
     }
-    return static_cast<char>(header[31]);
+    return static_cast<char>(header[layout::Header::JobCode::offset]);
 }
 
 } // namespace smartro
@@ -149,12 +149,21 @@ devices::DeviceInfo WindowsGdiPrinterAdapter::getDeviceInfo() const {
     info.deviceType = devices::DeviceType::PRINTER;
     info.deviceName =  printerName_;
     info.state = getState();
-    info.lastError = "";
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        info.lastError = lastError_;
+    }
     info.lastUpdateTime = std::chrono::system_clock::now();
     return info;
 }
 
 devices::DeviceState WindowsGdiPrinterAdapter::getState() const {
+    // 마지막 인쇄 실패 상태는 인쇄가 성공할 때까지 유지 — DC 생성 확인은 상태를 낮출 뿐 READY로 되돌리지 않음
+    // (되돌리면 방금 작업을 옮겨 큐가 빈 프린터가 다시 최소 큐로 뽑힘)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        if (reportedState_ != devices::DeviceState::STATE_READY) return reportedState_;
+    }
 #ifdef _WIN32
     if (printerName_.empty()) return devices::DeviceState::DISCONNECTED;
     std::wstring wname = resolvePrinterNameW(printerName_);
@@ -194,11 +203,13 @@ bool WindowsGdiPrinterAdapter::doPrint(const std::string& jobId,
     std::wstring wname = resolvePrinterNameW(printerName_);
     if (wname.empty()) {
         outEvent.errorMessage = "Printer not found: \"" + printerName_ + "\" (check name or add network printer in Windows)";
+        outEvent.state = devices::DeviceState::DISCONNECTED;
         return false;
     }
     auto [hdc, devModeBuf] = createPrinterDC(wname);
     if (!hdc) {
         outEvent.errorMessage = "CreateDC failed (printer not found or A4/4x6 not supported?)";
+        outEvent.state = devices::DeviceState::DISCONNECTED;
         return false;
     }
 
@@ -257,6 +268,7 @@ bool WindowsGdiPrinterAdapter::doPrint(const std::string& jobId,
         delete pBitmap;
         DeleteDC(hdc);
         outEvent.errorMessage = "StartDoc failed";
+        outEvent.state = devices::DeviceState::STATE_ERROR;
         return false;
     }
     if (StartPage(hdc) <= 0) {
@@ -264,6 +276,7 @@ bool WindowsGdiPrinterAdapter::doPrint(const std::string& jobId,
         delete pBitmap;
         DeleteDC(hdc);
         outEvent.errorMessage = "StartPage failed";
+        outEvent.state = devices::DeviceState::STATE_ERROR;
         return false;
     }
 
@@ -328,6 +341,7 @@ bool WindowsGdiPrinterAdapter::doPrintFromFile(const std::string& jobId,
     std::wstring wname = resolvePrinterNameW(printerName_);
     if (wname.empty()) {
         outEvent.errorMessage = "Printer not found: \"" + printerName_ + "\"";
+        outEvent.state = devices::DeviceState::DISCONNECTED;
         return false;
     }
     // UTF-8 path -> wstring for GDI+
@@ -367,6 +381,7 @@ bool WindowsGdiPrinterAdapter::doPrintFromFile(const std::string& jobId,
     if (!hdc) {
         delete pBitmap;
         outEvent.errorMessage = "CreateDC failed (printer not found or paper size not supported?)";
+        outEvent.state = devices::DeviceState::DISCONNECTED;
         return false;
     }
 
@@ -377,6 +392,7 @@ bool WindowsGdiPrinterAdapter::doPrintFromFile(const std::string& jobId,
         delete pBitmap;
         DeleteDC(hdc);
         outEvent.errorMessage = "StartDoc failed";
+        outEvent.state = devices::DeviceState::STATE_ERROR;
         return false;
     }
     if (StartPage(hdc) <= 0) {
@@ -384,6 +400,7 @@ bool WindowsGdiPrinterAdapter::doPrintFromFile(const std::string& jobId,
         delete pBitmap;
         DeleteDC(hdc);
         outEvent.errorMessage = "StartPage failed";
+        outEvent.state = devices::DeviceState::STATE_ERROR;
         return false;
     }
 
@@ -426,6 +443,7 @@ bool WindowsGdiPrinterAdapter::printFromFile(const std::string& jobId, const std
     std::lock_guard<std::mutex> lock(mutex_);
     devices::PrintJobCompleteEvent ev;
     bool ok = doPrintFromFile(jobId, filePath, ev, orientation);
+    reportStateLocked(ev);
     if (printJobCompleteCallback_) {
         printJobCompleteCallback_(ev);
     }
@@ -437,14 +455,51 @@ bool WindowsGdiPrinterAdapter::print(const std::string& jobId,
     std::lock_guard<std::mutex> lock(mutex_);
     devices::PrintJobCompleteEvent ev;
     bool ok = doPrint(jobId, printData, ev);
+    reportStateLocked(ev);
     if (printJobCompleteCallback_) {
         printJobCompleteCallback_(ev);
     }
     return ok;
 }
 
+void WindowsGdiPrinterAdapter::reportStateLocked(const devices::PrintJobCompleteEvent& outcome) {
+    // 인쇄 시도로 알게 된 상태가 바뀔 때만 알림 (PrinterPool이 ERROR/DISCONNECTED 프린터의 대기 작업을 옮김)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        bool ready = outcome.state == devices::DeviceState::STATE_READY;
+        if (ready && !outcome.success) return;  // 장치와 무관한 실패(빈 데이터, 깨진 이미지) — 상태 유지
+        if (ready) lastError_.clear();
+        else lastError_ = outcome.errorMessage;
+        if (outcome.state == reportedState_) return;
+        // 프린터/DC 없음 → NOT_FOUND, StartDoc/StartPage 실패 → DEVICE_FAULT
+        devices::StateErrorCode error = devices::StateErrorCode::NONE;
+        if (outcome.state == devices::DeviceState::DISCONNECTED) error = devices::StateErrorCode::NOT_FOUND;
+        else if (!ready) error = devices::StateErrorCode::DEVICE_FAULT;
+        history_.record(reportedState_, outcome.state, error);
+        reportedState_ = outcome.state;
+    }
+    logging::Logger::getInstance().info("Printer " + deviceId_ + " state -> " + devices::deviceStateToString(outcome.state));
+    if (stateChangedCallback_) {
+        stateChangedCallback_(outcome.state);
+    }
+}
+
 bool WindowsGdiPrinterAdapter::reset() {
-    return true;
+    // printer_reset: 인쇄 실패로 고정된 상태를 풀고 다음 getState()에서 DC로 다시 확인
+    devices::DeviceState previous;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        previous = reportedState_;
+        reportedState_ = devices::DeviceState::STATE_READY;
+        lastError_.clear();
+    }
+    devices::DeviceState now = getState();
+    if (now != previous) {
+        history_.record(previous, now, now == devices::DeviceState::STATE_READY
+            ? devices::StateErrorCode::NONE : devices::StateErrorCode::NOT_FOUND);
+        if (stateChangedCallback_) stateChangedCallback_(now);
+    }
+    return now == devices::DeviceState::STATE_READY;
 }
 
 devices::PrinterCapabilities WindowsGdiPrinterAdapter::getCapabilities() const {
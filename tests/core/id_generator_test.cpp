@@ -0,0 +1,114 @@
+// tests/core/id_generator_test.cpp
+#include "core/id_generator.h"
+#include "test_harness.h"
+
+#include <chrono>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+uint64_t nowMs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+// 48-bit Unix ms = 처음 12 hex 자리 (8-4 그룹)
+uint64_t timestampOf(const std::string& id) {
+    return std::stoull(id.substr(0, 8) + id.substr(9, 4), nullptr, 16);
+}
+
+bool wellFormed(const std::string& id) {
+    if (id.size() != core::IdGenerator::kLength) {
+        return false;
+    }
+    for (size_t i = 0; i < id.size(); ++i) {
+        bool dash = (i == 8 || i == 13 || i == 18 || i == 23);
+        char ch = id[i];
+        if (dash ? ch != '-' : !((ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'f'))) {
+            return false;
+        }
+    }
+    // version 7, variant 10xx
+    return id[14] == '7' && (id[19] == '8' || id[19] == '9' || id[19] == 'a' || id[19] == 'b');
+}
+
+} // namespace
+
+TEST_CASE("id_generator.uuid_v7_layout") {
+    // 새 스레드의 첫 ID: 카운터 상태가 없으므로 타임스탬프는 현재 시각 그대로
+    std::string id;
+    uint64_t before = 0;
+    uint64_t after = 0;
+    std::thread([&] {
+        before = nowMs();
+        id = core::IdGenerator::next();
+        after = nowMs();
+    }).join();
+    CHECK(wellFormed(id));
+    CHECK(timestampOf(id) >= before);
+    CHECK(timestampOf(id) <= after);
+
+    char buffer[core::IdGenerator::kLength + 1];
+    core::IdGenerator::next(buffer);
+    CHECK(buffer[core::IdGenerator::kLength] == '\0');
+    CHECK(wellFormed(buffer));
+}
+
+TEST_CASE("id_generator.monotonic_within_millisecond") {
+    // 빠른 루프라 같은 ms에 수천 개가 나옴 — 카운터(넘치면 ms 올림)로도 엄격히 증가해야 함
+    const size_t count = 200000;
+    std::vector<std::string> ids;
+    ids.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        ids.push_back(core::IdGenerator::next());
+    }
+
+    size_t sameMs = 0;
+    bool increasing = true;
+    bool formed = true;
+    for (size_t i = 1; i < count; ++i) {
+        increasing = increasing && ids[i - 1] < ids[i];
+        formed = formed && wellFormed(ids[i]);
+        if (timestampOf(ids[i - 1]) == timestampOf(ids[i])) {
+            ++sameMs;
+        }
+    }
+    CHECK(increasing);
+    CHECK(formed);
+    CHECK(sameMs > 0);  // 같은 ms 경로가 실제로 검증되었는지
+    // 카운터가 넘쳐 ms를 앞당겨도 실제 시각에서 크게 벗어나지 않음
+    CHECK(timestampOf(ids.back()) <= nowMs() + 1000);
+}
+
+TEST_CASE("id_generator.unique_across_threads") {
+    const int threads = 4;
+    const size_t perThread = 20000;
+    std::vector<std::vector<std::string>> results(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&results, t, perThread] {
+            results[t].reserve(perThread);
+            for (size_t i = 0; i < perThread; ++i) {
+                results[t].push_back(core::IdGenerator::next());
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::set<std::string> all;
+    bool increasing = true;
+    for (const auto& ids : results) {
+        for (size_t i = 1; i < ids.size(); ++i) {
+            increasing = increasing && ids[i - 1] < ids[i];
+        }
+        all.insert(ids.begin(), ids.end());
+    }
+    CHECK(increasing);
+    CHECK(all.size() == threads * perThread);
+}
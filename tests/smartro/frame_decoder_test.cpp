@@ -0,0 +1,180 @@
+// tests/smartro/frame_decoder_test.cpp
+#include "vendor_adapters/smartro/frame_decoder.h"
+#include "test_harness.h"
+#include "smartro/frame_fixture.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace {
+
+using smartro::FrameDecoder;
+using TokenType = FrameDecoder::TokenType;
+
+struct Received {
+    TokenType type;
+    std::vector<uint8_t> bytes;  // FRAME / BAD_FRAME: 콜백 밖에서는 뷰가 무효이므로 복사
+};
+
+struct Collector {
+    FrameDecoder decoder;
+    std::vector<Received> tokens;
+    FrameDecoder::Sink sink = [this](const FrameDecoder::Token& token) {
+        tokens.push_back(Received{token.type,
+                                  std::vector<uint8_t>(token.frame.data, token.frame.data + token.frame.size)});
+    };
+
+    void feed(const std::vector<uint8_t>& data) { decoder.feed(data.data(), data.size(), sink); }
+    void feedBytewise(const std::vector<uint8_t>& data) {
+        for (uint8_t byte : data) {
+            decoder.feed(&byte, 1, sink);
+        }
+    }
+};
+
+std::vector<uint8_t> concat(std::initializer_list<std::vector<uint8_t>> parts) {
+    std::vector<uint8_t> out;
+    for (const auto& part : parts) {
+        out.insert(out.end(), part.begin(), part.end());
+    }
+    return out;
+}
+
+const std::vector<uint8_t> kAck = {smartro::ACK};
+
+} // namespace
+
+TEST_CASE("frame_decoder.split_frames") {
+    std::vector<uint8_t> frame = test::makeFrame('b', 20);
+    std::vector<uint8_t> stream = concat({kAck, frame, kAck});
+
+    // 모든 분할 지점: 토큰과 바이트는 한 번에 받았을 때와 같아야 함
+    for (size_t split = 0; split <= stream.size(); ++split) {
+        Collector c;
+        c.feed(std::vector<uint8_t>(stream.begin(), stream.begin() + split));
+        c.feed(std::vector<uint8_t>(stream.begin() + split, stream.end()));
+        REQUIRE(c.tokens.size() == 3);
+        CHECK(c.tokens[0].type == TokenType::ACK);
+        CHECK(c.tokens[1].type == TokenType::FRAME);
+        CHECK(c.tokens[1].bytes == frame);
+        CHECK(c.tokens[2].type == TokenType::ACK);
+        CHECK(!c.decoder.inFrame());
+    }
+
+    // 한 바이트씩: 조립 버퍼 경로
+    Collector bytewise;
+    bytewise.feedBytewise(concat({frame, frame}));
+    REQUIRE(bytewise.tokens.size() == 2);
+    CHECK(bytewise.tokens[0].bytes == frame);
+    CHECK(bytewise.tokens[1].bytes == frame);
+    CHECK(bytewise.decoder.getStats().zeroCopyFrames == 0);
+
+    // 청크 안에 통째로 있는 프레임은 복사하지 않음
+    Collector whole;
+    whole.feed(concat({frame, frame}));
+    CHECK(whole.decoder.getStats().frames == 2);
+    CHECK(whole.decoder.getStats().zeroCopyFrames == 2);
+}
+
+TEST_CASE("frame_decoder.bad_bcc_reported_once") {
+    // 데이터에 ACK/NACK 값이 들어 있는 프레임의 BCC가 깨짐: BAD_FRAME 한 번만, 그 안의 바이트는
+    // ACK/NACK로 다시 보고되지 않고(quietUntil), 뒤따르는 정상 프레임은 그대로 나옴
+    std::vector<uint8_t> bad = test::makeFrame('b', 6, smartro::ACK);
+    bad[smartro::HEADER_SIZE + 2] = smartro::NACK;
+    bad.back() ^= 0xFF;
+    std::vector<uint8_t> good = test::makeFrame('e', 3);
+    std::vector<uint8_t> stream = concat({bad, good, kAck});
+
+    for (int bytewise = 0; bytewise < 2; ++bytewise) {
+        Collector c;
+        if (bytewise) {
+            c.feedBytewise(stream);
+        } else {
+            c.feed(stream);
+        }
+        REQUIRE(c.tokens.size() == 3);
+        CHECK(c.tokens[0].type == TokenType::BAD_FRAME);
+        CHECK(c.tokens[0].bytes == bad);
+        CHECK(c.tokens[1].type == TokenType::FRAME);
+        CHECK(c.tokens[1].bytes == good);
+        CHECK(c.tokens[2].type == TokenType::ACK);
+        CHECK(c.decoder.getStats().badFrames == 1);
+    }
+
+    // ETX 자리가 틀려도 같은 처리
+    std::vector<uint8_t> noEtx = test::makeFrame('b', 2);
+    noEtx[noEtx.size() - 2] = 'X';
+    Collector c;
+    c.feed(concat({noEtx, good}));
+    REQUIRE(c.tokens.size() == 2);
+    CHECK(c.tokens[0].type == TokenType::BAD_FRAME);
+    CHECK(c.tokens[1].bytes == good);
+}
+
+TEST_CASE("frame_decoder.abandon_partial_rescans") {
+    // 잡음 0x02 뒤에 진짜 프레임: 잡음 STX의 길이 필드(=프레임의 바이트)가 한도 안이라
+    // 디코더는 긴 프레임을 기다리며 진짜 프레임을 조립 버퍼에 삼킴
+    std::vector<uint8_t> frame = test::makeFrame('a', 4);
+    Collector c;
+    c.feed(concat({{smartro::STX}, frame, kAck}));
+    CHECK(c.tokens.empty());
+    CHECK(c.decoder.inFrame());
+
+    // 나머지가 오지 않음 → 삼킨 바이트를 다시 훑어 프레임과 ACK를 순서대로 복구
+    c.decoder.abandonPartial(c.sink);
+    CHECK(!c.decoder.inFrame());
+    REQUIRE(c.tokens.size() == 2);
+    CHECK(c.tokens[0].type == TokenType::FRAME);
+    CHECK(c.tokens[0].bytes == frame);
+    CHECK(c.tokens[1].type == TokenType::ACK);
+
+    // 다시 훑은 뒤에도 미완성이면 버리고, 이후 입력은 정상 디코딩
+    Collector partial;
+    std::vector<uint8_t> head(frame.begin(), frame.begin() + 10);
+    partial.feed(head);
+    partial.decoder.abandonPartial(partial.sink);
+    CHECK(partial.tokens.empty());
+    CHECK(!partial.decoder.inFrame());
+    partial.feed(frame);
+    REQUIRE(partial.tokens.size() == 1);
+    CHECK(partial.tokens[0].bytes == frame);
+}
+
+TEST_CASE("frame_decoder.max_data_length") {
+    // 한도 정확히: 정상 프레임
+    std::vector<uint8_t> largest = test::makeFrame('b', FrameDecoder::MAX_DATA_LENGTH);
+    for (int bytewise = 0; bytewise < 2; ++bytewise) {
+        Collector c;
+        if (bytewise) {
+            c.feedBytewise(largest);
+        } else {
+            c.feed(largest);
+        }
+        REQUIRE(c.tokens.size() == 1);
+        CHECK(c.tokens[0].type == TokenType::FRAME);
+        CHECK(c.tokens[0].bytes == largest);
+    }
+
+    // 한도 초과 길이 필드: 그 STX는 잡음 — 기다리지도, BAD_FRAME으로 보고하지도 않고 바로 다음 바이트부터
+    std::vector<uint8_t> oversized = test::makeFrame('b', 0);
+    oversized[33] = static_cast<uint8_t>((FrameDecoder::MAX_DATA_LENGTH + 1) & 0xFF);
+    oversized[34] = static_cast<uint8_t>((FrameDecoder::MAX_DATA_LENGTH + 1) >> 8);
+    std::vector<uint8_t> header(oversized.begin(), oversized.begin() + smartro::HEADER_SIZE);
+    std::vector<uint8_t> good = test::makeFrame('e', 1);
+    std::vector<uint8_t> stream = concat({header, good, kAck});
+
+    for (int bytewise = 0; bytewise < 2; ++bytewise) {
+        Collector c;
+        if (bytewise) {
+            c.feedBytewise(stream);
+        } else {
+            c.feed(stream);
+        }
+        REQUIRE(c.tokens.size() == 2);
+        CHECK(c.tokens[0].type == TokenType::FRAME);
+        CHECK(c.tokens[0].bytes == good);
+        CHECK(c.tokens[1].type == TokenType::ACK);
+        CHECK(c.decoder.getStats().badFrames == 0);
+        CHECK(!c.decoder.inFrame());
+    }
+}
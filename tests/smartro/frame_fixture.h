@@ -0,0 +1,31 @@
+// tests/smartro/frame_fixture.h
+#pragma once
+
+#include "vendor_adapters/smartro/smartro_protocol.h"
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace test {
+
+// STX | header (job code 31, data length 33-34 LE) | data | ETX | BCC(STX..ETX)
+inline std::vector<uint8_t> makeFrame(char jobCode, size_t dataLength, uint8_t fill = 'D') {
+    std::vector<uint8_t> frame(smartro::HEADER_SIZE + dataLength + smartro::TAIL_SIZE, '0');
+    frame[0] = smartro::STX;
+    frame[31] = static_cast<uint8_t>(jobCode);
+    frame[33] = static_cast<uint8_t>(dataLength & 0xFF);
+    frame[34] = static_cast<uint8_t>(dataLength >> 8);
+    for (size_t i = 0; i < dataLength; ++i) {
+        frame[smartro::HEADER_SIZE + i] = fill;
+    }
+    frame[frame.size() - 2] = smartro::ETX;
+    uint8_t bcc = 0;
+    for (size_t i = 0; i + 1 < frame.size(); ++i) {
+        bcc ^= frame[i];
+    }
+    frame.back() = bcc;
+    return frame;
+}
+
+} // namespace test
@@ -0,0 +1,204 @@
+// tests/smartro/serial_port_test.cpp
+// POSIX termios 백엔드를 pty 위에서 검증 (master = 단말기 쪽, slave = SerialPort가 여는 tty)
+#include "logging/logger.h"
+#include "vendor_adapters/smartro/serial_port.h"
+#include "test_harness.h"
+#include "smartro/frame_fixture.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <future>
+#include <vector>
+#include <string>
+
+#include <poll.h>
+#include <unistd.h>
+#if defined(__APPLE__)
+    #include <util.h>
+#else
+    #include <pty.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+long long elapsedMs(Clock::time_point since) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - since).count();
+}
+
+struct Pty {
+    int master = -1;
+    int slave = -1;
+    std::string slaveName;
+
+    Pty() {
+        char name[128] = {};
+        if (openpty(&master, &slave, name, nullptr, nullptr) == 0) {
+            slaveName = name;
+        }
+    }
+    ~Pty() {
+        if (master >= 0) ::close(master);
+        if (slave >= 0) ::close(slave);
+    }
+    bool ok() const { return master >= 0 && !slaveName.empty(); }
+
+    // Terminal side: read exactly length bytes the port wrote (empty on timeout)
+    std::vector<uint8_t> receive(size_t length, int timeoutMs) {
+        std::vector<uint8_t> out;
+        auto start = Clock::now();
+        while (out.size() < length) {
+            int remaining = timeoutMs - static_cast<int>(elapsedMs(start));
+            pollfd pfd = {master, POLLIN, 0};
+            if (remaining <= 0 || poll(&pfd, 1, remaining) <= 0) {
+                return {};
+            }
+            uint8_t chunk[256];
+            ssize_t n = ::read(master, chunk, std::min(sizeof(chunk), length - out.size()));
+            if (n <= 0) {
+                return {};
+            }
+            out.insert(out.end(), chunk, chunk + n);
+        }
+        return out;
+    }
+};
+
+} // namespace
+
+TEST_CASE("serial_port.frame_roundtrip") {
+    Pty pty;
+    REQUIRE(pty.ok());
+    smartro::SerialPort port;
+    REQUIRE(port.open(pty.slaveName, 115200));
+
+    // 단말기 → 포트: raw 모드라 바이트 변환 없이 그대로 도착해야 함
+    std::vector<uint8_t> response = test::makeFrame('a', 4);
+    REQUIRE(::write(pty.master, response.data(), response.size()) == static_cast<ssize_t>(response.size()));
+    std::vector<uint8_t> received(response.size());
+    REQUIRE(port.readExact(received.data(), received.size(), 1000));
+    CHECK(received == response);
+    CHECK(port.available() == 0);
+
+    // 포트 → 단말기
+    std::vector<uint8_t> request = test::makeFrame('A', 0);
+    REQUIRE(port.write(request.data(), request.size()));
+    CHECK(pty.receive(request.size(), 1000) == request);
+}
+
+TEST_CASE("serial_port.read_timeout") {
+    Pty pty;
+    REQUIRE(pty.ok());
+    smartro::SerialPort port;
+    REQUIRE(port.open(pty.slaveName, 115200));
+
+    uint8_t buffer[16];
+    size_t bytesRead = 1;
+    auto start = Clock::now();
+    CHECK(!port.read(buffer, sizeof(buffer), bytesRead, 200));
+    long long waited = elapsedMs(start);
+    CHECK(bytesRead == 0);
+    CHECK(waited >= 180);
+    CHECK(waited < 1000);
+
+    // readExact: 일부만 오면 시간 내 실패, 받은 바이트는 링에 남음
+    const uint8_t partial[3] = {smartro::STX, 'x', 'y'};
+    REQUIRE(::write(pty.master, partial, sizeof(partial)) == 3);
+    start = Clock::now();
+    CHECK(!port.readExact(buffer, 8, 200));
+    CHECK(elapsedMs(start) < 1000);
+    CHECK(port.available() == 3);
+}
+
+TEST_CASE("serial_port.close_wakes_blocked_read") {
+    Pty pty;
+    REQUIRE(pty.ok());
+    smartro::SerialPort port;
+    REQUIRE(port.open(pty.slaveName, 115200));
+
+    auto reader = std::async(std::launch::async, [&port] {
+        uint8_t buffer[16];
+        size_t bytesRead = 0;
+        bool ok = port.read(buffer, sizeof(buffer), bytesRead, smartro::SerialPort::WAIT_FOREVER);
+        return ok || bytesRead != 0;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CHECK(reader.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+
+    auto start = Clock::now();
+    port.close();
+    REQUIRE(reader.wait_for(std::chrono::seconds(2)) == std::future_status::ready);
+    CHECK(!reader.get());
+    CHECK(elapsedMs(start) < 1000);
+
+    CHECK(!port.isOpen());
+    uint8_t buffer[4];
+    size_t bytesRead = 0;
+    CHECK(!port.read(buffer, sizeof(buffer), bytesRead, 0));
+    const uint8_t ack = smartro::ACK;
+    CHECK(!port.write(&ack, 1));
+
+    // 다시 열면 이전 깨우기가 남아 있지 않아 정상적으로 대기/수신
+    REQUIRE(port.open(pty.slaveName, 115200));
+    REQUIRE(::write(pty.master, &ack, 1) == 1);
+    CHECK(port.read(buffer, sizeof(buffer), bytesRead, 1000));
+    CHECK(bytesRead == 1);
+    CHECK(buffer[0] == smartro::ACK);
+}
+
+TEST_CASE("serial_port.ring_wraparound") {
+    Pty pty;
+    REQUIRE(pty.ok());
+    smartro::SerialPort port;
+    REQUIRE(port.open(pty.slaveName, 115200));
+
+    // 링(4096)보다 긴 스트림을 여러 번 감아 돌며 읽음: 바이트 순서/내용이 그대로여야 함
+    auto patternAt = [](size_t position) { return static_cast<uint8_t>((position * 7 + position / 251) & 0xFF); };
+    const size_t chunk = 3000;  // 4096의 약수가 아니어서 매번 다른 위치에서 끝을 넘음
+    size_t written = 0;
+    size_t readPos = 0;
+    for (int round = 0; round < 5; ++round) {
+        std::vector<uint8_t> out(chunk);
+        for (size_t i = 0; i < chunk; ++i) {
+            out[i] = patternAt(written + i);
+        }
+        REQUIRE(::write(pty.master, out.data(), out.size()) == static_cast<ssize_t>(out.size()));
+        written += chunk;
+
+        std::vector<uint8_t> in(chunk);
+        REQUIRE(port.readExact(in.data(), in.size(), 2000));
+        bool same = true;
+        for (size_t i = 0; i < chunk; ++i) {
+            same = same && in[i] == patternAt(readPos + i);
+        }
+        CHECK(same);
+        readPos += chunk;
+    }
+
+    // peekView는 링 끝까지의 연속 구간만 보여주고, consume 후 나머지가 앞쪽에서 이어짐
+    // (읽은 위치 15000 = 링 안 오프셋 2712 → 끝까지 1384바이트)
+    const size_t toEnd = 4096 - (readPos % 4096);
+    const size_t length = toEnd + 100;
+    std::vector<uint8_t> out(length);
+    for (size_t i = 0; i < length; ++i) {
+        out[i] = patternAt(written + i);
+    }
+    REQUIRE(::write(pty.master, out.data(), out.size()) == static_cast<ssize_t>(out.size()));
+
+    std::vector<uint8_t> seen;
+    bool reachedEnd = false;
+    while (seen.size() < length) {
+        const uint8_t* view = nullptr;
+        size_t viewed = port.peekView(view, 1000);
+        REQUIRE(viewed > 0);
+        CHECK(viewed <= 4096 - ((readPos + seen.size()) % 4096));
+        seen.insert(seen.end(), view, view + std::min(viewed, length - seen.size()));
+        port.consume(viewed);
+        reachedEnd = reachedEnd || (readPos + seen.size()) % 4096 == 0;
+    }
+    CHECK(reachedEnd);
+    CHECK(seen == out);
+    CHECK(port.available() == 0);
+}
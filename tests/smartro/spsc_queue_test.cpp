@@ -0,0 +1,107 @@
+// tests/smartro/spsc_queue_test.cpp
+#include "vendor_adapters/smartro/spsc_queue.h"
+#include "test_harness.h"
+
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace {
+
+// 살아 있는 객체 수를 세어 슬롯의 생성/소멸 짝을 검증
+struct Tracked {
+    static int live;
+    int value = -1;
+
+    Tracked() { ++live; }
+    explicit Tracked(int v) : value(v) { ++live; }
+    Tracked(const Tracked& other) : value(other.value) { ++live; }
+    Tracked& operator=(const Tracked& other) = default;
+    ~Tracked() { --live; }
+};
+int Tracked::live = 0;
+
+} // namespace
+
+TEST_CASE("spsc_queue.wraparound") {
+    Tracked::live = 0;
+    {
+        smartro::SpscQueue<Tracked, 4> queue;
+        Tracked out;
+        int nextIn = 0;
+        int nextOut = 0;
+        bool ordered = true;
+
+        // 인덱스가 용량의 여러 배를 지나도록, 채움 정도를 바꿔 가며 넣고 뺌
+        for (int round = 0; round < 100; ++round) {
+            int fill = 1 + round % 4;
+            for (int i = 0; i < fill; ++i) {
+                Tracked* slot = queue.prepare(nextIn++);
+                REQUIRE(slot != nullptr);
+                queue.publish();
+            }
+            CHECK(queue.size() == static_cast<size_t>(fill));
+            if (fill == 4) {
+                CHECK(queue.prepare(-1) == nullptr);  // 가득 참
+            }
+            while (queue.tryPop(out)) {
+                ordered = ordered && out.value == nextOut++;
+            }
+            CHECK(queue.empty());
+        }
+        CHECK(ordered);
+        CHECK(nextOut == nextIn);
+        CHECK(Tracked::live == 1);  // out만 남음
+
+        // discard한 항목은 보이지 않고 슬롯은 다음 prepare가 재사용
+        REQUIRE(queue.prepare(1000) != nullptr);
+        queue.discard();
+        CHECK(queue.empty());
+        REQUIRE(queue.prepare(1001) != nullptr);
+        queue.publish();
+        REQUIRE(queue.tryPop(out));
+        CHECK(out.value == 1001);
+
+        // 남은 항목은 큐 소멸자가 정리
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(queue.prepare(i) != nullptr);
+            queue.publish();
+        }
+        CHECK(Tracked::live == 4);
+    }
+    CHECK(Tracked::live == 0);
+}
+
+TEST_CASE("spsc_queue.concurrent_order") {
+    // 작은 용량으로 생산자/소비자가 계속 가득 참/빔 경계를 지나며 인덱스가 수만 번 감김
+    smartro::SpscQueue<std::string, 8> queue;
+    const int count = 200000;
+
+    std::thread producer([&queue, count] {
+        for (int i = 0; i < count; ++i) {
+            std::string* slot;
+            while ((slot = queue.prepare()) == nullptr) {
+                std::this_thread::yield();
+            }
+            *slot = std::to_string(i);
+            queue.publish();
+        }
+    });
+
+    std::string item;
+    int expected = 0;
+    bool ordered = true;
+    while (expected < count) {
+        if (!queue.tryPop(item)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ordered = ordered && item == std::to_string(expected);
+        ++expected;
+    }
+    producer.join();
+
+    CHECK(ordered);
+    CHECK(queue.empty());
+    CHECK(queue.size() == 0);
+}
@@ -0,0 +1,66 @@
+// tests/test_harness.h
+#pragma once
+
+// 외부 의존성 없는 최소 테스트 러너: TEST_CASE로 등록, CHECK/REQUIRE로 검증.
+// unit_tests [prefix] — 이름이 prefix로 시작하는 케이스만 실행 (CTest는 모듈별로 호출)
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace test {
+
+struct Case {
+    const char* name;
+    std::function<void()> body;
+};
+
+inline std::vector<Case>& registry() {
+    static std::vector<Case> cases;
+    return cases;
+}
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+struct Registrar {
+    Registrar(const char* name, std::function<void()> body) {
+        registry().push_back(Case{name, std::move(body)});
+    }
+};
+
+struct RequireFailed {};
+
+inline void fail(const char* file, int line, const char* expr) {
+    std::fprintf(stderr, "  %s:%d: CHECK(%s) failed\n", file, line, expr);
+    ++failures();
+}
+
+} // namespace test
+
+#define TEST_CONCAT_INNER(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_INNER(a, b)
+
+#define TEST_CASE(name)                                                          \
+    static void TEST_CONCAT(testBody_, __LINE__)();                              \
+    static ::test::Registrar TEST_CONCAT(testRegistrar_, __LINE__)(              \
+        name, &TEST_CONCAT(testBody_, __LINE__));                                \
+    static void TEST_CONCAT(testBody_, __LINE__)()
+
+// 실패해도 계속 진행
+#define CHECK(expr)                                                              \
+    do {                                                                         \
+        if (!(expr)) ::test::fail(__FILE__, __LINE__, #expr);                    \
+    } while (0)
+
+// 실패하면 현재 케이스 중단 (이후 단계가 앞 결과에 의존할 때)
+#define REQUIRE(expr)                                                            \
+    do {                                                                         \
+        if (!(expr)) {                                                           \
+            ::test::fail(__FILE__, __LINE__, #expr);                             \
+            throw ::test::RequireFailed{};                                       \
+        }                                                                        \
+    } while (0)
@@ -0,0 +1,39 @@
+// tests/test_main.cpp
+#include "test_harness.h"
+
+#include <exception>
+
+int main(int argc, char** argv) {
+    std::string prefix = (argc > 1) ? argv[1] : "";
+    int ran = 0;
+    int failedCases = 0;
+
+    for (const test::Case& c : test::registry()) {
+        if (std::string(c.name).compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        ++ran;
+        int before = test::failures();
+        std::printf("[ RUN  ] %s\n", c.name);
+        try {
+            c.body();
+        } catch (const test::RequireFailed&) {
+            // 이미 보고됨
+        } catch (const std::exception& e) {
+            std::fprintf(stderr, "  unexpected exception: %s\n", e.what());
+            ++test::failures();
+        }
+        bool ok = test::failures() == before;
+        if (!ok) {
+            ++failedCases;
+        }
+        std::printf("[ %s ] %s\n", ok ? " OK " : "FAIL", c.name);
+    }
+
+    if (ran == 0) {
+        std::fprintf(stderr, "no test case matches '%s'\n", prefix.c_str());
+        return 1;
+    }
+    std::printf("%d case(s), %d failed\n", ran, failedCases);
+    return failedCases == 0 ? 0 : 1;
+}